@@ -162,7 +162,7 @@ void CL_Record_f (){
 
 	// Send the server data
 	MSG_WriteByte(&msg, SVC_SERVERDATA);
-	MSG_WriteLong(&msg, PROTOCOL_VERSION);
+	MSG_WriteLong(&msg, cls.serverProtocol);
 	MSG_WriteLong(&msg, 0x10000 + cl.serverCount);
 	MSG_WriteByte(&msg, 1);			// Demos are always attract loops
 	MSG_WriteString(&msg, cl.gameDir);
@@ -206,7 +206,11 @@ void CL_Record_f (){
 		}
 
 		MSG_WriteByte(&msg, SVC_SPAWNBASELINE);
-		MSG_WriteDeltaEntity(&msg, &nullState, entity, true, true);
+
+		if (cls.serverProtocol == PROTOCOL_VERSION)
+			MSG_WritePackedDeltaEntity(&msg, &nullState, entity, true, true);
+		else
+			MSG_WriteDeltaEntity(&msg, &nullState, entity, true, true);
 	}
 
 	MSG_WriteByte(&msg, SVC_STUFFTEXT);
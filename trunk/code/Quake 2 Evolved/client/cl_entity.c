@@ -29,6 +29,11 @@
 #include "client.h"
 
 
+// The bit-packed protocol has no header bits, so entities that have a delta to
+// parse are tagged with this to tell them apart from unchanged ones
+#define U_PACKED					(1<<28)
+
+
 static const char *	cl_eventNames[256] = {
 	"EV_NONE",
 	"EV_ITEM_RESPAWN",
@@ -61,6 +66,18 @@ static int CL_ParseEntityBits (uint *bits){
 
     uint	b, total;
     int		number;
+	bool	remove;
+
+	if (cls.serverProtocol == PROTOCOL_VERSION){
+		number = MSG_ReadPackedEntityNumber(&net_message, &remove);
+
+		if (remove)
+			*bits = U_REMOVE;
+		else
+			*bits = U_PACKED;
+
+		return number;
+	}
 
     total = MSG_ReadByte(&net_message);
 
@@ -96,6 +113,11 @@ static int CL_ParseEntityBits (uint *bits){
 */
 static void CL_ParseDelta (entity_state_t *from, entity_state_t *to, int number, int bits){
 
+	if (bits & U_PACKED){
+		MSG_ReadPackedDeltaEntity(&net_message, from, to, number);
+		return;
+	}
+
     // Set everything to the state we are delta'ing from
     *to = *from;
 
@@ -357,6 +379,15 @@ static void CL_ParsePlayerState (frame_t *oldFrame, frame_t *newFrame){
     else
         Mem_Fill(state, 0, sizeof(*state));
 
+	if (cls.serverProtocol == PROTOCOL_VERSION){
+		MSG_ReadPackedDeltaPlayerState(&net_message, state, state);
+
+		if (cl.demoPlayback)
+			state->pmove.pm_type = PM_FREEZE;	// Demo playback
+
+		return;
+	}
+
     flags = MSG_ReadShort(&net_message);
 
     // Parse the pmove_state_t
@@ -97,6 +97,51 @@ static void CL_RegisterLoadingInfo (){
 		cl.media.loadingPercent[i] = R_RegisterMaterialNoMip(Str_VarArgs("ui/assets/loading/percent/load_%i", j));
 }
 
+/*
+ ==================
+ CL_PrecacheFiles
+
+ Reads the files we know will be loaded in parallel, before the loaders ask for
+ them one at a time
+ ==================
+*/
+static void CL_PrecacheFiles (){
+
+	static char	imageNames[MAX_IMAGES][MAX_PATH_LENGTH];
+	const char	*names[MAX_MODELS + MAX_IMAGES];
+	int			numNames = 0;
+	int			i;
+
+	CL_UpdateLoading("files");
+
+	// The world map and the models that the server references
+	for (i = 1; i < MAX_MODELS; i++){
+		if (!cl.configStrings[CS_MODELS + i][0])
+			break;
+
+		if (cl.configStrings[CS_MODELS + i][0] == '*' || cl.configStrings[CS_MODELS + i][0] == '#')
+			continue;
+
+		names[numNames++] = cl.configStrings[CS_MODELS + i];
+	}
+
+	// The pics that the server references. Only the bare names map to a known
+	// file, the others are materials.
+	for (i = 1; i < MAX_IMAGES; i++){
+		if (!cl.configStrings[CS_IMAGES + i][0])
+			break;
+
+		if (Str_FindChar(cl.configStrings[CS_IMAGES + i], '/'))
+			continue;
+
+		Str_SPrintf(imageNames[i], sizeof(imageNames[i]), "pics/%s.pcx", cl.configStrings[CS_IMAGES + i]);
+
+		names[numNames++] = imageNames[i];
+	}
+
+	FS_PrecacheFiles(names, numNames);
+}
+
 /*
  ==================
  CL_RegisterClipMap
@@ -391,6 +436,7 @@ static void CL_LoadAssets (){
 	Com_Printf("Loading %s\n", cls.loadingInfo.name);
 
 	CL_RegisterLoadingInfo();
+	CL_PrecacheFiles();
 	CL_RegisterClipMap();
 	CL_RegisterSoundShaders();
 	CL_RegisterGraphics();
@@ -450,6 +496,9 @@ void CL_LoadLevel (){
 	// All precaches are now complete
 	cls.state = CA_PRIMED;
 
+	// Free all precached files
+	FS_FlushPrecache();
+
 	// Free all temporary allocations
 	Mem_FreeAll(TAG_TEMPORARY, true);
 
@@ -476,6 +525,9 @@ void CL_FreeLevel (){
 
 	// Clear the testing utilities
 	CL_ClearTestTools();
+
+	// Free any files left over from an interrupted level load
+	FS_FlushPrecache();
 }
 
 
@@ -56,6 +56,7 @@ cvar_t *					cl_pitchSpeed;
 cvar_t *					cl_angleSpeedKey;
 cvar_t *					cl_run;
 cvar_t *					cl_noDelta;
+cvar_t *					cl_legacyProtocol;
 cvar_t *					cl_showNet;
 cvar_t *					cl_showMiss;
 cvar_t *					cl_showEvents;
@@ -406,9 +407,16 @@ static void CL_SendChallengePacket (){
 */
 static void CL_SendConnectPacket (){
 
+	int		protocol;
+
 	CVar_ClearModifiedFlags(CVAR_USERINFO);
 
-	NET_OutOfBandPrintf(NS_CLIENT, cls.serverAddress, "connect %i %i %i \"%s\"\n", PROTOCOL_VERSION, CVar_GetVariableInteger("net_qport"), cls.serverChallenge, CVar_InfoString(CVAR_USERINFO));
+	if (cl_legacyProtocol->integerValue)
+		protocol = PROTOCOL_VERSION_LEGACY;
+	else
+		protocol = PROTOCOL_VERSION;
+
+	NET_OutOfBandPrintf(NS_CLIENT, cls.serverAddress, "connect %i %i %i \"%s\" %i %i 1\n", protocol, CVar_GetVariableInteger("net_qport"), cls.serverChallenge, CVar_InfoString(CVAR_USERINFO), CVar_GetVariableInteger("net_compression"), (int)NetComp_TableChecksum());
 }
 
 /*
@@ -504,8 +512,17 @@ void CL_Disconnect (bool shuttingDown){
 		return;
 
 	if (com_timeDemo->integerValue){
-		timeDemoMsec = Sys_Milliseconds() - cl.timeDemoStart;
-		timeDemoFrames = cl.timeDemoFrames;
+		if (cl.timeDemoStart){
+			timeDemoMsec = Sys_Milliseconds() - cl.timeDemoStart;
+			timeDemoFrames = cl.timeDemoFrames;
+
+			// Print the renderer stage timings before the renderer is restarted
+			R_PrintTimeDemoStats();
+		}
+		else {
+			timeDemoMsec = 0;
+			timeDemoFrames = 0;
+		}
 	}
 
 	cls.state = CA_DISCONNECTED;
@@ -666,6 +683,8 @@ static void CL_ChallengePacket (){
 */
 static void CL_ClientConnectPacket (){
 
+	bool	fragments = false;
+
 	if (cls.state != CA_CHALLENGING){
 		if (cls.state == CA_CONNECTED)
 			Com_Printf("Dup 'connect' received. Ignored\n");
@@ -683,7 +702,15 @@ static void CL_ClientConnectPacket (){
 	// Set up the network channel
 	cls.state = CA_CONNECTED;
 
-	NetChan_Setup(&cls.netChan, NS_CLIENT, net_from, CVar_GetVariableInteger("net_qport"));
+	// Newer servers may send messages larger than a packet
+	if (Cmd_Argc() > 2)
+		fragments = (Str_ToInteger(Cmd_Argv(2)) != 0);
+
+	NetChan_Setup(&cls.netChan, NS_CLIENT, net_from, CVar_GetVariableInteger("net_qport"), fragments);
+
+	// Use the compression mode picked by the server, if any
+	if (Cmd_Argc() > 1)
+		cls.netChan.compression = (netCompression_t)ClampInt(Str_ToInteger(Cmd_Argv(1)), NC_NONE, NC_ADAPTIVE);
 
 	MSG_WriteChar(&cls.netChan.message, CLC_STRINGCMD);
 	MSG_WriteString(&cls.netChan.message, "new");
@@ -949,6 +976,8 @@ static bool CL_CheckOrDownloadFile (const char *name){
 	cls.downloadStart = cls.realTime;
 	cls.downloadBytes = 0;
 	cls.downloadPercent = 0;
+	cls.downloadBlock = 0;
+	cls.downloadAcknowledge = false;
 
 	if (length){
 		FS_Seek(cls.downloadFile, 0, FS_SEEK_END);
@@ -1797,6 +1826,7 @@ static void CL_Register (){
 	cl_angleSpeedKey = CVar_Register("cl_angleSpeedKey", "1.5", CVAR_FLOAT, CVAR_ARCHIVE, NULL, 0.0f, 100.0f);
 	cl_run = CVar_Register("cl_run", "0", CVAR_BOOL, CVAR_ARCHIVE, NULL, 0, 0);
 	cl_noDelta = CVar_Register("cl_noDelta", "0", CVAR_BOOL, 0, NULL, 0, 0);
+	cl_legacyProtocol = CVar_Register("cl_legacyProtocol", "0", CVAR_BOOL, CVAR_ARCHIVE, "Connect using the legacy byte-aligned protocol, for old servers", 0, 0);
 	cl_showNet = CVar_Register("cl_showNet", "0", CVAR_BOOL, 0, NULL, 0, 0);
 	cl_showMiss = CVar_Register("cl_showMiss", "0", CVAR_BOOL, 0, NULL, 0, 0);
 	cl_showEvents = CVar_Register("cl_showEvents", "0", CVAR_BOOL, CVAR_CHEAT | CVAR_GAME, "Show entity events", 0, 0);
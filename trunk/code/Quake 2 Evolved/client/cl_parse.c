@@ -208,16 +208,26 @@ static void CL_ParseCenterPrint (){
 */
 static void CL_ParseDownload (){
 
-	int		size, percent;
+	int		size, percent, block = 0;
 
 	// Parse the data
 	size = MSG_ReadShort(&net_message);
 	percent = MSG_ReadByte(&net_message);
 
+	// Windowed downloads number the blocks, so lost and duplicated blocks
+	// can be detected
+	if (cls.netChan.fragments)
+		block = MSG_ReadLong(&net_message);
+
 	if (!cls.downloadFile){
-		Com_Printf("Unwanted download received. Ignored\n");
+		// Blocks that were sent again after the download finished are
+		// expected, so don't complain about them
+		if (!cls.netChan.fragments)
+			Com_Printf("Unwanted download received. Ignored\n");
+
+		if (size > 0)
+			net_message.readCount += size;
 
-		net_message.readCount += size;
 		return;
 	}
 
@@ -234,6 +244,20 @@ static void CL_ParseDownload (){
 		return;
 	}
 
+	if (cls.netChan.fragments){
+		// Acknowledge every block we get, so the server knows which ones
+		// were lost
+		cls.downloadAcknowledge = true;
+
+		// Ignore anything but the next block
+		if (block != cls.downloadBlock){
+			net_message.readCount += size;
+			return;
+		}
+
+		cls.downloadBlock++;
+	}
+
 	cls.downloadBytes += size;
 	cls.downloadPercent = percent;
 
@@ -249,12 +273,23 @@ static void CL_ParseDownload (){
 		// Rename the temp file to its final name
 		FS_RenameFile(cls.downloadTempName, cls.downloadName);
 
+		// Let the server know it can close the file
+		if (cls.netChan.fragments){
+			cls.downloadAcknowledge = false;
+
+			MSG_WriteByte(&cls.netChan.message, CLC_STRINGCMD);
+			MSG_WriteString(&cls.netChan.message, Str_VarArgs("nextdl %i", cls.downloadBlock));
+		}
+
 		// Get another file if needed
 		CL_RequestNextDownload();
 		return;
 	}
 
 	// Request next block
+	if (cls.netChan.fragments)
+		return;
+
 	MSG_WriteByte(&cls.netChan.message, CLC_STRINGCMD);
 	MSG_Print(&cls.netChan.message, "nextdl");
 }
@@ -283,9 +318,9 @@ static void CL_ParseServerData (){
 	cls.serverProtocol = MSG_ReadLong(&net_message);
 
 	// BIG HACK to let old demos continue to work
-	if (Com_ServerState() && PROTOCOL_VERSION == 34)
+	if (Com_ServerState())
 		;
-	else if (cls.serverProtocol != PROTOCOL_VERSION)
+	else if (cls.serverProtocol != PROTOCOL_VERSION && cls.serverProtocol != PROTOCOL_VERSION_LEGACY)
 		Com_Error(ERR_DROP, "Server returned version %i, not %i", cls.serverProtocol, PROTOCOL_VERSION);
 
 	cl.serverCount = MSG_ReadLong(&net_message);
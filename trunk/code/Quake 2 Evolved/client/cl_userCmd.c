@@ -238,6 +238,19 @@ void CL_BuildUserCmd (){
 		return;
 
 	if (cls.state < CA_ACTIVE){
+		// Acknowledge the download blocks received so far
+		if (cls.downloadAcknowledge){
+			cls.downloadAcknowledge = false;
+
+			MSG_Init(&msg, data, sizeof(data), false);
+
+			MSG_WriteByte(&msg, CLC_STRINGCMD);
+			MSG_WriteString(&msg, Str_VarArgs("nextdl %i", cls.downloadBlock));
+
+			NetChan_Transmit(&cls.netChan, msg.data, msg.curSize);
+			return;
+		}
+
 		if (cls.netChan.message.curSize	|| Sys_Milliseconds() - cls.netChan.lastSent > 1000)
 			NetChan_Transmit(&cls.netChan, NULL, 0);
 
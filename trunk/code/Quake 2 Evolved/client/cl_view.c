@@ -369,6 +369,17 @@ void CL_RenderActiveFrame (){
 		return;
 	}
 
+	// Time demo frames are counted from the first valid frame
+	if (com_timeDemo->integerValue){
+		if (!cl.timeDemoStart){
+			cl.timeDemoStart = Sys_Milliseconds();
+
+			R_ClearTimeDemoStats();
+		}
+
+		cl.timeDemoFrames++;
+	}
+
 	// Clear render lists
 	R_ClearScene();
 
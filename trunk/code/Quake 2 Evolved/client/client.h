@@ -402,6 +402,8 @@ typedef struct {
 	int						downloadStart;
 	int						downloadBytes;
 	int						downloadPercent;
+	int						downloadBlock;
+	bool					downloadAcknowledge;
 	char					downloadName[MAX_PATH_LENGTH];
 	char					downloadTempName[MAX_PATH_LENGTH];
 
@@ -465,6 +467,7 @@ extern cvar_t *				cl_pitchSpeed;
 extern cvar_t *				cl_angleSpeedKey;
 extern cvar_t *				cl_run;
 extern cvar_t *				cl_noDelta;
+extern cvar_t *				cl_legacyProtocol;
 extern cvar_t *				cl_showNet;
 extern cvar_t *				cl_showMiss;
 extern cvar_t *				cl_showEvents;
@@ -63,9 +63,18 @@ typedef struct {
 	int						contents;
 	int						numSides;
 	int						firstBrushSide;
+	int						firstSideGroup;
 	int						checkCount;		// To avoid repeated testings
 } clipBrush_t;
 
+// Brush side planes are also stored as structure-of-arrays in groups of four,
+// so the SIMD code can clip a box against four sides at once. The last group
+// of a brush is padded with null planes.
+typedef struct {
+	float					normal[3][4];
+	float					dist[4];
+} clipSideGroup_t;
+
 typedef struct {
 	cplane_t *				plane;
 	clipSurface_t *			surface;
@@ -76,6 +85,17 @@ typedef struct {
 	int						children[2];	// Negative numbers are leafs
 } clipNode_t;
 
+// Nodes are rebuilt into a flat array with the plane inlined, so a trace
+// touches a single 32 byte structure per node, and two nodes fit in a cache
+// line
+typedef struct {
+	vec3_t					normal;
+	float					dist;
+	int						type;			// For fast side tests
+	int						children[2];	// Negative numbers are leafs
+	int						pad;
+} clipFlatNode_t;
+
 typedef struct {
 	int						numAreaPortals;
 	int						firstAreaPortal;
@@ -106,6 +126,11 @@ typedef struct {
 	int						numVisibility;
 	clipVis_t *				visibility;
 
+	int						visRowSize;		// Decompressed row size, padded to 16 bytes
+	byte *					pvsRows;		// Decompressed PVS rows, if cached
+	byte *					phsRows;		// Decompressed PHS rows, if cached
+	byte *					visRowFlags;	// Rows that have been decompressed
+
 	int						numLeafs;
 	int						numClusters;
 	clipLeaf_t *			leafs;
@@ -119,8 +144,12 @@ typedef struct {
 	int						numBrushSides;
 	clipBrushSide_t *		brushSides;
 
+	int						numSideGroups;
+	clipSideGroup_t *		sideGroups;		// Used by traces
+
 	int						numNodes;
 	clipNode_t *			nodes;
+	clipFlatNode_t *		flatNodes;		// Used by traces
 
 	int						numModels;
 	clipInlineModel_t *		models;
@@ -143,6 +172,27 @@ void			CM_CreateBoxModel ();
 void			CM_InitModels ();
 void			CM_ShutdownModels ();
 
+/*
+ ==============================================================================
+
+ TRACING
+
+ ==============================================================================
+*/
+
+void			CM_InitTraces ();
+void			CM_ShutdownTraces ();
+
+/*
+ ==============================================================================
+
+ VISIBILITY
+
+ ==============================================================================
+*/
+
+void			CM_BuildVisCache ();
+
 /*
  ==============================================================================
 
@@ -152,6 +202,13 @@ void			CM_ShutdownModels ();
 */
 
 typedef struct {
+	int						traces;
+	int						traceNodes;
+	int						traceBrushes;
+	int						traceCacheHits;
+	int						traceCacheMisses;
+	int						traceCandidateHits;
+
 	int						leafPoints;
 	int						leafBounds;
 
@@ -164,6 +221,9 @@ extern clipStats_t			cm_stats;
 
 extern cvar_t *				cm_showStats;
 extern cvar_t *				cm_skipAreas;
+extern cvar_t *				cm_skipSIMD;
+extern cvar_t *				cm_traceCache;
+extern cvar_t *				cm_visCacheSize;
 
 
 #endif	// __CM_LOCAL_H__
\ No newline at end of file
@@ -37,6 +37,9 @@ static bool					cm_initialized = false;
 
 cvar_t *					cm_showStats;
 cvar_t *					cm_skipAreas;
+cvar_t *					cm_skipSIMD;
+cvar_t *					cm_traceCache;
+cvar_t *					cm_visCacheSize;
 
 
 /*
@@ -51,10 +54,10 @@ void CM_PrintStats (){
 
 	switch (cm_showStats->integerValue){
 	case 1:
-
+		Com_Printf("traces: %i (nodes: %i, brushes: %i)\n", cm_stats.traces, cm_stats.traceNodes, cm_stats.traceBrushes);
 		break;
 	case 2:
-
+		Com_Printf("trace cache: %i hits, %i misses, %i candidate hits\n", cm_stats.traceCacheHits, cm_stats.traceCacheMisses, cm_stats.traceCandidateHits);
 		break;
 	case 3:
 
@@ -97,9 +100,13 @@ void CM_Init (){
 	// Register variables
 	cm_showStats = CVar_Register("cm_showStats", "0", CVAR_INTEGER, CVAR_CHEAT, "Show collision statistics (TODO)", 0, 0);
 	cm_skipAreas = CVar_Register("cm_skipAreas", "0", CVAR_BOOL, CVAR_CHEAT, "Skip area portal connections", 0, 0);
+	cm_skipSIMD = CVar_Register("cm_skipSIMD", "0", CVAR_BOOL, CVAR_CHEAT, "Skip SIMD brush clipping", 0, 0);
+	cm_traceCache = CVar_Register("cm_traceCache", "1", CVAR_INTEGER, CVAR_ARCHIVE, "Cache trace results within a frame (1 = exact traces, 2 = also reuse candidate brushes of nearby traces)", 0, 2);
+	cm_visCacheSize = CVar_Register("cm_visCacheSize", "32", CVAR_INTEGER, CVAR_ARCHIVE, "Memory budget in MB for decompressed PVS and PHS rows (0 = don't cache)", 0, 1024);
 
 	// Initialize all the collision system modules
 	CM_InitModels();
+	CM_InitTraces();
 
 	cm_initialized = true;
 }
@@ -115,6 +122,7 @@ void CM_Shutdown (){
 		return;
 
 	// Shutdown all the collision system modules
+	CM_ShutdownTraces();
 	CM_ShutdownModels();
 
 	// Free all collision system allocations
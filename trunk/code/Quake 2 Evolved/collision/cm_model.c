@@ -295,6 +295,101 @@ static void CM_LoadNodes (const byte *data, const bspLump_t *lump){
 	}
 }
 
+/*
+ ==================
+ CM_BuildFlatNodes
+
+ Rebuilds the nodes (including the box hull) into a flat array aligned on a
+ cache line boundary, with the planes inlined
+ ==================
+*/
+static void CM_BuildFlatNodes (){
+
+	clipNode_t		*in;
+	clipFlatNode_t	*out;
+	byte			*buffer;
+	int				size;
+	int				i;
+
+	size = (cm.numNodes + 6) * sizeof(clipFlatNode_t) + 64;
+
+	buffer = (byte *)Mem_Alloc(size, TAG_COLLISION);
+
+	cm.flatNodes = out = (clipFlatNode_t *)ALIGN((size_t)buffer, 64);
+	cm.size += size;
+
+	in = cm.nodes;
+
+	for (i = 0; i < cm.numNodes + 6; i++, in++, out++){
+		VectorCopy(in->plane->normal, out->normal);
+		out->dist = in->plane->dist;
+		out->type = in->plane->type;
+
+		out->children[0] = in->children[0];
+		out->children[1] = in->children[1];
+
+		out->pad = 0;
+	}
+}
+
+/*
+ ==================
+ CM_UpdateSideGroups
+
+ Copies the brush side planes to the side groups of the given brush
+ ==================
+*/
+static void CM_UpdateSideGroups (clipBrush_t *brush){
+
+	clipSideGroup_t	*group;
+	cplane_t		*plane;
+	int				i;
+
+	group = &cm.sideGroups[brush->firstSideGroup];
+
+	Mem_Fill(group, 0, ((brush->numSides + 3) >> 2) * sizeof(clipSideGroup_t));
+
+	for (i = 0; i < brush->numSides; i++){
+		plane = cm.brushSides[brush->firstBrushSide+i].plane;
+
+		group[i>>2].normal[0][i&3] = plane->normal[0];
+		group[i>>2].normal[1][i&3] = plane->normal[1];
+		group[i>>2].normal[2][i&3] = plane->normal[2];
+		group[i>>2].dist[i&3] = plane->dist;
+	}
+}
+
+/*
+ ==================
+ CM_BuildSideGroups
+
+ Builds the brush side groups (including the box hull) used by the SIMD
+ brush clipping code
+ ==================
+*/
+static void CM_BuildSideGroups (){
+
+	clipBrush_t		*brush;
+	byte			*buffer;
+	int				i;
+
+	cm.numSideGroups = 0;
+
+	for (i = 0, brush = cm.brushes; i < cm.numBrushes + 1; i++, brush++){
+		brush->firstSideGroup = cm.numSideGroups;
+
+		cm.numSideGroups += (brush->numSides + 3) >> 2;
+	}
+
+	buffer = (byte *)Mem_Alloc(cm.numSideGroups * sizeof(clipSideGroup_t) + 64, TAG_COLLISION);
+
+	cm.sideGroups = (clipSideGroup_t *)ALIGN((size_t)buffer, 64);
+	cm.size += cm.numSideGroups * sizeof(clipSideGroup_t);
+
+	for (i = 0, brush = cm.brushes; i < cm.numBrushes + 1; i++, brush++)
+		CM_UpdateSideGroups(brush);
+}
+
 /*
  ==================
  CM_LoadInlineModels
@@ -419,8 +514,8 @@ static void CM_LoadEntityString (const byte *data, const bspLump_t *lump){
 */
 clipInlineModel_t *CM_LoadMap (const char *name, bool clientLoad, uint *checkCount){
 
-	bspHeader_t	*header;
-	byte		*data;
+	bspHeader_t	header;
+	const byte	*data;
 	int			i, length;
 
 	// Cinematic servers won't have anything at all
@@ -443,7 +538,7 @@ clipInlineModel_t *CM_LoadMap (const char *name, bool clientLoad, uint *checkCou
 	CM_FreeMap();
 
 	// Load the file
-	length = FS_ReadFile(name, (void **)&data);
+	length = FS_MapFile(name, (const void **)&data);
 	if (!data)
 		Com_Error(ERR_DROP, "CM_LoadMap: '%s' not found", name);
 
@@ -455,31 +550,32 @@ clipInlineModel_t *CM_LoadMap (const char *name, bool clientLoad, uint *checkCou
 
 	cm.checkCount = LittleLong(MD4_BlockChecksum(data, length));
 
-	// Byte swap the header fields and sanity check
-	header = (bspHeader_t *)data;
+	// Byte swap the header fields and sanity check.
+	// The file data may be memory-mapped, so we work on a copy.
+	Mem_Copy(&header, data, sizeof(bspHeader_t));
 
 	for (i = 0; i < sizeof(bspHeader_t) / 4; i++)
-		((int *)header)[i] = LittleLong(((int *)header)[i]);
+		((int *)&header)[i] = LittleLong(((int *)&header)[i]);
 
-	if (header->id != BSP_ID)
+	if (header.id != BSP_ID)
 		Com_Error(ERR_DROP, "CM_LoadMap: wrong file id (%s)", cm.name);
 
-	if (header->version != BSP_VERSION)
-		Com_Error(ERR_DROP, "CM_LoadMap: wrong version number (%i should be %i) (%s)", header->version, BSP_VERSION, cm.name);
+	if (header.version != BSP_VERSION)
+		Com_Error(ERR_DROP, "CM_LoadMap: wrong version number (%i should be %i) (%s)", header.version, BSP_VERSION, cm.name);
 
 	// Load the lumps
-	CM_LoadPlanes(data, &header->lumps[LUMP_PLANES]);
-	CM_LoadSurfaces(data, &header->lumps[LUMP_TEXINFO]);
-	CM_LoadVisibility(data, &header->lumps[LUMP_VISIBILITY]);
-	CM_LoadLeafs(data, &header->lumps[LUMP_LEAFS]);
-	CM_LoadLeafBrushes(data, &header->lumps[LUMP_LEAFBRUSHES]);
-	CM_LoadBrushes(data, &header->lumps[LUMP_BRUSHES]);
-	CM_LoadBrushSides(data, &header->lumps[LUMP_BRUSHSIDES]);
-	CM_LoadNodes(data, &header->lumps[LUMP_NODES]);
-	CM_LoadInlineModels(data, &header->lumps[LUMP_INLINEMODELS]);
-	CM_LoadAreas(data, &header->lumps[LUMP_AREAS]);
-	CM_LoadAreaPortals(data, &header->lumps[LUMP_AREAPORTALS]);
-	CM_LoadEntityString(data, &header->lumps[LUMP_ENTITIES]);
+	CM_LoadPlanes(data, &header.lumps[LUMP_PLANES]);
+	CM_LoadSurfaces(data, &header.lumps[LUMP_TEXINFO]);
+	CM_LoadVisibility(data, &header.lumps[LUMP_VISIBILITY]);
+	CM_LoadLeafs(data, &header.lumps[LUMP_LEAFS]);
+	CM_LoadLeafBrushes(data, &header.lumps[LUMP_LEAFBRUSHES]);
+	CM_LoadBrushes(data, &header.lumps[LUMP_BRUSHES]);
+	CM_LoadBrushSides(data, &header.lumps[LUMP_BRUSHSIDES]);
+	CM_LoadNodes(data, &header.lumps[LUMP_NODES]);
+	CM_LoadInlineModels(data, &header.lumps[LUMP_INLINEMODELS]);
+	CM_LoadAreas(data, &header.lumps[LUMP_AREAS]);
+	CM_LoadAreaPortals(data, &header.lumps[LUMP_AREAPORTALS]);
+	CM_LoadEntityString(data, &header.lumps[LUMP_ENTITIES]);
 
 	// Free file data
 	FS_FreeFile(data);
@@ -487,9 +583,19 @@ clipInlineModel_t *CM_LoadMap (const char *name, bool clientLoad, uint *checkCou
 	// Create the box model
 	CM_CreateBoxModel();
 
+	// Build the flat node array and brush side groups used by traces
+	CM_BuildFlatNodes();
+	CM_BuildSideGroups();
+
+	// Decompress the visibility data
+	CM_BuildVisCache();
+
 	// All floods are initially invalid
 	CM_FloodAreaConnections(true);
 
+	// Cached traces are no longer valid
+	CM_ClearTraceCache();
+
 	// Clear counter
 	*checkCount = cm.checkCount;
 
@@ -503,14 +609,27 @@ clipInlineModel_t *CM_LoadMap (const char *name, bool clientLoad, uint *checkCou
 */
 void CM_FreeMap (){
 
+	// The visibility cache can be large, so free it right away
+	if (cm.pvsRows)
+		Mem_Free(cm.pvsRows);
+	if (cm.visRowFlags)
+		Mem_Free(cm.visRowFlags);
+
 	cm.numPlanes = 0;
 	cm.numSurfaces = 0;
 	cm.numVisibility = 0;
+	cm.visRowSize = 0;
+	cm.pvsRows = NULL;
+	cm.phsRows = NULL;
+	cm.visRowFlags = NULL;
+	cm.flatNodes = NULL;
+	cm.sideGroups = NULL;
 	cm.numLeafs = 1;
 	cm.numClusters = 1;
 	cm.numLeafBrushes = 0;
 	cm.numBrushes = 0;
 	cm.numBrushSides = 0;
+	cm.numSideGroups = 0;
 	cm.numNodes = 0;
 	cm.numModels = 0;
 	cm.numAreas = 1;
@@ -663,6 +782,20 @@ int	CM_SetupBoxModel (const vec3_t mins, const vec3_t maxs){
 	cm_boxPlanes[10].dist = mins[2];
 	cm_boxPlanes[11].dist = -mins[2];
 
+	// Update the flat nodes and brush side groups (they won't exist if the
+	// map failed to load before they were built)
+	if (cm.flatNodes){
+		cm.flatNodes[cm_boxHeadNode+0].dist = maxs[0];
+		cm.flatNodes[cm_boxHeadNode+1].dist = mins[0];
+		cm.flatNodes[cm_boxHeadNode+2].dist = maxs[1];
+		cm.flatNodes[cm_boxHeadNode+3].dist = mins[1];
+		cm.flatNodes[cm_boxHeadNode+4].dist = maxs[2];
+		cm.flatNodes[cm_boxHeadNode+5].dist = mins[2];
+	}
+
+	if (cm.sideGroups)
+		CM_UpdateSideGroups(cm_boxBrush);
+
 	return cm_boxHeadNode;
 }
 
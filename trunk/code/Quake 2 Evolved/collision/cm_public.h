@@ -74,6 +74,10 @@ int				CM_PointInArea (const vec3_t point, int nodeNum);
 // Returns true if the given areas are connected
 bool			CM_AreasAreConnected (int areaNum1, int areaNum2);
 
+// Invalidates all the cached trace results. Called at the start of every
+// server frame.
+void			CM_ClearTraceCache ();
+
 // Statistics for debugging and optimization
 void			CM_PrintStats ();
 
@@ -107,9 +111,15 @@ int			CM_TransformedPointContents (const vec3_t p, int headNode, const vec3_t or
 trace_t		CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask);
 trace_t		CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const vec3_t origin, const vec3_t angles);
 
+// The returned rows are aligned on a 16-byte boundary and padded to
+// CM_ClusterRowSize bytes.
+// Must only be called from the main thread.
 byte		*CM_ClusterPVS (int cluster);
 byte		*CM_ClusterPHS (int cluster);
 
+// Returns the size in bytes of a PVS or PHS row, padded to a multiple of 16
+int			CM_ClusterRowSize ();
+
 void		CM_FloodAreaConnections (bool clear);
 
 void		CM_SetAreaPortalState (int portalNum, bool open);
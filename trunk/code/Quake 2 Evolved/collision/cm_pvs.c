@@ -29,8 +29,13 @@
 #include "cm_local.h"
 
 
-static byte					cm_pvsRow[MAX_MAP_LEAFS/8];
-static byte					cm_phsRow[MAX_MAP_LEAFS/8];
+#define VIS_CACHE_EAGER_SIZE		(4 << 20)	// Larger caches are filled lazily
+
+#define VIS_ROW_PVS					BIT(0)
+#define VIS_ROW_PHS					BIT(1)
+
+static ALIGN_16(byte		cm_pvsRow[MAX_MAP_LEAFS/8]);
+static ALIGN_16(byte		cm_phsRow[MAX_MAP_LEAFS/8]);
 
 
 /*
@@ -90,6 +95,92 @@ static void CM_DecompressVis (const byte *in, byte *out){
 	} while (vis - out < row);
 }
 
+/*
+ ==================
+ CM_CachedVisRow
+
+ Returns the cached row for the given cluster, decompressing it the first time
+ it is used
+ ==================
+*/
+static byte *CM_CachedVisRow (int cluster, int vis){
+
+	byte	*row;
+	int		flag;
+
+	if (vis == VIS_PVS){
+		row = cm.pvsRows + cluster * cm.visRowSize;
+		flag = VIS_ROW_PVS;
+	}
+	else {
+		row = cm.phsRows + cluster * cm.visRowSize;
+		flag = VIS_ROW_PHS;
+	}
+
+	if (cm.visRowFlags[cluster] & flag)
+		return row;
+
+	cm.visRowFlags[cluster] |= flag;
+
+	CM_DecompressVis((byte *)cm.visibility + cm.visibility->bitOfs[cluster][vis], row);
+
+	return row;
+}
+
+/*
+ ==================
+ CM_BuildVisCache
+
+ Allocates a contiguous bit matrix for the decompressed PVS and PHS rows of
+ all the clusters, if it fits in the memory budget.
+ Small maps are decompressed right away, while larger ones are decompressed
+ lazily as rows are used.
+ ==================
+*/
+void CM_BuildVisCache (){
+
+	int		i, size;
+
+	cm.visRowSize = ALIGN((cm.numClusters + 7) >> 3, 16);
+
+	if (!cm.numVisibility || cm.numClusters < 1)
+		return;
+
+	size = cm.numClusters * cm.visRowSize * 2;
+
+	if (size > cm_visCacheSize->integerValue << 20){
+		Com_DPrintf("CM_BuildVisCache: %i KB exceeds the budget, not caching\n", size >> 10);
+		return;
+	}
+
+	cm.pvsRows = (byte *)Mem_ClearedAlloc16(size, TAG_COLLISION);
+	cm.phsRows = cm.pvsRows + cm.numClusters * cm.visRowSize;
+	cm.visRowFlags = (byte *)Mem_ClearedAlloc(cm.numClusters, TAG_COLLISION);
+
+	cm.size += size + cm.numClusters;
+
+	if (size > VIS_CACHE_EAGER_SIZE)
+		return;
+
+	for (i = 0; i < cm.numClusters; i++){
+		CM_CachedVisRow(i, VIS_PVS);
+		CM_CachedVisRow(i, VIS_PHS);
+	}
+}
+
+/*
+ ==================
+ CM_ClusterRowSize
+ ==================
+*/
+int CM_ClusterRowSize (){
+
+	if (!cm.loaded)
+		Com_Error(ERR_DROP, "CM_ClusterRowSize: map not loaded");
+
+	return cm.visRowSize;
+}
+
 /*
  ==================
  
@@ -104,6 +195,8 @@ byte *CM_ClusterPVS (int cluster){
 
 	if (cluster == -1 || cm.numVisibility == 0)
 		Mem_Fill(cm_pvsRow, 0xFF, (cm.numClusters + 7) >> 3);
+	else if (cm.pvsRows)
+		return CM_CachedVisRow(cluster, VIS_PVS);
 	else
 		CM_DecompressVis((byte *)cm.visibility + cm.visibility->bitOfs[cluster][VIS_PVS], cm_pvsRow);
 
@@ -119,6 +212,8 @@ byte *CM_ClusterPHS (int cluster){
 
 	if (cluster == -1 || cm.numVisibility == 0)
 		Mem_Fill(cm_phsRow, 0, (cm.numClusters + 7) >> 3);
+	else if (cm.phsRows)
+		return CM_CachedVisRow(cluster, VIS_PHS);
 	else
 		CM_DecompressVis((byte *)cm.visibility + cm.visibility->bitOfs[cluster][VIS_PHS], cm_phsRow);
 
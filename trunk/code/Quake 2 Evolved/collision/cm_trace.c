@@ -32,6 +32,81 @@
 // 1/32 epsilon to keep floating point happy
 #define	DIST_EPSILON				(0.03125f)
 
+#define MAX_TRACE_STACK				256
+
+#define MAX_RECORDED_TRACES			65536
+
+#define TRACE_CACHE_SIZE			1024		// Must be a power of two
+
+#define MAX_TRACE_CANDIDATES		256
+#define MAX_CANDIDATE_BRUSHES		16384
+#define MAX_CANDIDATE_LEAFS			1024
+
+#define TRACE_CANDIDATE_MARGIN		32.0f
+#define TRACE_CANDIDATE_MAX_SIZE	256.0f		// Longer traces always walk the BSP tree
+
+#define TRACE_FILE_ID				(('R' << 24) + ('T' << 16) + ('M' << 8) + 'C')
+#define TRACE_FILE_VERSION			1
+
+typedef struct {
+	int						num;
+	float					pf1;
+	float					pf2;
+	vec3_t					p1;
+	vec3_t					p2;
+} traceWork_t;
+
+typedef struct {
+	vec3_t					start;
+	vec3_t					end;
+	vec3_t					mins;
+	vec3_t					maxs;
+	int						headNode;
+	int						brushMask;
+} traceKey_t;
+
+typedef struct {
+	traceKey_t				key;
+	int						frameCount;		// Only valid if equal to cm_traceCacheFrameCount
+
+	trace_t					trace;
+} traceCacheEntry_t;
+
+typedef struct {
+	vec3_t					bounds[2];
+	int						headNode;
+
+	int						numBrushes;
+	int						firstBrush;
+} traceCandidates_t;
+
+typedef struct {
+	vec3_t					start;
+	vec3_t					end;
+	vec3_t					mins;
+	vec3_t					maxs;
+	int						headNode;
+	int						brushMask;
+	float					fraction;		// Used to validate the replayed traces
+} recordedTrace_t;
+
+typedef struct {
+	int						id;
+	int						version;
+	uint					checkCount;		// Traces are only valid for the map they were recorded on
+	int						numTraces;
+} traceFileHeader_t;
+
+typedef struct {
+	bool					active;
+	char					name[MAX_PATH_LENGTH];
+
+	uint					checkCount;
+
+	int						numTraces;
+	recordedTrace_t *		traces;
+} traceRecording_t;
+
 static vec3_t				cm_traceStart, cm_traceEnd;
 static vec3_t				cm_traceMins, cm_traceMaxs;
 static vec3_t				cm_traceExtents;
@@ -39,9 +114,21 @@ static vec3_t				cm_traceExtents;
 static trace_t				cm_trace;
 static int					cm_traceContents;
 static bool					cm_traceIsPoint;		// Optimized case
+static bool					cm_traceSIMD;
 
 static int					cm_traceCheckCount;
 
+static traceCacheEntry_t	cm_traceCacheEntries[TRACE_CACHE_SIZE];
+static int					cm_traceCacheFrameCount = 1;
+
+static traceCandidates_t	cm_traceCandidates[MAX_TRACE_CANDIDATES];
+static int					cm_numTraceCandidates;
+static ushort				cm_candidateBrushes[MAX_CANDIDATE_BRUSHES];
+static int					cm_numCandidateBrushes;
+static int					cm_candidatesFrameCount;
+
+static traceRecording_t		cm_traceRecording;
+
 // TODO: just here for now
 extern int		cm_boxHeadNode;
 
@@ -223,6 +310,226 @@ static void CM_TestBoxInBrush (const vec3_t mins, const vec3_t maxs, const vec3_
 	trace->contents = brush->contents;
 }
 
+#if defined SIMD_X86
+
+/*
+ ==================
+ CM_ClipBoxToBrushSIMD
+
+ Same as CM_ClipBoxToBrush, but computes the distances to four brush sides at
+ once. The results must be identical to the scalar code.
+ ==================
+*/
+static void CM_ClipBoxToBrushSIMD (const vec3_t mins, const vec3_t maxs, const vec3_t p1, const vec3_t p2, trace_t *trace, clipBrush_t *brush){
+
+	const clipSideGroup_t	*group;
+	clipBrushSide_t			*side, *leadSide;
+	cplane_t				*clipPlane;
+	__m128					xmmZero, xmmMask, xmmOfs, xmmNormal;
+	__m128					xmmDot, xmmDot1, xmmDot2;
+	__m128					xmmD1, xmmD2;
+	ALIGN_16(float			d1[4]);
+	ALIGN_16(float			d2[4]);
+	float					enterFrac, leaveFrac;
+	float					f;
+	bool					getOut, startOut;
+	int						crossMask;
+	int						i, j;
+
+	enterFrac = -1;
+	leaveFrac = 1;
+	clipPlane = NULL;
+
+	if (!brush->numSides)
+		return;
+
+	getOut = false;
+	startOut = false;
+	leadSide = NULL;
+
+	xmmZero = _mm_setzero_ps();
+
+	group = &cm.sideGroups[brush->firstSideGroup];
+
+	for (i = 0; i < brush->numSides; i += 4, group++){
+		// Push the planes out appropriately for mins/maxs, and compute the
+		// distances in the same order as the scalar code
+		xmmNormal = _mm_load_ps(group->normal[0]);
+		xmmMask = _mm_cmplt_ps(xmmNormal, xmmZero);
+		xmmOfs = _mm_or_ps(_mm_and_ps(xmmMask, _mm_set1_ps(maxs[0])), _mm_andnot_ps(xmmMask, _mm_set1_ps(mins[0])));
+
+		xmmDot = _mm_mul_ps(xmmOfs, xmmNormal);
+		xmmDot1 = _mm_mul_ps(_mm_set1_ps(p1[0]), xmmNormal);
+		xmmDot2 = _mm_mul_ps(_mm_set1_ps(p2[0]), xmmNormal);
+
+		for (j = 1; j < 3; j++){
+			xmmNormal = _mm_load_ps(group->normal[j]);
+			xmmMask = _mm_cmplt_ps(xmmNormal, xmmZero);
+			xmmOfs = _mm_or_ps(_mm_and_ps(xmmMask, _mm_set1_ps(maxs[j])), _mm_andnot_ps(xmmMask, _mm_set1_ps(mins[j])));
+
+			xmmDot = _mm_add_ps(xmmDot, _mm_mul_ps(xmmOfs, xmmNormal));
+			xmmDot1 = _mm_add_ps(xmmDot1, _mm_mul_ps(_mm_set1_ps(p1[j]), xmmNormal));
+			xmmDot2 = _mm_add_ps(xmmDot2, _mm_mul_ps(_mm_set1_ps(p2[j]), xmmNormal));
+		}
+
+		xmmDot = _mm_sub_ps(_mm_load_ps(group->dist), xmmDot);
+
+		xmmD1 = _mm_sub_ps(xmmDot1, xmmDot);
+		xmmD2 = _mm_sub_ps(xmmDot2, xmmDot);
+
+		// If completely in front of any face, no intersection
+		if (_mm_movemask_ps(_mm_and_ps(_mm_cmpgt_ps(xmmD1, xmmZero), _mm_cmpge_ps(xmmD2, xmmD1))))
+			return;
+
+		if (_mm_movemask_ps(_mm_cmpgt_ps(xmmD2, xmmZero)))
+			getOut = true;	// End point is not in solid
+		if (_mm_movemask_ps(_mm_cmpgt_ps(xmmD1, xmmZero)))
+			startOut = true;
+
+		// Find the sides that cross the face. The padding sides never do.
+		crossMask = _mm_movemask_ps(_mm_or_ps(_mm_cmpnle_ps(xmmD1, xmmZero), _mm_cmpnle_ps(xmmD2, xmmZero)));
+		if (!crossMask)
+			continue;
+
+		_mm_store_ps(d1, xmmD1);
+		_mm_store_ps(d2, xmmD2);
+
+		for (j = 0; j < 4; j++){
+			if (!(crossMask & (1 << j)))
+				continue;
+
+			side = &cm.brushSides[brush->firstBrushSide+i+j];
+
+			if (d1[j] > d2[j]){
+				// Enter
+				f = (d1[j] - DIST_EPSILON) / (d1[j] - d2[j]);
+				if (f > enterFrac){
+					enterFrac = f;
+					clipPlane = side->plane;
+					leadSide = side;
+				}
+			}
+			else {
+				// Leave
+				f = (d1[j] + DIST_EPSILON) / (d1[j] - d2[j]);
+				if (f < leaveFrac)
+					leaveFrac = f;
+			}
+		}
+	}
+
+	if (!startOut){
+		// Original point was inside brush
+		trace->startsolid = true;
+		if (!getOut)
+			trace->allsolid = true;
+
+		return;
+	}
+
+	if (enterFrac < leaveFrac){
+		if (enterFrac > -1.0f && enterFrac < trace->fraction){
+			if (enterFrac < 0.0f)
+				enterFrac = 0.0f;
+
+			trace->fraction = enterFrac;
+			trace->plane = *clipPlane;
+			trace->surface = &(leadSide->surface->c);
+			trace->contents = brush->contents;
+		}
+	}
+}
+
+/*
+ ==================
+ CM_TestBoxInBrushSIMD
+
+ Same as CM_TestBoxInBrush, but tests four brush sides at once
+ ==================
+*/
+static void CM_TestBoxInBrushSIMD (const vec3_t mins, const vec3_t maxs, const vec3_t p, trace_t *trace, clipBrush_t *brush){
+
+	const clipSideGroup_t	*group;
+	__m128					xmmZero, xmmMask, xmmOfs, xmmNormal;
+	__m128					xmmDot, xmmDotP;
+	int						i, j;
+
+	if (!brush->numSides)
+		return;
+
+	xmmZero = _mm_setzero_ps();
+
+	group = &cm.sideGroups[brush->firstSideGroup];
+
+	for (i = 0; i < brush->numSides; i += 4, group++){
+		// Push the planes out appropriately for mins/maxs
+		xmmNormal = _mm_load_ps(group->normal[0]);
+		xmmMask = _mm_cmplt_ps(xmmNormal, xmmZero);
+		xmmOfs = _mm_or_ps(_mm_and_ps(xmmMask, _mm_set1_ps(maxs[0])), _mm_andnot_ps(xmmMask, _mm_set1_ps(mins[0])));
+
+		xmmDot = _mm_mul_ps(xmmOfs, xmmNormal);
+		xmmDotP = _mm_mul_ps(_mm_set1_ps(p[0]), xmmNormal);
+
+		for (j = 1; j < 3; j++){
+			xmmNormal = _mm_load_ps(group->normal[j]);
+			xmmMask = _mm_cmplt_ps(xmmNormal, xmmZero);
+			xmmOfs = _mm_or_ps(_mm_and_ps(xmmMask, _mm_set1_ps(maxs[j])), _mm_andnot_ps(xmmMask, _mm_set1_ps(mins[j])));
+
+			xmmDot = _mm_add_ps(xmmDot, _mm_mul_ps(xmmOfs, xmmNormal));
+			xmmDotP = _mm_add_ps(xmmDotP, _mm_mul_ps(_mm_set1_ps(p[j]), xmmNormal));
+		}
+
+		xmmDot = _mm_sub_ps(_mm_load_ps(group->dist), xmmDot);
+
+		// If completely in front of any face, no intersection
+		if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_sub_ps(xmmDotP, xmmDot), xmmZero)))
+			return;
+	}
+
+	// Inside this brush
+	trace->startsolid = trace->allsolid = true;
+	trace->fraction = 0;
+	trace->contents = brush->contents;
+}
+
+#endif
+
+/*
+ ==================
+ CM_TraceToBrush
+ ==================
+*/
+static void CM_TraceToBrush (clipBrush_t *brush){
+
+	cm_stats.traceBrushes++;
+
+#if defined SIMD_X86
+	if (cm_traceSIMD){
+		CM_ClipBoxToBrushSIMD(cm_traceMins, cm_traceMaxs, cm_traceStart, cm_traceEnd, &cm_trace, brush);
+		return;
+	}
+#endif
+
+	CM_ClipBoxToBrush(cm_traceMins, cm_traceMaxs, cm_traceStart, cm_traceEnd, &cm_trace, brush);
+}
+
+/*
+ ==================
+ CM_TestInBrush
+ ==================
+*/
+static void CM_TestInBrush (clipBrush_t *brush){
+
+#if defined SIMD_X86
+	if (cm_traceSIMD){
+		CM_TestBoxInBrushSIMD(cm_traceMins, cm_traceMaxs, cm_traceStart, &cm_trace, brush);
+		return;
+	}
+#endif
+
+	CM_TestBoxInBrush(cm_traceMins, cm_traceMaxs, cm_traceStart, &cm_trace, brush);
+}
+
 /*
  ==================
  
@@ -251,7 +558,7 @@ static void CM_TraceToLeaf (int leafNum){
 		if (!(brush->contents & cm_traceContents))
 			continue;
 
-		CM_ClipBoxToBrush(cm_traceMins, cm_traceMaxs, cm_traceStart, cm_traceEnd, &cm_trace, brush);
+		CM_TraceToBrush(brush);
 		if (!cm_trace.fraction)
 			return;
 	}
@@ -285,7 +592,7 @@ static void CM_TestInLeaf (int leafNum){
 		if (!(brush->contents & cm_traceContents))
 			continue;
 
-		CM_TestBoxInBrush(cm_traceMins, cm_traceMaxs, cm_traceStart, &cm_trace, brush);
+		CM_TestInBrush(brush);
 		if (!cm_trace.fraction)
 			return;
 	}
@@ -293,114 +600,350 @@ static void CM_TestInLeaf (int leafNum){
 
 /*
  ==================
- 
+ CM_TraceThroughTree
+
+ Walks the flat node array with an explicit stack instead of recursing. The
+ far side of a crossed node is pushed on the stack and visited after the near
+ side, in the same order as a recursive traversal.
  ==================
 */
-static void CM_RecursiveHullCheck (int num, float pf1, float pf2, const vec3_t p1, const vec3_t p2){
-
-	clipNode_t	*node;
-	cplane_t	*plane;
-	float		d1, d2, offset;
-	float		frac1, frac2;
-	float		dist;
-	vec3_t		mid;
-	int			side;
-	float		midf;
-
-	if (cm_trace.fraction <= pf1)
-		return;		// Already hit something nearer
-
-	// If < 0, we are in a leaf node
-	if (num < 0){
-		CM_TraceToLeaf(-1-num);
-		return;
+static void CM_TraceThroughTree (int headNode, const vec3_t start, const vec3_t end){
+
+	traceWork_t				stack[MAX_TRACE_STACK];
+	traceWork_t				*work;
+	const clipFlatNode_t	*node;
+	float					d1, d2, offset;
+	float					frac1, frac2;
+	float					dist;
+	int						num, side;
+	int						depth;
+	float					pf1, pf2;
+	vec3_t					p1, p2;
+
+	num = headNode;
+	depth = 0;
+
+	pf1 = 0.0f;
+	pf2 = 1.0f;
+
+	VectorCopy(start, p1);
+	VectorCopy(end, p2);
+
+	while (1){
+		if (cm_trace.fraction > pf1){
+			// If < 0, we are in a leaf node
+			if (num < 0)
+				CM_TraceToLeaf(-1-num);
+			else {
+				cm_stats.traceNodes++;
+
+				// Find the point distances to the separating plane and the
+				// offset for the size of the box
+				node = &cm.flatNodes[num];
+
+				if (node->type < 3){
+					d1 = p1[node->type] - node->dist;
+					d2 = p2[node->type] - node->dist;
+
+					offset = cm_traceExtents[node->type];
+				}
+				else {
+					d1 = DotProduct(p1, node->normal) - node->dist;
+					d2 = DotProduct(p2, node->normal) - node->dist;
+
+					if (cm_traceIsPoint)
+						offset = 0.0f;
+					else
+						offset = fabs(cm_traceExtents[0]*node->normal[0]) + fabs(cm_traceExtents[1]*node->normal[1]) + fabs(cm_traceExtents[2]*node->normal[2]);
+				}
+
+				// See which sides we need to consider
+				if (d1 >= offset && d2 >= offset){
+					num = node->children[0];
+					continue;
+				}
+				if (d1 < -offset && d2 < -offset){
+					num = node->children[1];
+					continue;
+				}
+
+				// Put the crosspoint DIST_EPSILON pixels on the near side
+				if (d1 < d2){
+					dist = 1.0f / (d1 - d2);
+					side = 1;
+					frac1 = (d1 - offset + DIST_EPSILON) * dist;
+					frac2 = (d1 + offset + DIST_EPSILON) * dist;
+				}
+				else if (d1 > d2){
+					dist = 1.0f / (d1 - d2);
+					side = 0;
+					frac1 = (d1 + offset + DIST_EPSILON) * dist;
+					frac2 = (d1 - offset - DIST_EPSILON) * dist;
+				}
+				else {
+					side = 0;
+					frac1 = 1.0f;
+					frac2 = 0.0f;
+				}
+
+				if (frac1 < 0.0f)
+					frac1 = 0.0f;
+				else if (frac1 > 1.0f)
+					frac1 = 1.0f;
+
+				if (frac2 < 0.0f)
+					frac2 = 0.0f;
+				else if (frac2 > 1.0f)
+					frac2 = 1.0f;
+
+				// Push the far side of the node
+				if (depth == MAX_TRACE_STACK)
+					Com_Error(ERR_DROP, "CM_TraceThroughTree: stack overflow (%s)", cm.name);
+
+				work = &stack[depth++];
+
+				work->num = node->children[side^1];
+				work->pf1 = pf1 + (pf2 - pf1) * frac2;
+				work->pf2 = pf2;
+
+				work->p1[0] = p1[0] + (p2[0] - p1[0]) * frac2;
+				work->p1[1] = p1[1] + (p2[1] - p1[1]) * frac2;
+				work->p1[2] = p1[2] + (p2[2] - p1[2]) * frac2;
+
+				VectorCopy(p2, work->p2);
+
+				// Move up to the node
+				num = node->children[side];
+
+				pf2 = pf1 + (pf2 - pf1) * frac1;
+
+				p2[0] = p1[0] + (p2[0] - p1[0]) * frac1;
+				p2[1] = p1[1] + (p2[1] - p1[1]) * frac1;
+				p2[2] = p1[2] + (p2[2] - p1[2]) * frac1;
+
+				continue;
+			}
+		}
+
+		// Pop the next node to visit
+		if (!depth)
+			break;
+
+		work = &stack[--depth];
+
+		num = work->num;
+		pf1 = work->pf1;
+		pf2 = work->pf2;
+
+		VectorCopy(work->p1, p1);
+		VectorCopy(work->p2, p2);
 	}
+}
 
-	// Find the point distances to the separating plane and the offset
-	// for the size of the box
-	node = &cm.nodes[num];
-	plane = node->plane;
+/*
+ ==================
+ CM_TraceToCandidates
+ ==================
+*/
+static void CM_TraceToCandidates (const traceCandidates_t *candidates){
+
+	clipBrush_t	*brush;
+	int			i;
 
-	if (plane->type < 3){
-		d1 = p1[plane->type] - plane->dist;
-		d2 = p2[plane->type] - plane->dist;
+	for (i = 0; i < candidates->numBrushes; i++){
+		brush = &cm.brushes[cm_candidateBrushes[candidates->firstBrush+i]];
 
-		offset = cm_traceExtents[plane->type];
+		if (!(brush->contents & cm_traceContents))
+			continue;
+
+		CM_TraceToBrush(brush);
+		if (!cm_trace.fraction)
+			return;
 	}
-	else {
-		d1 = DotProduct(p1, plane->normal) - plane->dist;
-		d2 = DotProduct(p2, plane->normal) - plane->dist;
+}
 
-		if (cm_traceIsPoint)
-			offset = 0.0f;
-		else
-			offset = fabs(cm_traceExtents[0]*plane->normal[0]) + fabs(cm_traceExtents[1]*plane->normal[1]) + fabs(cm_traceExtents[2]*plane->normal[2]);
+/*
+ ==================
+ CM_TestInCandidates
+ ==================
+*/
+static void CM_TestInCandidates (const traceCandidates_t *candidates){
+
+	clipBrush_t	*brush;
+	int			i;
+
+	for (i = 0; i < candidates->numBrushes; i++){
+		brush = &cm.brushes[cm_candidateBrushes[candidates->firstBrush+i]];
+
+		if (!(brush->contents & cm_traceContents))
+			continue;
+
+		CM_TestInBrush(brush);
+		if (cm_trace.allsolid)
+			return;
 	}
+}
 
-	// See which sides we need to consider
-	if (d1 >= offset && d2 >= offset){
-		CM_RecursiveHullCheck(node->children[0], pf1, pf2, p1, p2);
+/*
+ ==================
+ CM_RecordTrace
+ ==================
+*/
+static void CM_RecordTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const trace_t *trace){
+
+	recordedTrace_t	*recordedTrace;
+
+	// Box model traces depend on the current box, so don't record them
+	if (headNode >= cm_boxHeadNode)
 		return;
-	}
-	if (d1 < -offset && d2 < -offset){
-		CM_RecursiveHullCheck(node->children[1], pf1, pf2, p1, p2);
+
+	// Don't record traces from a different map
+	if (cm.checkCount != cm_traceRecording.checkCount)
+		return;
+
+	if (cm_traceRecording.numTraces == MAX_RECORDED_TRACES)
 		return;
+
+	recordedTrace = &cm_traceRecording.traces[cm_traceRecording.numTraces++];
+
+	VectorCopy(start, recordedTrace->start);
+	VectorCopy(end, recordedTrace->end);
+	VectorCopy(mins, recordedTrace->mins);
+	VectorCopy(maxs, recordedTrace->maxs);
+	recordedTrace->headNode = headNode;
+	recordedTrace->brushMask = brushMask;
+	recordedTrace->fraction = trace->fraction;
+}
+
+/*
+ ==================
+ CM_HashTraceKey
+ ==================
+*/
+static int CM_HashTraceKey (const traceKey_t *key){
+
+	const uint	*data = (const uint *)key;
+	uint		hash = 0;
+	int			i;
+
+	for (i = 0; i < sizeof(traceKey_t) >> 2; i++)
+		hash = (hash * 31) + data[i];
+
+	hash ^= (hash >> 16);
+
+	return hash & (TRACE_CACHE_SIZE - 1);
+}
+
+/*
+ ==================
+ CM_FindTraceCandidates
+
+ Returns a list of candidate brushes for the given trace, reusing the list of a
+ previous trace in the same frame if its bounds enclose this trace. Returns
+ NULL if the BSP tree should be walked instead.
+ ==================
+*/
+static const traceCandidates_t *CM_FindTraceCandidates (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode){
+
+	traceCandidates_t	*candidates;
+	clipLeaf_t			*leaf;
+	clipBrush_t			*brush;
+	vec3_t				bounds[2];
+	int					leafs[MAX_CANDIDATE_LEAFS], numLeafs;
+	int					brushNum;
+	int					i, j;
+
+	// Reset the candidate lists if this is a new frame
+	if (cm_candidatesFrameCount != cm_traceCacheFrameCount){
+		cm_candidatesFrameCount = cm_traceCacheFrameCount;
+
+		cm_numTraceCandidates = 0;
+		cm_numCandidateBrushes = 0;
 	}
-	
-	// Put the crosspoint DIST_EPSILON pixels on the near side
-	if (d1 < d2){
-		dist = 1.0f / (d1 - d2);
-		side = 1;
-		frac1 = (d1 - offset + DIST_EPSILON) * dist;
-		frac2 = (d1 + offset + DIST_EPSILON) * dist;
+
+	// Compute the bounds of the swept box, with the same epsilon used for
+	// position tests
+	for (i = 0; i < 3; i++){
+		if (start[i] < end[i]){
+			bounds[0][i] = start[i] + mins[i] - 1.0f;
+			bounds[1][i] = end[i] + maxs[i] + 1.0f;
+		}
+		else {
+			bounds[0][i] = end[i] + mins[i] - 1.0f;
+			bounds[1][i] = start[i] + maxs[i] + 1.0f;
+		}
+
+		if (bounds[1][i] - bounds[0][i] > TRACE_CANDIDATE_MAX_SIZE)
+			return NULL;
 	}
-	else if (d1 > d2){
-		dist = 1.0f / (d1 - d2);
-		side = 0;
-		frac1 = (d1 + offset + DIST_EPSILON) * dist;
-		frac2 = (d1 - offset - DIST_EPSILON) * dist;
+
+	// Search for a candidate list that encloses the swept box, most recent
+	// first
+	for (i = cm_numTraceCandidates - 1, candidates = &cm_traceCandidates[i]; i >= 0; i--, candidates--){
+		if (candidates->headNode != headNode)
+			continue;
+
+		if (bounds[0][0] < candidates->bounds[0][0] || bounds[0][1] < candidates->bounds[0][1] || bounds[0][2] < candidates->bounds[0][2])
+			continue;
+		if (bounds[1][0] > candidates->bounds[1][0] || bounds[1][1] > candidates->bounds[1][1] || bounds[1][2] > candidates->bounds[1][2])
+			continue;
+
+		cm_stats.traceCandidateHits++;
+
+		return candidates;
 	}
-	else {
-		side = 0;
-		frac1 = 1.0f;
-		frac2 = 0.0f;
+
+	if (cm_numTraceCandidates == MAX_TRACE_CANDIDATES)
+		return NULL;
+
+	// Gather all the brushes in the expanded bounds
+	candidates = &cm_traceCandidates[cm_numTraceCandidates];
+
+	for (i = 0; i < 3; i++){
+		candidates->bounds[0][i] = bounds[0][i] - TRACE_CANDIDATE_MARGIN;
+		candidates->bounds[1][i] = bounds[1][i] + TRACE_CANDIDATE_MARGIN;
 	}
 
-	// Move up to the node
-	if (frac1 < 0.0f)
-		frac1 = 0.0f;
-	else if (frac1 > 1.0f)
-		frac1 = 1.0f;
+	numLeafs = CM_BoundsInLeaves(candidates->bounds[0], candidates->bounds[1], leafs, MAX_CANDIDATE_LEAFS, headNode, NULL);
+	if (numLeafs == MAX_CANDIDATE_LEAFS)
+		return NULL;	// The leaf list may have been truncated
 
-	midf = pf1 + (pf2 - pf1) * frac1;
+	candidates->headNode = headNode;
+	candidates->numBrushes = 0;
+	candidates->firstBrush = cm_numCandidateBrushes;
 
-	mid[0] = p1[0] + (p2[0] - p1[0]) * frac1;
-	mid[1] = p1[1] + (p2[1] - p1[1]) * frac1;
-	mid[2] = p1[2] + (p2[2] - p1[2]) * frac1;
+	cm_traceCheckCount++;
 
-	CM_RecursiveHullCheck(node->children[side], pf1, midf, p1, mid);
+	for (i = 0; i < numLeafs; i++){
+		leaf = &cm.leafs[leafs[i]];
 
-	// Go past the node
-	if (frac2 < 0.0f)
-		frac2 = 0.0f;
-	else if (frac2 > 1.0f)
-		frac2 = 1.0f;
+		for (j = 0; j < leaf->numLeafBrushes; j++){
+			brushNum = cm.leafBrushes[leaf->firstLeafBrush+j];
+			brush = &cm.brushes[brushNum];
 
-	midf = pf1 + (pf2 - pf1) * frac2;
+			if (brush->checkCount == cm_traceCheckCount)
+				continue;		// Already added this brush from another leaf
+			brush->checkCount = cm_traceCheckCount;
+
+			if (cm_numCandidateBrushes == MAX_CANDIDATE_BRUSHES)
+				return NULL;
+
+			cm_candidateBrushes[cm_numCandidateBrushes++] = brushNum;
+			candidates->numBrushes++;
+		}
+	}
 
-	mid[0] = p1[0] + (p2[0] - p1[0]) * frac2;
-	mid[1] = p1[1] + (p2[1] - p1[1]) * frac2;
-	mid[2] = p1[2] + (p2[2] - p1[2]) * frac2;
+	cm_numTraceCandidates++;
 
-	CM_RecursiveHullCheck(node->children[side^1], midf, pf2, mid, p2);
+	return candidates;
 }
 
 /*
  ==================
- 
+ CM_Trace
  ==================
 */
-trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask){
+static trace_t CM_Trace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask, const traceCandidates_t *candidates){
 
 	// Fill in a default trace
 	Mem_Fill(&cm_trace, 0, sizeof(cm_trace));
@@ -411,9 +954,11 @@ trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, co
 		return cm_trace;	// Map not loaded
 
 	cm_traceCheckCount++;	// For multi-check avoidance
-//	cm_traces++;			// Optimize counter
+
+	cm_stats.traces++;
 
 	cm_traceContents = brushMask;
+	cm_traceSIMD = !cm_skipSIMD->integerValue;
 	VectorCopy(start, cm_traceStart);
 	VectorCopy(end, cm_traceEnd);
 	VectorCopy(mins, cm_traceMins);
@@ -426,17 +971,21 @@ trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, co
 		int		leafs[1024], numLeafs;
 		int		topNode;
 
-		for (i = 0; i < 3; i++){
-			c1[i] = (start[i] + mins[i]) - 1;
-			c2[i] = (start[i] + maxs[i]) + 1;
-		}
+		if (candidates)
+			CM_TestInCandidates(candidates);
+		else {
+			for (i = 0; i < 3; i++){
+				c1[i] = (start[i] + mins[i]) - 1;
+				c2[i] = (start[i] + maxs[i]) + 1;
+			}
 
-		numLeafs = CM_BoundsInLeaves(c1, c2, leafs, 1024, headNode, &topNode);
+			numLeafs = CM_BoundsInLeaves(c1, c2, leafs, 1024, headNode, &topNode);
 
-		for (i = 0; i < numLeafs; i++){
-			CM_TestInLeaf(leafs[i]);
-			if (cm_trace.allsolid)
-				break;
+			for (i = 0; i < numLeafs; i++){
+				CM_TestInLeaf(leafs[i]);
+				if (cm_trace.allsolid)
+					break;
+			}
 		}
 
 		VectorCopy(start, cm_trace.endpos);
@@ -459,7 +1008,10 @@ trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, co
 	}
 
 	// General sweeping through world
-	CM_RecursiveHullCheck(headNode, 0.0f, 1.0f, start, end);
+	if (candidates)
+		CM_TraceToCandidates(candidates);
+	else
+		CM_TraceThroughTree(headNode, start, end);
 
 	if (cm_trace.fraction == 1.0f){
 		cm_trace.endpos[0] = end[0];
@@ -475,6 +1027,61 @@ trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, co
 	return cm_trace;
 }
 
+/*
+ ==================
+ 
+ ==================
+*/
+trace_t CM_BoxTrace (const vec3_t start, const vec3_t end, const vec3_t mins, const vec3_t maxs, int headNode, int brushMask){
+
+	traceCacheEntry_t			*entry;
+	const traceCandidates_t		*candidates;
+	traceKey_t					key;
+	trace_t						trace;
+
+	// Box hull traces depend on the current box, so they can't be cached
+	if (!cm_traceCache->integerValue || !cm.loaded || headNode >= cm_boxHeadNode)
+		trace = CM_Trace(start, end, mins, maxs, headNode, brushMask, NULL);
+	else {
+		VectorCopy(start, key.start);
+		VectorCopy(end, key.end);
+		VectorCopy(mins, key.mins);
+		VectorCopy(maxs, key.maxs);
+		key.headNode = headNode;
+		key.brushMask = brushMask;
+
+		// Check if this exact trace was already done this frame
+		entry = &cm_traceCacheEntries[CM_HashTraceKey(&key)];
+
+		if (entry->frameCount == cm_traceCacheFrameCount && Mem_Compare(&entry->key, &key, sizeof(traceKey_t))){
+			cm_stats.traceCacheHits++;
+
+			trace = entry->trace;
+		}
+		else {
+			cm_stats.traceCacheMisses++;
+
+			// Try to reuse the candidate brushes of a nearby trace
+			if (cm_traceCache->integerValue == 2)
+				candidates = CM_FindTraceCandidates(start, end, mins, maxs, headNode);
+			else
+				candidates = NULL;
+
+			trace = CM_Trace(start, end, mins, maxs, headNode, brushMask, candidates);
+
+			// Add it to the cache
+			entry->key = key;
+			entry->frameCount = cm_traceCacheFrameCount;
+			entry->trace = trace;
+		}
+	}
+
+	if (cm_traceRecording.active)
+		CM_RecordTrace(start, end, mins, maxs, headNode, brushMask, &trace);
+
+	return trace;
+}
+
 /*
  ==================
  
@@ -530,4 +1137,389 @@ trace_t	CM_TransformedBoxTrace (const vec3_t start, const vec3_t end, const vec3
 	}
 
 	return trace;
+}
+
+/*
+ ==================
+ CM_ClearTraceCache
+ ==================
+*/
+void CM_ClearTraceCache (){
+
+	cm_traceCacheFrameCount++;
+}
+
+
+/*
+ ==============================================================================
+
+ RECORDED TRACES
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ CM_LoadTraces
+
+ Loads a set of recorded traces for the current map
+ ==================
+*/
+static recordedTrace_t *CM_LoadTraces (const char *name, int *numTraces){
+
+	traceFileHeader_t	*header;
+	recordedTrace_t		*recordedTrace;
+	byte				*buffer;
+	int					size;
+	int					i;
+
+	size = FS_ReadFile(name, (void **)&buffer);
+	if (!buffer){
+		Com_Printf("Couldn't find %s\n", name);
+		return NULL;
+	}
+
+	header = (traceFileHeader_t *)buffer;
+
+	if (size < sizeof(traceFileHeader_t) || header->id != TRACE_FILE_ID || header->version != TRACE_FILE_VERSION){
+		Com_Printf("%s is not a valid trace file\n", name);
+
+		FS_FreeFile(buffer);
+		return NULL;
+	}
+
+	if (size != sizeof(traceFileHeader_t) + header->numTraces * sizeof(recordedTrace_t)){
+		Com_Printf("%s has a bad size\n", name);
+
+		FS_FreeFile(buffer);
+		return NULL;
+	}
+
+	if (header->checkCount != cm.checkCount){
+		Com_Printf("%s was recorded on a different map\n", name);
+
+		FS_FreeFile(buffer);
+		return NULL;
+	}
+
+	if (!header->numTraces){
+		Com_Printf("%s has no traces\n", name);
+
+		FS_FreeFile(buffer);
+		return NULL;
+	}
+
+	recordedTrace = (recordedTrace_t *)(buffer + sizeof(traceFileHeader_t));
+
+	for (i = 0; i < header->numTraces; i++, recordedTrace++){
+		if (recordedTrace->headNode < 0 || recordedTrace->headNode >= cm.numNodes){
+			Com_Printf("%s has a bad head node\n", name);
+
+			FS_FreeFile(buffer);
+			return NULL;
+		}
+	}
+
+	*numTraces = header->numTraces;
+
+	return (recordedTrace_t *)(buffer + sizeof(traceFileHeader_t));
+}
+
+/*
+ ==================
+ CM_FreeTraces
+ ==================
+*/
+static void CM_FreeTraces (recordedTrace_t *recordedTraces){
+
+	FS_FreeFile((byte *)recordedTraces - sizeof(traceFileHeader_t));
+}
+
+
+/*
+ ==============================================================================
+
+ CONSOLE COMMANDS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ CM_RecordTraces_f
+ ==================
+*/
+static void CM_RecordTraces_f (){
+
+	if (Cmd_Argc() != 2){
+		Com_Printf("Usage: recordTraces <name>\n");
+		return;
+	}
+
+	if (cm_traceRecording.active){
+		Com_Printf("Already recording traces\n");
+		return;
+	}
+
+	if (!cm.loaded){
+		Com_Printf("You must be in a level to record traces\n");
+		return;
+	}
+
+	Str_SPrintf(cm_traceRecording.name, sizeof(cm_traceRecording.name), "traces/%s", Cmd_Argv(1));
+	Str_DefaultFileExtension(cm_traceRecording.name, sizeof(cm_traceRecording.name), ".trc");
+
+	cm_traceRecording.active = true;
+	cm_traceRecording.checkCount = cm.checkCount;
+	cm_traceRecording.numTraces = 0;
+	cm_traceRecording.traces = (recordedTrace_t *)Mem_Alloc(MAX_RECORDED_TRACES * sizeof(recordedTrace_t), TAG_COMMON);
+
+	Com_Printf("Recording traces to %s\n", cm_traceRecording.name);
+}
+
+/*
+ ==================
+ CM_StopTraces_f
+ ==================
+*/
+static void CM_StopTraces_f (){
+
+	traceFileHeader_t	*header;
+	byte				*buffer;
+	int					size;
+
+	if (!cm_traceRecording.active){
+		Com_Printf("Not recording traces\n");
+		return;
+	}
+
+	cm_traceRecording.active = false;
+
+	// Write the file
+	size = sizeof(traceFileHeader_t) + cm_traceRecording.numTraces * sizeof(recordedTrace_t);
+
+	buffer = (byte *)Mem_Alloc(size, TAG_TEMPORARY);
+
+	header = (traceFileHeader_t *)buffer;
+
+	header->id = TRACE_FILE_ID;
+	header->version = TRACE_FILE_VERSION;
+	header->checkCount = cm_traceRecording.checkCount;
+	header->numTraces = cm_traceRecording.numTraces;
+
+	Mem_Copy(buffer + sizeof(traceFileHeader_t), cm_traceRecording.traces, cm_traceRecording.numTraces * sizeof(recordedTrace_t));
+
+	if (!FS_WriteFile(cm_traceRecording.name, buffer, size))
+		Com_Printf("Couldn't write %s\n", cm_traceRecording.name);
+	else
+		Com_Printf("Wrote %s (%i traces)\n", cm_traceRecording.name, cm_traceRecording.numTraces);
+
+	Mem_Free(buffer);
+
+	Mem_Free(cm_traceRecording.traces);
+	cm_traceRecording.traces = NULL;
+}
+
+/*
+ ==================
+ CM_BenchmarkTraces_f
+
+ Replays a set of recorded traces to measure the tracing performance
+ ==================
+*/
+static void CM_BenchmarkTraces_f (){
+
+	recordedTrace_t		*recordedTraces, *recordedTrace;
+	trace_t				trace;
+	char				name[MAX_PATH_LENGTH];
+	longlong			ticks;
+	double				seconds;
+	int					numTraces, iterations, mismatches;
+	int					i, j;
+
+	if (Cmd_Argc() < 2 || Cmd_Argc() > 3){
+		Com_Printf("Usage: benchmarkTraces <name> [iterations]\n");
+		return;
+	}
+
+	if (cm_traceRecording.active){
+		Com_Printf("Can't benchmark traces while recording\n");
+		return;
+	}
+
+	if (!cm.loaded){
+		Com_Printf("You must be in a level to benchmark traces\n");
+		return;
+	}
+
+	if (Cmd_Argc() == 3)
+		iterations = ClampInt(Str_ToInteger(Cmd_Argv(2)), 1, 1000);
+	else
+		iterations = 10;
+
+	// Load the traces
+	Str_SPrintf(name, sizeof(name), "traces/%s", Cmd_Argv(1));
+	Str_DefaultFileExtension(name, sizeof(name), ".trc");
+
+	recordedTraces = CM_LoadTraces(name, &numTraces);
+	if (!recordedTraces)
+		return;
+
+	// Validate the traces against the recorded results
+	mismatches = 0;
+
+	for (i = 0, recordedTrace = recordedTraces; i < numTraces; i++, recordedTrace++){
+		trace = CM_Trace(recordedTrace->start, recordedTrace->end, recordedTrace->mins, recordedTrace->maxs, recordedTrace->headNode, recordedTrace->brushMask, NULL);
+
+		if (trace.fraction != recordedTrace->fraction)
+			mismatches++;
+	}
+
+	// Replay the traces
+	ticks = Sys_ClockTicks();
+
+	for (i = 0; i < iterations; i++){
+		for (j = 0, recordedTrace = recordedTraces; j < numTraces; j++, recordedTrace++)
+			CM_Trace(recordedTrace->start, recordedTrace->end, recordedTrace->mins, recordedTrace->maxs, recordedTrace->headNode, recordedTrace->brushMask, NULL);
+	}
+
+	seconds = (double)(Sys_ClockTicks() - ticks) / Sys_ClockTicksPerSecond();
+
+	Com_Printf("%i traces x %i iterations in %.2f msec (%.0f traces/sec)\n", numTraces, iterations, seconds * 1000.0, (numTraces * iterations) / seconds);
+
+	if (mismatches)
+		Com_Printf(S_COLOR_YELLOW "%i traces didn't match the recorded results\n", mismatches);
+
+	CM_FreeTraces(recordedTraces);
+}
+
+/*
+ ==================
+ CM_CompareTraces_f
+
+ Replays a set of recorded traces with both the scalar and SIMD brush clipping
+ code, and makes sure the results are identical
+ ==================
+*/
+static void CM_CompareTraces_f (){
+
+#if defined SIMD_X86
+
+	recordedTrace_t		*recordedTraces, *recordedTrace;
+	trace_t				*traces, trace;
+	char				name[MAX_PATH_LENGTH];
+	bool				skipSIMD;
+	int					numTraces, mismatches;
+	int					i;
+
+	if (Cmd_Argc() != 2){
+		Com_Printf("Usage: compareTraces <name>\n");
+		return;
+	}
+
+	if (cm_traceRecording.active){
+		Com_Printf("Can't compare traces while recording\n");
+		return;
+	}
+
+	if (!cm.loaded){
+		Com_Printf("You must be in a level to compare traces\n");
+		return;
+	}
+
+	// Load the traces
+	Str_SPrintf(name, sizeof(name), "traces/%s", Cmd_Argv(1));
+	Str_DefaultFileExtension(name, sizeof(name), ".trc");
+
+	recordedTraces = CM_LoadTraces(name, &numTraces);
+	if (!recordedTraces)
+		return;
+
+	traces = (trace_t *)Mem_Alloc(numTraces * sizeof(trace_t), TAG_TEMPORARY);
+
+	skipSIMD = cm_skipSIMD->integerValue;
+
+	// Run the traces with the scalar code
+	CVar_SetBool(cm_skipSIMD, true);
+
+	for (i = 0, recordedTrace = recordedTraces; i < numTraces; i++, recordedTrace++)
+		traces[i] = CM_Trace(recordedTrace->start, recordedTrace->end, recordedTrace->mins, recordedTrace->maxs, recordedTrace->headNode, recordedTrace->brushMask, NULL);
+
+	// Run the traces with the SIMD code and compare the results bit for bit
+	CVar_SetBool(cm_skipSIMD, false);
+
+	mismatches = 0;
+
+	for (i = 0, recordedTrace = recordedTraces; i < numTraces; i++, recordedTrace++){
+		trace = CM_Trace(recordedTrace->start, recordedTrace->end, recordedTrace->mins, recordedTrace->maxs, recordedTrace->headNode, recordedTrace->brushMask, NULL);
+
+		if (Mem_Compare(&trace, &traces[i], sizeof(trace_t)))
+			continue;
+
+		if (mismatches++ < 10)
+			Com_Printf(S_COLOR_YELLOW "Trace %i: fraction %g (scalar %g), contents %i (scalar %i)\n", i, trace.fraction, traces[i].fraction, trace.contents, traces[i].contents);
+	}
+
+	CVar_SetBool(cm_skipSIMD, skipSIMD);
+
+	if (mismatches)
+		Com_Printf(S_COLOR_RED "%i of %i traces didn't match\n", mismatches, numTraces);
+	else
+		Com_Printf("All %i traces matched\n", numTraces);
+
+	Mem_Free(traces);
+
+	CM_FreeTraces(recordedTraces);
+
+#else
+
+	Com_Printf("SIMD brush clipping is not available on this platform\n");
+
+#endif
+}
+
+
+/*
+ ==============================================================================
+
+ INITIALIZATION AND SHUTDOWN
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ CM_InitTraces
+ ==================
+*/
+void CM_InitTraces (){
+
+	// Add commands
+	Cmd_AddCommand("recordTraces", CM_RecordTraces_f, "Records traces for benchmarking", NULL);
+	Cmd_AddCommand("stopTraces", CM_StopTraces_f, "Stops recording traces", NULL);
+	Cmd_AddCommand("benchmarkTraces", CM_BenchmarkTraces_f, "Replays recorded traces and measures the tracing performance", NULL);
+	Cmd_AddCommand("compareTraces", CM_CompareTraces_f, "Compares the results of the scalar and SIMD brush clipping code", NULL);
+}
+
+/*
+ ==================
+ CM_ShutdownTraces
+ ==================
+*/
+void CM_ShutdownTraces (){
+
+	// Remove commands
+	Cmd_RemoveCommand("recordTraces");
+	Cmd_RemoveCommand("stopTraces");
+	Cmd_RemoveCommand("benchmarkTraces");
+	Cmd_RemoveCommand("compareTraces");
+
+	// Stop recording
+	if (cm_traceRecording.traces)
+		Mem_Free(cm_traceRecording.traces);
+
+	Mem_Fill(&cm_traceRecording, 0, sizeof(traceRecording_t));
 }
\ No newline at end of file
@@ -886,6 +886,9 @@ void Com_Frame (){
 	// Process commands
 	Cmd_ExecuteBuffer();
 
+	// Run callbacks for finished asynchronous file reads
+	FS_UpdateAsyncReads();
+
 	// Run server frame
 	SV_Frame(msec);
 
@@ -901,6 +904,9 @@ void Com_Frame (){
 	// Print memory manager statistics
 	Mem_PrintStats();
 
+	// Release all the frame memory
+	Mem_ResetFrameArenas();
+
 	// Print common statistics
 	Com_PrintStats();
 }
@@ -975,6 +981,9 @@ void Com_Init (const char *cmdLine){
 	Cmd_AddCommand("pause", Com_Pause_f, "Pauses the game", NULL);
 	Cmd_AddCommand("quit", Com_Quit_f, "Quits the game", NULL);
 
+	// Initialize job system
+	Job_Init();
+
 	// Initialize server and client
 	SV_Init();
 	CL_Init();
@@ -986,6 +995,7 @@ void Com_Init (const char *cmdLine){
 	NET_Init();
 
 	NetChan_Init();
+	NetComp_Init();
 
 	// Initialize lookup table manager
 	LUT_Init();
@@ -1053,7 +1063,12 @@ void Com_Shutdown (){
 	// Shutdown lookup table manager
 	LUT_Shutdown();
 
+	// Shutdown job system
+	Job_Shutdown();
+
 	// Shutdown networking
+	NetComp_Shutdown();
+
 	NET_Shutdown();
 
 	// Shutdown file system
@@ -41,9 +41,11 @@
 #include "msgSystem.h"
 #include "protocol.h"
 #include "network.h"
+#include "netCompression.h"
 #include "netChan.h"
 #include "table.h"
 #include "parser.h"
+#include "jobSystem.h"
 #include "system.h"
 
 #include "../collision/cm_public.h"
@@ -107,7 +109,7 @@ extern cvar_t *				com_serverRunning;
 extern cvar_t *				com_timeDemo;
 extern cvar_t *				com_maxFPS;
 
-ulong		MD4_BlockChecksum (const void *data, int length);
+uint		MD4_BlockChecksum (const void *data, int length);
 
 byte		Com_BlockSequenceCRCByte (const byte *buffer, int length, int sequence);
 
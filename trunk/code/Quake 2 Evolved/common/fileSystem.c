@@ -39,13 +39,26 @@
 
 #define FILES_HASH_SIZE				1024
 
+#define FILE_INDEX_HASH_SIZE		16384
+#define MAX_INDEX_DIRECTORY_FILES	32768		// Must match the limit of Sys_ListFilteredFiles
+
 #define MAX_FILE_HANDLES			64
 
+
 #define MAX_LIST_FILES				65536
 #define MAX_LIST_MODS				64
 
 #define MAX_PACK_FILES				1024
 
+#define MAX_ASYNC_READS				256
+
+#define MAX_PRECACHE_BATCH			(MAX_ASYNC_READS >> 1)
+
+#define ZIP_LOCAL_HEADER_ID			0x04034B50
+#define ZIP_LOCAL_HEADER_SIZE		30
+#define ZIP_CENTRAL_HEADER_ID		0x02014B50
+#define ZIP_CENTRAL_HEADER_SIZE		46
+
 typedef struct {
 	char					name[MAX_PATH_LENGTH];
 	fsMode_t				mode;
@@ -59,7 +72,9 @@ typedef struct fileInPack_s {
 	bool					isDirectory;
 
 	int						size;
-	int						offset;				// This is ignored in PK3 files
+	int						offset;				// In PK3 files, only valid for stored entries in mapped packs
+
+	bool					isStored;			// True if the data is not compressed
 
 	struct fileInPack_s *	nextHash;
 } fileInPack_t;
@@ -70,7 +85,14 @@ typedef struct {
 
 	FILE *					pak;				// Only one of pak or
 	unzFile					pk3;				// pk3 will be used
-	
+
+	const byte *			mapping;			// Memory-mapped pack file, if available
+	int						mappingSize;
+
+	volatile int			asyncFiles;			// Asynchronous read statistics
+	volatile int			asyncBytes;
+	volatile int			asyncMicroseconds;
+
 	int						numFiles;
 	fileInPack_t *			files;
 	fileInPack_t *			filesHashTable[FILES_HASH_SIZE];
@@ -79,6 +101,8 @@ typedef struct {
 typedef struct directory_s {
 	char					base[MAX_PATH_LENGTH];
 	char					game[MAX_PATH_LENGTH];
+
+	bool					isIndexed;			// False if files can appear without the index knowing about it
 } directory_t;
 
 typedef struct searchPath_s {
@@ -88,6 +112,53 @@ typedef struct searchPath_s {
 	struct searchPath_s *	next;
 } searchPath_t;
 
+typedef enum {
+	AS_FREE,
+	AS_QUEUED,
+	AS_READING,
+	AS_COMPLETE,
+	AS_FAILED
+} asyncState_t;
+
+typedef struct {
+	char					name[MAX_PATH_LENGTH];
+
+	volatile asyncState_t	state;
+	fsPriority_t			priority;
+	int						sequence;
+	bool					canceled;
+
+	FILE *					realFile;			// Only one of realFile, zipFile, or
+	unzFile					zipFile;			// mappedData will be used
+	const byte *			mappedData;
+
+	int						size;
+	byte *					buffer;
+
+	pack_t *				pack;				// Pack file containing the file, if any
+
+	asyncCallback_t			callback;
+	void *					data;
+} asyncFile_t;
+
+typedef struct precacheFile_s {
+	char					name[MAX_PATH_LENGTH];
+
+	int						size;
+	byte *					buffer;
+
+	struct precacheFile_s *	nextHash;
+} precacheFile_t;
+
+typedef struct fileIndex_s {
+	const char *			name;
+
+	searchPath_t *			searchPath;			// Search path the file will be read from
+	fileInPack_t *			fileInPack;			// NULL for files in a directory
+
+	struct fileIndex_s *	nextHash;
+} fileIndex_t;
+
 static file_t				fs_fileHandles[MAX_FILE_HANDLES];
 
 static searchPath_t	*		fs_searchPaths;
@@ -97,9 +168,41 @@ static int					fs_writeCount;
 
 static int					fs_packFilesCount;
 
+static int					fs_mappedReads;
+static int					fs_mappedBytes;
+
+static fileIndex_t *		fs_fileIndexHashTable[FILE_INDEX_HASH_SIZE];
+static int					fs_indexFiles;
+static int					fs_indexBuildTime;
+static int					fs_indexHits;
+static int					fs_indexMisses;
+
+static void *				fs_indexLock;		// Lookups can add and remove entries from any thread
+
 static char					fs_curGame[MAX_PATH_LENGTH];
 
+static asyncFile_t			fs_asyncFiles[MAX_ASYNC_READS];
+static int					fs_asyncSequence;
+
+static void *				fs_asyncLock;
+static void *				fs_asyncWakeEvent;
+static void *				fs_asyncDoneEvent;
+
+static volatile bool		fs_asyncShutdown;
+
+static int					fs_numAsyncThreads;
+static void *				fs_asyncThreadHandles[MAX_ASYNC_THREADS];
+static char					fs_asyncThreadNames[MAX_ASYNC_THREADS][32];
+
+static precacheFile_t *		fs_precacheHashTable[FILES_HASH_SIZE];
+static int					fs_precacheFiles;
+static int					fs_precacheBytes;
+
+static void *				fs_precacheLock;	// Loaders can take precached files from any thread
+
 static cvar_t *				fs_debug;
+static cvar_t *				fs_mapPacks;
+static cvar_t *				fs_asyncThreads;
 static cvar_t *				fs_basePath;
 static cvar_t *				fs_savePath;
 cvar_t *					fs_game;
@@ -279,7 +382,16 @@ static int FS_FileNameCompare (const char *name1, const char *name2){
 /*
  ==============================================================================
 
- FILE I/O FUNCTIONS
+ GLOBAL FILE INDEX
+
+ All the files in all the search paths are merged into a single hash table
+ that maps each file name to the search path it would be read from, so finding
+ a file (or not finding it) doesn't require walking the search paths and
+ opening files in every directory.
+
+ Files can be written to the save directory behind our back (by the game
+ module, for example), so it is never considered fully indexed, and a lookup
+ that misses the index will still try to open the file there.
 
  ==============================================================================
 */
@@ -287,380 +399,1545 @@ static int FS_FileNameCompare (const char *name1, const char *name2){
 
 /*
  ==================
- FS_Read
-
- Properly handles partial reads
+ FS_FindInIndex
  ==================
 */
-int FS_Read (fileHandle_t f, void *buffer, int size){
-
-	file_t	*file;
-	byte	*ptr;
-	int		remaining, count;
-	bool	tried = false;
+static fileIndex_t *FS_FindInIndex (const char *name, uint hashKey){
 
-	if (!buffer)
-		Com_Error(ERR_FATAL, "FS_Read: NULL buffer");
-	if (size < 0)
-		Com_Error(ERR_FATAL, "FS_Read: size < 0");
+	fileIndex_t	*fileIndex;
 
-	file = FS_GetFileByHandle(f);
+	for (fileIndex = fs_fileIndexHashTable[hashKey]; fileIndex; fileIndex = fileIndex->nextHash){
+		if (!FS_FileNameCompare(fileIndex->name, name))
+			return fileIndex;
+	}
 
-	if (file->mode != FS_READ)
-		Com_Error(ERR_FATAL, "FS_Read: cannot read from '%s'", file->name);
+	return NULL;
+}
 
-	ptr = (byte *)buffer;
-	remaining = size;
+/*
+ ==================
+ FS_RemoveFromIndex
+ ==================
+*/
+static void FS_RemoveFromIndex (const char *name){
 
-	while (remaining){
-		if (file->realFile)
-			count = fread(ptr, 1, remaining, file->realFile);
-		else
-			count = unzReadCurrentFile(file->zipFile, ptr, remaining);
+	fileIndex_t	*fileIndex, **prevFileIndex;
+	uint		hashKey;
 
-		if (count == 0){
-			if (!tried){
-				tried = true;
-				continue;
-			}
+	hashKey = Str_HashKey(name, FILE_INDEX_HASH_SIZE, false);
 
-			Com_DPrintf(S_COLOR_RED "FS_Read: 0 bytes read from '%s'\n", file->name);
+	for (prevFileIndex = &fs_fileIndexHashTable[hashKey]; *prevFileIndex; prevFileIndex = &(*prevFileIndex)->nextHash){
+		fileIndex = *prevFileIndex;
 
-			if (fs_debug->integerValue)
-				Com_Printf("FS_Read: %i bytes read from '%s'\n", size - remaining, file->name);
+		if (FS_FileNameCompare(fileIndex->name, name))
+			continue;
 
-			return size - remaining;
-		}
+		*prevFileIndex = fileIndex->nextHash;
 
-		if (count < 0)
-			Com_Error(ERR_FATAL, "FS_Read: -1 bytes read from '%s'", file->name);
+		Mem_Free(fileIndex);
 
-		ptr += count;
-		remaining -= count;
+		fs_indexFiles--;
 
-		fs_readCount += count;
+		return;
 	}
-
-	if (fs_debug->integerValue)
-		Com_Printf("FS_Read: %i bytes read from '%s'\n", size, file->name);
-
-	return size;
 }
 
 /*
  ==================
- FS_Write
+ FS_AddToIndex
 
- Properly handles partial writes
+ If the file is already in the index, it will only be updated if replace is
+ true. Files in a directory have their names copied, pack files share the name
+ of the file in the pack.
  ==================
 */
-int FS_Write (fileHandle_t f, const void *buffer, int size){
-
-	file_t	*file;
-	byte	*ptr;
-	int		remaining, count;
-	bool	tried = false;
+static fileIndex_t *FS_AddToIndex (const char *name, searchPath_t *searchPath, fileInPack_t *fileInPack, bool replace){
 
-	if (!buffer)
-		Com_Error(ERR_FATAL, "FS_Write: NULL buffer");
-	if (size < 0)
-		Com_Error(ERR_FATAL, "FS_Write: size < 0");
+	fileIndex_t	*fileIndex;
+	uint		hashKey;
+	int			length;
 
-	file = FS_GetFileByHandle(f);
+	hashKey = Str_HashKey(name, FILE_INDEX_HASH_SIZE, false);
 
-	if (file->mode != FS_WRITE && file->mode != FS_APPEND)
-		Com_Error(ERR_FATAL, "FS_Write: cannot write to '%s'", file->name);
+	// See if already indexed
+	fileIndex = FS_FindInIndex(name, hashKey);
+	if (fileIndex){
+		if (!replace)
+			return fileIndex;
 
-	ptr = (byte *)buffer;
-	remaining = size;
+		// Files in a directory need their own copy of the name
+		if (fileInPack || !fileIndex->fileInPack){
+			fileIndex->searchPath = searchPath;
+			fileIndex->fileInPack = fileInPack;
 
-	while (remaining){
-		if (file->realFile)
-			count = fwrite(ptr, 1, remaining, file->realFile);
-		else
-			Com_Error(ERR_FATAL, "FS_Write: cannot write to zipped file '%s'", file->name);
+			return fileIndex;
+		}
 
-		if (count == 0){
-			if (!tried){
-				tried = true;
-				continue;
-			}
+		FS_RemoveFromIndex(name);
+	}
 
-			Com_DPrintf(S_COLOR_RED "FS_Write: 0 bytes written to '%s'\n", file->name);
+	// Allocate a new entry
+	if (fileInPack){
+		fileIndex = (fileIndex_t *)Mem_Alloc(sizeof(fileIndex_t), TAG_COMMON);
 
-			if (fs_debug->integerValue)
-				Com_Printf("FS_Write: %i bytes written to '%s'\n", size - remaining, file->name);
+		fileIndex->name = fileInPack->name;
+	}
+	else {
+		length = Str_Length(name);
 
-			return size - remaining;
-		}
+		fileIndex = (fileIndex_t *)Mem_Alloc(sizeof(fileIndex_t) + length + 1, TAG_COMMON);
 
-		if (count < 0)
-			Com_Error(ERR_FATAL, "FS_Write: -1 bytes written to '%s'", file->name);
+		fileIndex->name = (const char *)(fileIndex + 1);
+		Mem_Copy(fileIndex + 1, name, length + 1);
+	}
 
-		ptr += count;
-		remaining -= count;
+	fileIndex->searchPath = searchPath;
+	fileIndex->fileInPack = fileInPack;
 
-		fs_writeCount += count;
-	}
+	// Add to hash table
+	fileIndex->nextHash = fs_fileIndexHashTable[hashKey];
+	fs_fileIndexHashTable[hashKey] = fileIndex;
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_Write: %i bytes written to '%s'\n", size, file->name);
+	fs_indexFiles++;
 
-	return size;
+	return fileIndex;
 }
 
 /*
  ==================
- FS_Printf
+ FS_ClearFileIndex
  ==================
 */
-int FS_Printf (fileHandle_t f, const char *fmt, ...){
-
-	file_t	*file;
-	va_list	argPtr;
-	int		count;
-
-	file = FS_GetFileByHandle(f);
-
-	if (file->mode != FS_WRITE && file->mode != FS_APPEND)
-		Com_Error(ERR_FATAL, "FS_Printf: cannot write to '%s'", file->name);
+static void FS_ClearFileIndex (){
 
-	if (file->realFile){
-		va_start(argPtr, fmt);
-		count = vfprintf(file->realFile, fmt, argPtr);
-		va_end(argPtr);
-	}
-	else
-		Com_Error(ERR_FATAL, "FS_Printf: cannot write to zipped file '%s'", file->name);
+	fileIndex_t	*fileIndex, *nextFileIndex;
+	int			i;
 
-	if (count == 0){
-		Com_DPrintf(S_COLOR_RED "FS_Printf: 0 chars written to '%s'\n", file->name);
+	for (i = 0; i < FILE_INDEX_HASH_SIZE; i++){
+		for (fileIndex = fs_fileIndexHashTable[i]; fileIndex; fileIndex = nextFileIndex){
+			nextFileIndex = fileIndex->nextHash;
 
-		if (fs_debug->integerValue)
-			Com_Printf("FS_Printf: 0 chars written to '%s'\n", file->name);
+			Mem_Free(fileIndex);
+		}
 
-		return 0;
+		fs_fileIndexHashTable[i] = NULL;
 	}
 
-	if (count < 0)
-		Com_Error(ERR_FATAL, "FS_Printf: -1 chars written to '%s'", file->name);
-
-	fs_writeCount += count;
-
-	if (fs_debug->integerValue)
-		Com_Printf("FS_Printf: %i chars written to '%s'\n", count, file->name);
-
-	return count;
+	fs_indexFiles = 0;
 }
 
 /*
  ==================
- FS_VPrintf
+ FS_IndexDirectory
+
+ Adds all the files in the given directory tree that are not already indexed
  ==================
 */
-int FS_VPrintf (fileHandle_t f, const char *fmt, va_list argPtr){
+static void FS_IndexDirectory (searchPath_t *searchPath){
 
-	file_t	*file;
-	int		count;
-
-	file = FS_GetFileByHandle(f);
+	directory_t	*directory = searchPath->directory;
+	char		path[MAX_PATH_LENGTH];
+	const char	**fileList;
+	int			numFiles, length;
+	bool		isDirectory;
+	int			i, j;
 
-	if (file->mode != FS_WRITE && file->mode != FS_APPEND)
-		Com_Error(ERR_FATAL, "FS_VPrintf: cannot write to '%s'", file->name);
+	Str_SPrintf(path, sizeof(path), "%s/%s", directory->base, directory->game);
 
-	if (file->realFile)
-		count = vfprintf(file->realFile, fmt, argPtr);
-	else
-		Com_Error(ERR_FATAL, "FS_VPrintf: cannot write to zipped file '%s'", file->name);
+	// Scan the directory tree
+	fileList = Sys_ListFilteredFiles(path, "*", true, &numFiles);
 
-	if (count == 0){
-		Com_DPrintf(S_COLOR_RED "FS_VPrintf: 0 chars written to '%s'\n", file->name);
+	// If the list was truncated, we can't trust the index for this directory
+	if (numFiles >= MAX_INDEX_DIRECTORY_FILES)
+		directory->isIndexed = false;
 
-		if (fs_debug->integerValue)
-			Com_Printf("FS_VPrintf: 0 chars written to '%s'\n", file->name);
+	// Add the files.
+	// The list also contains the subdirectories, which are sorted before
+	// their contents, so skip any name that is followed by names starting with
+	// it and a path separator.
+	for (i = 0; i < numFiles; i++){
+		length = Str_Length(fileList[i]);
+		isDirectory = false;
 
-		return 0;
-	}
+		for (j = i + 1; j < numFiles; j++){
+			if (Str_CompareChars(fileList[i], fileList[j], length))
+				break;
 
-	if (count < 0)
-		Com_Error(ERR_FATAL, "FS_VPrintf: -1 chars written to '%s'", file->name);
+			if (fileList[j][length] == '/'){
+				isDirectory = true;
+				break;
+			}
+		}
 
-	fs_writeCount += count;
+		if (isDirectory)
+			continue;
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_VPrintf: %i chars written to '%s'\n", count, file->name);
+		FS_AddToIndex(fileList[i], searchPath, NULL, false);
+	}
 
-	return count;
+	Sys_FreeFileList(fileList);
 }
 
 /*
  ==================
- FS_Length
+ FS_BuildFileIndex
+
+ Walks the search paths in order, so the first source found for a file wins
  ==================
 */
-int FS_Length (fileHandle_t f){
+static void FS_BuildFileIndex (){
 
-	file_t			*file;
-	unz_file_info	info;
-	int				cur, end;
+	searchPath_t	*searchPath;
+	pack_t			*pack;
+	fileInPack_t	*fileInPack;
+	int				time;
+	int				i;
 
-	file = FS_GetFileByHandle(f);
+	time = Sys_Milliseconds();
 
-	if (file->realFile){
-		cur = ftell(file->realFile);
-		fseek(file->realFile, 0, SEEK_END);
-		end = ftell(file->realFile);
-		fseek(file->realFile, cur, SEEK_SET);
+	FS_ClearFileIndex();
 
-		return end;
-	}
-	else {
-		unzGetCurrentFileInfo(file->zipFile, &info, NULL, 0, NULL, 0, NULL, 0);
+	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
+		if (searchPath->pack){
+			pack = searchPath->pack;
 
-		return info.uncompressed_size;
+			for (i = 0, fileInPack = pack->files; i < pack->numFiles; i++, fileInPack++){
+				if (fileInPack->isDirectory)
+					continue;
+
+				FS_AddToIndex(fileInPack->name, searchPath, fileInPack, false);
+			}
+		}
+		else if (searchPath->directory){
+			searchPath->directory->isIndexed = true;
+
+			// The save directory is never fully indexed
+			if (!FS_FileNameCompare(searchPath->directory->base, fs_savePath->value) && !FS_FileNameCompare(searchPath->directory->game, fs_game->value))
+				searchPath->directory->isIndexed = false;
+
+			FS_IndexDirectory(searchPath);
+		}
 	}
+
+	fs_indexBuildTime = Sys_Milliseconds() - time;
+
+	fs_indexHits = 0;
+	fs_indexMisses = 0;
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_BuildFileIndex: %i files indexed in %i msec\n", fs_indexFiles, fs_indexBuildTime);
 }
 
 /*
  ==================
- FS_Tell
+ FS_SearchFile
+
+ Searches for the given file through all the search paths, without using the
+ index, and updates the index with the result.
+ Returns true if found.
  ==================
 */
-int FS_Tell (fileHandle_t f){
+static bool FS_SearchFile (const char *name){
 
-	file_t	*file;
+	searchPath_t	*searchPath;
+	pack_t			*pack;
+	fileInPack_t	*fileInPack;
+	directory_t		*directory;
+	char			path[MAX_PATH_LENGTH];
+	FILE			*f;
+	uint			hashKey;
+
+	// Get the hash key for the given file name
+	hashKey = Str_HashKey(name, FILES_HASH_SIZE, false);
+
+	// Search through the paths, one element at a time
+	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
+		if (searchPath->pack){
+			// Search inside the pack file
+			pack = searchPath->pack;
+
+			for (fileInPack = pack->filesHashTable[hashKey]; fileInPack; fileInPack = fileInPack->nextHash){
+				if (fileInPack->isDirectory)
+					continue;
+
+				if (!FS_FileNameCompare(fileInPack->name, name)){
+					Sys_LockMutex(fs_indexLock);
+					FS_AddToIndex(fileInPack->name, searchPath, fileInPack, true);
+					Sys_UnlockMutex(fs_indexLock);
+
+					return true;
+				}
+			}
+		}
+		else if (searchPath->directory){
+			// Search in the directory tree
+			directory = searchPath->directory;
+
+			FS_BuildOSPath(directory->base, directory->game, name, path);
+
+			f = fopen(path, "rb");
+			if (f){
+				fclose(f);
+
+				Sys_LockMutex(fs_indexLock);
+				FS_AddToIndex(name, searchPath, NULL, true);
+				Sys_UnlockMutex(fs_indexLock);
+
+				return true;
+			}
+		}
+	}
+
+	// Not found
+	Sys_LockMutex(fs_indexLock);
+	FS_RemoveFromIndex(name);
+	Sys_UnlockMutex(fs_indexLock);
+
+	return false;
+}
+
+/*
+ ==================
+ FS_LookupFile
+
+ Returns false if not found. Otherwise sets the search path and pack file entry
+ (NULL for files in a directory) the file will be read from.
+ Index entries can be replaced or removed by other threads, so they are copied
+ out while holding the lock. The search paths and pack files they point to
+ only change when the file system is restarted.
+ ==================
+*/
+static bool FS_LookupFile (const char *name, searchPath_t **foundSearchPath, fileInPack_t **foundFileInPack){
+
+	searchPath_t	*searchPath;
+	directory_t		*directory;
+	fileIndex_t		*fileIndex;
+	char			path[MAX_PATH_LENGTH];
+	FILE			*f;
+
+	Sys_LockMutex(fs_indexLock);
+
+	fileIndex = FS_FindInIndex(name, Str_HashKey(name, FILE_INDEX_HASH_SIZE, false));
+	if (fileIndex){
+		fs_indexHits++;
+
+		*foundSearchPath = fileIndex->searchPath;
+		*foundFileInPack = fileIndex->fileInPack;
+
+		Sys_UnlockMutex(fs_indexLock);
+
+		return true;
+	}
+
+	// Check the directories that are not fully indexed
+	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
+		if (!searchPath->directory || searchPath->directory->isIndexed)
+			continue;
+
+		directory = searchPath->directory;
+
+		FS_BuildOSPath(directory->base, directory->game, name, path);
+
+		f = fopen(path, "rb");
+		if (f){
+			fclose(f);
+
+			fs_indexHits++;
+
+			FS_AddToIndex(name, searchPath, NULL, false);
+
+			*foundSearchPath = searchPath;
+			*foundFileInPack = NULL;
+
+			Sys_UnlockMutex(fs_indexLock);
+
+			return true;
+		}
+	}
+
+	fs_indexMisses++;
+
+	Sys_UnlockMutex(fs_indexLock);
+
+	return false;
+}
+
+
+/*
+ ==============================================================================
+
+ FILE I/O FUNCTIONS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ FS_Read
+
+ Properly handles partial reads
+ ==================
+*/
+int FS_Read (fileHandle_t f, void *buffer, int size){
+
+	file_t	*file;
+	byte	*ptr;
+	int		remaining, count;
+	bool	tried = false;
+
+	if (!buffer)
+		Com_Error(ERR_FATAL, "FS_Read: NULL buffer");
+	if (size < 0)
+		Com_Error(ERR_FATAL, "FS_Read: size < 0");
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->mode != FS_READ)
+		Com_Error(ERR_FATAL, "FS_Read: cannot read from '%s'", file->name);
+
+	ptr = (byte *)buffer;
+	remaining = size;
+
+	while (remaining){
+		if (file->realFile)
+			count = fread(ptr, 1, remaining, file->realFile);
+		else
+			count = unzReadCurrentFile(file->zipFile, ptr, remaining);
+
+		if (count == 0){
+			if (!tried){
+				tried = true;
+				continue;
+			}
+
+			Com_DPrintf(S_COLOR_RED "FS_Read: 0 bytes read from '%s'\n", file->name);
+
+			if (fs_debug->integerValue)
+				Com_Printf("FS_Read: %i bytes read from '%s'\n", size - remaining, file->name);
+
+			return size - remaining;
+		}
+
+		if (count < 0)
+			Com_Error(ERR_FATAL, "FS_Read: -1 bytes read from '%s'", file->name);
+
+		ptr += count;
+		remaining -= count;
+
+		fs_readCount += count;
+	}
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_Read: %i bytes read from '%s'\n", size, file->name);
+
+	return size;
+}
+
+/*
+ ==================
+ FS_Write
+
+ Properly handles partial writes
+ ==================
+*/
+int FS_Write (fileHandle_t f, const void *buffer, int size){
+
+	file_t	*file;
+	byte	*ptr;
+	int		remaining, count;
+	bool	tried = false;
+
+	if (!buffer)
+		Com_Error(ERR_FATAL, "FS_Write: NULL buffer");
+	if (size < 0)
+		Com_Error(ERR_FATAL, "FS_Write: size < 0");
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->mode != FS_WRITE && file->mode != FS_APPEND)
+		Com_Error(ERR_FATAL, "FS_Write: cannot write to '%s'", file->name);
+
+	ptr = (byte *)buffer;
+	remaining = size;
+
+	while (remaining){
+		if (file->realFile)
+			count = fwrite(ptr, 1, remaining, file->realFile);
+		else
+			Com_Error(ERR_FATAL, "FS_Write: cannot write to zipped file '%s'", file->name);
+
+		if (count == 0){
+			if (!tried){
+				tried = true;
+				continue;
+			}
+
+			Com_DPrintf(S_COLOR_RED "FS_Write: 0 bytes written to '%s'\n", file->name);
+
+			if (fs_debug->integerValue)
+				Com_Printf("FS_Write: %i bytes written to '%s'\n", size - remaining, file->name);
+
+			return size - remaining;
+		}
+
+		if (count < 0)
+			Com_Error(ERR_FATAL, "FS_Write: -1 bytes written to '%s'", file->name);
+
+		ptr += count;
+		remaining -= count;
+
+		fs_writeCount += count;
+	}
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_Write: %i bytes written to '%s'\n", size, file->name);
+
+	return size;
+}
+
+/*
+ ==================
+ FS_Printf
+ ==================
+*/
+int FS_Printf (fileHandle_t f, const char *fmt, ...){
+
+	file_t	*file;
+	va_list	argPtr;
+	int		count;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->mode != FS_WRITE && file->mode != FS_APPEND)
+		Com_Error(ERR_FATAL, "FS_Printf: cannot write to '%s'", file->name);
+
+	if (file->realFile){
+		va_start(argPtr, fmt);
+		count = vfprintf(file->realFile, fmt, argPtr);
+		va_end(argPtr);
+	}
+	else
+		Com_Error(ERR_FATAL, "FS_Printf: cannot write to zipped file '%s'", file->name);
+
+	if (count == 0){
+		Com_DPrintf(S_COLOR_RED "FS_Printf: 0 chars written to '%s'\n", file->name);
+
+		if (fs_debug->integerValue)
+			Com_Printf("FS_Printf: 0 chars written to '%s'\n", file->name);
+
+		return 0;
+	}
+
+	if (count < 0)
+		Com_Error(ERR_FATAL, "FS_Printf: -1 chars written to '%s'", file->name);
+
+	fs_writeCount += count;
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_Printf: %i chars written to '%s'\n", count, file->name);
+
+	return count;
+}
+
+/*
+ ==================
+ FS_VPrintf
+ ==================
+*/
+int FS_VPrintf (fileHandle_t f, const char *fmt, va_list argPtr){
+
+	file_t	*file;
+	int		count;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->mode != FS_WRITE && file->mode != FS_APPEND)
+		Com_Error(ERR_FATAL, "FS_VPrintf: cannot write to '%s'", file->name);
+
+	if (file->realFile)
+		count = vfprintf(file->realFile, fmt, argPtr);
+	else
+		Com_Error(ERR_FATAL, "FS_VPrintf: cannot write to zipped file '%s'", file->name);
+
+	if (count == 0){
+		Com_DPrintf(S_COLOR_RED "FS_VPrintf: 0 chars written to '%s'\n", file->name);
+
+		if (fs_debug->integerValue)
+			Com_Printf("FS_VPrintf: 0 chars written to '%s'\n", file->name);
+
+		return 0;
+	}
+
+	if (count < 0)
+		Com_Error(ERR_FATAL, "FS_VPrintf: -1 chars written to '%s'", file->name);
+
+	fs_writeCount += count;
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_VPrintf: %i chars written to '%s'\n", count, file->name);
+
+	return count;
+}
+
+/*
+ ==================
+ FS_Length
+ ==================
+*/
+int FS_Length (fileHandle_t f){
+
+	file_t			*file;
+	unz_file_info	info;
+	int				cur, end;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->realFile){
+		cur = ftell(file->realFile);
+		fseek(file->realFile, 0, SEEK_END);
+		end = ftell(file->realFile);
+		fseek(file->realFile, cur, SEEK_SET);
+
+		return end;
+	}
+	else {
+		unzGetCurrentFileInfo(file->zipFile, &info, NULL, 0, NULL, 0, NULL, 0);
+
+		return info.uncompressed_size;
+	}
+}
+
+/*
+ ==================
+ FS_Tell
+ ==================
+*/
+int FS_Tell (fileHandle_t f){
+
+	file_t	*file;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->realFile)
+		return ftell(file->realFile);
+	else
+		return unztell(file->zipFile);
+}
+
+/*
+ ==================
+ FS_Seek
+ ==================
+*/
+void FS_Seek (fileHandle_t f, int offset, fsOrigin_t origin){
+
+	file_t			*file;
+	unz_file_info	info;
+	byte			dummy[65536];
+	int				remaining, count;
+	bool			tried = false;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->realFile){
+		switch (origin){
+		case FS_SEEK_SET:
+			fseek(file->realFile, offset, SEEK_SET);
+			break;
+		case FS_SEEK_CUR:
+			fseek(file->realFile, offset, SEEK_CUR);
+			break;
+		case FS_SEEK_END:
+			fseek(file->realFile, offset, SEEK_END);
+			break;
+		default:
+			Com_Error(ERR_FATAL, "FS_Seek: bad origin for '%s'", file->name);
+		}
+	}
+	else {
+		unzGetCurrentFileInfo(file->zipFile, &info, NULL, 0, NULL, 0, NULL, 0);
+
+		switch (origin){
+		case FS_SEEK_SET:
+			remaining = offset;
+			break;
+		case FS_SEEK_CUR:
+			remaining = offset + unztell(file->zipFile);
+			break;
+		case FS_SEEK_END:
+			remaining = offset + info.uncompressed_size;
+			break;
+		default:
+			Com_Error(ERR_FATAL, "FS_Seek: bad origin for '%s'", file->name);
+		}
+
+		// Reopen the file
+		unzCloseCurrentFile(file->zipFile);
+
+		if (unzOpenCurrentFile(file->zipFile) != UNZ_OK)
+			return;
+
+		// Skip until the desired offset is reached
+		if (remaining <= 0)
+			return;
+
+		if (remaining > info.uncompressed_size)
+			remaining = info.uncompressed_size;
+
+		while (remaining){
+			count = remaining;
+			if (count > sizeof(dummy))
+				count = sizeof(dummy);
+
+			count = unzReadCurrentFile(file->zipFile, dummy, count);
+
+			if (count == 0){
+				if (!tried){
+					tried = true;
+					continue;
+				}
+
+				break;
+			}
+
+			if (count < 0)
+				break;
+
+			remaining -= count;
+		}
+	}
+}
+
+/*
+ ==================
+ FS_Flush
+ ==================
+*/
+void FS_Flush (fileHandle_t f){
+
+	file_t	*file;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->realFile)
+		fflush(file->realFile);
+	else
+		Com_Error(ERR_FATAL, "FS_Flush: cannot flush zipped file '%s'", file->name);
+}
+
+/*
+ ==================
+ FS_ForceFlush
+ ==================
+*/
+void FS_ForceFlush (fileHandle_t f){
+
+	file_t	*file;
+
+	file = FS_GetFileByHandle(f);
+
+	if (file->realFile)
+		setvbuf(file->realFile, NULL, _IONBF, 0);
+	else
+		Com_Error(ERR_FATAL, "FS_ForceFlush: cannot flush zipped file '%s'", file->name);
+}
+
+
+/*
+ ==============================================================================
+
+ PRECACHED FILES
+
+ A batch of files can be read (and decompressed) in parallel by the
+ asynchronous file loading threads and kept in memory (see FS_PrecacheFiles),
+ so the loaders that read them one at a time later on don't have to wait for
+ the disk or zlib.
+
+ The first load of a precached file takes ownership of the buffer the file was
+ read into, so the data is never copied again. Any later load of the same file
+ reads it normally.
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ FS_FindPrecache
+
+ Must be called with the lock held
+ ==================
+*/
+static precacheFile_t *FS_FindPrecache (const char *name){
+
+	precacheFile_t	*precacheFile;
+	uint			hashKey;
+
+	if (!fs_precacheFiles)
+		return NULL;
+
+	hashKey = Str_HashKey(name, FILES_HASH_SIZE, false);
+
+	for (precacheFile = fs_precacheHashTable[hashKey]; precacheFile; precacheFile = precacheFile->nextHash){
+		if (!FS_FileNameCompare(precacheFile->name, name))
+			return precacheFile;
+	}
+
+	return NULL;
+}
+
+/*
+ ==================
+ FS_TakePrecache
+
+ Returns NULL if the given file is not precached. Otherwise removes it and
+ returns its buffer, which the caller must free with FS_FreeFile.
+ ==================
+*/
+static byte *FS_TakePrecache (const char *name, int *size){
+
+	precacheFile_t	*precacheFile, **prevPrecacheFile;
+	byte			*buffer;
+	uint			hashKey;
+
+	if (!fs_precacheFiles)
+		return NULL;
+
+	hashKey = Str_HashKey(name, FILES_HASH_SIZE, false);
+
+	Sys_LockMutex(fs_precacheLock);
+
+	for (prevPrecacheFile = &fs_precacheHashTable[hashKey]; *prevPrecacheFile; prevPrecacheFile = &(*prevPrecacheFile)->nextHash){
+		precacheFile = *prevPrecacheFile;
+
+		if (FS_FileNameCompare(precacheFile->name, name))
+			continue;
+
+		// Remove from hash table
+		*prevPrecacheFile = precacheFile->nextHash;
+
+		fs_precacheFiles--;
+		fs_precacheBytes -= precacheFile->size;
+
+		Sys_UnlockMutex(fs_precacheLock);
+
+		buffer = precacheFile->buffer;
+		*size = precacheFile->size;
+
+		Mem_Free(precacheFile);
+
+		return buffer;
+	}
+
+	Sys_UnlockMutex(fs_precacheLock);
+
+	return NULL;
+}
+
+/*
+ ==================
+ FS_AddPrecache
+ ==================
+*/
+static void FS_AddPrecache (const char *name, byte *buffer, int size){
+
+	precacheFile_t	*precacheFile;
+	uint			hashKey;
+
+	Sys_LockMutex(fs_precacheLock);
+
+	// Check if already precached
+	if (FS_FindPrecache(name)){
+		Sys_UnlockMutex(fs_precacheLock);
+
+		Mem_Free(buffer);
+		return;
+	}
+
+	// Add a new precached file
+	precacheFile = (precacheFile_t *)Mem_Alloc(sizeof(precacheFile_t), TAG_COMMON);
+
+	Str_Copy(precacheFile->name, name, sizeof(precacheFile->name));
+	precacheFile->size = size;
+	precacheFile->buffer = buffer;
+
+	// Add to hash table
+	hashKey = Str_HashKey(name, FILES_HASH_SIZE, false);
+
+	precacheFile->nextHash = fs_precacheHashTable[hashKey];
+	fs_precacheHashTable[hashKey] = precacheFile;
+
+	fs_precacheFiles++;
+	fs_precacheBytes += size;
+
+	Sys_UnlockMutex(fs_precacheLock);
+}
+
+/*
+ ==================
+ FS_FlushPrecache
+ ==================
+*/
+void FS_FlushPrecache (){
+
+	precacheFile_t	*precacheFile, *nextPrecacheFile;
+	int				i;
+
+	if (!fs_precacheFiles)
+		return;
+
+	Sys_LockMutex(fs_precacheLock);
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_FlushPrecache: %i files (%i bytes)\n", fs_precacheFiles, fs_precacheBytes);
+
+	for (i = 0; i < FILES_HASH_SIZE; i++){
+		for (precacheFile = fs_precacheHashTable[i]; precacheFile; precacheFile = nextPrecacheFile){
+			nextPrecacheFile = precacheFile->nextHash;
+
+			Mem_Free(precacheFile->buffer);
+			Mem_Free(precacheFile);
+		}
+
+		fs_precacheHashTable[i] = NULL;
+	}
+
+	fs_precacheFiles = 0;
+	fs_precacheBytes = 0;
+
+	Sys_UnlockMutex(fs_precacheLock);
+}
+
+
+/*
+ ==============================================================================
+
+ FUNCTIONS FOR ENTIRE FILES
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ FS_IsMappedFile
+
+ Returns true if the file is stored uncompressed in a memory-mapped pack file,
+ so reading it is just a copy out of the mapping
+ ==================
+*/
+static bool FS_IsMappedFile (const char *name){
+
+	searchPath_t	*searchPath;
+	fileInPack_t	*fileInPack;
+
+	if (!FS_LookupFile(name, &searchPath, &fileInPack) || !fileInPack)
+		return false;
+
+	if (!searchPath->pack->mapping || !fileInPack->isStored)
+		return false;
+
+	return true;
+}
+
+/*
+ ==================
+ FS_IsMappedBuffer
+
+ Returns true if the given buffer points into the mapping of a pack file.
+ Search paths only change when the file system is restarted, so this doesn't
+ need a lock and there is nothing to release if a mapped buffer is never freed.
+ ==================
+*/
+static bool FS_IsMappedBuffer (const void *buffer){
+
+	searchPath_t	*searchPath;
+	pack_t			*pack;
+
+	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
+		pack = searchPath->pack;
+
+		if (!pack || !pack->mapping)
+			continue;
+
+		if ((const byte *)buffer >= pack->mapping && (const byte *)buffer < pack->mapping + pack->mappingSize)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ ==================
+ FS_OpenFileRead
+
+ Returns file size or -1 if not found.
+ Can open separate files as well as files inside pack files (both PAK 
+ and PK3).
+ If mappedData is not NULL and the file is stored uncompressed in a
+ memory-mapped pack file, it will be set to point to the file data and no file
+ will be opened.
+ ==================
+*/
+static int FS_OpenFileRead (const char *name, FILE **realFile, unzFile *zipFile, const byte **mappedData){
+
+	searchPath_t	*searchPath;
+	pack_t			*pack;
+	fileInPack_t	*fileInPack;
+	directory_t		*directory;
+	char			path[MAX_PATH_LENGTH];
+
+	// Look it up in the index
+	if (!FS_LookupFile(name, &searchPath, &fileInPack)){
+		// Not found!
+		if (fs_debug->integerValue)
+			Com_Printf("FS_OpenFileRead: couldn't find %s\n", name);
+
+		return -1;
+	}
+
+	if (fileInPack){
+		// Open it inside a pack file
+		pack = searchPath->pack;
+
+		if (fs_debug->integerValue)
+			Com_Printf("FS_OpenFileRead: '%s' (found in '%s')\n", name, pack->path);
+
+		if (mappedData && pack->mapping && fileInPack->isStored){
+			// Memory-mapped
+			*mappedData = pack->mapping + fileInPack->offset;
+
+			return fileInPack->size;
+		}
+
+		if (pack->pak){
+			// PAK
+			*realFile = fopen(pack->path, "rb");
+			if (*realFile){
+				fseek(*realFile, fileInPack->offset, SEEK_SET);
+
+				return fileInPack->size;
+			}
+		}
+		else if (pack->pk3){
+			// PK3
+			*zipFile = unzOpen(pack->path);
+			if (*zipFile){
+				if (unzLocateFile(*zipFile, name, 2) == UNZ_OK){
+					if (unzOpenCurrentFile(*zipFile) == UNZ_OK)
+						return fileInPack->size;
+				}
+
+				unzClose(*zipFile);
+			}
+		}
+
+		Com_DPrintf(S_COLOR_RED "FS_OpenFileRead: couldn't reopen '%s'\n", pack->path);
+
+		return -1;
+	}
+
+	// Open it in a directory tree
+	directory = searchPath->directory;
+
+	FS_BuildOSPath(directory->base, directory->game, name, path);
+
+	*realFile = fopen(path, "rb");
+	if (*realFile){
+		if (fs_debug->integerValue)
+			Com_Printf("FS_OpenFileRead: '%s' (found in '%s%s%s')\n", name, directory->base, PATH_SEPARATOR_STRING, directory->game);
+
+		return FS_FileLength(*realFile);
+	}
+
+	// The index is out of date, so search again
+	if (FS_SearchFile(name))
+		return FS_OpenFileRead(name, realFile, zipFile, mappedData);
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_OpenFileRead: couldn't find %s\n", name);
+
+	return -1;
+}
+
+/*
+ ==================
+ FS_OpenFileWrite
+
+ Always returns 0 or -1 on error
+ ==================
+*/
+static int FS_OpenFileWrite (const char *name, FILE **realFile){
+
+	char	path[MAX_PATH_LENGTH];
+
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, name, path);
+
+	// Create any needed subdirectories
+	FS_CreateOSPath(path);
+
+	// Open the file
+	*realFile = fopen(path, "wb");
+	if (*realFile){
+		if (fs_debug->integerValue)
+			Com_Printf("FS_OpenFileWrite: '%s' (opened in '%s%s%s')\n", name, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+
+		// Update the index
+		FS_SearchFile(name);
+
+		return 0;
+	}
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_OpenFileWrite: couldn't open '%s'\n", name);
+
+	return -1;
+}
+
+/*
+ ==================
+ FS_OpenFileAppend
+
+ Returns file size or -1 on error
+ ==================
+*/
+static int FS_OpenFileAppend (const char *name, FILE **realFile){
+
+	char	path[MAX_PATH_LENGTH];
+
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, name, path);
+
+	// Create any needed subdirectories
+	FS_CreateOSPath(path);
+
+	// Open the file
+	*realFile = fopen(path, "ab");
+	if (*realFile){
+		if (fs_debug->integerValue)
+			Com_Printf("FS_OpenFileAppend: '%s' (opened in '%s%s%s')\n", name, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+
+		// Update the index
+		FS_SearchFile(name);
+
+		return FS_FileLength(*realFile);
+	}
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_OpenFileAppend: couldn't open '%s'\n", name);
+
+	return -1;
+}
+
+/*
+ ==================
+ FS_OpenFile
+ ==================
+*/
+int FS_OpenFile (const char *name, fsMode_t mode, fileHandle_t *f){
+
+	file_t	*file;
+	FILE	*realFile = NULL;
+	unzFile	zipFile = NULL;
+	int		size;
+
+	// Try to open the file
+	switch (mode){
+	case FS_READ:
+		size = FS_OpenFileRead(name, &realFile, &zipFile, NULL);
+		break;
+	case FS_WRITE:
+		size = FS_OpenFileWrite(name, &realFile);
+		break;
+	case FS_APPEND:
+		size = FS_OpenFileAppend(name, &realFile);
+		break;
+	default:
+		Com_Error(ERR_FATAL, "FS_OpenFile: bad mode for '%s'", name);
+	}
+
+	if (size == -1){
+		*f = 0;
+
+		return -1;
+	}
+
+	// Create a new file handle
+	file = FS_HandleForFile(f);
+
+	Str_Copy(file->name, name, sizeof(file->name));
+	file->mode = mode;
+	file->realFile = realFile;
+	file->zipFile = zipFile;
+
+	return size;
+}
+
+/*
+ ==================
+ FS_CloseFile
+ ==================
+*/
+void FS_CloseFile (fileHandle_t f){
+
+	file_t	*file;
 
 	file = FS_GetFileByHandle(f);
 
 	if (file->realFile)
-		return ftell(file->realFile);
-	else
-		return unztell(file->zipFile);
+		fclose(file->realFile);
+	else {
+		unzCloseCurrentFile(file->zipFile);
+		unzClose(file->zipFile);
+	}
+
+	Mem_Fill(file, 0, sizeof(file_t));
 }
 
 /*
  ==================
- FS_Seek
+ FS_CopyFile
  ==================
 */
-void FS_Seek (fileHandle_t f, int offset, fsOrigin_t origin){
+bool FS_CopyFile (const char *srcName, const char *dstName){
 
-	file_t			*file;
-	unz_file_info	info;
-	byte			dummy[65536];
-	int				remaining, count;
-	bool			tried = false;
+	char	srcPath[MAX_PATH_LENGTH], dstPath[MAX_PATH_LENGTH];
+	FILE	*f1, *f2;
+	byte	buffer[65536];
+	int		remaining, count;
 
-	file = FS_GetFileByHandle(f);
+	// Make sure the file names are valid
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, srcName, srcPath);
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, dstName, dstPath);
 
-	if (file->realFile){
-		switch (origin){
-		case FS_SEEK_SET:
-			fseek(file->realFile, offset, SEEK_SET);
-			break;
-		case FS_SEEK_CUR:
-			fseek(file->realFile, offset, SEEK_CUR);
+	if (fs_debug->integerValue)
+		Com_Printf("FS_CopyFile: '%s' to '%s' ('%s%s%s')\n", srcName, dstName, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+
+	// Open the files
+	f1 = fopen(srcPath, "rb");
+	if (!f1){
+		Com_DPrintf(S_COLOR_RED "FS_CopyFile: couldn't open '%s'\n", srcName);
+		return false;
+	}
+
+	f2 = fopen(dstPath, "wb");
+	if (!f2){
+		fclose(f1);
+
+		Com_DPrintf(S_COLOR_RED "FS_CopyFile: couldn't open '%s'\n", dstName);
+		return false;
+	}
+
+	// Copy in small chunks
+	remaining = FS_FileLength(f1);
+
+	while (remaining){
+		count = remaining;
+		if (count > sizeof(buffer))
+			count = sizeof(buffer);
+
+		if (fread(buffer, 1, count, f1) != count){
+			Com_DPrintf(S_COLOR_RED "FS_CopyFile: short read from '%s'\n", srcName);
 			break;
-		case FS_SEEK_END:
-			fseek(file->realFile, offset, SEEK_END);
+		}
+
+		if (fwrite(buffer, 1, count, f2) != count){
+			Com_DPrintf(S_COLOR_RED "FS_CopyFile: short write to '%s'\n", dstName);
 			break;
-		default:
-			Com_Error(ERR_FATAL, "FS_Seek: bad origin for '%s'", file->name);
 		}
+
+		remaining -= count;
 	}
-	else {
-		unzGetCurrentFileInfo(file->zipFile, &info, NULL, 0, NULL, 0, NULL, 0);
 
-		switch (origin){
-		case FS_SEEK_SET:
-			remaining = offset;
-			break;
-		case FS_SEEK_CUR:
-			remaining = offset + unztell(file->zipFile);
-			break;
-		case FS_SEEK_END:
-			remaining = offset + info.uncompressed_size;
-			break;
-		default:
-			Com_Error(ERR_FATAL, "FS_Seek: bad origin for '%s'", file->name);
+	fclose(f1);
+	fclose(f2);
+
+	// Update the index
+	FS_SearchFile(dstName);
+
+	return (remaining == 0);
+}
+
+/*
+ ==================
+ FS_RenameFile
+ ==================
+*/
+bool FS_RenameFile (const char *oldName, const char *newName){
+
+	char	oldPath[MAX_PATH_LENGTH], newPath[MAX_PATH_LENGTH];
+
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, oldName, oldPath);
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, newName, newPath);
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_RenameFile: '%s' to '%s' ('%s%s%s')\n", oldName, newName, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+
+	// Rename it
+	if (rename(oldPath, newPath)){
+		Com_DPrintf(S_COLOR_RED "FS_RenameFile: couldn't rename '%s' to '%s'\n", oldName, newName);
+		return false;
+	}
+
+	// Update the index
+	FS_SearchFile(oldName);
+	FS_SearchFile(newName);
+
+	return true;
+}
+		
+/*
+ ==================
+ FS_RemoveFile
+ ==================
+*/
+bool FS_RemoveFile (const char *name){
+
+	char	path[MAX_PATH_LENGTH];
+
+	FS_BuildOSPath(fs_savePath->value, fs_game->value, name, path);
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_RemoveFile: '%s' ('%s%s%s')\n", name, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+
+	// Remove it
+	if (remove(path)){
+		Com_DPrintf(S_COLOR_RED "FS_RemoveFile: couldn't remove '%s'\n", name);
+		return false;
+	}
+
+	// Update the index
+	FS_SearchFile(name);
+
+	return true;
+}
+
+/*
+ ==================
+ FS_FileExists
+ ==================
+*/
+bool FS_FileExists (const char *name){
+
+	fileHandle_t	f;
+
+	FS_OpenFile(name, FS_READ, &f);
+	if (!f)
+		return false;
+
+	FS_CloseFile(f);
+
+	return true;
+}
+
+/*
+ ==================
+ FS_FindFile
+ ==================
+*/
+findFile_t FS_FindFile (const char *name, char sourcePath[MAX_PATH_LENGTH]){
+
+	searchPath_t	*searchPath;
+	fileInPack_t	*fileInPack;
+	pack_t			*pack;
+	directory_t		*directory;
+
+	// Look it up in the index
+	if (!FS_LookupFile(name, &searchPath, &fileInPack)){
+		// Not found!
+		if (fs_debug->integerValue)
+			Com_Printf("FS_FindFile: couldn't find '%s'\n", name);
+
+		return FIND_NO;
+	}
+
+	if (fileInPack){
+		// Found it inside a pack file
+		pack = searchPath->pack;
+
+		if (fs_debug->integerValue)
+			Com_Printf("FS_FindFile: '%s' (found in '%s')\n", name, pack->path);
+
+		if (sourcePath)
+			Str_Copy(sourcePath, pack->path, MAX_PATH_LENGTH);
+
+		return FIND_PACK;
+	}
+
+	// Found it in a directory tree
+	directory = searchPath->directory;
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_FindFile: '%s' (found in '%s%s%s')\n", name, directory->base, PATH_SEPARATOR_STRING, directory->game);
+
+	if (sourcePath)
+		Str_SPrintf(sourcePath, MAX_PATH_LENGTH, "%s%s%s", directory->base, PATH_SEPARATOR_STRING, directory->game);
+
+	return FIND_DIRECTORY;
+}
+
+/*
+ ==================
+ FS_LoadFile
+
+ If map is true and the file is stored uncompressed in a memory-mapped pack
+ file, the returned buffer will point directly into the mapping. Otherwise the
+ file will be read into a newly allocated, null-terminated buffer.
+ ==================
+*/
+static int FS_LoadFile (const char *name, const void **buffer, bool map){
+
+	file_t			*file;
+	FILE			*realFile = NULL;
+	unzFile			zipFile = NULL;
+	const byte		*mappedData = NULL;
+	fileHandle_t	f;
+	byte			*ptr;
+	int				size;
+
+	// If precached, just hand over the buffer the file was read into.
+	// Memory-mapped files are never precached.
+	if (buffer){
+		ptr = FS_TakePrecache(name, &size);
+		if (ptr){
+			*buffer = ptr;
+			return size;
 		}
+	}
 
-		// Reopen the file
-		unzCloseCurrentFile(file->zipFile);
+	size = FS_OpenFileRead(name, &realFile, &zipFile, &mappedData);
+	if (size == -1){
+		if (buffer)
+			*buffer = NULL;
 
-		if (unzOpenCurrentFile(file->zipFile) != UNZ_OK)
-			return;
+		return -1;
+	}
 
-		// Skip until the desired offset is reached
-		if (remaining <= 0)
-			return;
+	// If stored in a memory-mapped pack file, just use the mapping
+	if (mappedData){
+		if (!buffer)
+			return size;
 
-		if (remaining > info.uncompressed_size)
-			remaining = info.uncompressed_size;
+		Sys_AtomicAdd(&fs_readCount, size);
 
-		while (remaining){
-			count = remaining;
-			if (count > sizeof(dummy))
-				count = sizeof(dummy);
+		Sys_AtomicIncrement(&fs_mappedReads);
+		Sys_AtomicAdd(&fs_mappedBytes, size);
 
-			count = unzReadCurrentFile(file->zipFile, dummy, count);
+		// FS_FreeFile knows not to free it, because it lies in the mapping
+		if (map){
+			*buffer = mappedData;
+			return size;
+		}
+
+		*buffer = ptr = (byte *)Mem_Alloc(size + 1, TAG_TEMPORARY);
+
+		Mem_Copy(ptr, mappedData, size);
+
+		ptr[size] = 0;
+
+		return size;
+	}
+
+	// Create a new file handle
+	file = FS_HandleForFile(&f);
+
+	Str_Copy(file->name, name, sizeof(file->name));
+	file->mode = FS_READ;
+	file->realFile = realFile;
+	file->zipFile = zipFile;
+
+	if (!buffer){
+		FS_CloseFile(f);
+		return size;
+	}
+
+	if (map && fs_debug->integerValue)
+		Com_Printf("FS_MapFile: '%s' is not in a mapped pack file, copying\n", name);
+
+	*buffer = ptr = (byte *)Mem_Alloc(size + 1, TAG_TEMPORARY);
+
+	FS_Read(f, ptr, size);
+	FS_CloseFile(f);
+
+	ptr[size] = 0;
+
+	return size;
+}
 
-			if (count == 0){
-				if (!tried){
-					tried = true;
-					continue;
-				}
+/*
+ ==================
+ FS_ReadFile
+ ==================
+*/
+int FS_ReadFile (const char *name, void **buffer){
 
-				break;
-			}
+	return FS_LoadFile(name, (const void **)buffer, false);
+}
 
-			if (count < 0)
-				break;
+/*
+ ==================
+ FS_MapFile
+ ==================
+*/
+int FS_MapFile (const char *name, const void **buffer){
 
-			remaining -= count;
-		}
-	}
+	return FS_LoadFile(name, buffer, true);
 }
 
 /*
  ==================
- FS_Flush
+ FS_FreeFile
  ==================
 */
-void FS_Flush (fileHandle_t f){
+void FS_FreeFile (const void *buffer){
 
-	file_t	*file;
+	if (!buffer)
+		Com_Error(ERR_FATAL, "FS_FreeFile: NULL buffer");
 
-	file = FS_GetFileByHandle(f);
+	// Memory-mapped data is released when the pack file is closed
+	if (FS_IsMappedBuffer(buffer))
+		return;
 
-	if (file->realFile)
-		fflush(file->realFile);
-	else
-		Com_Error(ERR_FATAL, "FS_Flush: cannot flush zipped file '%s'", file->name);
+	Mem_Free(buffer);
 }
 
 /*
  ==================
- FS_ForceFlush
+ FS_WriteFile
  ==================
 */
-void FS_ForceFlush (fileHandle_t f){
+bool FS_WriteFile (const char *name, const void *buffer, int size){
 
-	file_t	*file;
+	fileHandle_t	f;
 
-	file = FS_GetFileByHandle(f);
+	if (!buffer)
+		Com_Error(ERR_FATAL, "FS_WriteFile: NULL buffer");
 
-	if (file->realFile)
-		setvbuf(file->realFile, NULL, _IONBF, 0);
-	else
-		Com_Error(ERR_FATAL, "FS_ForceFlush: cannot flush zipped file '%s'", file->name);
+	FS_OpenFile(name, FS_WRITE, &f);
+	if (!f)
+		return false;
+
+	FS_Write(f, buffer, size);
+	FS_CloseFile(f);
+
+	return true;
 }
 
 
 /*
  ==============================================================================
 
- FUNCTIONS FOR ENTIRE FILES
+ ASYNCHRONOUS FILE LOADING
+
+ Files are located and opened by the calling thread when a read is queued, so
+ the worker threads never touch the search paths or the file index. They only
+ read (and decompress) the data, taking the queued reads with the highest
+ priority first.
+
+ Reads can be queued, checked, waited on, or canceled from any thread, since
+ the file index is only accessed with its lock held and the read slots are
+ protected by their own lock. Callbacks are always run on the main thread by
+ FS_UpdateAsyncReads.
 
  ==============================================================================
 */
@@ -668,478 +1945,596 @@ void FS_ForceFlush (fileHandle_t f){
 
 /*
  ==================
- FS_OpenFileRead
-
- Returns file size or -1 if not found.
- Can open separate files as well as files inside pack files (both PAK 
- and PK3).
+ FS_GetAsyncFile
  ==================
 */
-static int FS_OpenFileRead (const char *name, FILE **realFile, unzFile *zipFile){
-
-	searchPath_t	*searchPath;
-	pack_t			*pack;
-	fileInPack_t	*fileInPack;
-	directory_t		*directory;
-	char			path[MAX_PATH_LENGTH];
-	uint			hashKey;
+static asyncFile_t *FS_GetAsyncFile (asyncRead_t handle){
 
-	// Get the hash key for the given file name
-	hashKey = Str_HashKey(name, FILES_HASH_SIZE, false);
+	asyncFile_t	*file;
 
-	// Search through the paths, one element at a time
-	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
-		if (searchPath->pack){
-			// Search inside a pack file
-			pack = searchPath->pack;
+	if (handle <= 0 || handle > MAX_ASYNC_READS)
+		Com_Error(ERR_FATAL, "FS_GetAsyncFile: handle out of range");
 
-			for (fileInPack = pack->filesHashTable[hashKey]; fileInPack; fileInPack = fileInPack->nextHash){
-				if (!FS_FileNameCompare(fileInPack->name, name)){
-					// Found it!
-					if (fs_debug->integerValue)
-						Com_Printf("FS_OpenFileRead: '%s' (found in '%s')\n", name, pack->path);
-
-					if (pack->pak){
-						// PAK
-						*realFile = fopen(pack->path, "rb");
-						if (*realFile){
-							fseek(*realFile, fileInPack->offset, SEEK_SET);
-
-							return fileInPack->size;
-						}
-					}
-					else if (pack->pk3){
-						// PK3
-						*zipFile = unzOpen(pack->path);
-						if (*zipFile){
-							if (unzLocateFile(*zipFile, name, 2) == UNZ_OK){
-								if (unzOpenCurrentFile(*zipFile) == UNZ_OK)
-									return fileInPack->size;
-							}
-
-							unzClose(*zipFile);
-						}
-					}
-
-					Com_DPrintf(S_COLOR_RED "FS_OpenFileRead: couldn't reopen '%s'\n", pack->path);
+	file = &fs_asyncFiles[handle - 1];
 
-					return -1;
-				}
-			}
-		}
-		else if (searchPath->directory){
-			// Search in a directory tree
-			directory = searchPath->directory;
+	if (file->state == AS_FREE)
+		Com_Error(ERR_FATAL, "FS_GetAsyncFile: invalid handle");
 
-			FS_BuildOSPath(directory->base, directory->game, name, path);
+	return file;
+}
 
-			*realFile = fopen(path, "rb");
-			if (*realFile){
-				// Found it!
-				if (fs_debug->integerValue)
-					Com_Printf("FS_OpenFileRead: '%s' (found in '%s%s%s')\n", name, directory->base, PATH_SEPARATOR_STRING, directory->game);
+/*
+ ==================
+ FS_CloseAsyncFile
+ ==================
+*/
+static void FS_CloseAsyncFile (asyncFile_t *file){
 
-				return FS_FileLength(*realFile);
-			}
-		}
+	if (file->realFile){
+		fclose(file->realFile);
+		file->realFile = NULL;
 	}
 
-	// Not found!
-	if (fs_debug->integerValue)
-		Com_Printf("FS_OpenFileRead: couldn't find %s\n", name);
-
-	return -1;
+	if (file->zipFile){
+		unzCloseCurrentFile(file->zipFile);
+		unzClose(file->zipFile);
+		file->zipFile = NULL;
+	}
 }
 
 /*
  ==================
- FS_OpenFileWrite
+ FS_PerformAsyncRead
 
- Always returns 0 or -1 on error
+ Called by the thread that changed the state to AS_READING
  ==================
 */
-static int FS_OpenFileWrite (const char *name, FILE **realFile){
+static void FS_PerformAsyncRead (asyncFile_t *file){
 
-	char	path[MAX_PATH_LENGTH];
+	longlong	ticks;
+	byte		*ptr;
+	int			remaining, count;
 
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, name, path);
+	ticks = Sys_ClockTicks();
 
-	// Create any needed subdirectories
-	FS_CreateOSPath(path);
+	file->buffer = ptr = (byte *)Mem_Alloc(file->size + 1, TAG_COMMON);
 
-	// Open the file
-	*realFile = fopen(path, "wb");
-	if (*realFile){
-		if (fs_debug->integerValue)
-			Com_Printf("FS_OpenFileWrite: '%s' (opened in '%s%s%s')\n", name, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+	// Read the data
+	if (file->mappedData)
+		Mem_Copy(ptr, file->mappedData, file->size);
+	else {
+		remaining = file->size;
 
-		return 0;
+		while (remaining){
+			if (file->realFile)
+				count = fread(ptr, 1, remaining, file->realFile);
+			else
+				count = unzReadCurrentFile(file->zipFile, ptr, remaining);
+
+			if (count <= 0)
+				break;
+
+			ptr += count;
+			remaining -= count;
+		}
+
+		FS_CloseAsyncFile(file);
+
+		if (remaining){
+			Mem_Free(file->buffer);
+			file->buffer = NULL;
+		}
 	}
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_OpenFileWrite: couldn't open '%s'\n", name);
+	if (file->buffer){
+		file->buffer[file->size] = 0;
 
-	return -1;
+		Sys_AtomicAdd(&fs_readCount, file->size);
+
+		// Update pack file statistics
+		if (file->pack){
+			ticks = (Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond();
+
+			Sys_AtomicIncrement(&file->pack->asyncFiles);
+			Sys_AtomicAdd(&file->pack->asyncBytes, file->size);
+			Sys_AtomicAdd(&file->pack->asyncMicroseconds, (int)ticks);
+		}
+	}
+
+	// Done
+	Sys_LockMutex(fs_asyncLock);
+
+	file->state = (file->buffer) ? AS_COMPLETE : AS_FAILED;
+
+	Sys_UnlockMutex(fs_asyncLock);
+
+	Sys_SignalEvent(fs_asyncDoneEvent);
 }
 
 /*
  ==================
- FS_OpenFileAppend
+ FS_ClaimAsyncRead
 
- Returns file size or -1 on error
+ Returns the queued read with the highest priority, or NULL if there are none
  ==================
 */
-static int FS_OpenFileAppend (const char *name, FILE **realFile){
+static asyncFile_t *FS_ClaimAsyncRead (){
 
-	char	path[MAX_PATH_LENGTH];
+	asyncFile_t	*file, *best = NULL;
+	bool		morePending = false;
+	int			i;
 
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, name, path);
+	Sys_LockMutex(fs_asyncLock);
 
-	// Create any needed subdirectories
-	FS_CreateOSPath(path);
+	for (i = 0, file = fs_asyncFiles; i < MAX_ASYNC_READS; i++, file++){
+		if (file->state != AS_QUEUED)
+			continue;
 
-	// Open the file
-	*realFile = fopen(path, "ab");
-	if (*realFile){
-		if (fs_debug->integerValue)
-			Com_Printf("FS_OpenFileAppend: '%s' (opened in '%s%s%s')\n", name, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+		if (!best){
+			best = file;
+			continue;
+		}
 
-		return FS_FileLength(*realFile);
+		morePending = true;
+
+		if (file->priority > best->priority || (file->priority == best->priority && file->sequence - best->sequence < 0))
+			best = file;
 	}
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_OpenFileAppend: couldn't open '%s'\n", name);
+	if (best)
+		best->state = AS_READING;
 
-	return -1;
+	Sys_UnlockMutex(fs_asyncLock);
+
+	// Wake up another thread if there's more work to do
+	if (morePending)
+		Sys_SignalEvent(fs_asyncWakeEvent);
+
+	return best;
 }
 
 /*
  ==================
- FS_OpenFile
+ FS_AsyncThread
  ==================
 */
-int FS_OpenFile (const char *name, fsMode_t mode, fileHandle_t *f){
-
-	file_t	*file;
-	FILE	*realFile = NULL;
-	unzFile	zipFile = NULL;
-	int		size;
+static void FS_AsyncThread (void *data){
 
-	// Try to open the file
-	switch (mode){
-	case FS_READ:
-		size = FS_OpenFileRead(name, &realFile, &zipFile);
-		break;
-	case FS_WRITE:
-		size = FS_OpenFileWrite(name, &realFile);
-		break;
-	case FS_APPEND:
-		size = FS_OpenFileAppend(name, &realFile);
-		break;
-	default:
-		Com_Error(ERR_FATAL, "FS_OpenFile: bad mode for '%s'", name);
-	}
+	asyncFile_t	*file;
 
-	if (size == -1){
-		*f = 0;
+	Mem_AttachThread((const char *)data);
 
-		return -1;
-	}
+	while (1){
+		Sys_WaitEvent(fs_asyncWakeEvent, -1);
 
-	// Create a new file handle
-	file = FS_HandleForFile(f);
+		if (fs_asyncShutdown){
+			// Pass it on to the other threads
+			Sys_SignalEvent(fs_asyncWakeEvent);
+			break;
+		}
 
-	Str_Copy(file->name, name, sizeof(file->name));
-	file->mode = mode;
-	file->realFile = realFile;
-	file->zipFile = zipFile;
+		while ((file = FS_ClaimAsyncRead()) != NULL)
+			FS_PerformAsyncRead(file);
+	}
 
-	return size;
+	Mem_DetachThread();
 }
 
 /*
  ==================
- FS_CloseFile
+ FS_FinishAsyncRead
+
+ Sets the buffer and size of a read that is done and releases the handle
  ==================
 */
-void FS_CloseFile (fileHandle_t f){
+static asyncStatus_t FS_FinishAsyncRead (asyncFile_t *file, void **buffer, int *size){
 
-	file_t	*file;
+	asyncStatus_t	status;
 
-	file = FS_GetFileByHandle(f);
+	if (file->state == AS_COMPLETE){
+		status = ASYNC_COMPLETE;
 
-	if (file->realFile)
-		fclose(file->realFile);
+		if (buffer)
+			*buffer = file->buffer;
+		else
+			Mem_Free(file->buffer);
+
+		if (size)
+			*size = file->size;
+	}
 	else {
-		unzCloseCurrentFile(file->zipFile);
-		unzClose(file->zipFile);
+		status = ASYNC_FAILED;
+
+		if (buffer)
+			*buffer = NULL;
+
+		if (size)
+			*size = -1;
 	}
 
-	Mem_Fill(file, 0, sizeof(file_t));
+	Mem_Fill(file, 0, sizeof(asyncFile_t));
+
+	return status;
 }
 
 /*
  ==================
- FS_CopyFile
+ FS_ReadFileAsync
  ==================
 */
-bool FS_CopyFile (const char *srcName, const char *dstName){
+asyncRead_t FS_ReadFileAsync (const char *name, fsPriority_t priority, asyncCallback_t callback, void *data){
 
-	char	srcPath[MAX_PATH_LENGTH], dstPath[MAX_PATH_LENGTH];
-	FILE	*f1, *f2;
-	byte	buffer[65536];
-	int		remaining, count;
+	asyncFile_t		*file;
+	fileIndex_t		*fileIndex;
+	pack_t			*pack = NULL;
+	FILE			*realFile = NULL;
+	unzFile			zipFile = NULL;
+	const byte		*mappedData = NULL;
+	int				size;
+	int				i;
 
-	// Make sure the file names are valid
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, srcName, srcPath);
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, dstName, dstPath);
+	// Open the file
+	size = FS_OpenFileRead(name, &realFile, &zipFile, &mappedData);
+	if (size == -1)
+		return 0;
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_CopyFile: '%s' to '%s' ('%s%s%s')\n", srcName, dstName, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+	// Find the pack file it will be read from
+	Sys_LockMutex(fs_indexLock);
 
-	// Open the files
-	f1 = fopen(srcPath, "rb");
-	if (!f1){
-		Com_DPrintf(S_COLOR_RED "FS_CopyFile: couldn't open '%s'\n", srcName);
-		return false;
-	}
+	fileIndex = FS_FindInIndex(name, Str_HashKey(name, FILE_INDEX_HASH_SIZE, false));
+	if (fileIndex && fileIndex->fileInPack)
+		pack = fileIndex->searchPath->pack;
 
-	f2 = fopen(dstPath, "wb");
-	if (!f2){
-		fclose(f1);
+	Sys_UnlockMutex(fs_indexLock);
 
-		Com_DPrintf(S_COLOR_RED "FS_CopyFile: couldn't open '%s'\n", dstName);
-		return false;
+	// Find a free slot
+	Sys_LockMutex(fs_asyncLock);
+
+	for (i = 0, file = fs_asyncFiles; i < MAX_ASYNC_READS; i++, file++){
+		if (file->state == AS_FREE)
+			break;
 	}
 
-	// Copy in small chunks
-	remaining = FS_FileLength(f1);
+	if (i == MAX_ASYNC_READS)
+		Com_Error(ERR_FATAL, "FS_ReadFileAsync: none free");
+
+	// Fill it in
+	Str_Copy(file->name, name, sizeof(file->name));
+	file->priority = priority;
+	file->sequence = fs_asyncSequence++;
+	file->canceled = false;
+	file->realFile = realFile;
+	file->zipFile = zipFile;
+	file->mappedData = mappedData;
+	file->size = size;
+	file->buffer = NULL;
+	file->pack = pack;
+	file->callback = callback;
+	file->data = data;
+
+	// Queue it, or read it now if there are no worker threads
+	if (fs_numAsyncThreads)
+		file->state = AS_QUEUED;
+	else
+		file->state = AS_READING;
+
+	Sys_UnlockMutex(fs_asyncLock);
+
+	if (fs_numAsyncThreads)
+		Sys_SignalEvent(fs_asyncWakeEvent);
+	else
+		FS_PerformAsyncRead(file);
+
+	if (fs_debug->integerValue)
+		Com_Printf("FS_ReadFileAsync: '%s' (%i bytes, priority %i)\n", name, size, priority);
+
+	return i + 1;
+}
 
-	while (remaining){
-		count = remaining;
-		if (count > sizeof(buffer))
-			count = sizeof(buffer);
+/*
+ ==================
+ FS_CheckAsyncRead
+ ==================
+*/
+asyncStatus_t FS_CheckAsyncRead (asyncRead_t handle, void **buffer, int *size){
 
-		if (fread(buffer, 1, count, f1) != count){
-			Com_DPrintf(S_COLOR_RED "FS_CopyFile: short read from '%s'\n", srcName);
-			break;
-		}
+	asyncFile_t		*file;
+	asyncStatus_t	status;
 
-		if (fwrite(buffer, 1, count, f2) != count){
-			Com_DPrintf(S_COLOR_RED "FS_CopyFile: short write to '%s'\n", dstName);
-			break;
-		}
+	file = FS_GetAsyncFile(handle);
 
-		remaining -= count;
-	}
+	Sys_LockMutex(fs_asyncLock);
 
-	fclose(f1);
-	fclose(f2);
+	if (file->state == AS_QUEUED || file->state == AS_READING)
+		status = ASYNC_PENDING;
+	else
+		status = FS_FinishAsyncRead(file, buffer, size);
 
-	return (remaining == 0);
+	Sys_UnlockMutex(fs_asyncLock);
+
+	return status;
 }
 
 /*
  ==================
- FS_RenameFile
+ FS_WaitAsyncRead
  ==================
 */
-bool FS_RenameFile (const char *oldName, const char *newName){
+asyncStatus_t FS_WaitAsyncRead (asyncRead_t handle, void **buffer, int *size){
 
-	char	oldPath[MAX_PATH_LENGTH], newPath[MAX_PATH_LENGTH];
+	asyncFile_t		*file;
+	asyncStatus_t	status;
+	bool			claimed = false;
 
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, oldName, oldPath);
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, newName, newPath);
+	file = FS_GetAsyncFile(handle);
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_RenameFile: '%s' to '%s' ('%s%s%s')\n", oldName, newName, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+	// If it hasn't been started yet, read it now
+	Sys_LockMutex(fs_asyncLock);
 
-	// Rename it
-	if (rename(oldPath, newPath)){
-		Com_DPrintf(S_COLOR_RED "FS_RenameFile: couldn't rename '%s' to '%s'\n", oldName, newName);
-		return false;
+	if (file->state == AS_QUEUED){
+		file->state = AS_READING;
+
+		claimed = true;
 	}
 
-	return true;
+	Sys_UnlockMutex(fs_asyncLock);
+
+	if (claimed)
+		FS_PerformAsyncRead(file);
+
+	// Wait for the worker thread to finish it
+	while (file->state == AS_READING)
+		Sys_WaitEvent(fs_asyncDoneEvent, -1);
+
+	Sys_LockMutex(fs_asyncLock);
+
+	status = FS_FinishAsyncRead(file, buffer, size);
+
+	Sys_UnlockMutex(fs_asyncLock);
+
+	return status;
 }
-		
+
 /*
  ==================
- FS_RemoveFile
+ FS_CancelAsyncRead
  ==================
 */
-bool FS_RemoveFile (const char *name){
+void FS_CancelAsyncRead (asyncRead_t handle){
 
-	char	path[MAX_PATH_LENGTH];
+	asyncFile_t	*file;
 
-	FS_BuildOSPath(fs_savePath->value, fs_game->value, name, path);
+	file = FS_GetAsyncFile(handle);
 
-	if (fs_debug->integerValue)
-		Com_Printf("FS_RemoveFile: '%s' ('%s%s%s')\n", name, fs_savePath->value, PATH_SEPARATOR_STRING, fs_game->value);
+	Sys_LockMutex(fs_asyncLock);
 
-	// Remove it
-	if (remove(path)){
-		Com_DPrintf(S_COLOR_RED "FS_RemoveFile: couldn't remove '%s'\n", name);
-		return false;
+	switch (file->state){
+	case AS_QUEUED:
+		FS_CloseAsyncFile(file);
+
+		Mem_Fill(file, 0, sizeof(asyncFile_t));
+
+		break;
+	case AS_READING:
+		// Will be released by FS_UpdateAsyncReads
+		file->canceled = true;
+
+		break;
+	default:
+		FS_FinishAsyncRead(file, NULL, NULL);
+
+		break;
 	}
 
-	return true;
+	Sys_UnlockMutex(fs_asyncLock);
 }
 
 /*
  ==================
- FS_FileExists
+ FS_UpdateAsyncReads
  ==================
 */
-bool FS_FileExists (const char *name){
+void FS_UpdateAsyncReads (){
 
-	fileHandle_t	f;
+	asyncFile_t		*file;
+	asyncCallback_t	callback;
+	char			name[MAX_PATH_LENGTH];
+	void			*buffer, *data;
+	int				size;
+	int				i;
 
-	FS_OpenFile(name, FS_READ, &f);
-	if (!f)
-		return false;
+	for (i = 0, file = fs_asyncFiles; i < MAX_ASYNC_READS; i++, file++){
+		if (file->state != AS_COMPLETE && file->state != AS_FAILED)
+			continue;
 
-	FS_CloseFile(f);
+		if (!file->callback && !file->canceled)
+			continue;		// Waiting for FS_CheckAsyncRead or FS_WaitAsyncRead
 
-	return true;
+		// Release it
+		Sys_LockMutex(fs_asyncLock);
+
+		if (file->canceled){
+			FS_FinishAsyncRead(file, NULL, NULL);
+
+			Sys_UnlockMutex(fs_asyncLock);
+
+			continue;
+		}
+
+		Str_Copy(name, file->name, sizeof(name));
+		callback = file->callback;
+		data = file->data;
+
+		FS_FinishAsyncRead(file, &buffer, &size);
+
+		Sys_UnlockMutex(fs_asyncLock);
+
+		// Run the callback
+		callback(name, buffer, size, data);
+	}
 }
 
 /*
  ==================
- FS_FindFile
+ FS_PrecacheFiles
  ==================
 */
-findFile_t FS_FindFile (const char *name, char sourcePath[MAX_PATH_LENGTH]){
+void FS_PrecacheFiles (const char **names, int numNames){
 
 	searchPath_t	*searchPath;
 	pack_t			*pack;
-	fileInPack_t	*fileInPack;
-	directory_t		*directory;
-	char			path[MAX_PATH_LENGTH];
-	FILE			*f;
-	uint			hashKey;
+	asyncRead_t		handles[MAX_PRECACHE_BATCH];
+	const char		*handleNames[MAX_PRECACHE_BATCH];
+	void			*buffer;
+	bool			precached;
+	int				numHandles, numFiles = 0, numBytes = 0;
+	int				time, size;
+	int				i, j;
 
-	// Get the hash key for the given file name
-	hashKey = Str_HashKey(name, FILES_HASH_SIZE, false);
+	time = Sys_Milliseconds();
 
-	// Search through the paths, one element at a time
+	// Clear pack file statistics
 	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
-		if (searchPath->pack){
-			// Search inside the pack file
-			pack = searchPath->pack;
+		if (!searchPath->pack)
+			continue;
 
-			for (fileInPack = pack->filesHashTable[hashKey]; fileInPack; fileInPack = fileInPack->nextHash){
-				if (fileInPack->isDirectory)
-					continue;
+		searchPath->pack->asyncFiles = 0;
+		searchPath->pack->asyncBytes = 0;
+		searchPath->pack->asyncMicroseconds = 0;
+	}
 
-				if (!FS_FileNameCompare(fileInPack->name, name)){
-					// Found it!
-					if (fs_debug->integerValue)
-						Com_Printf("FS_FindFile: '%s' (found in '%s')\n", name, pack->path);
+	// Queue the files in batches, then wait for them in order. The main
+	// thread will read any files the worker threads haven't started yet, so
+	// it helps instead of just waiting.
+	for (i = 0; i < numNames; ){
+		numHandles = 0;
 
-					if (sourcePath)
-						Str_Copy(sourcePath, pack->path, MAX_PATH_LENGTH);
+		for ( ; i < numNames && numHandles < MAX_PRECACHE_BATCH; i++){
+			if (!names[i] || !names[i][0])
+				continue;
 
-					return FIND_PACK;
-				}
-			}
-		}
-		else if (searchPath->directory){
-			// Search in the directory tree
-			directory = searchPath->directory;
+			Sys_LockMutex(fs_precacheLock);
+			precached = (FS_FindPrecache(names[i]) != NULL);
+			Sys_UnlockMutex(fs_precacheLock);
 
-			FS_BuildOSPath(directory->base, directory->game, name, path);
+			if (precached)
+				continue;
 
-			f = fopen(path, "rb");
-			if (f){
-				// Found it!
-				if (fs_debug->integerValue)
-					Com_Printf("FS_FindFile: '%s' (found in '%s%s%s')\n", name, directory->base, PATH_SEPARATOR_STRING, directory->game);
+			// Nothing to gain from reading memory-mapped files ahead of time
+			if (FS_IsMappedFile(names[i]))
+				continue;
 
-				fclose(f);
+			handles[numHandles] = FS_ReadFileAsync(names[i], FS_PRIORITY_HIGH, NULL, NULL);
+			if (!handles[numHandles])
+				continue;
 
-				if (sourcePath)
-					Str_SPrintf(sourcePath, MAX_PATH_LENGTH, "%s%s%s", directory->base, PATH_SEPARATOR_STRING, directory->game);
+			handleNames[numHandles++] = names[i];
+		}
 
-				return FIND_DIRECTORY;
-			}
+		for (j = 0; j < numHandles; j++){
+			if (FS_WaitAsyncRead(handles[j], &buffer, &size) != ASYNC_COMPLETE)
+				continue;
+
+			FS_AddPrecache(handleNames[j], (byte *)buffer, size);
+
+			numFiles++;
+			numBytes += size;
 		}
 	}
 
-	// Not found!
-	if (fs_debug->integerValue)
-		Com_Printf("FS_FindFile: couldn't find '%s'\n", name);
+	time = Sys_Milliseconds() - time;
+
+	Com_Printf("Precached %i files (%.2f MB) in %i msec with %i threads\n", numFiles, numBytes * (1.0f / 1048576.0f), time, fs_numAsyncThreads + 1);
 
-	return FIND_NO;
+	// Report per-archive throughput
+	for (searchPath = fs_searchPaths; searchPath; searchPath = searchPath->next){
+		if (!searchPath->pack)
+			continue;
+
+		pack = searchPath->pack;
+
+		if (!pack->asyncFiles)
+			continue;
+
+		Com_DPrintf("...%s: %i files, %.2f MB in %.1f msec (%.2f MB/s per thread)\n", pack->path, pack->asyncFiles, pack->asyncBytes * (1.0f / 1048576.0f), pack->asyncMicroseconds * 0.001f, (pack->asyncMicroseconds) ? (pack->asyncBytes * (1.0f / 1048576.0f)) / (pack->asyncMicroseconds * 0.000001f) : 0.0f);
+	}
 }
 
 /*
  ==================
- FS_ReadFile
+ FS_InitAsyncReads
  ==================
 */
-int FS_ReadFile (const char *name, void **buffer){
-
-	fileHandle_t	f;
-	byte			*ptr;
-	int				size;
+static void FS_InitAsyncReads (){
 
-	size = FS_OpenFile(name, FS_READ, &f);
-	if (!f){
-		if (buffer)
-			*buffer = NULL;
+	int		i;
 
-		return -1;
-	}
+	fs_asyncLock = Sys_CreateMutex();
 
-	if (!buffer){
-		FS_CloseFile(f);
-		return size;
-	}
+	fs_asyncWakeEvent = Sys_CreateEvent(false);
+	fs_asyncDoneEvent = Sys_CreateEvent(false);
 
-	*buffer = ptr = (byte *)Mem_Alloc(size + 1, TAG_TEMPORARY);
+	fs_asyncShutdown = false;
 
-	FS_Read(f, ptr, size);
-	FS_CloseFile(f);
+	// Start the worker threads
+	fs_numAsyncThreads = Mem_ReserveThreads("fsAsync", ClampInt(fs_asyncThreads->integerValue, 0, MAX_ASYNC_THREADS));
 
-	ptr[size] = 0;
+	for (i = 0; i < fs_numAsyncThreads; i++){
+		Str_SPrintf(fs_asyncThreadNames[i], sizeof(fs_asyncThreadNames[i]), "fsAsync%i", i);
 
-	return size;
+		fs_asyncThreadHandles[i] = Sys_CreateThread(FS_AsyncThread, fs_asyncThreadNames[i], fs_asyncThreadNames[i]);
+	}
 }
 
 /*
  ==================
- FS_FreeFile
+ FS_ShutdownAsyncReads
  ==================
 */
-void FS_FreeFile (const void *buffer){
+static void FS_ShutdownAsyncReads (){
 
-	if (!buffer)
-		Com_Error(ERR_FATAL, "FS_FreeFile: NULL buffer");
+	asyncFile_t	*file;
+	int			i;
 
-	Mem_Free(buffer);
-}
+	if (!fs_asyncLock)
+		return;
 
-/*
- ==================
- FS_WriteFile
- ==================
-*/
-bool FS_WriteFile (const char *name, const void *buffer, int size){
+	// Stop the worker threads
+	fs_asyncShutdown = true;
 
-	fileHandle_t	f;
+	Sys_SignalEvent(fs_asyncWakeEvent);
 
-	if (!buffer)
-		Com_Error(ERR_FATAL, "FS_WriteFile: NULL buffer");
+	for (i = 0; i < fs_numAsyncThreads; i++){
+		Sys_DestroyThread(fs_asyncThreadHandles[i]);
 
-	FS_OpenFile(name, FS_WRITE, &f);
-	if (!f)
-		return false;
+		fs_asyncThreadHandles[i] = NULL;
+	}
 
-	FS_Write(f, buffer, size);
-	FS_CloseFile(f);
+	Mem_ReleaseThreads(fs_numAsyncThreads);
 
-	return true;
+	fs_numAsyncThreads = 0;
+
+	// Release all the reads
+	for (i = 0, file = fs_asyncFiles; i < MAX_ASYNC_READS; i++, file++){
+		if (file->state == AS_FREE)
+			continue;
+
+		FS_CloseAsyncFile(file);
+
+		if (file->buffer)
+			Mem_Free(file->buffer);
+
+		Mem_Fill(file, 0, sizeof(asyncFile_t));
+	}
+
+	Sys_DestroyEvent(fs_asyncWakeEvent);
+	Sys_DestroyEvent(fs_asyncDoneEvent);
+
+	Sys_DestroyMutex(fs_asyncLock);
+
+	fs_asyncWakeEvent = NULL;
+	fs_asyncDoneEvent = NULL;
+	fs_asyncLock = NULL;
 }
 
 
@@ -1666,6 +3061,24 @@ void FS_ResetWriteCount (){
 */
 
 
+/*
+ ==================
+ FS_MapPack
+
+ Maps the whole pack file into memory, so stored files can be read without
+ any file I/O or copying
+ ==================
+*/
+static void FS_MapPack (pack_t *pack){
+
+	pack->mapping = (const byte *)Sys_MapFile(pack->path, &pack->mappingSize);
+	if (!pack->mapping){
+		Com_DPrintf(S_COLOR_YELLOW "FS_MapPack: couldn't map '%s'\n", pack->path);
+
+		pack->mappingSize = 0;
+	}
+}
+
 /*
  ==================
  FS_LoadPAK
@@ -1724,6 +3137,8 @@ static pack_t *FS_LoadPAK (const char *packPath, const char *packGame){
 	Str_Copy(pack->game, packGame, sizeof(pack->game));
 	pack->pak = handle;
 	pack->pk3 = NULL;
+	pack->mapping = NULL;
+	pack->mappingSize = 0;
 	pack->numFiles = numFiles;
 	pack->files = fileInPack = (fileInPack_t *)Mem_Alloc(numFiles * sizeof(fileInPack_t), TAG_COMMON);
 	Mem_Fill(pack->filesHashTable, 0, sizeof(pack->filesHashTable));
@@ -1739,6 +3154,7 @@ static pack_t *FS_LoadPAK (const char *packPath, const char *packGame){
 		fileInPack->size = LittleLong(info.fileLen);
 		fileInPack->offset = LittleLong(info.filePos);
 		fileInPack->isDirectory = false;
+		fileInPack->isStored = true;
 
 		// Add to hash table
 		hashKey = Str_HashKey(fileInPack->name, FILES_HASH_SIZE, false);
@@ -1750,6 +3166,10 @@ static pack_t *FS_LoadPAK (const char *packPath, const char *packGame){
 		fileInPack++;
 	}
 
+	// Map the pack file if desired
+	if (fs_mapPacks->integerValue)
+		FS_MapPack(pack);
+
 	return pack;
 }
 
@@ -1763,6 +3183,69 @@ static pack_t *FS_LoadPAK (const char *packPath, const char *packGame){
 */
 
 
+/*
+ ==================
+ FS_ZipShort
+ ==================
+*/
+static int FS_ZipShort (const byte *data){
+
+	return data[0] | (data[1] << 8);
+}
+
+/*
+ ==================
+ FS_ZipLong
+ ==================
+*/
+static int FS_ZipLong (const byte *data){
+
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+}
+
+/*
+ ==================
+ FS_PK3DataOffset
+
+ Finds the offset of the data for the entry with the given central directory
+ position in a memory-mapped pack file.
+ Returns -1 if the headers are invalid.
+ ==================
+*/
+static int FS_PK3DataOffset (const pack_t *pack, uLong centralPos, int size){
+
+	const byte	*header;
+	int			offset;
+
+	if (centralPos + ZIP_CENTRAL_HEADER_SIZE > (uLong)pack->mappingSize)
+		return -1;
+
+	header = pack->mapping + centralPos;
+
+	if (FS_ZipLong(header) != ZIP_CENTRAL_HEADER_ID)
+		return -1;
+
+	// Find the local header
+	offset = FS_ZipLong(header + 42);
+
+	if (offset < 0 || offset + ZIP_LOCAL_HEADER_SIZE > pack->mappingSize)
+		return -1;
+
+	header = pack->mapping + offset;
+
+	if (FS_ZipLong(header) != ZIP_LOCAL_HEADER_ID)
+		return -1;
+
+	// Skip the local header, file name, and extra field
+	offset += ZIP_LOCAL_HEADER_SIZE + FS_ZipShort(header + 26) + FS_ZipShort(header + 28);
+
+	if (offset + size > pack->mappingSize)
+		return -1;
+
+	return offset;
+}
+
+
 /*
  ==================
  FS_LoadPK3
@@ -1819,10 +3302,16 @@ static pack_t *FS_LoadPK3 (const char *packPath, const char *packGame){
 	Str_Copy(pack->game, packGame, sizeof(pack->game));
 	pack->pak = NULL;
 	pack->pk3 = handle;
+	pack->mapping = NULL;
+	pack->mappingSize = 0;
 	pack->numFiles = 0;
 	pack->files = fileInPack = (fileInPack_t *)Mem_Alloc(numFiles * sizeof(fileInPack_t), TAG_COMMON);
 	Mem_Fill(pack->filesHashTable, 0, sizeof(pack->filesHashTable));
 
+	// Map the pack file if desired
+	if (fs_mapPacks->integerValue)
+		FS_MapPack(pack);
+
 	// Parse the directory
 	unzGoToFirstFile(handle);
 
@@ -1845,6 +3334,14 @@ static pack_t *FS_LoadPK3 (const char *packPath, const char *packGame){
 		fileInPack->isDirectory = isDirectory;
 		fileInPack->size = info.uncompressed_size;
 		fileInPack->offset = -1;
+		fileInPack->isStored = false;
+
+		// Stored entries can be read directly from the mapping
+		if (pack->mapping && !isDirectory && info.compression_method == 0){
+			fileInPack->offset = FS_PK3DataOffset(pack, unzGetOffset(handle), fileInPack->size);
+			if (fileInPack->offset != -1)
+				fileInPack->isStored = true;
+		}
 
 		// Add to hash table
 		hashKey = Str_HashKey(fileInPack->name, FILES_HASH_SIZE, false);
@@ -1964,6 +3461,7 @@ static void FS_AddGameDirectory (const char *base, const char *game){
 
 	Str_Copy(directory->base, base, sizeof(directory->base));
 	Str_Copy(directory->game, game, sizeof(directory->game));
+	directory->isIndexed = false;
 
 	// Add the directory to the search paths
 	searchPath = (searchPath_t *)Mem_Alloc(sizeof(searchPath_t), TAG_COMMON);
@@ -2037,7 +3535,7 @@ static void FS_ListSearchPaths_f (){
 	searchPath_t	*searchPath;
 	pack_t			*pack;
 	directory_t		*directory;
-	int				totalPacks = 0, totalFiles = 0;
+	int				totalPacks = 0, totalFiles = 0, mappedPacks = 0;
 
 	Com_Printf("Current search paths:\n");
 
@@ -2045,7 +3543,13 @@ static void FS_ListSearchPaths_f (){
 		if (searchPath->pack){
 			pack = searchPath->pack;
 
-			Com_Printf("%s (%i files)\n", pack->path, pack->numFiles);
+			if (pack->mapping){
+				Com_Printf("%s (%i files, mapped)\n", pack->path, pack->numFiles);
+
+				mappedPacks++;
+			}
+			else
+				Com_Printf("%s (%i files)\n", pack->path, pack->numFiles);
 
 			totalPacks++;
 			totalFiles += pack->numFiles;
@@ -2059,6 +3563,10 @@ static void FS_ListSearchPaths_f (){
 
 	Com_Printf("---------------------\n");
 	Com_Printf("%i files in %i PAK/PK3 files\n", totalFiles, totalPacks);
+	Com_Printf("%i PAK/PK3 files mapped, %i files (%i KB) read from mappings\n", mappedPacks, fs_mappedReads, fs_mappedBytes >> 10);
+
+	if (fs_debug->integerValue)
+		Com_Printf("%i files indexed in %i msec, %i hits, %i misses\n", fs_indexFiles, fs_indexBuildTime, fs_indexHits, fs_indexMisses);
 }
 
 /*
@@ -2210,6 +3718,9 @@ static void FS_Startup (){
 	FS_AddGameDirectory(fs_basePath->value, fs_game->value);
 	FS_AddGameDirectory(fs_savePath->value, fs_game->value);
 
+	// Build the file index
+	FS_BuildFileIndex();
+
 	// Set the current game
 	Str_Copy(fs_curGame, fs_game->value, sizeof(fs_curGame));
 
@@ -2258,12 +3769,16 @@ void FS_Init (){
 
 	// Allow command line parameters to override our defaults
 	Com_StartupVariable("fs_debug", true);
+	Com_StartupVariable("fs_mapPacks", true);
+	Com_StartupVariable("fs_asyncThreads", true);
 	Com_StartupVariable("fs_basePath", true);
 	Com_StartupVariable("fs_savePath", true);
 	Com_StartupVariable("fs_game", true);
 
 	// Register variables
 	fs_debug = CVar_Register("fs_debug", "0", CVAR_BOOL, 0, "Print debugging information", 0, 0);
+	fs_mapPacks = CVar_Register("fs_mapPacks", "1", CVAR_BOOL, CVAR_INIT, "Memory-map PAK/PK3 files", 0, 0);
+	fs_asyncThreads = CVar_Register("fs_asyncThreads", Str_VarArgs("%i", ClampInt(Sys_GetProcessorCount() - 1, 1, MAX_ASYNC_THREADS)), CVAR_INTEGER, CVAR_INIT, "Number of threads for asynchronous file reads", 0, MAX_ASYNC_THREADS);
 	fs_basePath = CVar_Register("fs_basePath", Sys_DefaultBaseDirectory(), CVAR_STRING, CVAR_INIT, "Base path", 0, 0);
 	fs_savePath = CVar_Register("fs_savePath", Sys_DefaultSaveDirectory(), CVAR_STRING, CVAR_INIT, "Save path", 0, 0);
 	fs_game = CVar_Register("fs_game", BASE_DIRECTORY, CVAR_STRING, CVAR_SERVERINFO | CVAR_INIT, "Current game directory", 0, 0);
@@ -2276,6 +3791,13 @@ void FS_Init (){
 	Cmd_AddCommand("listMods", FS_ListMods_f, "Lists available game mods", NULL);
 	Cmd_AddCommand("touchFile", FS_TouchFile_f, "Touches a file", NULL);
 
+	// Create the file index and precache locks
+	fs_indexLock = Sys_CreateMutex();
+	fs_precacheLock = Sys_CreateMutex();
+
+	// Start the asynchronous file loading threads
+	FS_InitAsyncReads();
+
 	// Add the directories
 	FS_Startup();
 
@@ -2323,6 +3845,12 @@ void FS_Shutdown (){
 	Cmd_RemoveCommand("listMods");
 	Cmd_RemoveCommand("touchFile");
 
+	// Stop the asynchronous file loading threads
+	FS_ShutdownAsyncReads();
+
+	// Free precached files
+	FS_FlushPrecache();
+
 	// Close all files
 	for (i = 0, file = fs_fileHandles; i < MAX_FILE_HANDLES; i++, file++){
 		if (!file->realFile && !file->zipFile)
@@ -2338,6 +3866,9 @@ void FS_Shutdown (){
 		Mem_Fill(file, 0, sizeof(file_t));
 	}
 
+	// Free the file index
+	FS_ClearFileIndex();
+
 	// Free search paths
 	for (searchPath = fs_searchPaths; searchPath; searchPath = nextSearchPath){
 		nextSearchPath = searchPath->next;
@@ -2348,6 +3879,9 @@ void FS_Shutdown (){
 			else if (searchPath->pack->pk3)
 				unzClose(searchPath->pack->pk3);
 
+			if (searchPath->pack->mapping)
+				Sys_UnmapFile(searchPath->pack->mapping);
+
 			Mem_Free(searchPath->pack->files);
 			Mem_Free(searchPath->pack);
 		}
@@ -2363,6 +3897,16 @@ void FS_Shutdown (){
 	fs_readCount = 0;
 	fs_writeCount = 0;
 
+	fs_mappedReads = 0;
+	fs_mappedBytes = 0;
+
 	// Reset pack files counter
 	fs_packFilesCount = 0;
+
+	// Destroy the file index and precache locks
+	Sys_DestroyMutex(fs_indexLock);
+	Sys_DestroyMutex(fs_precacheLock);
+
+	fs_indexLock = NULL;
+	fs_precacheLock = NULL;
 }
\ No newline at end of file
@@ -57,6 +57,8 @@
 
 #define	MAX_PATH_LENGTH				256			// Max length of a file system path
 
+#define MAX_ASYNC_THREADS			8			// Max number of asynchronous file loading threads
+
 typedef int					fileHandle_t;
 
 typedef enum {
@@ -82,6 +84,24 @@ typedef struct {
 	const char *			description;
 } modList_t;
 
+typedef int					asyncRead_t;
+
+typedef enum {
+	FS_PRIORITY_LOW,							// Streaming and speculative prefetching
+	FS_PRIORITY_NORMAL,
+	FS_PRIORITY_HIGH							// Data needed as soon as possible
+} fsPriority_t;
+
+typedef enum {
+	ASYNC_PENDING,
+	ASYNC_COMPLETE,
+	ASYNC_FAILED
+} asyncStatus_t;
+
+// The buffer is NULL if the file couldn't be read, otherwise it must be freed
+// with FS_FreeFile
+typedef void				(*asyncCallback_t)(const char *name, void *buffer, int size, void *data);
+
 // Reads data from a file, properly handling partial reads.
 // Returns the number of bytes read.
 int				FS_Read (fileHandle_t f, void *buffer, int size);
@@ -142,13 +162,55 @@ findFile_t		FS_FindFile (const char *name, char sourcePath[MAX_PATH_LENGTH]);
 // Appends a trailing 0, so string operations are always safe.
 int				FS_ReadFile (const char *name, void **buffer);
 
-// Frees the memory allocated by FS_ReadFile
+// Like FS_ReadFile, but if the file is stored uncompressed in a memory-mapped
+// pack file, the buffer will point directly into the mapping without copying.
+// The buffer is read-only and is not guaranteed to have a trailing 0.
+int				FS_MapFile (const char *name, const void **buffer);
+
+// Frees the memory allocated by FS_ReadFile or FS_MapFile
 void			FS_FreeFile (const void *buffer);
 
 // Writes a complete file. Will create any needed subdirectories.
 // Returns true if the file was written.
 bool			FS_WriteFile (const char *name, const void *buffer, int size);
 
+// Queues a complete file to be read by a worker thread.
+// Returns a handle to the read, or 0 if the file wasn't found.
+// If a callback is given, it will be called from FS_UpdateAsyncReads when the
+// read is done, and the handle will be released automatically. Otherwise
+// FS_CheckAsyncRead or FS_WaitAsyncRead must be called to get the data and
+// release the handle.
+// The buffer has a trailing 0 like FS_ReadFile, and must be freed with
+// FS_FreeFile.
+asyncRead_t		FS_ReadFileAsync (const char *name, fsPriority_t priority, asyncCallback_t callback, void *data);
+
+// Checks if an asynchronous read is done without blocking.
+// If complete, sets the buffer and size and releases the handle.
+asyncStatus_t	FS_CheckAsyncRead (asyncRead_t handle, void **buffer, int *size);
+
+// Waits for an asynchronous read to be done, then sets the buffer and size and
+// releases the handle.
+// If the read hasn't been started yet, it is done by the calling thread.
+asyncStatus_t	FS_WaitAsyncRead (asyncRead_t handle, void **buffer, int *size);
+
+// Cancels an asynchronous read and releases the handle.
+// Any data already read will be freed.
+void			FS_CancelAsyncRead (asyncRead_t handle);
+
+// Runs the callbacks for all the asynchronous reads that are done.
+// Called once per frame from the main thread.
+void			FS_UpdateAsyncReads ();
+
+// Reads all the given files in parallel and keeps them in memory until they
+// are loaded or FS_FlushPrecache is called, so that loading them later doesn't
+// have to wait for disk access or decompression. The first load of each file
+// gets the precached buffer itself, without copying.
+// Files that are not found are ignored.
+void			FS_PrecacheFiles (const char **names, int numNames);
+
+// Frees all the precached files
+void			FS_FlushPrecache ();
+
 // Extracts the given dynamic library from a pack file and sets the fully
 // qualified path to the extracted file (appending suffix and extension
 // appropriate for the underlying platform).
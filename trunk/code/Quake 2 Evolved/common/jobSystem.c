@@ -0,0 +1,275 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// jobSystem.c - Job system
+//
+
+
+#include "common.h"
+
+
+typedef struct {
+	jobFunction_t			function;
+	void *					data;
+
+	int						count;
+	int						next;				// Next index to claim
+
+	volatile int			remaining;			// Calls that are not done yet
+} jobBatch_t;
+
+static jobBatch_t			job_batch;
+
+static void *				job_runLock;			// Serializes batches started from different threads
+static void *				job_lock;
+static void *				job_wakeEvent;
+static void *				job_doneEvent;
+
+static volatile bool		job_shutdown;
+
+static int					job_numThreads;
+static void *				job_threadHandles[MAX_JOB_THREADS];
+static char					job_threadNames[MAX_JOB_THREADS][32];
+
+static cvar_t *				job_threads;
+
+
+/*
+ ==================
+ Job_Claim
+
+ Claims the next index of the current batch. Returns false if there's nothing
+ left to claim.
+ ==================
+*/
+static bool Job_Claim (jobFunction_t *function, void **data, int *index){
+
+	bool	morePending;
+
+	Sys_LockMutex(job_lock);
+
+	if (job_batch.next >= job_batch.count){
+		Sys_UnlockMutex(job_lock);
+		return false;
+	}
+
+	*function = job_batch.function;
+	*data = job_batch.data;
+	*index = job_batch.next++;
+
+	morePending = (job_batch.next < job_batch.count);
+
+	Sys_UnlockMutex(job_lock);
+
+	// Wake up another thread if there's more work to do
+	if (morePending)
+		Sys_SignalEvent(job_wakeEvent);
+
+	return true;
+}
+
+/*
+ ==================
+ Job_Execute
+
+ Runs claimed jobs until the current batch has nothing left to claim
+ ==================
+*/
+static void Job_Execute (){
+
+	jobFunction_t	function;
+	void			*data;
+	int				index;
+
+	while (Job_Claim(&function, &data, &index)){
+		function(data, index);
+
+		// Signal the main thread if this was the last one
+		if (!Sys_AtomicDecrement(&job_batch.remaining))
+			Sys_SignalEvent(job_doneEvent);
+	}
+}
+
+/*
+ ==================
+ Job_Thread
+ ==================
+*/
+static void Job_Thread (void *data){
+
+	Mem_AttachThread((const char *)data);
+
+	while (1){
+		Sys_WaitEvent(job_wakeEvent, -1);
+
+		if (job_shutdown){
+			// Pass it on to the other threads
+			Sys_SignalEvent(job_wakeEvent);
+			break;
+		}
+
+		Job_Execute();
+	}
+
+	Mem_DetachThread();
+}
+
+/*
+ ==================
+ Job_Run
+ ==================
+*/
+void Job_Run (jobFunction_t function, void *data, int count){
+
+	int		i;
+
+	if (count <= 0)
+		return;
+
+	// If there are no worker threads or a single call, just run it here
+	if (!job_numThreads || count == 1){
+		for (i = 0; i < count; i++)
+			function(data, i);
+
+		return;
+	}
+
+	// Wait for any batch started by another thread
+	Sys_LockMutex(job_runLock);
+
+	// Set up the batch
+	Sys_LockMutex(job_lock);
+
+	job_batch.function = function;
+	job_batch.data = data;
+	job_batch.count = count;
+	job_batch.next = 0;
+	job_batch.remaining = count;
+
+	Sys_UnlockMutex(job_lock);
+
+	// Wake up the worker threads and help them
+	Sys_SignalEvent(job_wakeEvent);
+
+	Job_Execute();
+
+	// Wait for the calls that are still running on the worker threads
+	while (job_batch.remaining)
+		Sys_WaitEvent(job_doneEvent, -1);
+
+	Sys_UnlockMutex(job_runLock);
+}
+
+/*
+ ==================
+ Job_NumThreads
+ ==================
+*/
+int Job_NumThreads (){
+
+	return job_numThreads + 1;
+}
+
+
+/*
+ ==============================================================================
+
+ INITIALIZATION AND SHUTDOWN
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Job_Init
+ ==================
+*/
+void Job_Init (){
+
+	int		i;
+
+	// Allow command line parameters to override our defaults
+	Com_StartupVariable("job_threads", true);
+
+	// Register variables
+	job_threads = CVar_Register("job_threads", Str_VarArgs("%i", ClampInt(Sys_GetProcessorCount() - 1, 0, MAX_JOB_THREADS)), CVAR_INTEGER, CVAR_INIT, "Number of worker threads for parallel jobs", 0, MAX_JOB_THREADS);
+
+	job_runLock = Sys_CreateMutex();
+	job_lock = Sys_CreateMutex();
+
+	job_wakeEvent = Sys_CreateEvent(false);
+	job_doneEvent = Sys_CreateEvent(false);
+
+	job_shutdown = false;
+
+	// Start the worker threads
+	job_numThreads = Mem_ReserveThreads("job", ClampInt(job_threads->integerValue, 0, MAX_JOB_THREADS));
+
+	for (i = 0; i < job_numThreads; i++){
+		Str_SPrintf(job_threadNames[i], sizeof(job_threadNames[i]), "job%i", i);
+
+		job_threadHandles[i] = Sys_CreateThread(Job_Thread, job_threadNames[i], job_threadNames[i]);
+	}
+}
+
+/*
+ ==================
+ Job_Shutdown
+ ==================
+*/
+void Job_Shutdown (){
+
+	int		i;
+
+	if (!job_lock)
+		return;
+
+	// Stop the worker threads
+	job_shutdown = true;
+
+	Sys_SignalEvent(job_wakeEvent);
+
+	for (i = 0; i < job_numThreads; i++){
+		Sys_DestroyThread(job_threadHandles[i]);
+
+		job_threadHandles[i] = NULL;
+	}
+
+	Mem_ReleaseThreads(job_numThreads);
+
+	job_numThreads = 0;
+
+	Sys_DestroyEvent(job_wakeEvent);
+	Sys_DestroyEvent(job_doneEvent);
+
+	Sys_DestroyMutex(job_runLock);
+	Sys_DestroyMutex(job_lock);
+
+	job_wakeEvent = NULL;
+	job_doneEvent = NULL;
+	job_runLock = NULL;
+	job_lock = NULL;
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// jobSystem.h - Job system
+//
+
+
+#ifndef __JOBSYSTEM_H__
+#define __JOBSYSTEM_H__
+
+
+/*
+ ==============================================================================
+
+ Job System:
+
+ The job system keeps a pool of worker threads that can be used to split a
+ batch of independent work items across all the CPU cores.
+
+ A batch is run by calling the given function once for every index in the
+ batch. The calls are spread across the worker threads and the calling thread,
+ and may run in any order, so the function must not depend on the order of the
+ calls or modify any data shared with the other calls without synchronization.
+
+ Job_Run does not return until all the calls are done, so the batch data can
+ live on the stack of the caller.
+
+ Batches can be run from any thread attached to the memory manager, such as
+ the renderer front-end thread. Only one batch runs at a time, so a batch
+ started while another one is running waits for it to finish. Batches can't be
+ nested.
+
+ Worker threads are attached to the memory manager, so jobs can allocate
+ memory, including frame memory.
+
+ ==============================================================================
+*/
+
+#define MAX_JOB_THREADS				8
+
+typedef void			(*jobFunction_t)(void *data, int index);
+
+// Calls the given function for every index from 0 to count - 1, spreading the
+// calls across all the threads. Returns when all the calls are done.
+void			Job_Run (jobFunction_t function, void *data, int count);
+
+// Returns the number of threads that can run jobs, including the main thread
+int				Job_NumThreads ();
+
+// Initializes the job system
+void			Job_Init ();
+
+// Shuts down the job system
+void			Job_Shutdown ();
+
+
+#endif	// __JOBSYSTEM_H__
\ No newline at end of file
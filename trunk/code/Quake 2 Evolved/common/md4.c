@@ -51,7 +51,7 @@
 
 typedef unsigned char *			POINTER;
 typedef unsigned short int		UINT2;
-typedef unsigned long int		UINT4;
+typedef unsigned int			UINT4;
 
 #define S11						3
 #define S12						7
@@ -304,11 +304,11 @@ static void MD4_Final (MD4_CTX *context, byte digest[16]){
  MD4_BlockChecksum
  ==================
 */
-ulong MD4_BlockChecksum (const void *data, int length){
+uint MD4_BlockChecksum (const void *data, int length){
 
 	MD4_CTX	ctx;
-	ulong	digest[4];
-	ulong	val;
+	uint	digest[4];
+	uint	val;
 
 	MD4_Init(&ctx);
 	MD4_Update(&ctx, (byte *)data, length);
@@ -45,6 +45,24 @@
 #define MEDIUM_ZONE_SIZE			(32 << 20)
 #define LARGE_ZONE_SIZE				(512 << 20)
 
+#define SLAB_REGION_SIZE			(8 << 20)
+#define SLAB_PAGE_SIZE				16384
+#define SLAB_PAGES					(SLAB_REGION_SIZE / SLAB_PAGE_SIZE)
+
+#define MAX_SLAB_SIZE				1024
+#define MAX_SLAB_CLASSES			12
+
+#define SLAB_FREE_MARKER			0x65657246626C6153
+
+#define MAX_CACHED_CLASSES			6			// Size classes up to 128 bytes are cached per thread
+#define MAX_CACHED_BLOCKS			16
+#define CACHE_REFILL_BLOCKS			8
+
+#define FRAME_ARENA_SIZE			(2 << 20)
+#define TEMP_ARENA_SIZE				(8 << 20)
+
+#define MAX_MEMORY_THREADS			(MAX_JOB_THREADS + MAX_ASYNC_THREADS + 2)	// Plus the main and renderer front-end threads
+
 #define TINY_BLOCK_SIZE				80			// Upper limit for tiny block fill/copy/compare
 #define IN_CACHE_BLOCK_SIZE			262144		// Upper limit for in-cache block fill/copy
 
@@ -95,15 +113,104 @@ typedef struct {
 	int						allocPeak;
 } memoryHeap_t;
 
+typedef struct slabPage_s {
+	byte					sizeClass;			// Size class index
+	byte					tag;				// Tag identifier (TAG_FREE if unused)
+	short					usedBlocks;			// Number of allocated blocks
+	short					carvedBlocks;		// Number of blocks ever handed out since the page was claimed
+
+	void *					freeList;			// Blocks that have been freed
+
+	struct slabPage_s *		prev;				// Partially used pages of the same class and tag, or free pages
+	struct slabPage_s *		next;
+} slabPage_t;
+
+typedef struct {
+	byte *					base;
+	int						size;
+
+	slabPage_t				pages[SLAB_PAGES];
+
+	slabPage_t *			freePages;
+	slabPage_t *			partialPages[MAX_SLAB_CLASSES][TAG_MAX];
+
+	// Slab statistics
+	int						usedPages;
+	int						allocBlocks;
+	int						allocBytes;
+	int						allocPeak;
+
+	int						classBlocks[MAX_SLAB_CLASSES];
+	int						classPages[MAX_SLAB_CLASSES];
+
+	int						tagBlocks[TAG_MAX];
+	int						tagBytes[TAG_MAX];
+} memorySlab_t;
+
+typedef struct memoryChunk_s {
+	int						size;				// Chunk size (not including this header)
+	int						used;				// Bytes used by allocations
+
+	struct memoryChunk_s *	next;
+} memoryChunk_t;
+
+typedef struct {
+	const char *			name;
+
+	int						size;				// Default chunk size
+
+	memoryChunk_t *			base;				// Permanent chunk
+	memoryChunk_t *			chunks;				// Overflow chunks allocated from the heap
+
+	// Arena statistics
+	int						allocBlocks;
+	int						allocBytes;
+	int						overflowBytes;
+	int						peakBytes;			// High-water mark since last reset
+	int						lastPeakBytes;		// High-water mark before last reset
+	int						maxPeakBytes;		// High-water mark since creation
+	int						numOverflows;
+} memoryArena_t;
+
+typedef struct {
+	bool					inUse;
+
+	char					name[32];
+
+	memoryArena_t			frameArena;
+	memoryArena_t			tempArena;
+
+	int						frameSequence;		// Frame the frame arena was last reset for
+	int						freeSequence[TAG_MAX];	// Mem_FreeAll call the cache and temporary arena were last synced with
+
+	// Small blocks freed by this thread, ready for reuse without locking
+	void *					cachedBlocks[MAX_CACHED_CLASSES][TAG_MAX][MAX_CACHED_BLOCKS];
+	int						numCachedBlocks[MAX_CACHED_CLASSES][TAG_MAX];
+
+	// Thread statistics
+	int						cacheHits;
+	int						cacheMisses;
+} memoryThread_t;
+
 typedef struct {
 	bool					initialized;
 
+	void *					lock;				// Protects the slab region, zones, heap, and global statistics
+
+	memorySlab_t			slab;
+
 	memoryZone_t			smallZone;
 	memoryZone_t			mediumZone;
 	memoryZone_t			largeZone;
 
 	memoryHeap_t			mainHeap;
 
+	memoryThread_t			threads[MAX_MEMORY_THREADS];
+	int						reservedThreads;	// Thread slots promised to the main thread, renderer and thread pools
+
+	volatile int			frameSequence;		// Bumped at the end of every frame
+	volatile int			freeSequence[TAG_MAX];	// Bumped by every Mem_FreeAll call for the tag
+
 	// Global statistics
 	int						totalBlocks;
 	int						totalBytes;
@@ -113,10 +220,18 @@ typedef struct {
 	int						frameAllocBytes;
 	int						frameFreeBlocks;
 	int						frameFreeBytes;
+
+	int						frameLocks;
+	int						frameContentions;
 } memory_t;
 
 static memory_t				mem;
 
+static THREAD_LOCAL memoryThread_t *	mem_thread;
+
+static const int			mem_slabClassSizes[MAX_SLAB_CLASSES] = {16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024};
+static byte					mem_slabClassForSize[(MAX_SLAB_SIZE >> 4) + 1];
+
 static const char *			mem_tagNames[TAG_MAX] = {"free", "client", "server", "common", "collision", "renderer", "sound", "GUI", "temporary"};
 
 static cvar_t *				mem_checkIntegrity;
@@ -737,22 +852,902 @@ static void Mem_HeapStats (memoryHeap_t *heap, int tagBlocks[TAG_MAX], int tagBy
 
 /*
  ==================
- Mem_HeapDump
+ Mem_HeapDump
+ ==================
+*/
+static void Mem_HeapDump (memoryHeap_t *heap, fileHandle_t f){
+
+	memoryBlock_t	*block;
+
+	FS_Printf(f, NEWLINE);
+
+	for (block = heap->blockList.next; block != &heap->blockList; block = block->next)
+		FS_Printf(f, "block: %8p, size: %9i, overhead: %2i, tag: %-10s" NEWLINE, block, block->size, block->overhead, mem_tagNames[block->tag]);
+
+	FS_Printf(f, "---------------------------------------------------------------" NEWLINE);
+	FS_Printf(f, "%.2f MB heap memory in %i blocks" NEWLINE, heap->allocBytes * (1.0f / 1048576.0f), heap->allocBlocks);
+	FS_Printf(f, "%i KB heap memory overhead" NEWLINE, heap->allocOverhead >> 10);
+	FS_Printf(f, NEWLINE);
+}
+
+
+/*
+ ==============================================================================
+
+ SLAB MEMORY ALLOCATOR
+
+ Small blocks are allocated from segregated size classes. Every page in the
+ slab region holds blocks of a single size class and a single tag, so the
+ blocks don't need a header, allocation and freeing are constant time, and
+ all the pages with a given tag can be released at once.
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Mem_SlabCreate
+ ==================
+*/
+static void Mem_SlabCreate (memorySlab_t *slab, int size){
+
+	slabPage_t	*page;
+	int			i, j;
+
+	// Build the size class lookup table
+	for (i = 0, j = 0; i <= (MAX_SLAB_SIZE >> 4); i++){
+		while (mem_slabClassSizes[j] < (i << 4))
+			j++;
+
+		mem_slabClassForSize[i] = j;
+	}
+
+	// Allocate the slab region, aligned on a page boundary
+	slab->base = (byte *)malloc(size + SLAB_PAGE_SIZE);
+	if (!slab->base)
+		Com_Error(ERR_FATAL, "Failed to allocate %i MB for slab region", size >> 20);
+
+	slab->size = size;
+
+	// Set all the pages as free
+	slab->freePages = NULL;
+
+	for (i = SLAB_PAGES - 1, page = &slab->pages[SLAB_PAGES - 1]; i >= 0; i--, page--){
+		page->sizeClass = 0;
+		page->tag = TAG_FREE;
+		page->usedBlocks = 0;
+		page->carvedBlocks = 0;
+		page->freeList = NULL;
+		page->prev = NULL;
+		page->next = slab->freePages;
+
+		if (slab->freePages)
+			slab->freePages->prev = page;
+
+		slab->freePages = page;
+	}
+
+	Mem_Fill(slab->partialPages, 0, sizeof(slab->partialPages));
+
+	slab->usedPages = 0;
+	slab->allocBlocks = 0;
+	slab->allocBytes = 0;
+	slab->allocPeak = 0;
+
+	Mem_Fill(slab->classBlocks, 0, sizeof(slab->classBlocks));
+	Mem_Fill(slab->classPages, 0, sizeof(slab->classPages));
+	Mem_Fill(slab->tagBlocks, 0, sizeof(slab->tagBlocks));
+	Mem_Fill(slab->tagBytes, 0, sizeof(slab->tagBytes));
+}
+
+/*
+ ==================
+ Mem_SlabDestroy
+ ==================
+*/
+static void Mem_SlabDestroy (memorySlab_t *slab){
+
+	if (!slab->base)
+		return;
+
+	// Free all the memory
+	free(slab->base);
+	slab->base = NULL;
+}
+
+/*
+ ==================
+ Mem_SlabPageData
+ ==================
+*/
+static byte *Mem_SlabPageData (memorySlab_t *slab, const slabPage_t *page){
+
+	byte	*base;
+
+	base = (byte *)ALIGN((size_t)slab->base, SLAB_PAGE_SIZE);
+
+	return base + (page - slab->pages) * SLAB_PAGE_SIZE;
+}
+
+/*
+ ==================
+ Mem_SlabPageForPointer
+
+ Returns NULL if the given pointer was not allocated from the slab region
+ ==================
+*/
+static slabPage_t *Mem_SlabPageForPointer (memorySlab_t *slab, const void *ptr){
+
+	byte	*base;
+	int		offset;
+
+	if (!slab->base)
+		return NULL;
+
+	base = (byte *)ALIGN((size_t)slab->base, SLAB_PAGE_SIZE);
+
+	if ((const byte *)ptr < base || (const byte *)ptr >= base + slab->size)
+		return NULL;
+
+	offset = (const byte *)ptr - base;
+
+	return &slab->pages[offset / SLAB_PAGE_SIZE];
+}
+
+/*
+ ==================
+ Mem_SlabUnlinkPage
+ ==================
+*/
+static void Mem_SlabUnlinkPage (slabPage_t **list, slabPage_t *page){
+
+	if (page->prev)
+		page->prev->next = page->next;
+	else
+		*list = page->next;
+
+	if (page->next)
+		page->next->prev = page->prev;
+
+	page->prev = NULL;
+	page->next = NULL;
+}
+
+/*
+ ==================
+ Mem_SlabLinkPage
+ ==================
+*/
+static void Mem_SlabLinkPage (slabPage_t **list, slabPage_t *page){
+
+	page->prev = NULL;
+	page->next = *list;
+
+	if (*list)
+		(*list)->prev = page;
+
+	*list = page;
+}
+
+/*
+ ==================
+ Mem_SlabReleasePage
+ ==================
+*/
+static void Mem_SlabReleasePage (memorySlab_t *slab, slabPage_t *page){
+
+	slab->classPages[page->sizeClass]--;
+	slab->usedPages--;
+
+	page->tag = TAG_FREE;
+	page->usedBlocks = 0;
+	page->carvedBlocks = 0;
+	page->freeList = NULL;
+
+	Mem_SlabLinkPage(&slab->freePages, page);
+}
+
+/*
+ ==================
+ Mem_SlabCheck
+ ==================
+*/
+static void Mem_SlabCheck (memorySlab_t *slab){
+
+	slabPage_t	*page;
+	void		*block;
+	int			capacity, freeBlocks;
+	int			i;
+
+	for (i = 0, page = slab->pages; i < SLAB_PAGES; i++, page++){
+		if (page->tag == TAG_FREE)
+			continue;
+
+		if (page->tag >= TAG_MAX)
+			Com_Error(ERR_FATAL, "Page has invalid tag (slab)");
+
+		if (page->sizeClass >= MAX_SLAB_CLASSES)
+			Com_Error(ERR_FATAL, "Page has invalid size class (slab)");
+
+		capacity = SLAB_PAGE_SIZE / mem_slabClassSizes[page->sizeClass];
+
+		if (page->usedBlocks < 0 || page->usedBlocks > page->carvedBlocks || page->carvedBlocks > capacity)
+			Com_Error(ERR_FATAL, "Page has invalid block count (slab)");
+
+		freeBlocks = 0;
+
+		for (block = page->freeList; block; block = *(void **)block){
+			if (Mem_SlabPageForPointer(slab, block) != page)
+				Com_Error(ERR_FATAL, "Free block points outside its page (slab)");
+
+			freeBlocks++;
+		}
+
+		if (page->usedBlocks + freeBlocks != page->carvedBlocks)
+			Com_Error(ERR_FATAL, "Page free list does not match block count (slab)");
+	}
+}
+
+/*
+ ==================
+ Mem_SlabAlloc
+
+ Returns NULL if the slab region is full
+ ==================
+*/
+static void *Mem_SlabAlloc (memorySlab_t *slab, int size, memoryTag_t tag){
+
+	slabPage_t	*page;
+	byte		*blockPtr;
+	int			sizeClass, classSize;
+
+	sizeClass = mem_slabClassForSize[(size + 15) >> 4];
+	classSize = mem_slabClassSizes[sizeClass];
+
+	// Get a partially used page of this size class and tag, or claim a free
+	// page
+	page = slab->partialPages[sizeClass][tag];
+
+	if (!page){
+		page = slab->freePages;
+		if (!page){
+			Com_DPrintf(S_COLOR_RED "Failed on allocation of %i bytes from the slab region\n", size);
+
+			return NULL;
+		}
+
+		Mem_SlabUnlinkPage(&slab->freePages, page);
+		Mem_SlabLinkPage(&slab->partialPages[sizeClass][tag], page);
+
+		page->sizeClass = sizeClass;
+		page->tag = tag;
+		page->usedBlocks = 0;
+		page->carvedBlocks = 0;
+		page->freeList = NULL;
+
+		slab->classPages[sizeClass]++;
+		slab->usedPages++;
+	}
+
+	// Take a block from the free list, or carve a new one from the unused end
+	// of the page
+	if (page->freeList){
+		blockPtr = (byte *)page->freeList;
+		page->freeList = *(void **)blockPtr;
+
+#ifdef DEBUG_MEMORY
+
+		if (*(const qword *)(blockPtr + 8) != SLAB_FREE_MARKER)
+			Com_Error(ERR_FATAL, "Free slab block trashed");
+
+		*(qword *)(blockPtr + 8) = 0;
+
+#endif
+	}
+	else {
+		blockPtr = Mem_SlabPageData(slab, page) + page->carvedBlocks * classSize;
+		page->carvedBlocks++;
+	}
+
+	page->usedBlocks++;
+
+	// If the page is now full, take it off the partial list
+	if (!page->freeList && page->carvedBlocks == SLAB_PAGE_SIZE / classSize)
+		Mem_SlabUnlinkPage(&slab->partialPages[sizeClass][tag], page);
+
+	// Update slab statistics
+	slab->allocBlocks++;
+	slab->allocBytes += classSize;
+
+	if (slab->allocBytes > slab->allocPeak)
+		slab->allocPeak = slab->allocBytes;
+
+	slab->classBlocks[sizeClass]++;
+
+	slab->tagBlocks[tag]++;
+	slab->tagBytes[tag] += classSize;
+
+	// Update global statistics
+	mem.totalBlocks++;
+	mem.totalBytes += classSize;
+
+	mem.frameAllocBlocks++;
+	mem.frameAllocBytes += classSize;
+
+	// Development tool
+	if (mem_checkIntegrity){
+		if (mem_checkIntegrity->integerValue == 1 || mem_checkIntegrity->integerValue == 3)
+			Mem_SlabCheck(slab);
+	}
+
+	return (void *)blockPtr;
+}
+
+/*
+ ==================
+ Mem_SlabFree
+ ==================
+*/
+static void Mem_SlabFree (memorySlab_t *slab, slabPage_t *page, void *ptr){
+
+	int		sizeClass, classSize;
+
+	if (page->tag == TAG_FREE || !page->usedBlocks)
+		Com_Error(ERR_FATAL, "Mem_Free: tried to free a freed block");
+
+	sizeClass = page->sizeClass;
+	classSize = mem_slabClassSizes[sizeClass];
+
+	if ((byte *)ptr - Mem_SlabPageData(slab, page) >= page->carvedBlocks * classSize || ((byte *)ptr - Mem_SlabPageData(slab, page)) % classSize)
+		Com_Error(ERR_FATAL, "Mem_Free: invalid slab block");
+
+#ifdef DEBUG_MEMORY
+
+	if (*(const qword *)((const byte *)ptr + 8) == SLAB_FREE_MARKER)
+		Com_Error(ERR_FATAL, "Mem_Free: tried to free a freed block");
+
+	*(qword *)((byte *)ptr + 8) = SLAB_FREE_MARKER;
+
+#endif
+
+	// Update slab statistics
+	slab->allocBlocks--;
+	slab->allocBytes -= classSize;
+
+	slab->classBlocks[sizeClass]--;
+
+	slab->tagBlocks[page->tag]--;
+	slab->tagBytes[page->tag] -= classSize;
+
+	// Update global statistics
+	mem.totalBlocks--;
+	mem.totalBytes -= classSize;
+
+	mem.frameFreeBlocks++;
+	mem.frameFreeBytes += classSize;
+
+	// If the page was full, put it back on the partial list
+	if (!page->freeList && page->carvedBlocks == SLAB_PAGE_SIZE / classSize)
+		Mem_SlabLinkPage(&slab->partialPages[sizeClass][page->tag], page);
+
+	// Add the block to the free list
+	*(void **)ptr = page->freeList;
+	page->freeList = ptr;
+
+	page->usedBlocks--;
+
+	// If the page is now empty, release it
+	if (!page->usedBlocks){
+		Mem_SlabUnlinkPage(&slab->partialPages[sizeClass][page->tag], page);
+		Mem_SlabReleasePage(slab, page);
+	}
+
+	// Development tool
+	if (mem_checkIntegrity){
+		if (mem_checkIntegrity->integerValue == 2 || mem_checkIntegrity->integerValue == 3)
+			Mem_SlabCheck(slab);
+	}
+}
+
+/*
+ ==================
+ Mem_SlabFreeAll
+ ==================
+*/
+static int Mem_SlabFreeAll (memorySlab_t *slab, memoryTag_t tag){
+
+	slabPage_t	*page;
+	int			sizeClass, classSize;
+	int			bytes = 0;
+	int			i;
+
+	for (i = 0, page = slab->pages; i < SLAB_PAGES; i++, page++){
+		if (page->tag != tag)
+			continue;
+
+		sizeClass = page->sizeClass;
+		classSize = mem_slabClassSizes[sizeClass];
+
+		bytes += page->usedBlocks * classSize;
+
+		// Update slab statistics
+		slab->allocBlocks -= page->usedBlocks;
+		slab->allocBytes -= page->usedBlocks * classSize;
+
+		slab->classBlocks[sizeClass] -= page->usedBlocks;
+
+		slab->tagBlocks[tag] -= page->usedBlocks;
+		slab->tagBytes[tag] -= page->usedBlocks * classSize;
+
+		// Update global statistics
+		mem.totalBlocks -= page->usedBlocks;
+		mem.totalBytes -= page->usedBlocks * classSize;
+
+		mem.frameFreeBlocks += page->usedBlocks;
+		mem.frameFreeBytes += page->usedBlocks * classSize;
+
+		// Release the whole page at once
+		if (page->freeList || page->carvedBlocks != SLAB_PAGE_SIZE / classSize)
+			Mem_SlabUnlinkPage(&slab->partialPages[sizeClass][tag], page);
+
+		Mem_SlabReleasePage(slab, page);
+	}
+
+	return bytes;
+}
+
+/*
+ ==================
+ Mem_SlabStats
+ ==================
+*/
+static void Mem_SlabStats (memorySlab_t *slab, int tagBlocks[TAG_MAX], int tagBytes[TAG_MAX]){
+
+	int		capacity;
+	int		i;
+
+	for (i = 0; i < TAG_MAX; i++){
+		tagBlocks[i] += slab->tagBlocks[i];
+		tagBytes[i] += slab->tagBytes[i];
+	}
+
+	// Print slab statistics
+	Com_Printf("\n");
+	Com_Printf("%6.2f MB total slab region:\n", slab->size * (1.0f / 1048576.0f));
+	Com_Printf("--------------------------------------------------------------\n");
+	Com_Printf("    %9i bytes (%6.2f MB) in %5i allocated blocks\n", slab->allocBytes, slab->allocBytes * (1.0f / 1048576.0f), slab->allocBlocks);
+	Com_Printf("    %9i pages used out of %i\n", slab->usedPages, SLAB_PAGES);
+	Com_Printf("\n");
+
+	for (i = 0; i < MAX_SLAB_CLASSES; i++){
+		if (!slab->classPages[i])
+			continue;
+
+		capacity = slab->classPages[i] * (SLAB_PAGE_SIZE / mem_slabClassSizes[i]);
+
+		Com_Printf("    %4i bytes: %6i blocks in %4i pages (%3i%% used)\n", mem_slabClassSizes[i], slab->classBlocks[i], slab->classPages[i], slab->classBlocks[i] * 100 / capacity);
+	}
+
+	Com_Printf("\n");
+	Com_Printf("    %9.2f MB peak usage\n", slab->allocPeak * (1.0f / 1048576.0f));
+	Com_Printf("\n");
+}
+
+/*
+ ==================
+ Mem_SlabDump
+ ==================
+*/
+static void Mem_SlabDump (memorySlab_t *slab, fileHandle_t f){
+
+	slabPage_t	*page;
+	int			i;
+
+	FS_Printf(f, NEWLINE);
+
+	for (i = 0, page = slab->pages; i < SLAB_PAGES; i++, page++){
+		if (page->tag == TAG_FREE)
+			continue;
+
+		FS_Printf(f, "page: %8p, class: %4i, blocks: %4i, tag: %-10s" NEWLINE, Mem_SlabPageData(slab, page), mem_slabClassSizes[page->sizeClass], page->usedBlocks, mem_tagNames[page->tag]);
+	}
+
+	FS_Printf(f, "---------------------------------------------------------------" NEWLINE);
+	FS_Printf(f, "%.2f MB slab memory in %i blocks" NEWLINE, slab->allocBytes * (1.0f / 1048576.0f), slab->allocBlocks);
+	FS_Printf(f, "%i slab pages in use" NEWLINE, slab->usedPages);
+	FS_Printf(f, NEWLINE);
+}
+
+
+/*
+ ==============================================================================
+
+ LOCKING AND THREAD CACHES
+
+ The slab region, zones, and heap are shared by all threads and protected by
+ a single lock. To avoid serializing on that lock, every attached thread
+ keeps a small cache of recently freed blocks for the hottest size classes,
+ which is refilled and drained in batches.
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Mem_Lock
+ ==================
+*/
+static void Mem_Lock (){
+
+	if (!mem.lock)
+		return;
+
+	if (!Sys_TryLockMutex(mem.lock)){
+		Sys_LockMutex(mem.lock);
+
+		mem.frameContentions++;
+	}
+
+	mem.frameLocks++;
+}
+
+/*
+ ==================
+ Mem_Unlock
+ ==================
+*/
+static void Mem_Unlock (){
+
+	if (!mem.lock)
+		return;
+
+	Sys_UnlockMutex(mem.lock);
+}
+
+/*
+ ==================
+ Mem_FlushCachedBlocks
+
+ Returns the cached blocks of the given size class and tag to the slab region,
+ leaving only the given number of blocks in the cache.
+ Must be called with the lock held.
+ ==================
+*/
+static void Mem_FlushCachedBlocks (memoryThread_t *thread, int sizeClass, memoryTag_t tag, int keep){
+
+	void	*ptr;
+	int		i;
+
+	for (i = keep; i < thread->numCachedBlocks[sizeClass][tag]; i++){
+		ptr = thread->cachedBlocks[sizeClass][tag][i];
+
+#ifdef DEBUG_MEMORY
+
+		// Clear the free marker set when the block was cached
+		*(qword *)((byte *)ptr + 8) = 0;
+
+#endif
+
+		Mem_SlabFree(&mem.slab, Mem_SlabPageForPointer(&mem.slab, ptr), ptr);
+	}
+
+	if (thread->numCachedBlocks[sizeClass][tag] > keep)
+		thread->numCachedBlocks[sizeClass][tag] = keep;
+}
+
+/*
+ ==================
+ Mem_SyncCachedBlocks
+
+ Forgets the cached blocks of the given tag if another thread freed all memory
+ with that tag since the cache was last used. The blocks were already released
+ along with their slab pages, so they must not be flushed.
+ Returns true if the cache was stale.
+ ==================
+*/
+static bool Mem_SyncCachedBlocks (memoryThread_t *thread, memoryTag_t tag){
+
+	int		i;
+
+	if (thread->freeSequence[tag] == mem.freeSequence[tag])
+		return false;
+
+	thread->freeSequence[tag] = mem.freeSequence[tag];
+
+	for (i = 0; i < MAX_CACHED_CLASSES; i++)
+		thread->numCachedBlocks[i][tag] = 0;
+
+	return true;
+}
+
+/*
+ ==================
+ Mem_SmallAlloc
+
+ Returns NULL if the slab region is full
+ ==================
+*/
+static void *Mem_SmallAlloc (int size, memoryTag_t tag){
+
+	memoryThread_t	*thread = mem_thread;
+	void			*ptr;
+	int				sizeClass, classSize;
+	int				count;
+
+	sizeClass = mem_slabClassForSize[(size + 15) >> 4];
+	classSize = mem_slabClassSizes[sizeClass];
+
+	if (!thread || sizeClass >= MAX_CACHED_CLASSES){
+		Mem_Lock();
+		ptr = Mem_SlabAlloc(&mem.slab, size, tag);
+		Mem_Unlock();
+
+		return ptr;
+	}
+
+	Mem_SyncCachedBlocks(thread, tag);
+
+	// Try the cache of the calling thread first
+	count = thread->numCachedBlocks[sizeClass][tag];
+
+	if (count)
+		thread->cacheHits++;
+	else {
+		thread->cacheMisses++;
+
+		// Refill the cache with a batch of blocks
+		Mem_Lock();
+
+		for ( ; count < CACHE_REFILL_BLOCKS; count++){
+			ptr = Mem_SlabAlloc(&mem.slab, classSize, tag);
+			if (!ptr)
+				break;
+
+			thread->cachedBlocks[sizeClass][tag][count] = ptr;
+		}
+
+		Mem_Unlock();
+
+		if (!count)
+			return NULL;
+	}
+
+	ptr = thread->cachedBlocks[sizeClass][tag][--count];
+	thread->numCachedBlocks[sizeClass][tag] = count;
+
+#ifdef DEBUG_MEMORY
+
+	// Clear the free marker
+	*(qword *)((byte *)ptr + 8) = 0;
+
+#endif
+
+	return ptr;
+}
+
+/*
+ ==================
+ Mem_SmallFree
+ ==================
+*/
+static void Mem_SmallFree (slabPage_t *page, void *ptr){
+
+	memoryThread_t	*thread = mem_thread;
+	memoryTag_t		tag;
+	int				sizeClass;
+	int				count;
+
+	sizeClass = page->sizeClass;
+	tag = (memoryTag_t)page->tag;
+
+	if (!thread || sizeClass >= MAX_CACHED_CLASSES || tag == TAG_FREE){
+		Mem_Lock();
+		Mem_SlabFree(&mem.slab, page, ptr);
+		Mem_Unlock();
+
+		return;
+	}
+
+	Mem_SyncCachedBlocks(thread, tag);
+
+#ifdef DEBUG_MEMORY
+
+	if (*(const qword *)((const byte *)ptr + 8) == SLAB_FREE_MARKER)
+		Com_Error(ERR_FATAL, "Mem_Free: tried to free a freed block");
+
+	*(qword *)((byte *)ptr + 8) = SLAB_FREE_MARKER;
+
+#endif
+
+	// If the cache is full, return half of it to the slab region
+	if (thread->numCachedBlocks[sizeClass][tag] == MAX_CACHED_BLOCKS){
+		Mem_Lock();
+		Mem_FlushCachedBlocks(thread, sizeClass, tag, MAX_CACHED_BLOCKS >> 1);
+		Mem_Unlock();
+	}
+
+	// Add the block to the cache
+	count = thread->numCachedBlocks[sizeClass][tag];
+
+	thread->cachedBlocks[sizeClass][tag][count] = ptr;
+	thread->numCachedBlocks[sizeClass][tag] = count + 1;
+}
+
+
+/*
+ ==============================================================================
+
+ ARENA MEMORY ALLOCATOR
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Mem_ArenaCreateChunk
+ ==================
+*/
+static memoryChunk_t *Mem_ArenaCreateChunk (memoryArena_t *arena, int size){
+
+	memoryChunk_t	*chunk;
+
+	// Allocate the chunk, with some extra space to align the data on a 16-byte
+	// boundary
+	chunk = (memoryChunk_t *)malloc(ALIGN(sizeof(memoryChunk_t), 16) + size + 16);
+	if (!chunk)
+		Com_Error(ERR_FATAL, "Failed to allocate %i KB for %s arena", size >> 10, arena->name);
+
+	chunk->size = size;
+	chunk->used = 0;
+	chunk->next = NULL;
+
+	return chunk;
+}
+
+/*
+ ==================
+ Mem_ArenaCreate
+ ==================
+*/
+static void Mem_ArenaCreate (memoryArena_t *arena, const char *name, int size){
+
+	arena->name = name;
+	arena->size = size;
+	arena->base = NULL;
+	arena->chunks = NULL;
+	arena->allocBlocks = 0;
+	arena->allocBytes = 0;
+	arena->overflowBytes = 0;
+	arena->peakBytes = 0;
+	arena->lastPeakBytes = 0;
+	arena->maxPeakBytes = 0;
+	arena->numOverflows = 0;
+
+	// Allocate the permanent chunk
+	arena->base = Mem_ArenaCreateChunk(arena, size);
+}
+
+/*
+ ==================
+ Mem_ArenaReset
+ ==================
+*/
+static void Mem_ArenaReset (memoryArena_t *arena){
+
+	memoryChunk_t	*chunk, *next;
+
+	if (!arena->base)
+		return;
+
+	// Free all the overflow chunks
+	for (chunk = arena->chunks; chunk; chunk = next){
+		next = chunk->next;
+
+		free(chunk);
+	}
+
+	arena->chunks = NULL;
+
+	// Rewind the permanent chunk
+	arena->base->used = 0;
+
+	// Update arena statistics
+	arena->lastPeakBytes = arena->peakBytes;
+
+	arena->allocBlocks = 0;
+	arena->allocBytes = 0;
+	arena->overflowBytes = 0;
+	arena->peakBytes = 0;
+}
+
+/*
+ ==================
+ Mem_ArenaDestroy
+ ==================
+*/
+static void Mem_ArenaDestroy (memoryArena_t *arena){
+
+	if (!arena->base)
+		return;
+
+	// Free all the memory
+	Mem_ArenaReset(arena);
+
+	free(arena->base);
+	arena->base = NULL;
+}
+
+/*
+ ==================
+ Mem_ArenaAlloc
+ ==================
+*/
+static void *Mem_ArenaAlloc (memoryArena_t *arena, int size){
+
+	memoryChunk_t	*chunk;
+	byte			*blockPtr;
+	int				allocSize;
+
+	// Align to 16-byte boundary
+	allocSize = ALIGN(size, 16);
+
+	// If the current chunk is full, allocate an overflow chunk from the heap.
+	// It will be freed when the arena is reset.
+	chunk = (arena->chunks) ? arena->chunks : arena->base;
+
+	if (chunk->used + allocSize > chunk->size){
+		chunk = Mem_ArenaCreateChunk(arena, Max(allocSize, arena->size));
+
+		chunk->next = arena->chunks;
+		arena->chunks = chunk;
+
+		arena->overflowBytes += chunk->size;
+		arena->numOverflows++;
+	}
+
+	// Get the pointer
+	blockPtr = (byte *)chunk + ALIGN(sizeof(memoryChunk_t), 16);
+	blockPtr = (byte *)ALIGN((size_t)blockPtr, 16) + chunk->used;
+
+	chunk->used += allocSize;
+
+	// Update arena statistics
+	arena->allocBlocks++;
+	arena->allocBytes += allocSize;
+
+	if (arena->allocBytes > arena->peakBytes)
+		arena->peakBytes = arena->allocBytes;
+
+	if (arena->allocBytes > arena->maxPeakBytes)
+		arena->maxPeakBytes = arena->allocBytes;
+
+	return (void *)blockPtr;
+}
+
+/*
+ ==================
+ Mem_ArenaStats
+ ==================
+*/
+static void Mem_ArenaStats (const char *threadName, memoryArena_t *arena){
+
+	Com_Printf("%-12s %-9s %7i KB %7i KB %7i KB %7i KB %5i\n", threadName, arena->name, arena->size >> 10, arena->lastPeakBytes >> 10, arena->maxPeakBytes >> 10, arena->allocBytes >> 10, arena->numOverflows);
+}
+
+/*
+ ==================
+ Mem_GetThread
  ==================
 */
-static void Mem_HeapDump (memoryHeap_t *heap, fileHandle_t f){
-
-	memoryBlock_t	*block;
+static memoryThread_t *Mem_GetThread (){
 
-	FS_Printf(f, NEWLINE);
-
-	for (block = heap->blockList.next; block != &heap->blockList; block = block->next)
-		FS_Printf(f, "block: %8p, size: %9i, overhead: %2i, tag: %-10s" NEWLINE, block, block->size, block->overhead, mem_tagNames[block->tag]);
+	if (!mem_thread)
+		Com_Error(ERR_FATAL, "Mem_GetThread: no arenas bound to the calling thread");
 
-	FS_Printf(f, "---------------------------------------------------------------" NEWLINE);
-	FS_Printf(f, "%.2f MB heap memory in %i blocks" NEWLINE, heap->allocBytes * (1.0f / 1048576.0f), heap->allocBlocks);
-	FS_Printf(f, "%i KB heap memory overhead" NEWLINE, heap->allocOverhead >> 10);
-	FS_Printf(f, NEWLINE);
+	return mem_thread;
 }
 
 
@@ -781,9 +1776,18 @@ void *Mem_Alloc (int size, memoryTag_t tag){
 	if (tag <= TAG_FREE || tag >= TAG_MAX)
 		Com_Error(ERR_FATAL, "Mem_Alloc: bad tag (%i)", tag);
 
+	// Small blocks are allocated from the slab region if possible
+	if (tag != TAG_TEMPORARY && size <= MAX_SLAB_SIZE){
+		blockPtr = (byte *)Mem_SmallAlloc(size, tag);
+		if (blockPtr)
+			return (void *)blockPtr;
+	}
+
 	// If a temporary allocation, allocate it directly from the heap.
 	// Otherwise try to allocate it from a zone selected depending on the
 	// requested size.
+	Mem_Lock();
+
 	if (tag == TAG_TEMPORARY)
 		block = Mem_HeapAlloc(&mem.mainHeap, size, tag, false);
 	else {
@@ -800,6 +1804,8 @@ void *Mem_Alloc (int size, memoryTag_t tag){
 			block = Mem_HeapAlloc(&mem.mainHeap, size, tag, false);
 	}
 
+	Mem_Unlock();
+
 	if (!block)
 		Com_Error(ERR_FATAL, "Mem_Alloc: failed on allocation of %i bytes", size);
 
@@ -845,9 +1851,18 @@ void *Mem_Alloc16 (int size, memoryTag_t tag){
 	if (tag <= TAG_FREE || tag >= TAG_MAX)
 		Com_Error(ERR_FATAL, "Mem_Alloc16: bad tag (%i)", tag);
 
+	// Small blocks are allocated from the slab region if possible
+	if (tag != TAG_TEMPORARY && size <= MAX_SLAB_SIZE){
+		blockPtr = (byte *)Mem_SmallAlloc(size, tag);
+		if (blockPtr)
+			return (void *)blockPtr;
+	}
+
 	// If a temporary allocation, allocate it directly from the heap.
 	// Otherwise try to allocate it from a zone selected depending on the
 	// requested size.
+	Mem_Lock();
+
 	if (tag == TAG_TEMPORARY)
 		block = Mem_HeapAlloc(&mem.mainHeap, size, tag, true);
 	else {
@@ -864,6 +1879,8 @@ void *Mem_Alloc16 (int size, memoryTag_t tag){
 			block = Mem_HeapAlloc(&mem.mainHeap, size, tag, true);
 	}
 
+	Mem_Unlock();
+
 	if (!block)
 		Com_Error(ERR_FATAL, "Mem_Alloc16: failed on allocation of %i bytes", size);
 
@@ -888,7 +1905,7 @@ void *Mem_Alloc16 (int size, memoryTag_t tag){
 #endif
 
 	// Align on a 16-byte boundary if needed
-	if (((dword)blockPtr) & 15){
+	if (((size_t)blockPtr) & 15){
 		*(qword *)blockPtr = BLOCK_PADDING;
 
 		// Skip over the padding
@@ -914,9 +1931,22 @@ void *Mem_ClearedAlloc (int size, memoryTag_t tag){
 	if (tag <= TAG_FREE || tag >= TAG_MAX)
 		Com_Error(ERR_FATAL, "Mem_ClearedAlloc: bad tag (%i)", tag);
 
+	// Small blocks are allocated from the slab region if possible
+	if (tag != TAG_TEMPORARY && size <= MAX_SLAB_SIZE){
+		blockPtr = (byte *)Mem_SmallAlloc(size, tag);
+
+		if (blockPtr){
+			Mem_Fill(blockPtr, 0, size);
+
+			return (void *)blockPtr;
+		}
+	}
+
 	// If a temporary allocation, allocate it directly from the heap.
 	// Otherwise try to allocate it from a zone selected depending on the
 	// requested size.
+	Mem_Lock();
+
 	if (tag == TAG_TEMPORARY)
 		block = Mem_HeapAlloc(&mem.mainHeap, size, tag, false);
 	else {
@@ -933,6 +1963,8 @@ void *Mem_ClearedAlloc (int size, memoryTag_t tag){
 			block = Mem_HeapAlloc(&mem.mainHeap, size, tag, false);
 	}
 
+	Mem_Unlock();
+
 	if (!block)
 		Com_Error(ERR_FATAL, "Mem_ClearedAlloc: failed on allocation of %i bytes", size);
 
@@ -981,9 +2013,22 @@ void *Mem_ClearedAlloc16 (int size, memoryTag_t tag){
 	if (tag <= TAG_FREE || tag >= TAG_MAX)
 		Com_Error(ERR_FATAL, "Mem_ClearedAlloc16: bad tag (%i)", tag);
 
+	// Small blocks are allocated from the slab region if possible
+	if (tag != TAG_TEMPORARY && size <= MAX_SLAB_SIZE){
+		blockPtr = (byte *)Mem_SmallAlloc(size, tag);
+
+		if (blockPtr){
+			Mem_Fill(blockPtr, 0, size);
+
+			return (void *)blockPtr;
+		}
+	}
+
 	// If a temporary allocation, allocate it directly from the heap.
 	// Otherwise try to allocate it from a zone selected depending on the
 	// requested size.
+	Mem_Lock();
+
 	if (tag == TAG_TEMPORARY)
 		block = Mem_HeapAlloc(&mem.mainHeap, size, tag, true);
 	else {
@@ -1000,6 +2045,8 @@ void *Mem_ClearedAlloc16 (int size, memoryTag_t tag){
 			block = Mem_HeapAlloc(&mem.mainHeap, size, tag, true);
 	}
 
+	Mem_Unlock();
+
 	if (!block)
 		Com_Error(ERR_FATAL, "Mem_ClearedAlloc16: failed on allocation of %i bytes", size);
 
@@ -1024,7 +2071,7 @@ void *Mem_ClearedAlloc16 (int size, memoryTag_t tag){
 #endif
 
 	// Align on a 16-byte boundary if needed
-	if (((dword)blockPtr) & 15){
+	if (((size_t)blockPtr) & 15){
 		*(qword *)blockPtr = BLOCK_PADDING;
 
 		// Skip over the padding
@@ -1045,11 +2092,19 @@ void *Mem_ClearedAlloc16 (int size, memoryTag_t tag){
 void Mem_Free (const void *ptr){
 
 	memoryBlock_t	*block;
+	slabPage_t		*page;
 	const byte		*blockPtr;
 
 	if (!ptr)
 		Com_Error(ERR_FATAL, "Mem_Free: NULL pointer");
 
+	// Check if allocated from the slab region
+	page = Mem_SlabPageForPointer(&mem.slab, ptr);
+	if (page){
+		Mem_SmallFree(page, (void *)ptr);
+		return;
+	}
+
 	blockPtr = (const byte *)ptr;
 
 	// Back up over any padding
@@ -1082,6 +2137,8 @@ void Mem_Free (const void *ptr){
 #endif
 
 	// Free
+	Mem_Lock();
+
 	switch (block->allocator){
 	case ALLOC_SMALL_ZONE:
 		Mem_ZoneFree(&mem.smallZone, block);
@@ -1098,6 +2155,8 @@ void Mem_Free (const void *ptr){
 	default:
 		Com_Error(ERR_FATAL, "Mem_Free: block has invalid allocator");
 	}
+
+	Mem_Unlock();
 }
 
 /*
@@ -1107,7 +2166,43 @@ void Mem_Free (const void *ptr){
 */
 void Mem_FreeAll (memoryTag_t tag, bool reportLeaks){
 
-	int		totalBytes = 0;
+	memoryThread_t	*thread = mem_thread;
+	int				totalBytes = 0, cachedBytes = 0;
+	int				i, j;
+
+	Mem_Lock();
+
+	// Return the cached blocks of the calling thread with the given tag to the
+	// slab region
+	if (thread){
+		if (!Mem_SyncCachedBlocks(thread, tag)){
+			for (i = 0; i < MAX_CACHED_CLASSES; i++)
+				Mem_FlushCachedBlocks(thread, i, tag, 0);
+		}
+	}
+
+	// The caches of other threads are never touched from here. Their blocks
+	// are released along with the slab pages below, and each thread forgets
+	// them on its next small allocation or free, so they must not be kept
+	// for reporting leaks.
+	for (i = 0; i < MAX_MEMORY_THREADS; i++){
+		if (!mem.threads[i].inUse || &mem.threads[i] == thread)
+			continue;
+
+		if (mem.threads[i].freeSequence[tag] != mem.freeSequence[tag])
+			continue;
+
+		for (j = 0; j < MAX_CACHED_CLASSES; j++)
+			cachedBytes += mem.threads[i].numCachedBlocks[j][tag] * mem_slabClassSizes[j];
+	}
+
+	Sys_AtomicIncrement(&mem.freeSequence[tag]);
+
+	if (thread)
+		thread->freeSequence[tag] = mem.freeSequence[tag];
+
+	// Free all slab blocks with the given tag
+	totalBytes += Mem_SlabFreeAll(&mem.slab, tag);
 
 	// Free all zone blocks with the given tag
 	totalBytes += Mem_ZoneFreeAll(&mem.smallZone, tag);
@@ -1117,8 +2212,17 @@ void Mem_FreeAll (memoryTag_t tag, bool reportLeaks){
 	// Free all heap blocks with the given tag
 	totalBytes += Mem_HeapFreeAll(&mem.mainHeap, tag);
 
+	// Temporary memory also lives in the temporary arenas. Other threads reset
+	// their own arenas the next time they allocate temporary memory.
+	if (tag == TAG_TEMPORARY && thread)
+		Mem_ArenaReset(&thread->tempArena);
+
+	Mem_Unlock();
+
+	totalBytes -= cachedBytes;
+
 	// Report leaks if desired
-	if (!reportLeaks || !totalBytes)
+	if (!reportLeaks || totalBytes <= 0)
 		return;
 
 	Com_Printf("Freed %.2f MB of leaked %s data\n", totalBytes * (1.0f / 1048576.0f), mem_tagNames[tag]);
@@ -1132,11 +2236,21 @@ void Mem_FreeAll (memoryTag_t tag, bool reportLeaks){
 int Mem_Size (const void *ptr){
 
 	memoryBlock_t	*block;
+	slabPage_t		*page;
 	const byte		*blockPtr;
 
 	if (!ptr)
 		Com_Error(ERR_FATAL, "Mem_Size: NULL pointer");
 
+	// Check if allocated from the slab region
+	page = Mem_SlabPageForPointer(&mem.slab, ptr);
+	if (page){
+		if (page->tag == TAG_FREE)
+			Com_Error(ERR_FATAL, "Mem_Size: freed block");
+
+		return mem_slabClassSizes[page->sizeClass];
+	}
+
 	blockPtr = (const byte *)ptr;
 
 	// Back up over any padding
@@ -1592,6 +2706,253 @@ bool Mem_Compare (const void *buffer1, const void *buffer2, int size){
 #endif
 }
 
+/*
+ ==================
+ Mem_GetFrameArena
+
+ Returns the frame arena of the calling thread. Each thread resets its own
+ arena the first time it allocates frame memory after the end of a frame, so
+ no other thread ever touches it.
+ ==================
+*/
+static memoryArena_t *Mem_GetFrameArena (){
+
+	memoryThread_t	*thread = Mem_GetThread();
+
+	if (thread->frameSequence != mem.frameSequence){
+		thread->frameSequence = mem.frameSequence;
+
+		Mem_ArenaReset(&thread->frameArena);
+	}
+
+	return &thread->frameArena;
+}
+
+/*
+ ==================
+ Mem_FrameAlloc
+ ==================
+*/
+void *Mem_FrameAlloc (int size){
+
+	if (size < 0)
+		Com_Error(ERR_FATAL, "Mem_FrameAlloc: size < 0");
+
+	return Mem_ArenaAlloc(Mem_GetFrameArena(), size);
+}
+
+/*
+ ==================
+ Mem_ClearedFrameAlloc
+ ==================
+*/
+void *Mem_ClearedFrameAlloc (int size){
+
+	void	*buffer;
+
+	if (size < 0)
+		Com_Error(ERR_FATAL, "Mem_ClearedFrameAlloc: size < 0");
+
+	buffer = Mem_ArenaAlloc(Mem_GetFrameArena(), size);
+
+	// Clear the block
+	Mem_Fill(buffer, 0, size);
+
+	return buffer;
+}
+
+/*
+ ==================
+ Mem_GetTempArena
+
+ Returns the temporary arena of the calling thread. Each thread resets its own
+ arena the first time it allocates temporary memory after TAG_TEMPORARY memory
+ was freed, so no other thread ever touches it.
+ ==================
+*/
+static memoryArena_t *Mem_GetTempArena (){
+
+	memoryThread_t	*thread = Mem_GetThread();
+
+	if (thread->freeSequence[TAG_TEMPORARY] != mem.freeSequence[TAG_TEMPORARY]){
+		thread->freeSequence[TAG_TEMPORARY] = mem.freeSequence[TAG_TEMPORARY];
+
+		Mem_ArenaReset(&thread->tempArena);
+	}
+
+	return &thread->tempArena;
+}
+
+/*
+ ==================
+ Mem_TempAlloc
+ ==================
+*/
+void *Mem_TempAlloc (int size){
+
+	if (size < 0)
+		Com_Error(ERR_FATAL, "Mem_TempAlloc: size < 0");
+
+	return Mem_ArenaAlloc(Mem_GetTempArena(), size);
+}
+
+/*
+ ==================
+ Mem_ClearedTempAlloc
+ ==================
+*/
+void *Mem_ClearedTempAlloc (int size){
+
+	void	*buffer;
+
+	if (size < 0)
+		Com_Error(ERR_FATAL, "Mem_ClearedTempAlloc: size < 0");
+
+	buffer = Mem_ArenaAlloc(Mem_GetTempArena(), size);
+
+	// Clear the block
+	Mem_Fill(buffer, 0, size);
+
+	return buffer;
+}
+
+/*
+ ==================
+ Mem_AttachThread
+ ==================
+*/
+void Mem_AttachThread (const char *name){
+
+	memoryThread_t	*thread;
+	int				i;
+
+	if (mem_thread)
+		Com_Error(ERR_FATAL, "Mem_AttachThread: thread already attached");
+
+	// Find a free slot
+	Mem_Lock();
+
+	for (i = 0, thread = mem.threads; i < MAX_MEMORY_THREADS; i++, thread++){
+		if (!thread->inUse)
+			break;
+	}
+
+	if (i == MAX_MEMORY_THREADS){
+		Mem_Unlock();
+		Com_Error(ERR_FATAL, "Mem_AttachThread: MAX_MEMORY_THREADS hit");
+	}
+
+	thread->inUse = true;
+
+	Mem_Unlock();
+
+	Str_Copy(thread->name, name, sizeof(thread->name));
+
+	thread->frameSequence = mem.frameSequence;
+
+	for (i = 0; i < TAG_MAX; i++)
+		thread->freeSequence[i] = mem.freeSequence[i];
+
+	// Create the arenas if needed, they are kept around for reuse
+	if (!thread->frameArena.base)
+		Mem_ArenaCreate(&thread->frameArena, "frame", FRAME_ARENA_SIZE);
+	if (!thread->tempArena.base)
+		Mem_ArenaCreate(&thread->tempArena, "temporary", TEMP_ARENA_SIZE);
+
+	// Bind them to the calling thread
+	mem_thread = thread;
+}
+
+/*
+ ==================
+ Mem_ReserveThreads
+ ==================
+*/
+int Mem_ReserveThreads (const char *pool, int count){
+
+	int		available;
+
+	Mem_Lock();
+
+	available = MAX_MEMORY_THREADS - mem.reservedThreads;
+
+	if (count > available){
+		Com_Printf(S_COLOR_YELLOW "WARNING: only %i of %i %s threads can be attached\n", available, count, pool);
+
+		count = available;
+	}
+
+	mem.reservedThreads += count;
+
+	Mem_Unlock();
+
+	return count;
+}
+
+/*
+ ==================
+ Mem_ReleaseThreads
+ ==================
+*/
+void Mem_ReleaseThreads (int count){
+
+	Mem_Lock();
+
+	mem.reservedThreads -= count;
+
+	Mem_Unlock();
+}
+
+/*
+ ==================
+ Mem_DetachThread
+ ==================
+*/
+void Mem_DetachThread (){
+
+	memoryThread_t	*thread;
+	int				i, j;
+
+	thread = Mem_GetThread();
+
+	// Release any memory still in use
+	Mem_ArenaReset(&thread->frameArena);
+	Mem_ArenaReset(&thread->tempArena);
+
+	// Return all the cached blocks to the slab region
+	Mem_Lock();
+
+	for (i = 0; i < TAG_MAX; i++){
+		if (Mem_SyncCachedBlocks(thread, (memoryTag_t)i))
+			continue;
+
+		for (j = 0; j < MAX_CACHED_CLASSES; j++)
+			Mem_FlushCachedBlocks(thread, j, (memoryTag_t)i, 0);
+	}
+
+	thread->inUse = false;
+
+	Mem_Unlock();
+
+	// Unbind them from the calling thread
+	mem_thread = NULL;
+}
+
+/*
+ ==================
+ Mem_ResetFrameArenas
+ ==================
+*/
+void Mem_ResetFrameArenas (){
+
+	memoryThread_t	*thread = Mem_GetThread();
+
+	// Other threads reset their own arenas on their next frame allocation
+	thread->frameSequence = Sys_AtomicIncrement(&mem.frameSequence);
+
+	Mem_ArenaReset(&thread->frameArena);
+}
+
 /*
  ==================
  Mem_DupString
@@ -1639,12 +3000,18 @@ void *Mem_DupData (const void *data, int size, memoryTag_t tag){
 void Mem_TouchMemory (){
 
 	memoryBlock_t	*block;
+	slabPage_t		*page;
 	volatile int	sum = 0;
 	int				time;
-	int				i;
+	int				i, j;
 
 	time = Sys_Milliseconds();
 
+	Mem_Lock();
+
+	// Check integrity of the slab region
+	Mem_SlabCheck(&mem.slab);
+
 	// Check integrity of the zones
 	Mem_ZoneCheck(&mem.smallZone);
 	Mem_ZoneCheck(&mem.mediumZone);
@@ -1653,6 +3020,16 @@ void Mem_TouchMemory (){
 	// Check integrity of the heap
 	Mem_HeapCheck(&mem.mainHeap);
 
+	// Touch the slab region
+	for (i = 0, page = mem.slab.pages; i < SLAB_PAGES; i++, page++){
+		if (page->tag == TAG_FREE)
+			continue;
+
+		// Only need to touch each page
+		for (j = 0; j < page->carvedBlocks * mem_slabClassSizes[page->sizeClass]; j += 1024)
+			sum += Mem_SlabPageData(&mem.slab, page)[j];
+	}
+
 	// Touch the small zone
 	for (block = mem.smallZone.blockList.next; block != &mem.smallZone.blockList; block = block->next){
 		if (block->tag == TAG_FREE)
@@ -1690,6 +3067,8 @@ void Mem_TouchMemory (){
 			sum += ((const byte *)block)[i];
 	}
 
+	Mem_Unlock();
+
 	Com_Printf("%.2f MB of memory touched in %i msec\n", mem.totalBytes * (1.0f / 1048576.0f), Sys_Milliseconds() - time);
 }
 
@@ -1704,14 +3083,40 @@ void Mem_TouchMemory (){
 */
 void Mem_PrintStats (){
 
+	memoryThread_t	*thread;
+	int				arenaBlocks = 0, arenaBytes = 0;
+	int				cacheHits = 0, cacheMisses = 0;
+	int				i;
+
+	Mem_Lock();
+
 	if (mem_showUsage->integerValue){
+		for (i = 0, thread = mem.threads; i < MAX_MEMORY_THREADS; i++, thread++){
+			if (!thread->inUse)
+				continue;
+
+			arenaBlocks += thread->frameArena.allocBlocks;
+			arenaBytes += thread->frameArena.peakBytes;
+
+			cacheHits += thread->cacheHits;
+			cacheMisses += thread->cacheMisses;
+		}
+
 		Com_Printf("total allocated memory: %6i = %6.2f MB (overhead: %4i KB)\n", mem.totalBlocks, mem.totalBytes * (1.0f / 1048576.0f), mem.totalOverhead >> 10);
-		Com_Printf("frame alloc: %4i = %4i KB, frame free: %4i = %4i KB\n", mem.frameAllocBlocks, mem.frameAllocBytes >> 10, mem.frameFreeBlocks, mem.frameFreeBytes >> 10);
+		Com_Printf("frame alloc: %4i = %4i KB, frame free: %4i = %4i KB, frame arenas: %4i = %4i KB\n", mem.frameAllocBlocks, mem.frameAllocBytes >> 10, mem.frameFreeBlocks, mem.frameFreeBytes >> 10, arenaBlocks, arenaBytes >> 10);
+		Com_Printf("locks: %4i (%4i contended), cache hits: %4i, cache misses: %4i\n", mem.frameLocks, mem.frameContentions, cacheHits, cacheMisses);
 	}
 
 	// Clear for next frame
 	mem.frameAllocBlocks = mem.frameAllocBytes = 0;
 	mem.frameFreeBlocks = mem.frameFreeBytes = 0;
+
+	mem.frameLocks = mem.frameContentions = 0;
+
+	for (i = 0, thread = mem.threads; i < MAX_MEMORY_THREADS; i++, thread++)
+		thread->cacheHits = thread->cacheMisses = 0;
+
+	Mem_Unlock();
 }
 
 
@@ -1733,11 +3138,17 @@ static void Mem_Stats_f (){
 
 	int		tagBlocks[TAG_MAX];
 	int		tagBytes[TAG_MAX];
-	int		i;
+	int		cachedBlocks;
+	int		i, j, k;
 
 	Mem_Fill(tagBlocks, 0, sizeof(tagBlocks));
 	Mem_Fill(tagBytes, 0, sizeof(tagBytes));
 
+	Mem_Lock();
+
+	// Print slab statistics and accumulate per-tag information
+	Mem_SlabStats(&mem.slab, tagBlocks, tagBytes);
+
 	// Print zone statistics and accumulate per-tag information
 	Mem_ZoneStats(&mem.smallZone, tagBlocks, tagBytes);
 	Mem_ZoneStats(&mem.mediumZone, tagBlocks, tagBytes);
@@ -1746,6 +3157,39 @@ static void Mem_Stats_f (){
 	// Print heap statistics and accumulate per-tag information
 	Mem_HeapStats(&mem.mainHeap, tagBlocks, tagBytes);
 
+	// Print arena statistics
+	Com_Printf("\n");
+	Com_Printf("Arenas:\n");
+	Com_Printf("--------------------------------------------------------------\n");
+	Com_Printf("thread       arena        size  last peak   max peak    in use  ovfl\n");
+
+	for (i = 0; i < MAX_MEMORY_THREADS; i++){
+		if (!mem.threads[i].inUse)
+			continue;
+
+		Mem_ArenaStats(mem.threads[i].name, &mem.threads[i].frameArena);
+		Mem_ArenaStats(mem.threads[i].name, &mem.threads[i].tempArena);
+	}
+
+	// Print thread cache statistics
+	Com_Printf("\n");
+	Com_Printf("Thread caches:\n");
+	Com_Printf("--------------------------------------------------------------\n");
+
+	for (i = 0; i < MAX_MEMORY_THREADS; i++){
+		if (!mem.threads[i].inUse)
+			continue;
+
+		cachedBlocks = 0;
+
+		for (j = 0; j < MAX_CACHED_CLASSES; j++){
+			for (k = 0; k < TAG_MAX; k++)
+				cachedBlocks += mem.threads[i].numCachedBlocks[j][k];
+		}
+
+		Com_Printf("%-12s %5i cached blocks\n", mem.threads[i].name, cachedBlocks);
+	}
+
 	// Print totals
 	Com_Printf("\n");
 	Com_Printf("Totals:\n");
@@ -1758,6 +3202,8 @@ static void Mem_Stats_f (){
 	Com_Printf("%i total memory blocks allocated\n", mem.totalBlocks);
 	Com_Printf("%.2f MB total memory allocated (%i KB total overhead)\n", mem.totalBytes * (1.0f / 1048576.0f), mem.totalOverhead >> 10);
 	Com_Printf("\n");
+
+	Mem_Unlock();
 }
 
 /*
@@ -1784,6 +3230,11 @@ static void Mem_Dump_f (){
 		return;
 	}
 
+	Mem_Lock();
+
+	// Write slab information
+	Mem_SlabDump(&mem.slab, f);
+
 	// Write zone information
 	Mem_ZoneDump(&mem.smallZone, f);
 	Mem_ZoneDump(&mem.mediumZone, f);
@@ -1792,6 +3243,8 @@ static void Mem_Dump_f (){
 	// Write heap information
 	Mem_HeapDump(&mem.mainHeap, f);
 
+	Mem_Unlock();
+
 	FS_CloseFile(f);
 
 	Com_Printf("Dumped memory information to %s\n", name);
@@ -1814,14 +3267,26 @@ static void Mem_Dump_f (){
 */
 void Mem_Init (){
 
+	// Create the lock
+	mem.lock = Sys_CreateMutex();
+
 	// Create the heap
 	Mem_HeapCreate(&mem.mainHeap, ALLOC_HEAP);
 
+	// Create the slab region
+	Mem_SlabCreate(&mem.slab, SLAB_REGION_SIZE);
+
 	// Create the zones
 	Mem_ZoneCreate(&mem.smallZone, "small", ALLOC_SMALL_ZONE, SMALL_ZONE_SIZE);
 	Mem_ZoneCreate(&mem.mediumZone, "medium", ALLOC_MEDIUM_ZONE, MEDIUM_ZONE_SIZE);
 	Mem_ZoneCreate(&mem.largeZone, "large", ALLOC_LARGE_ZONE, LARGE_ZONE_SIZE);
 
+	// The main and renderer front-end threads always have a slot
+	mem.reservedThreads = 2;
+
+	// Create the arenas for the main thread
+	Mem_AttachThread("main");
+
 	// Register variables
 	mem_checkIntegrity = CVar_Register("mem_checkIntegrity", "0", CVAR_INTEGER, CVAR_CHEAT, "Check integrity of the heap (1 = on each alloc, 2 = on each free, 3 = on each alloc and free)", 0, 3);
 	mem_showUsage = CVar_Register("mem_showUsage", "0", CVAR_BOOL, CVAR_CHEAT, "Show total and per-frame memory usage", 0, 0);
@@ -1842,6 +3307,8 @@ void Mem_Init (){
 */
 void Mem_Shutdown (){
 
+	int		i;
+
 	if (!mem.initialized)
 		return;
 
@@ -1849,13 +3316,27 @@ void Mem_Shutdown (){
 	Cmd_RemoveCommand("memStats");
 	Cmd_RemoveCommand("memDump");
 
+	// Destroy the arenas
+	for (i = 0; i < MAX_MEMORY_THREADS; i++){
+		Mem_ArenaDestroy(&mem.threads[i].frameArena);
+		Mem_ArenaDestroy(&mem.threads[i].tempArena);
+	}
+
+	mem_thread = NULL;
+
 	// Destroy the zones
 	Mem_ZoneDestroy(&mem.largeZone);
 	Mem_ZoneDestroy(&mem.mediumZone);
 	Mem_ZoneDestroy(&mem.smallZone);
 
+	// Destroy the slab region
+	Mem_SlabDestroy(&mem.slab);
+
 	// Destroy the heap
 	Mem_HeapDestroy(&mem.mainHeap);
 
+	// Destroy the lock
+	Sys_DestroyMutex(mem.lock);
+
 	Mem_Fill(&mem, 0, sizeof(memory_t));
 }
\ No newline at end of file
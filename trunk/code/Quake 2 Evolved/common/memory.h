@@ -69,6 +69,27 @@
  All memory allocations are always guaranteed to be 8-byte aligned unless
  16-byte alignment is explicitly requested.
 
+ Short-lived scratch memory can also be allocated from the memory arenas.
+ Every thread has its own pair of arenas (frame and temporary), and arena
+ allocations just bump a pointer, so they are very fast and don't fragment the
+ zones.
+ Arena blocks can't be freed individually. The frame arenas are reset at the
+ end of every frame, and the temporary arenas are reset along with all the
+ other temporary memory when Mem_FreeAll is called with TAG_TEMPORARY.
+ Arena memory is always aligned on a 16-byte boundary.
+
+ All the functions can be called from any thread. Any thread other than the
+ main thread should call Mem_AttachThread before allocating memory, and
+ Mem_DetachThread before it terminates. Attached threads keep a small cache of
+ recently freed blocks, so most small allocations don't need to lock the
+ memory manager. Threads that are not attached can still allocate and free
+ memory, but can't use the arenas.
+
+ Mem_FreeAll must not be called while other threads are allocating memory with
+ the same tag, and the arenas are reset without locking, so no other threads
+ should be allocating arena memory at the end of a frame, or when temporary
+ memory is freed.
+
  ==============================================================================
 */
 
@@ -102,7 +123,10 @@ void *			Mem_ClearedAlloc16 (int size, memoryTag_t tag);
 // Frees a block of memory
 void			Mem_Free (const void *ptr);
 
-// Frees all blocks of memory with the given tag
+// Frees all blocks of memory with the given tag.
+// Only the calling thread returns its cached blocks and resets its temporary
+// arena. Other threads do the same on their next allocation or free, so they
+// must not be using memory with the given tag.
 void			Mem_FreeAll (memoryTag_t tag, bool reportLeaks);
 
 // Returns the size of the given block of memory
@@ -117,6 +141,43 @@ void			Mem_Copy (void *dst, const void *src, int size);
 // Compares two blocks of memory of the given size
 bool			Mem_Compare (const void *buffer1, const void *buffer2, int size);
 
+// Allocates a block of memory of the given size from the frame arena of the
+// calling thread. The memory is released at the end of the frame, so it must
+// not be handed to anything that outlives the frame (like the renderer
+// back-end, which runs one frame behind with r_smp).
+void *			Mem_FrameAlloc (int size);
+
+// Like Mem_FrameAlloc, but clears the block to zero
+void *			Mem_ClearedFrameAlloc (int size);
+
+// Allocates a block of memory of the given size from the temporary arena of
+// the calling thread. The memory is released along with TAG_TEMPORARY memory.
+void *			Mem_TempAlloc (int size);
+
+// Like Mem_TempAlloc, but clears the block to zero
+void *			Mem_ClearedTempAlloc (int size);
+
+// Binds a pair of arenas to the calling thread.
+// Must be called by any thread other than the main thread before allocating
+// arena memory.
+void			Mem_AttachThread (const char *name);
+
+// Releases the arenas bound to the calling thread
+void			Mem_DetachThread ();
+
+// Reserves slots for the given number of threads of a pool, before they are
+// created. Returns the number of threads that can be created, which may be
+// less than requested.
+int				Mem_ReserveThreads (const char *pool, int count);
+
+// Releases the slots reserved for a pool after its threads have terminated
+void			Mem_ReleaseThreads (int count);
+
+// Ends the frame, resetting the frame arena of the calling thread.
+// Other threads reset their own frame arenas the next time they allocate frame
+// memory, so they must not keep frame memory across frames.
+void			Mem_ResetFrameArenas ();
+
 // Allocates a block of memory and copies the given string
 char *			Mem_DupString (const char *string, memoryTag_t tag);
 
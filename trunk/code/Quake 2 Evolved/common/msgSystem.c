@@ -51,6 +51,8 @@ void MSG_Init (msg_t *msg, byte *data, int maxSize, bool allowOverflow){
 	msg->maxSize = maxSize;
 	msg->curSize = 0;
 	msg->readCount = 0;
+	msg->writeBit = 0;
+	msg->readBit = 0;
 }
 
 
@@ -545,6 +547,7 @@ void MSG_WriteDeltaEntity (msg_t *msg, const entity_state_t *from, const entity_
 void MSG_BeginReading (msg_t *msg){
 
 	msg->readCount = 0;
+	msg->readBit = 0;
 }
 
 /*
@@ -818,4 +821,677 @@ void MSG_ReadData (msg_t *msg, void *buffer, int size){
 
 	for (i = 0; i < size; i++)
 		((byte *)buffer)[i] = MSG_ReadByte(msg);
+}
+
+
+/*
+ ==============================================================================
+
+ BIT STREAM FUNCTIONS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ MSG_WriteBits
+ ==================
+*/
+void MSG_WriteBits (msg_t *msg, int value, int bits){
+
+	byte	*buffer;
+	uint	v;
+	int		bit, count;
+
+	if (bits <= 0 || bits > 32)
+		Com_Error(ERR_FATAL, "MSG_WriteBits: bad bit count (%i)", bits);
+
+	v = (uint)value;
+
+	while (bits){
+		// Keep filling the last byte if it was started by a previous bit
+		// write, otherwise start a new one
+		if (msg->writeBit > (msg->curSize - 1) * 8 && msg->writeBit < msg->curSize * 8)
+			buffer = msg->data + msg->curSize - 1;
+		else {
+			buffer = MSG_GetSpace(msg, 1);
+			buffer[0] = 0;
+
+			msg->writeBit = (msg->curSize - 1) * 8;
+		}
+
+		bit = msg->writeBit & 7;
+		count = Min(8 - bit, bits);
+
+		buffer[0] |= (v & ((1 << count) - 1)) << bit;
+
+		v >>= count;
+		bits -= count;
+
+		msg->writeBit += count;
+	}
+}
+
+/*
+ ==================
+ MSG_ReadBits
+ ==================
+*/
+int MSG_ReadBits (msg_t *msg, int bits){
+
+	uint	value = 0;
+	int		bit, count, shift = 0;
+	int		b;
+
+	if (bits <= 0 || bits > 32)
+		Com_Error(ERR_FATAL, "MSG_ReadBits: bad bit count (%i)", bits);
+
+	while (shift < bits){
+		// Keep reading the last byte if it was started by a previous bit
+		// read, otherwise start a new one
+		if (msg->readBit <= (msg->readCount - 1) * 8 || msg->readBit >= msg->readCount * 8){
+			msg->readBit = msg->readCount * 8;
+			msg->readCount += 1;
+		}
+
+		if (msg->readCount > msg->curSize)
+			b = 0;
+		else
+			b = msg->data[msg->readCount - 1];
+
+		bit = msg->readBit & 7;
+		count = Min(8 - bit, bits - shift);
+
+		value |= (uint)((b >> bit) & ((1 << count) - 1)) << shift;
+
+		shift += count;
+
+		msg->readBit += count;
+	}
+
+	return (int)value;
+}
+
+/*
+ ==================
+ MSG_GetWrittenBits
+ ==================
+*/
+int MSG_GetWrittenBits (const msg_t *msg){
+
+	// Only count the bits written to a partially filled last byte
+	if (msg->writeBit > (msg->curSize - 1) * 8 && msg->writeBit < msg->curSize * 8)
+		return msg->writeBit;
+
+	return msg->curSize * 8;
+}
+
+/*
+ ==================
+ MSG_WriteBitStream
+ ==================
+*/
+void MSG_WriteBitStream (msg_t *msg, const byte *data, int bits){
+
+	int		bytes = bits >> 3;
+	int		i;
+
+	// Whole bytes can be copied directly if the last byte is full
+	if (MSG_GetWrittenBits(msg) == msg->curSize * 8){
+		MSG_Write(msg, data, bytes);
+
+		if (bits & 7)
+			MSG_WriteBits(msg, data[bytes], bits & 7);
+
+		return;
+	}
+
+	for (i = 0; i < bytes; i++)
+		MSG_WriteBits(msg, data[i], 8);
+
+	if (bits & 7)
+		MSG_WriteBits(msg, data[bytes], bits & 7);
+}
+
+
+/*
+ ==============================================================================
+
+ BIT-PACKED DELTAS
+
+ ==============================================================================
+*/
+
+#define ESOFS(x)					(int)(size_t)&(((entity_state_t *)0)->x)
+#define PSOFS(x)					(int)(size_t)&(((player_state_t *)0)->x)
+
+#define ENTITY_FIELD_BITS			5			// Enough for the number of entity fields
+#define PLAYER_FIELD_BITS			6			// Enough for the number of player fields
+
+typedef enum {
+	NF_INT,							// Unsigned integer
+	NF_SHORT,						// Signed short
+	NF_BYTE,						// Unsigned byte
+	NF_EVENT,						// Unsigned integer, not delta compressed, just 0 compressed
+	NF_COORD,						// Coordinate in 1/8 units
+	NF_ANGLE,						// Angle in the given number of bits
+	NF_OFFSET,						// Small offset or angle in 1/4 units
+	NF_BLEND,						// Color component in the 0.0 - 1.0 range
+	NF_FOV							// Whole degrees
+} netFieldType_t;
+
+typedef struct {
+	int						offset;
+	netFieldType_t			type;
+
+	int						bits;			// Width of the full value
+	int						smallBits;		// Width of the short form, or 0 if none.
+											// For signed types this is a delta from
+											// the old value, otherwise a small value.
+} netField_t;
+
+// Entity fields, sorted by how often they change so the change mask can stop
+// at the last changed field
+static netField_t			msg_entityFields[] = {
+	{ESOFS(origin[0]),			NF_COORD,	16,	10},
+	{ESOFS(origin[1]),			NF_COORD,	16,	10},
+	{ESOFS(origin[2]),			NF_COORD,	16,	10},
+	{ESOFS(angles[1]),			NF_ANGLE,	8,	0},
+	{ESOFS(frame),				NF_INT,		16,	8},
+	{ESOFS(event),				NF_EVENT,	8,	0},
+	{ESOFS(angles[0]),			NF_ANGLE,	8,	0},
+	{ESOFS(angles[2]),			NF_ANGLE,	8,	0},
+	{ESOFS(effects),			NF_INT,		32,	8},
+	{ESOFS(renderfx),			NF_INT,		32,	8},
+	{ESOFS(skinnum),			NF_INT,		32,	8},
+	{ESOFS(sound),				NF_INT,		8,	0},
+	{ESOFS(modelindex),			NF_INT,		8,	0},
+	{ESOFS(modelindex2),		NF_INT,		8,	0},
+	{ESOFS(modelindex3),		NF_INT,		8,	0},
+	{ESOFS(modelindex4),		NF_INT,		8,	0},
+	{ESOFS(solid),				NF_INT,		16,	0}
+};
+
+// Player state fields, sorted by how often they change
+static netField_t			msg_playerFields[] = {
+	{PSOFS(pmove.origin[0]),		NF_SHORT,	16,	10},
+	{PSOFS(pmove.origin[1]),		NF_SHORT,	16,	10},
+	{PSOFS(pmove.origin[2]),		NF_SHORT,	16,	10},
+	{PSOFS(pmove.velocity[0]),		NF_SHORT,	16,	10},
+	{PSOFS(pmove.velocity[1]),		NF_SHORT,	16,	10},
+	{PSOFS(pmove.velocity[2]),		NF_SHORT,	16,	10},
+	{PSOFS(viewangles[1]),			NF_ANGLE,	16,	0},
+	{PSOFS(viewangles[0]),			NF_ANGLE,	16,	0},
+	{PSOFS(gunframe),				NF_INT,		8,	0},
+	{PSOFS(pmove.pm_time),			NF_BYTE,	8,	0},
+	{PSOFS(pmove.pm_flags),			NF_BYTE,	8,	0},
+	{PSOFS(kick_angles[0]),			NF_OFFSET,	8,	0},
+	{PSOFS(kick_angles[1]),			NF_OFFSET,	8,	0},
+	{PSOFS(kick_angles[2]),			NF_OFFSET,	8,	0},
+	{PSOFS(gunoffset[0]),			NF_OFFSET,	8,	0},
+	{PSOFS(gunoffset[1]),			NF_OFFSET,	8,	0},
+	{PSOFS(gunoffset[2]),			NF_OFFSET,	8,	0},
+	{PSOFS(gunangles[0]),			NF_OFFSET,	8,	0},
+	{PSOFS(gunangles[1]),			NF_OFFSET,	8,	0},
+	{PSOFS(gunangles[2]),			NF_OFFSET,	8,	0},
+	{PSOFS(viewoffset[0]),			NF_OFFSET,	8,	0},
+	{PSOFS(viewoffset[1]),			NF_OFFSET,	8,	0},
+	{PSOFS(viewoffset[2]),			NF_OFFSET,	8,	0},
+	{PSOFS(viewangles[2]),			NF_ANGLE,	16,	0},
+	{PSOFS(blend[0]),				NF_BLEND,	8,	0},
+	{PSOFS(blend[1]),				NF_BLEND,	8,	0},
+	{PSOFS(blend[2]),				NF_BLEND,	8,	0},
+	{PSOFS(blend[3]),				NF_BLEND,	8,	0},
+	{PSOFS(pmove.delta_angles[0]),	NF_SHORT,	16,	0},
+	{PSOFS(pmove.delta_angles[1]),	NF_SHORT,	16,	0},
+	{PSOFS(pmove.delta_angles[2]),	NF_SHORT,	16,	0},
+	{PSOFS(pmove.pm_type),			NF_INT,		8,	0},
+	{PSOFS(pmove.gravity),			NF_SHORT,	16,	0},
+	{PSOFS(gunindex),				NF_INT,		8,	0},
+	{PSOFS(fov),					NF_FOV,		8,	0},
+	{PSOFS(rdflags),				NF_INT,		8,	0}
+};
+
+// Old origins are sent as a delta from the new origin
+static netField_t			msg_oldOriginField = {0, NF_COORD, 16, 10};
+
+// Stats are sent as a delta from the old stats
+static netField_t			msg_statField = {0, NF_SHORT, 16, 8};
+
+
+/*
+ ==================
+ MSG_SignExtend
+ ==================
+*/
+static int MSG_SignExtend (int value, int bits){
+
+	value &= (1 << bits) - 1;
+
+	if (value & (1 << (bits - 1)))
+		value -= 1 << bits;
+
+	return value;
+}
+
+/*
+ ==================
+ MSG_IsSignedField
+ ==================
+*/
+static bool MSG_IsSignedField (const netField_t *field){
+
+	switch (field->type){
+	case NF_SHORT:
+	case NF_COORD:
+	case NF_ANGLE:
+	case NF_OFFSET:
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ ==================
+ MSG_QuantizeField
+
+ Returns the value of the given field exactly as it will be sent, so the
+ writer and the reader always agree on whether it changed
+ ==================
+*/
+static int MSG_QuantizeField (const netField_t *field, const void *base){
+
+	const byte	*ptr = (const byte *)base + field->offset;
+
+	switch (field->type){
+	case NF_INT:
+	case NF_EVENT:
+		if (field->bits == 32)
+			return *(const int *)ptr;
+
+		return *(const int *)ptr & ((1 << field->bits) - 1);
+	case NF_SHORT:
+		return *(const short *)ptr;
+	case NF_BYTE:
+		return *(const byte *)ptr;
+	case NF_COORD:
+		return MSG_SignExtend((int)(*(const float *)ptr * 8), field->bits);
+	case NF_ANGLE:
+		return MSG_SignExtend((int)(*(const float *)ptr * (1 << field->bits) / 360), field->bits);
+	case NF_OFFSET:
+		return MSG_SignExtend((int)(*(const float *)ptr * 4), field->bits);
+	case NF_BLEND:
+		return (int)(*(const float *)ptr * 255) & 255;
+	case NF_FOV:
+		return (int)(*(const float *)ptr) & 255;
+	}
+
+	return 0;
+}
+
+/*
+ ==================
+ MSG_DequantizeField
+ ==================
+*/
+static void MSG_DequantizeField (const netField_t *field, void *base, int value){
+
+	byte	*ptr = (byte *)base + field->offset;
+
+	switch (field->type){
+	case NF_INT:
+	case NF_EVENT:
+		*(int *)ptr = value;
+		break;
+	case NF_SHORT:
+		*(short *)ptr = value;
+		break;
+	case NF_BYTE:
+		*(byte *)ptr = value;
+		break;
+	case NF_COORD:
+		*(float *)ptr = value * 0.125f;
+		break;
+	case NF_ANGLE:
+		*(float *)ptr = value * (360.0f / (1 << field->bits));
+		break;
+	case NF_OFFSET:
+		*(float *)ptr = value * 0.25f;
+		break;
+	case NF_BLEND:
+		*(float *)ptr = value / 255.0f;
+		break;
+	case NF_FOV:
+		*(float *)ptr = value;
+		break;
+	}
+}
+
+/*
+ ==================
+ MSG_WriteFieldValue
+
+ Uses the short form of the field if the value (or the delta for signed
+ fields) fits in it
+ ==================
+*/
+static void MSG_WriteFieldValue (msg_t *msg, const netField_t *field, int oldValue, int newValue){
+
+	int		delta, range;
+
+	if (!field->smallBits){
+		MSG_WriteBits(msg, newValue, field->bits);
+		return;
+	}
+
+	if (MSG_IsSignedField(field)){
+		delta = newValue - oldValue;
+		range = 1 << (field->smallBits - 1);
+
+		if (delta >= -range && delta < range){
+			MSG_WriteBits(msg, 0, 1);
+			MSG_WriteBits(msg, delta, field->smallBits);
+			return;
+		}
+	}
+	else {
+		if ((uint)newValue < (1U << field->smallBits)){
+			MSG_WriteBits(msg, 0, 1);
+			MSG_WriteBits(msg, newValue, field->smallBits);
+			return;
+		}
+	}
+
+	MSG_WriteBits(msg, 1, 1);
+	MSG_WriteBits(msg, newValue, field->bits);
+}
+
+/*
+ ==================
+ MSG_ReadFieldValue
+ ==================
+*/
+static int MSG_ReadFieldValue (msg_t *msg, const netField_t *field, int oldValue){
+
+	bool	full;
+
+	if (!field->smallBits)
+		full = true;
+	else
+		full = MSG_ReadBits(msg, 1);
+
+	if (full){
+		if (MSG_IsSignedField(field))
+			return MSG_SignExtend(MSG_ReadBits(msg, field->bits), field->bits);
+
+		return MSG_ReadBits(msg, field->bits);
+	}
+
+	if (MSG_IsSignedField(field))
+		return oldValue + MSG_SignExtend(MSG_ReadBits(msg, field->smallBits), field->smallBits);
+
+	return MSG_ReadBits(msg, field->smallBits);
+}
+
+/*
+ ==================
+ MSG_OldFieldValue
+ ==================
+*/
+static int MSG_OldFieldValue (const netField_t *field, const void *from){
+
+	if (field->type == NF_EVENT)
+		return 0;
+
+	return MSG_QuantizeField(field, from);
+}
+
+/*
+ ==================
+ MSG_CountChangedFields
+
+ Returns the number of fields up to and including the last changed one
+ ==================
+*/
+static int MSG_CountChangedFields (const netField_t *fields, int numFields, const void *from, const void *to){
+
+	int		i;
+
+	for (i = numFields - 1; i >= 0; i--){
+		if (MSG_QuantizeField(&fields[i], to) != MSG_OldFieldValue(&fields[i], from))
+			break;
+	}
+
+	return i + 1;
+}
+
+/*
+ ==================
+ MSG_WriteDeltaFields
+ ==================
+*/
+static void MSG_WriteDeltaFields (msg_t *msg, const netField_t *fields, int numFields, int countBits, const void *from, const void *to){
+
+	const netField_t	*field;
+	int					oldValue, newValue;
+	int					i, count;
+
+	count = MSG_CountChangedFields(fields, numFields, from, to);
+
+	MSG_WriteBits(msg, count, countBits);
+
+	for (i = 0, field = fields; i < count; i++, field++){
+		oldValue = MSG_OldFieldValue(field, from);
+		newValue = MSG_QuantizeField(field, to);
+
+		if (newValue == oldValue){
+			MSG_WriteBits(msg, 0, 1);
+			continue;
+		}
+
+		MSG_WriteBits(msg, 1, 1);
+		MSG_WriteFieldValue(msg, field, oldValue, newValue);
+	}
+}
+
+/*
+ ==================
+ MSG_ReadDeltaFields
+
+ The destination must already hold a copy of the state being delta'd from
+ ==================
+*/
+static void MSG_ReadDeltaFields (msg_t *msg, const netField_t *fields, int numFields, int countBits, void *to){
+
+	const netField_t	*field;
+	int					i, count;
+
+	count = MSG_ReadBits(msg, countBits);
+	if (count > numFields)
+		Com_Error(ERR_DROP, "MSG_ReadDeltaFields: bad field count (%i)", count);
+
+	for (i = 0, field = fields; i < numFields; i++, field++){
+		if (i >= count || !MSG_ReadBits(msg, 1)){
+			// Events are not delta compressed
+			if (field->type == NF_EVENT)
+				MSG_DequantizeField(field, to, 0);
+
+			continue;
+		}
+
+		MSG_DequantizeField(field, to, MSG_ReadFieldValue(msg, field, MSG_OldFieldValue(field, to)));
+	}
+}
+
+/*
+ ==================
+ MSG_WritePackedDeltaEntity
+
+ Writes part of a packet entities message using the bit-packed protocol.
+ Can delta from either a baseline or a previous packet entity.
+ ==================
+*/
+void MSG_WritePackedDeltaEntity (msg_t *msg, const entity_state_t *from, const entity_state_t *to, bool force, bool newEntity){
+
+	bool	oldOrigin = false;
+	int		i;
+
+	if (!to->number)
+		Com_Error(ERR_DROP, "MSG_WritePackedDeltaEntity: unset entity number");
+	if (to->number >= MAX_EDICTS)
+		Com_Error(ERR_DROP, "MSG_WritePackedDeltaEntity: number >= MAX_EDICTS");
+
+	// The old origin defaults to the origin being delta'd from, so it only
+	// needs to be sent if it is different
+	if (newEntity || (to->renderfx & RF_BEAM)){
+		for (i = 0; i < 3; i++){
+			if ((int)(to->old_origin[i] * 8) != (int)(from->origin[i] * 8)){
+				oldOrigin = true;
+				break;
+			}
+		}
+	}
+
+	if (!force && !oldOrigin){
+		if (!MSG_CountChangedFields(msg_entityFields, sizeof(msg_entityFields) / sizeof(netField_t), from, to))
+			return;		// Nothing to send!
+	}
+
+	// Write the header
+	MSG_WriteBits(msg, to->number, ENTITYNUM_BITS);
+	MSG_WriteBits(msg, 0, 1);
+
+	// Write the fields
+	MSG_WriteDeltaFields(msg, msg_entityFields, sizeof(msg_entityFields) / sizeof(netField_t), ENTITY_FIELD_BITS, from, to);
+
+	// Write the old origin if needed
+	MSG_WriteBits(msg, oldOrigin, 1);
+
+	if (!oldOrigin)
+		return;
+
+	for (i = 0; i < 3; i++)
+		MSG_WriteFieldValue(msg, &msg_oldOriginField, MSG_SignExtend((int)(to->origin[i] * 8), 16), MSG_SignExtend((int)(to->old_origin[i] * 8), 16));
+}
+
+/*
+ ==================
+ MSG_WritePackedRemoveEntity
+ ==================
+*/
+void MSG_WritePackedRemoveEntity (msg_t *msg, int number){
+
+	MSG_WriteBits(msg, number, ENTITYNUM_BITS);
+	MSG_WriteBits(msg, 1, 1);
+}
+
+/*
+ ==================
+ MSG_WritePackedDeltaPlayerState
+ ==================
+*/
+void MSG_WritePackedDeltaPlayerState (msg_t *msg, const player_state_t *from, const player_state_t *to){
+
+	int		statBits;
+	int		i;
+
+	MSG_WriteDeltaFields(msg, msg_playerFields, sizeof(msg_playerFields) / sizeof(netField_t), PLAYER_FIELD_BITS, from, to);
+
+	// Write the stats
+	statBits = 0;
+	for (i = 0; i < MAX_STATS; i++){
+		if (to->stats[i] != from->stats[i])
+			statBits |= 1 << i;
+	}
+
+	if (!statBits){
+		MSG_WriteBits(msg, 0, 1);
+		return;
+	}
+
+	MSG_WriteBits(msg, 1, 1);
+	MSG_WriteBits(msg, statBits, MAX_STATS);
+
+	for (i = 0; i < MAX_STATS; i++){
+		if (statBits & (1 << i))
+			MSG_WriteFieldValue(msg, &msg_statField, from->stats[i], to->stats[i]);
+	}
+}
+
+/*
+ ==================
+ MSG_ReadPackedEntityNumber
+ ==================
+*/
+int MSG_ReadPackedEntityNumber (msg_t *msg, bool *remove){
+
+	int		number;
+
+	number = MSG_ReadBits(msg, ENTITYNUM_BITS);
+	if (!number){
+		*remove = false;
+		return 0;
+	}
+
+	*remove = MSG_ReadBits(msg, 1);
+
+	return number;
+}
+
+/*
+ ==================
+ MSG_ReadPackedDeltaEntity
+
+ Can go from either a baseline or a previous packet entity
+ ==================
+*/
+void MSG_ReadPackedDeltaEntity (msg_t *msg, const entity_state_t *from, entity_state_t *to, int number){
+
+	int		i;
+
+	// Set everything to the state we are delta'ing from
+	*to = *from;
+
+	VectorCopy(from->origin, to->old_origin);
+	to->number = number;
+
+	// Read the fields
+	MSG_ReadDeltaFields(msg, msg_entityFields, sizeof(msg_entityFields) / sizeof(netField_t), ENTITY_FIELD_BITS, to);
+
+	// Read the old origin if present
+	if (!MSG_ReadBits(msg, 1))
+		return;
+
+	for (i = 0; i < 3; i++)
+		to->old_origin[i] = MSG_ReadFieldValue(msg, &msg_oldOriginField, MSG_SignExtend((int)(to->origin[i] * 8), 16)) * 0.125f;
+}
+
+/*
+ ==================
+ MSG_ReadPackedDeltaPlayerState
+ ==================
+*/
+void MSG_ReadPackedDeltaPlayerState (msg_t *msg, const player_state_t *from, player_state_t *to){
+
+	int		statBits;
+	int		i;
+
+	// Set everything to the state we are delta'ing from
+	*to = *from;
+
+	// Read the fields
+	MSG_ReadDeltaFields(msg, msg_playerFields, sizeof(msg_playerFields) / sizeof(netField_t), PLAYER_FIELD_BITS, to);
+
+	// Read the stats
+	if (!MSG_ReadBits(msg, 1))
+		return;
+
+	statBits = MSG_ReadBits(msg, MAX_STATS);
+
+	for (i = 0; i < MAX_STATS; i++){
+		if (statBits & (1 << i))
+			to->stats[i] = MSG_ReadFieldValue(msg, &msg_statField, from->stats[i]);
+	}
 }
\ No newline at end of file
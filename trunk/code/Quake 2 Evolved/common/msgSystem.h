@@ -37,6 +37,9 @@ typedef struct {
 	int					maxSize;
 	int					curSize;
 	int					readCount;
+
+	int					writeBit;			// Bit position of the bit stream writer
+	int					readBit;			// Bit position of the bit stream reader
 } msg_t;
 
 void			MSG_Init (msg_t *msg, byte *data, int maxSize, bool allowOverflow);
@@ -61,6 +64,31 @@ void			MSG_WriteDir (msg_t *msg, const vec3_t vec);
 void			MSG_WriteDeltaUserCmd (msg_t *msg, const struct usercmd_s *from, const struct usercmd_s *to);
 void			MSG_WriteDeltaEntity (msg_t *msg, const struct entity_state_s *from, const struct entity_state_s *to, bool force, bool newEntity);
 
+// Bit stream functions.
+// Bits are packed into the last byte of the message until it is full. Writing
+// or reading anything else always starts at the next whole byte, so bit
+// streams don't need to be explicitly terminated.
+void			MSG_WriteBits (msg_t *msg, int value, int bits);
+int				MSG_ReadBits (msg_t *msg, int bits);
+
+// Returns the number of bits written to the message so far
+int				MSG_GetWrittenBits (const msg_t *msg);
+
+// Appends the given number of bits, as written by the functions above to
+// another message, so previously encoded data can be reused
+void			MSG_WriteBitStream (msg_t *msg, const byte *data, int bits);
+
+// Field table driven deltas used by the bit-packed protocol.
+// Only the fields that changed are sent, each one using as few bits as it can.
+void			MSG_WritePackedDeltaEntity (msg_t *msg, const struct entity_state_s *from, const struct entity_state_s *to, bool force, bool newEntity);
+void			MSG_WritePackedRemoveEntity (msg_t *msg, int number);
+void			MSG_WritePackedDeltaPlayerState (msg_t *msg, const struct player_state_s *from, const struct player_state_s *to);
+
+// Returns the entity number, or 0 at the end of the packet entities
+int				MSG_ReadPackedEntityNumber (msg_t *msg, bool *remove);
+void			MSG_ReadPackedDeltaEntity (msg_t *msg, const struct entity_state_s *from, struct entity_state_s *to, int number);
+void			MSG_ReadPackedDeltaPlayerState (msg_t *msg, const struct player_state_s *from, struct player_state_s *to);
+
 // Reading functions
 void			MSG_BeginReading (msg_t *msg);
 int				MSG_ReadChar (msg_t *msg);
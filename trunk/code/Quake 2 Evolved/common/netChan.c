@@ -31,13 +31,14 @@
 
 netAdr_t					net_from;
 msg_t						net_message;
-byte						net_messageBuffer[MAX_MSGLEN];
+byte						net_messageBuffer[MAX_FRAGMENTED_MSGLEN];
 
 static const char *			net_sourceString[2] = {"client", "server"};
 
 static cvar_t *				net_qport;
 static cvar_t *				net_showPackets;
 static cvar_t *				net_showDrop;
+static cvar_t *				net_compression;
 
 
 /*
@@ -60,6 +61,7 @@ void NetChan_Init (){
 	net_qport = CVar_Register("net_qport", Str_FromInteger(Sys_Milliseconds() & 0xFFFF), CVAR_INTEGER, CVAR_READONLY, "Network channel port", 0, 65535);
 	net_showPackets = CVar_Register("net_showPackets", "0", CVAR_BOOL, 0, "Show incoming/outgoing packets", 0, 0);
 	net_showDrop = CVar_Register("net_showDrop", "0", CVAR_BOOL, 0, "Show packet dropping", 0, 0);
+	net_compression = CVar_Register("net_compression", "0", CVAR_INTEGER, CVAR_ARCHIVE, "Packet compression (0 = off, 1 = static Huffman, 2 = adaptive)", NC_NONE, NC_ADAPTIVE);
 
 	// Initialize the message buffer
 	MSG_Init(&net_message, net_messageBuffer, sizeof(net_messageBuffer), false);
@@ -70,7 +72,7 @@ void NetChan_Init (){
  NetChan_Setup
  ==================
 */
-void NetChan_Setup (netChan_t *netChan, netSrc_t sock, const netAdr_t adr, int port){
+void NetChan_Setup (netChan_t *netChan, netSrc_t sock, const netAdr_t adr, int port, bool fragments){
 
 	Mem_Fill(netChan, 0, sizeof(netChan_t));
 
@@ -80,8 +82,192 @@ void NetChan_Setup (netChan_t *netChan, netSrc_t sock, const netAdr_t adr, int p
 	netChan->lastReceived = Sys_Milliseconds();
 	netChan->incomingSequence = 0;
 	netChan->outgoingSequence = 1;
+	netChan->fragments = fragments;
 
-	MSG_Init(&netChan->message, netChan->messageBuffer, sizeof(netChan->messageBuffer), true);
+	// Reliable messages must fit in a single packet unless they can be split
+	// into fragments
+	if (fragments)
+		MSG_Init(&netChan->message, netChan->messageBuffer, sizeof(netChan->messageBuffer), true);
+	else
+		MSG_Init(&netChan->message, netChan->messageBuffer, MAX_MSGLEN - 16, true);
+}
+
+/*
+ ==================
+ NetChan_CompressPayload
+
+ Replaces the payload with its compressed version if it gets smaller
+ ==================
+*/
+static void NetChan_CompressPayload (netChan_t *netChan, msg_t *msg){
+
+	byte		buffer[MAX_FRAGMENTED_MSGLEN];
+	longlong	ticks;
+	int			size, length;
+
+	ticks = Sys_ClockTicks();
+
+	// The compression header is already written
+	size = msg->curSize - 1;
+
+	length = NetComp_Compress(netChan->compression, msg->data + 1, size, buffer, size - 3);
+	if (length){
+		msg->curSize = 0;
+
+		MSG_WriteByte(msg, netChan->compression);
+		MSG_WriteShort(msg, size);
+		MSG_Write(msg, buffer, length);
+	}
+
+	netChan->payloadBytes += size;
+	netChan->compressedBytes += msg->curSize;
+	netChan->compressionTime += (Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond();
+}
+
+/*
+ ==================
+ NetChan_DecompressPayload
+
+ Replaces the payload with its decompressed version, removing the compression
+ header. Returns false if the payload is corrupt.
+ ==================
+*/
+static bool NetChan_DecompressPayload (netChan_t *netChan, msg_t *msg){
+
+	byte		buffer[MAX_FRAGMENTED_MSGLEN];
+	longlong	ticks;
+	int			offset, mode, size;
+
+	offset = msg->readCount;
+
+	mode = MSG_ReadByte(msg);
+
+	if (mode == NC_NONE){
+		if (msg->readCount > msg->curSize)
+			return false;
+
+		size = msg->curSize - msg->readCount;
+
+		Mem_Copy(buffer, msg->data + msg->readCount, size);
+	}
+	else {
+		if (mode != NC_HUFFMAN && mode != NC_ADAPTIVE)
+			return false;
+
+		size = MSG_ReadShort(msg) & 0xFFFF;
+		if (msg->readCount > msg->curSize || offset + size > msg->maxSize)
+			return false;
+
+		ticks = Sys_ClockTicks();
+
+		if (!NetComp_Decompress(mode, msg->data + msg->readCount, msg->curSize - msg->readCount, buffer, size))
+			return false;
+
+		netChan->decompressionTime += (Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond();
+	}
+
+	Mem_Copy(msg->data + offset, buffer, size);
+
+	msg->readCount = offset;
+	msg->curSize = offset + size;
+
+	return true;
+}
+
+/*
+ ==================
+ NetChan_AddFragment
+
+ Adds a fragment to the message being reassembled. Returns true when the
+ message is complete, in which case the whole payload is copied to the
+ message.
+ ==================
+*/
+static bool NetChan_AddFragment (netChan_t *netChan, msg_t *msg, int sequence, int offset){
+
+	int		fragmentStart, fragmentLength;
+
+	fragmentStart = MSG_ReadShort(msg) & 0xFFFF;
+	fragmentLength = MSG_ReadShort(msg) & 0xFFFF;
+
+	// A new message throws away any incomplete one
+	if (sequence != netChan->fragmentSequence){
+		netChan->fragmentSequence = sequence;
+		netChan->fragmentLength = 0;
+	}
+
+	// Fragments must arrive in order, so losing one drops the whole message
+	if (fragmentStart != netChan->fragmentLength){
+		if (net_showDrop->integerValue)
+			Com_Printf("%s: dropped fragment %i of packet %i\n", NET_AddressToString(netChan->remoteAddress), fragmentStart, sequence);
+
+		return false;
+	}
+
+	if (fragmentLength > FRAGMENT_SIZE || msg->readCount + fragmentLength > msg->curSize || netChan->fragmentLength + fragmentLength > sizeof(netChan->fragmentBuffer)){
+		if (net_showDrop->integerValue)
+			Com_Printf("%s: illegal fragment length %i\n", NET_AddressToString(netChan->remoteAddress), fragmentLength);
+
+		return false;
+	}
+
+	Mem_Copy(netChan->fragmentBuffer + netChan->fragmentLength, msg->data + msg->readCount, fragmentLength);
+	netChan->fragmentLength += fragmentLength;
+
+	// The last fragment is always shorter than a full fragment
+	if (fragmentLength == FRAGMENT_SIZE)
+		return false;
+
+	if (offset + netChan->fragmentLength > msg->maxSize)
+		return false;
+
+	// Copy the payload over the fragment header
+	Mem_Copy(msg->data + offset, netChan->fragmentBuffer, netChan->fragmentLength);
+
+	msg->readCount = offset;
+	msg->curSize = offset + netChan->fragmentLength;
+
+	netChan->fragmentLength = 0;
+
+	return true;
+}
+
+/*
+ ==================
+ NetChan_SendPacket
+
+ Adds the packet header and sends a single packet. A fragment offset of -1
+ means the packet holds the whole message.
+ ==================
+*/
+static int NetChan_SendPacket (netChan_t *netChan, uint w1, uint w2, int fragmentStart, const byte *data, int length){
+
+	byte	buffer[MAX_FRAGMENTED_MSGLEN];
+	msg_t	msg;
+
+	MSG_Init(&msg, buffer, sizeof(buffer), false);
+
+	if (fragmentStart != -1)
+		w1 |= FRAGMENT_BIT;
+
+	MSG_WriteLong(&msg, w1);
+	MSG_WriteLong(&msg, w2);
+
+	// Send the qport if we are a client
+	if (netChan->sock == NS_CLIENT)
+		MSG_WriteShort(&msg, net_qport->integerValue);
+
+	if (fragmentStart != -1){
+		MSG_WriteShort(&msg, fragmentStart);
+		MSG_WriteShort(&msg, length);
+	}
+
+	MSG_Write(&msg, data, length);
+
+	// Send the datagram
+	NET_SendPacket(netChan->sock, netChan->remoteAddress, msg.data, msg.curSize);
+
+	return msg.curSize;
 }
 
 /*
@@ -89,17 +275,18 @@ void NetChan_Setup (netChan_t *netChan, netSrc_t sock, const netAdr_t adr, int p
  NetChan_Transmit
  ==================
 */
-void NetChan_Transmit (netChan_t *netChan, const void *data, int length){
+int NetChan_Transmit (netChan_t *netChan, const void *data, int length){
 
-	byte	buffer[MAX_MSGLEN];
+	byte	buffer[MAX_FRAGMENTED_MSGLEN - PACKET_HEADER];
 	msg_t	msg;
 	bool	sendReliable = false;
 	uint	w1, w2;
+	int		offset, size = 0;
 
 	// Check for message overflow
 	if (netChan->message.overflowed){
 		Com_Printf(S_COLOR_YELLOW "%s: outgoing message overflow\n", NET_AddressToString(netChan->remoteAddress));
-		return;
+		return 0;
 	}
 
 	// If the remote side dropped the last reliable message, resend it
@@ -119,20 +306,22 @@ void NetChan_Transmit (netChan_t *netChan, const void *data, int length){
 	}
 
 	// Write the packet header
-	MSG_Init(&msg, buffer, sizeof(buffer), false);
-
 	w1 = (netChan->outgoingSequence & ~(1 << 31)) | (sendReliable<<31);
 	w2 = (netChan->incomingSequence & ~(1 << 31)) | (netChan->incomingReliableSequence<<31);
 
 	netChan->outgoingSequence++;
 	netChan->lastSent = Sys_Milliseconds();
 
-	MSG_WriteLong(&msg, w1);
-	MSG_WriteLong(&msg, w2);
+	// Messages that can't be fragmented must fit in a single packet along
+	// with the header
+	if (netChan->fragments)
+		MSG_Init(&msg, buffer, sizeof(buffer), false);
+	else
+		MSG_Init(&msg, buffer, MAX_MSGLEN - PACKET_HEADER, false);
 
-	// Send the qport if we are a client
-	if (netChan->sock == NS_CLIENT)
-		MSG_WriteShort(&msg, net_qport->integerValue);
+	// Write the compression header, the payload is sent as-is for now
+	if (netChan->compression != NC_NONE)
+		MSG_WriteByte(&msg, NC_NONE);
 
 	// Copy the reliable message to the packet first
 	if (sendReliable){
@@ -146,15 +335,32 @@ void NetChan_Transmit (netChan_t *netChan, const void *data, int length){
 	else
 		Com_Printf(S_COLOR_YELLOW "%s: dumped unreliable\n", NET_AddressToString(netChan->remoteAddress));
 
-	// Send the datagram
-	NET_SendPacket(netChan->sock, netChan->remoteAddress, msg.data, msg.curSize);
+	// Compress the payload if needed
+	if (netChan->compression != NC_NONE)
+		NetChan_CompressPayload(netChan, &msg);
+
+	// Send the datagram, splitting it into fragments if needed. Loopback
+	// packets can be of any size.
+	if (!netChan->fragments || msg.curSize <= FRAGMENT_SIZE || NET_IsLocalAddress(netChan->remoteAddress))
+		size = NetChan_SendPacket(netChan, w1, w2, -1, msg.data, msg.curSize);
+	else {
+		for (offset = 0; offset <= msg.curSize; offset += FRAGMENT_SIZE){
+			length = Min(msg.curSize - offset, FRAGMENT_SIZE);
+
+			// If the message is a multiple of the fragment size, an empty
+			// fragment marks the end
+			size += NetChan_SendPacket(netChan, w1, w2, offset, msg.data + offset, length);
+		}
+	}
 
 	if (net_showPackets->integerValue){
 		if (sendReliable)
-			Com_Printf("%s send %4i: seq=%i reliable=%i ack=%i rack=%i\n", net_sourceString[netChan->sock], msg.curSize, netChan->outgoingSequence - 1, netChan->reliableSequence, netChan->incomingSequence, netChan->incomingReliableSequence);
+			Com_Printf("%s send %4i: seq=%i reliable=%i ack=%i rack=%i\n", net_sourceString[netChan->sock], size, netChan->outgoingSequence - 1, netChan->reliableSequence, netChan->incomingSequence, netChan->incomingReliableSequence);
 		else
-			Com_Printf("%s send %4i: seq=%i ack=%i rack=%i\n", net_sourceString[netChan->sock], msg.curSize, netChan->outgoingSequence - 1, netChan->incomingSequence, netChan->incomingReliableSequence);
+			Com_Printf("%s send %4i: seq=%i ack=%i rack=%i\n", net_sourceString[netChan->sock], size, netChan->outgoingSequence - 1, netChan->incomingSequence, netChan->incomingReliableSequence);
 	}
+
+	return size;
 }
 
 /*
@@ -166,7 +372,8 @@ bool NetChan_Process (netChan_t *netChan, msg_t *msg){
 
 	uint	sequence, sequenceAck;
 	uint	reliableAck, reliableMessage;
-	int		port;
+	bool	fragmented = false;
+	int		port, offset;
 
 	MSG_BeginReading(msg);
 
@@ -178,12 +385,21 @@ bool NetChan_Process (netChan_t *netChan, msg_t *msg){
 	if (netChan->sock == NS_SERVER)
 		port = MSG_ReadShort(msg);
 
+	// The payload will be moved here after removing the fragment and
+	// compression headers
+	offset = msg->readCount;
+
 	reliableMessage = sequence >> 31;
 	reliableAck = sequenceAck >> 31;
 
 	sequence &= ~(1 << 31);
 	sequenceAck &= ~(1 << 31);	
 
+	if (netChan->fragments){
+		fragmented = (sequence & FRAGMENT_BIT) != 0;
+		sequence &= ~FRAGMENT_BIT;
+	}
+
 	if (net_showPackets->integerValue){
 		if (reliableMessage)
 			Com_Printf("%s recv %4i: seq=%i reliable=%i ack=%i rack=%i\n", net_sourceString[netChan->sock], msg->curSize, sequence, netChan->incomingReliableSequence ^ 1, sequenceAck, reliableAck);
@@ -199,6 +415,22 @@ bool NetChan_Process (netChan_t *netChan, msg_t *msg){
 		return false;
 	}
 
+	// Wait until all the fragments have been received
+	if (fragmented){
+		if (!NetChan_AddFragment(netChan, msg, sequence, offset))
+			return false;
+	}
+
+	// Decompress the payload if needed
+	if (netChan->compression != NC_NONE){
+		if (!NetChan_DecompressPayload(netChan, msg)){
+			if (net_showDrop->integerValue)
+				Com_Printf("%s: bad compressed packet %i\n", NET_AddressToString(netChan->remoteAddress), sequence);
+
+			return false;
+		}
+	}
+
 	// Dropped packets don't keep the message from being used
 	netChan->dropped = sequence - (netChan->incomingSequence + 1);
 	if (netChan->dropped > 0){
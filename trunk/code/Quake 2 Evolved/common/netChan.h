@@ -45,6 +45,23 @@
  1		Acknowledge receipt of even/odd message
  16		qport
 
+ If fragmented messages were negotiated when connecting, bit 30 of the
+ sequence is set on fragments, which are followed by a fragment header:
+ 16		fragment offset
+ 16		fragment length
+
+ If compression was negotiated when connecting, the payload follows a
+ compression header:
+ 8		compression mode, or 0 if the payload was sent as-is
+ 16		uncompressed payload size (not present if sent as-is)
+
+ Messages larger than a packet (up to MAX_FRAGMENTED_MSGLEN) are split into
+ fragments that all share the same sequence number. A fragment shorter than
+ FRAGMENT_SIZE ends the message, so an empty fragment is sent if the message
+ size is a multiple of FRAGMENT_SIZE. The whole message is dropped if any of
+ its fragments is lost, in which case the reliable part will be resent as
+ usual. Loopback messages are never fragmented.
+
  The remote connection never knows if it missed a reliable message, the
  local side detects that it has been dropped by seeing a sequence
  acknowledge higher than the last reliable sequence, but without the
@@ -93,6 +110,10 @@
  ==============================================================================
 */
 
+#define PACKET_HEADER				14			// Largest possible packet header
+#define FRAGMENT_SIZE				(MAX_MSGLEN - 100)
+#define FRAGMENT_BIT				(1<<30)
+
 typedef struct {
 	netSrc_t				sock;
 
@@ -114,13 +135,28 @@ typedef struct {
 	int						reliableSequence;				// Single bit
 	int						lastReliableSequence;			// Sequence number of last send
 
+	// Messages larger than a packet, negotiated when connecting
+	bool					fragments;
+
+	int						fragmentSequence;				// Message being reassembled
+	int						fragmentLength;
+	byte					fragmentBuffer[MAX_FRAGMENTED_MSGLEN];
+
+	// Payload compression, negotiated when connecting
+	netCompression_t		compression;
+
+	longlong				payloadBytes;					// Outgoing bytes before compression
+	longlong				compressedBytes;				// Outgoing bytes after compression
+	longlong				compressionTime;				// Microseconds spent compressing
+	longlong				decompressionTime;				// Microseconds spent decompressing
+
 	// Reliable staging and holding areas
 	msg_t					message;						// Writing buffer to send to server
-	byte					messageBuffer[MAX_MSGLEN-16];	// Leave space for header
+	byte					messageBuffer[MAX_FRAGMENTED_MSGLEN-16];	// Leave space for header
 
 	// Message is copied to this buffer when it is first transfered
 	int						reliableLength;
-	byte					reliableBuffer[MAX_MSGLEN-16];	// Unacked reliable message
+	byte					reliableBuffer[MAX_FRAGMENTED_MSGLEN-16];	// Unacked reliable message
 } netChan_t;
 
 extern netAdr_t				net_from;
@@ -129,14 +165,16 @@ extern msg_t				net_message;
 // Initializes the network channel subsystem
 void			NetChan_Init ();
 
-// Opens a channel to a remote system
-void			NetChan_Setup (netChan_t *netChan, netSrc_t sock, const netAdr_t adr, int port);
+// Opens a channel to a remote system. If fragments is true, messages can be
+// larger than a single packet.
+void			NetChan_Setup (netChan_t *netChan, netSrc_t sock, const netAdr_t adr, int port, bool fragments);
 
 // Tries to send an unreliable message to a connection, and handles the
 // transmition / retransmition of the reliable messages.
 // A 0 length will still generate a packet and deal with the reliable 
 // messages.
-void			NetChan_Transmit (netChan_t *netChan, const void *data, int length);
+// Returns the size of the packet that was sent.
+int				NetChan_Transmit (netChan_t *netChan, const void *data, int length);
 
 // Called when the current net_message is from remoteAddress. Modifies 
 // net_message so that it points to the packet payload.
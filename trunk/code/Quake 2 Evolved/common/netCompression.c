@@ -0,0 +1,779 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+//
+// netCompression.c - Network packet compression
+//
+
+
+#include "common.h"
+
+
+#define MAX_CODE_BITS				16
+
+#define RC_TOP						(1U << 24)
+#define RC_BOT						(1U << 16)
+
+#define MODEL_TOTAL					1024		// Total of the initial adaptive model
+#define MODEL_INCREMENT				24			// Added to a symbol every time it is coded
+
+typedef struct {
+	// Encoding tables
+	uint					codes[256];
+	int						lengths[256];
+
+	// Canonical decoding tables
+	int						firstCode[MAX_CODE_BITS + 1];
+	int						firstIndex[MAX_CODE_BITS + 1];
+	int						count[MAX_CODE_BITS + 1];
+	byte					symbols[256];
+} huffmanCode_t;
+
+typedef struct {
+	int						total;
+	int						freqs[256];
+	int						tree[257];					// Fenwick tree of the frequencies
+} adaptiveModel_t;
+
+typedef struct {
+	uint					low;
+	uint					range;
+	uint					code;
+
+	byte *					data;
+	int						size;
+	int						pos;
+} rangeCoder_t;
+
+// Byte frequencies of server to client messages. Regenerate this table with
+// trainNetCompression after changing the protocol.
+static const int			netComp_frequencies[256] = {
+	12000,  1867,  1195,   871,   682,   558,   471,   407,   368,   319,   332,   261,   239,   220,   204,   190,
+	  188,   167,   158,   149,   141,   134,   128,   122,   127,   112,   107,   103,    99,    96,    92,    89,
+	  141,    84,    81,    79,    76,    74,    72,    70,    78,    66,    65,    63,    62,    60,   104,   103,
+	   96,    85,    84,    83,    82,    81,    80,    79,    88,    77,    46,    45,    45,    44,    43,    42,
+	   52,    71,    70,    70,    69,    68,    68,    67,    77,    66,    66,    65,    65,    64,    64,    63,
+	   73,    63,    62,    62,    61,    61,    61,    60,    70,    60,    59,    29,    74,    28,    28,    73,
+	   37,    87,    87,    87,    86,    86,    86,    86,    95,    85,    85,    85,    84,    84,    84,    84,
+	   94,    83,    83,    83,    83,    83,    82,    82,    92,    82,    82,    22,    21,    21,    21,    21,
+	   31,    21,    21,    20,    20,    20,    20,    20,    30,    20,    20,    19,    19,    19,    19,    19,
+	   29,    19,    19,    19,    18,    18,    18,    18,    28,    18,    18,    18,    18,    18,    18,    18,
+	   27,    17,    17,    17,    17,    17,    17,    17,    27,    17,    17,    17,    17,    17,    17,    17,
+	   27,    17,    17,    16,    16,    16,    16,    16,    26,    16,    16,    16,    16,    16,    16,    16,
+	   26,    16,    16,    16,    16,    16,    16,    16,    26,    17,    17,    17,    17,    17,    17,    17,
+	   27,    17,    17,    17,    17,    18,    18,    18,    28,    18,    18,    18,    19,    19,    19,    19,
+	   30,    20,    20,    21,    21,    22,    22,    23,    33,    24,    25,    25,    26,    27,    28,    30,
+	   41,    33,    35,    37,    40,    43,    47,    52,    69,    67,    79,    96,   123,   170,   270,   609
+};
+
+static huffmanCode_t		netComp_huffman;
+static adaptiveModel_t		netComp_model;
+
+static uint					netComp_checksum;
+
+
+/*
+ ==============================================================================
+
+ STATIC HUFFMAN CODING
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ NetComp_BuildCodeLengths
+
+ Returns the length of the longest code
+ ==================
+*/
+static int NetComp_BuildCodeLengths (const int *frequencies, int *lengths){
+
+	int		weights[511], parents[511];
+	bool	merged[511];
+	int		numNodes, node1, node2;
+	int		maxLength = 0;
+	int		i, j;
+
+	for (i = 0; i < 256; i++){
+		weights[i] = Max(frequencies[i], 1);
+		merged[i] = false;
+	}
+
+	// Merge the two lightest nodes until only the root is left
+	for (numNodes = 256; numNodes < 511; numNodes++){
+		node1 = node2 = -1;
+
+		for (j = 0; j < numNodes; j++){
+			if (merged[j])
+				continue;
+
+			if (node1 == -1 || weights[j] < weights[node1]){
+				node2 = node1;
+				node1 = j;
+			}
+			else if (node2 == -1 || weights[j] < weights[node2])
+				node2 = j;
+		}
+
+		weights[numNodes] = weights[node1] + weights[node2];
+		merged[numNodes] = false;
+
+		parents[node1] = numNodes;
+		parents[node2] = numNodes;
+
+		merged[node1] = true;
+		merged[node2] = true;
+	}
+
+	// The length of a code is the depth of its leaf
+	for (i = 0; i < 256; i++){
+		lengths[i] = 0;
+
+		for (j = i; j != 510; j = parents[j])
+			lengths[i]++;
+
+		maxLength = Max(maxLength, lengths[i]);
+	}
+
+	return maxLength;
+}
+
+/*
+ ==================
+ NetComp_BuildHuffmanCode
+ ==================
+*/
+static void NetComp_BuildHuffmanCode (huffmanCode_t *huffman, const int *frequencies){
+
+	int		scaled[256];
+	int		code, index;
+	int		i, length;
+
+	for (i = 0; i < 256; i++)
+		scaled[i] = Max(frequencies[i], 1);
+
+	// Flatten the frequencies until no code is too long
+	while (NetComp_BuildCodeLengths(scaled, huffman->lengths) > MAX_CODE_BITS){
+		for (i = 0; i < 256; i++)
+			scaled[i] = (scaled[i] + 1) >> 1;
+	}
+
+	// Assign canonical codes, ordered by length and then by symbol
+	Mem_Fill(huffman->count, 0, sizeof(huffman->count));
+
+	for (i = 0; i < 256; i++)
+		huffman->count[huffman->lengths[i]]++;
+
+	code = 0;
+	index = 0;
+
+	for (length = 1; length <= MAX_CODE_BITS; length++){
+		huffman->firstCode[length] = code;
+		huffman->firstIndex[length] = index;
+
+		for (i = 0; i < 256; i++){
+			if (huffman->lengths[i] != length)
+				continue;
+
+			huffman->codes[i] = code++;
+			huffman->symbols[index++] = i;
+		}
+
+		code <<= 1;
+	}
+}
+
+/*
+ ==================
+ NetComp_HuffmanCompress
+ ==================
+*/
+static int NetComp_HuffmanCompress (const huffmanCode_t *huffman, const byte *in, int inSize, byte *out, int maxSize){
+
+	uint	bits = 0;
+	int		numBits = 0;
+	int		size = 0;
+	int		i;
+
+	for (i = 0; i < inSize; i++){
+		bits = (bits << huffman->lengths[in[i]]) | huffman->codes[in[i]];
+		numBits += huffman->lengths[in[i]];
+
+		while (numBits >= 8){
+			if (size == maxSize)
+				return 0;
+
+			numBits -= 8;
+			out[size++] = bits >> numBits;
+		}
+	}
+
+	// Flush the remaining bits
+	if (numBits){
+		if (size == maxSize)
+			return 0;
+
+		out[size++] = bits << (8 - numBits);
+	}
+
+	return size;
+}
+
+/*
+ ==================
+ NetComp_HuffmanDecompress
+ ==================
+*/
+static bool NetComp_HuffmanDecompress (const huffmanCode_t *huffman, const byte *in, int inSize, byte *out, int outSize){
+
+	int		bitPos = 0, numBits = inSize << 3;
+	int		code, length;
+	int		i;
+
+	for (i = 0; i < outSize; i++){
+		code = 0;
+
+		for (length = 1; length <= MAX_CODE_BITS; length++){
+			if (bitPos == numBits)
+				return false;
+
+			code = (code << 1) | ((in[bitPos >> 3] >> (7 - (bitPos & 7))) & 1);
+			bitPos++;
+
+			if (code - huffman->firstCode[length] < huffman->count[length])
+				break;
+		}
+
+		if (length > MAX_CODE_BITS)
+			return false;
+
+		out[i] = huffman->symbols[huffman->firstIndex[length] + code - huffman->firstCode[length]];
+	}
+
+	return true;
+}
+
+
+/*
+ ==============================================================================
+
+ ADAPTIVE RANGE CODING
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ NetComp_AddFrequency
+ ==================
+*/
+static void NetComp_AddFrequency (adaptiveModel_t *model, int symbol, int amount){
+
+	int		i;
+
+	model->freqs[symbol] += amount;
+	model->total += amount;
+
+	for (i = symbol + 1; i <= 256; i += i & -i)
+		model->tree[i] += amount;
+}
+
+/*
+ ==================
+ NetComp_CumulativeFrequency
+
+ Returns the sum of the frequencies of all the symbols before the given one
+ ==================
+*/
+static int NetComp_CumulativeFrequency (const adaptiveModel_t *model, int symbol){
+
+	int		sum = 0;
+	int		i;
+
+	for (i = symbol; i > 0; i -= i & -i)
+		sum += model->tree[i];
+
+	return sum;
+}
+
+/*
+ ==================
+ NetComp_FindSymbol
+
+ Returns the symbol whose cumulative frequency range holds the given value
+ ==================
+*/
+static int NetComp_FindSymbol (const adaptiveModel_t *model, int value, int *cumulative){
+
+	int		symbol = 0;
+	int		step;
+
+	*cumulative = 0;
+
+	for (step = 256; step; step >>= 1){
+		if (symbol + step > 256 || model->tree[symbol + step] > value)
+			continue;
+
+		symbol += step;
+		value -= model->tree[symbol];
+
+		*cumulative += model->tree[symbol];
+	}
+
+	return symbol;
+}
+
+/*
+ ==================
+ NetComp_SetupModel
+ ==================
+*/
+static void NetComp_SetupModel (adaptiveModel_t *model, const int *frequencies){
+
+	int		i;
+
+	Mem_Fill(model, 0, sizeof(adaptiveModel_t));
+
+	for (i = 0; i < 256; i++)
+		NetComp_AddFrequency(model, i, Max(frequencies[i], 1));
+}
+
+/*
+ ==================
+ NetComp_UpdateModel
+ ==================
+*/
+static void NetComp_UpdateModel (adaptiveModel_t *model, int symbol){
+
+	int		frequencies[256];
+	int		i;
+
+	NetComp_AddFrequency(model, symbol, MODEL_INCREMENT);
+
+	if (model->total + MODEL_INCREMENT <= RC_BOT)
+		return;
+
+	// Halve the frequencies so the total stays in range
+	for (i = 0; i < 256; i++)
+		frequencies[i] = (model->freqs[i] + 1) >> 1;
+
+	NetComp_SetupModel(model, frequencies);
+}
+
+/*
+ ==================
+ NetComp_EncodeSymbol
+ ==================
+*/
+static bool NetComp_EncodeSymbol (rangeCoder_t *rc, uint cumulative, uint frequency, uint total){
+
+	rc->range /= total;
+	rc->low += cumulative * rc->range;
+	rc->range *= frequency;
+
+	while (1){
+		if ((rc->low ^ (rc->low + rc->range)) >= RC_TOP){
+			if (rc->range >= RC_BOT)
+				break;
+
+			rc->range = -rc->low & (RC_BOT - 1);
+		}
+
+		if (rc->pos == rc->size)
+			return false;
+
+		rc->data[rc->pos++] = rc->low >> 24;
+
+		rc->low <<= 8;
+		rc->range <<= 8;
+	}
+
+	return true;
+}
+
+/*
+ ==================
+ NetComp_DecodeSymbol
+ ==================
+*/
+static void NetComp_DecodeSymbol (rangeCoder_t *rc, uint cumulative, uint frequency){
+
+	rc->low += cumulative * rc->range;
+	rc->range *= frequency;
+
+	while (1){
+		if ((rc->low ^ (rc->low + rc->range)) >= RC_TOP){
+			if (rc->range >= RC_BOT)
+				break;
+
+			rc->range = -rc->low & (RC_BOT - 1);
+		}
+
+		rc->code <<= 8;
+
+		if (rc->pos < rc->size)
+			rc->code |= rc->data[rc->pos];
+
+		rc->pos++;
+
+		rc->low <<= 8;
+		rc->range <<= 8;
+	}
+}
+
+/*
+ ==================
+ NetComp_AdaptiveCompress
+ ==================
+*/
+static int NetComp_AdaptiveCompress (const byte *in, int inSize, byte *out, int maxSize){
+
+	adaptiveModel_t	model;
+	rangeCoder_t	rc;
+	int				i;
+
+	Mem_Copy(&model, &netComp_model, sizeof(adaptiveModel_t));
+
+	rc.low = 0;
+	rc.range = 0xFFFFFFFF;
+	rc.code = 0;
+	rc.data = out;
+	rc.size = maxSize;
+	rc.pos = 0;
+
+	for (i = 0; i < inSize; i++){
+		if (!NetComp_EncodeSymbol(&rc, NetComp_CumulativeFrequency(&model, in[i]), model.freqs[in[i]], model.total))
+			return 0;
+
+		NetComp_UpdateModel(&model, in[i]);
+	}
+
+	// Flush the low end of the range
+	for (i = 0; i < 4; i++){
+		if (rc.pos == rc.size)
+			return 0;
+
+		rc.data[rc.pos++] = rc.low >> 24;
+		rc.low <<= 8;
+	}
+
+	return rc.pos;
+}
+
+/*
+ ==================
+ NetComp_AdaptiveDecompress
+ ==================
+*/
+static bool NetComp_AdaptiveDecompress (const byte *in, int inSize, byte *out, int outSize){
+
+	adaptiveModel_t	model;
+	rangeCoder_t	rc;
+	uint			value;
+	int				symbol, cumulative;
+	int				i;
+
+	if (inSize < 4)
+		return false;
+
+	Mem_Copy(&model, &netComp_model, sizeof(adaptiveModel_t));
+
+	rc.low = 0;
+	rc.range = 0xFFFFFFFF;
+	rc.code = (in[0] << 24) | (in[1] << 16) | (in[2] << 8) | in[3];
+	rc.data = (byte *)in;
+	rc.size = inSize;
+	rc.pos = 4;
+
+	for (i = 0; i < outSize; i++){
+		rc.range /= model.total;
+
+		value = (rc.code - rc.low) / rc.range;
+		if (value >= (uint)model.total)
+			return false;
+
+		symbol = NetComp_FindSymbol(&model, value, &cumulative);
+
+		NetComp_DecodeSymbol(&rc, cumulative, model.freqs[symbol]);
+
+		// Reading far past the end means the data is corrupt
+		if (rc.pos > rc.size + 4)
+			return false;
+
+		NetComp_UpdateModel(&model, symbol);
+
+		out[i] = symbol;
+	}
+
+	return true;
+}
+
+
+/*
+ ==============================================================================
+
+ PUBLIC INTERFACE
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ NetComp_Compress
+ ==================
+*/
+int NetComp_Compress (netCompression_t mode, const byte *in, int inSize, byte *out, int maxSize){
+
+	if (inSize <= 0 || maxSize <= 0)
+		return 0;
+
+	switch (mode){
+	case NC_HUFFMAN:
+		return NetComp_HuffmanCompress(&netComp_huffman, in, inSize, out, maxSize);
+	case NC_ADAPTIVE:
+		return NetComp_AdaptiveCompress(in, inSize, out, maxSize);
+	}
+
+	return 0;
+}
+
+/*
+ ==================
+ NetComp_Decompress
+ ==================
+*/
+bool NetComp_Decompress (netCompression_t mode, const byte *in, int inSize, byte *out, int outSize){
+
+	switch (mode){
+	case NC_HUFFMAN:
+		return NetComp_HuffmanDecompress(&netComp_huffman, in, inSize, out, outSize);
+	case NC_ADAPTIVE:
+		return NetComp_AdaptiveDecompress(in, inSize, out, outSize);
+	}
+
+	return false;
+}
+
+/*
+ ==================
+ NetComp_TableChecksum
+ ==================
+*/
+uint NetComp_TableChecksum (){
+
+	return netComp_checksum;
+}
+
+
+/*
+ ==============================================================================
+
+ CONSOLE COMMANDS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ NetComp_CodedBits
+ ==================
+*/
+static double NetComp_CodedBits (const huffmanCode_t *huffman, const double *counts){
+
+	double	bits = 0.0;
+	int		i;
+
+	for (i = 0; i < 256; i++)
+		bits += counts[i] * huffman->lengths[i];
+
+	return bits;
+}
+
+/*
+ ==================
+ NetComp_TrainNetCompression_f
+
+ Counts the bytes of all the messages in the given demos, and writes a new
+ frequency table that can be pasted into netCompression.c
+ ==================
+*/
+static void NetComp_TrainNetCompression_f (){
+
+	huffmanCode_t	*huffman;
+	char			name[MAX_OSPATH];
+	char			*text;
+	double			counts[256], total = 0.0, maxCount = 0.0;
+	int				frequencies[256];
+	byte			*data;
+	int				size, offset, length;
+	int				numDemos = 0, numMessages = 0;
+	int				i, textLength;
+
+	if (Cmd_Argc() < 2){
+		Com_Printf("Usage: trainNetCompression <demo> [demo ...]\n");
+		return;
+	}
+
+	Mem_Fill(counts, 0, sizeof(counts));
+
+	for (i = 1; i < Cmd_Argc(); i++){
+		Str_SPrintf(name, sizeof(name), "demos/%s", Cmd_Argv(i));
+		Str_DefaultFileExtension(name, sizeof(name), ".dm2");
+
+		size = FS_ReadFile(name, (void **)&data);
+		if (!data){
+			Com_Printf("Couldn't load %s\n", name);
+			continue;
+		}
+
+		// Demos are a sequence of messages, each preceded by its length
+		offset = 0;
+
+		while (offset + 4 <= size){
+			length = LittleLong(*(int *)(data + offset));
+			offset += 4;
+
+			if (length < 0 || length > MAX_FRAGMENTED_MSGLEN || offset + length > size)
+				break;
+
+			for ( ; length; length--, offset++)
+				counts[data[offset]] += 1.0;
+
+			numMessages++;
+		}
+
+		FS_FreeFile(data);
+
+		numDemos++;
+	}
+
+	for (i = 0; i < 256; i++){
+		total += counts[i];
+		maxCount = Max(maxCount, counts[i]);
+	}
+
+	if (!numMessages || total == 0.0){
+		Com_Printf("No messages found\n");
+		return;
+	}
+
+	// Scale the counts so the table doesn't overflow when building codes
+	for (i = 0; i < 256; i++)
+		frequencies[i] = Max((int)(counts[i] * 65535.0 / maxCount), 1);
+
+	// Compare the current table with the new one
+	huffman = (huffmanCode_t *)Mem_Alloc(sizeof(huffmanCode_t), TAG_TEMPORARY);
+
+	NetComp_BuildHuffmanCode(huffman, frequencies);
+
+	Com_Printf("%i demos, %i messages, %.0f bytes\n", numDemos, numMessages, total);
+	Com_Printf("Current table: %5.1f%% of the original size\n", NetComp_CodedBits(&netComp_huffman, counts) * 100.0 / (total * 8.0));
+	Com_Printf("Trained table: %5.1f%% of the original size\n", NetComp_CodedBits(huffman, counts) * 100.0 / (total * 8.0));
+
+	Mem_Free(huffman);
+
+	// Write the table
+	textLength = 256 * 8 + 64;
+	text = (char *)Mem_Alloc(textLength, TAG_TEMPORARY);
+
+	Str_Copy(text, "static const int\t\t\tnetComp_frequencies[256] = {\n", textLength);
+
+	for (i = 0; i < 256; i++){
+		if (!(i & 15))
+			Str_Append(text, "\t", textLength);
+
+		Str_Append(text, Str_VarArgs("%5i", frequencies[i]), textLength);
+
+		if (i != 255)
+			Str_Append(text, ",", textLength);
+
+		if ((i & 15) == 15)
+			Str_Append(text, "\n", textLength);
+		else
+			Str_Append(text, " ", textLength);
+	}
+
+	Str_Append(text, "};\n", textLength);
+
+	if (FS_WriteFile("netCompression.txt", text, Str_Length(text)))
+		Com_Printf("Wrote netCompression.txt\n");
+	else
+		Com_Printf("Couldn't write netCompression.txt\n");
+
+	Mem_Free(text);
+}
+
+
+/*
+ ==============================================================================
+
+ INITIALIZATION AND SHUTDOWN
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ NetComp_Init
+ ==================
+*/
+void NetComp_Init (){
+
+	int		frequencies[256];
+	int		total = 0;
+	int		i;
+
+	// Add commands
+	Cmd_AddCommand("trainNetCompression", NetComp_TrainNetCompression_f, "Trains the network compression table on recorded demos", NULL);
+
+	// Build the Huffman code
+	NetComp_BuildHuffmanCode(&netComp_huffman, netComp_frequencies);
+
+	// Scale the initial adaptive model down so it can adapt quickly
+	for (i = 0; i < 256; i++)
+		total += netComp_frequencies[i];
+
+	for (i = 0; i < 256; i++)
+		frequencies[i] = Max(netComp_frequencies[i] * MODEL_TOTAL / total, 1);
+
+	NetComp_SetupModel(&netComp_model, frequencies);
+
+	netComp_checksum = MD4_BlockChecksum(netComp_frequencies, sizeof(netComp_frequencies));
+}
+
+/*
+ ==================
+ NetComp_Shutdown
+ ==================
+*/
+void NetComp_Shutdown (){
+
+	// Remove commands
+	Cmd_RemoveCommand("trainNetCompression");
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+//
+// netCompression.h - Network packet compression
+//
+
+
+#ifndef __NETCOMPRESSION_H__
+#define __NETCOMPRESSION_H__
+
+
+/*
+ ==============================================================================
+
+ Network Compression:
+
+ Packet payloads can be compressed with a static Huffman code, or with an
+ adaptive range coder that starts from the same byte frequencies and adapts
+ to the data as it is coded.
+
+ Both coders start over for every packet, so a dropped packet never affects
+ the decoding of other packets.
+
+ The byte frequencies come from a table built into the engine. A new table
+ can be trained on recorded demos with the trainNetCompression command. Both
+ sides of a connection must use the same table, so the table checksum is
+ checked when the compression mode is negotiated.
+
+ ==============================================================================
+*/
+
+typedef enum {
+	NC_NONE,
+	NC_HUFFMAN,								// Static Huffman code
+	NC_ADAPTIVE								// Adaptive range coder
+} netCompression_t;
+
+// Compresses a block of data. Returns the compressed size, or 0 if the data
+// couldn't be compressed into less than maxSize bytes.
+int				NetComp_Compress (netCompression_t mode, const byte *in, int inSize, byte *out, int maxSize);
+
+// Decompresses a block of data of the given decompressed size. Returns false
+// if the compressed data is corrupt.
+bool			NetComp_Decompress (netCompression_t mode, const byte *in, int inSize, byte *out, int outSize);
+
+// Returns a checksum of the byte frequency table
+uint			NetComp_TableChecksum ();
+
+// Initializes network compression
+void			NetComp_Init ();
+
+// Shuts down network compression
+void			NetComp_Shutdown ();
+
+
+#endif	// __NETCOMPRESSION_H__
\ No newline at end of file
@@ -40,7 +40,7 @@
 #define	MAX_LOOPBACK				4
 
 typedef struct {
-	byte					data[MAX_MSGLEN];
+	byte					data[MAX_FRAGMENTED_MSGLEN];	// Messages are never fragmented
 	int						dataLength;
 } loopMsg_t;
 
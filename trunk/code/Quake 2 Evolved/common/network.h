@@ -49,6 +49,7 @@
 #define	PORT_ANY					-1
 
 #define	MAX_MSGLEN					1400		// Max length of a message
+#define MAX_FRAGMENTED_MSGLEN		16384		// Max length of a message split into several packets
 
 typedef enum {
 	NS_CLIENT, 
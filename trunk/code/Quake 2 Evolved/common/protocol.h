@@ -43,13 +43,14 @@
  ==============================================================================
 */
 
-#define	PROTOCOL_VERSION			34
+#define	PROTOCOL_VERSION			35		// Bit-packed deltas
+#define	PROTOCOL_VERSION_LEGACY		34		// Byte-aligned deltas, used by old clients and demos
 
 #define	UPDATE_BACKUP				16
 #define	UPDATE_MASK					(UPDATE_BACKUP-1)
 
 // Server to client
-enum {
+typedef enum {
 	SVC_BAD,
 
 	// These ops are known to the game library
@@ -78,7 +79,7 @@ enum {
 } svcOps_t;
 
 // Client to server
-enum {
+typedef enum {
 	CLC_BAD,
 	CLC_NOP, 		
 	CLC_MOVE,					// [usercmd_t]
@@ -160,5 +161,10 @@ enum {
 #define	U_SOUND						(1<<26)
 #define	U_SOLID						(1<<27)
 
+// Bit-packed entity_state_t communication.
+// Every entity starts with its number and a remove bit, and the packet
+// entities end with entity number 0.
+#define	ENTITYNUM_BITS				10			// Enough for MAX_EDICTS
+
 
 #endif	// __PROTOCOL_H__
\ No newline at end of file
@@ -79,6 +79,13 @@ const char *	Sys_DefaultSaveDirectory ();
 // containing the given directory
 int				Sys_DiskFreeSpace (const char *directory);
 
+// Maps the given file into memory for reading and sets its size.
+// Returns NULL if the file could not be mapped.
+const void *	Sys_MapFile (const char *path, int *size);
+
+// Unmaps a file mapped by Sys_MapFile
+void			Sys_UnmapFile (const void *data);
+
 // Loads the given dynamic library
 void *			Sys_LoadLibrary (const char *libPath);
 
@@ -88,6 +95,58 @@ void			Sys_FreeLibrary (void *libHandle);
 // Gets the address of the given procedure from the given dynamic library
 void *			Sys_GetProcAddress (void *libHandle, const char *procName);
 
+// Creates a thread that will run the given function with the given data.
+// The name is only used for debugging.
+void *			Sys_CreateThread (void (*function)(void *), void *data, const char *name);
+
+// Waits for the given thread to finish and destroys it
+void			Sys_DestroyThread (void *thread);
+
+// Creates an event.
+// When an auto-reset event is signaled, a single waiting thread is released
+// and the event is reset automatically. A manual-reset event stays signaled
+// until it is reset, releasing all waiting threads.
+void *			Sys_CreateEvent (bool manualReset);
+
+// Destroys the given event
+void			Sys_DestroyEvent (void *event);
+
+// Signals the given event
+void			Sys_SignalEvent (void *event);
+
+// Resets the given event
+void			Sys_ResetEvent (void *event);
+
+// Waits for the given event to be signaled, up to the given number of
+// milliseconds (or forever if msec is negative).
+// Returns false if the wait timed out.
+bool			Sys_WaitEvent (void *event, int msec);
+
+// Creates a mutex.
+// Mutexes are recursive, so the same thread can lock a mutex multiple times,
+// as long as it unlocks it the same number of times.
+void *			Sys_CreateMutex ();
+
+// Destroys the given mutex
+void			Sys_DestroyMutex (void *mutex);
+
+// Locks the given mutex, waiting for other threads to release it if needed
+void			Sys_LockMutex (void *mutex);
+
+// Tries to lock the given mutex without waiting.
+// Returns false if it is currently locked by another thread.
+bool			Sys_TryLockMutex (void *mutex);
+
+// Unlocks the given mutex
+void			Sys_UnlockMutex (void *mutex);
+
+// Atomically increments or decrements the given value and returns the result
+int				Sys_AtomicIncrement (volatile int *value);
+int				Sys_AtomicDecrement (volatile int *value);
+
+// Atomically adds the given amount to the given value and returns the result
+int				Sys_AtomicAdd (volatile int *value, int amount);
+
 // Returns information about the CPU
 int				Sys_GetProcessorId ();
 int				Sys_GetProcessorCount ();
@@ -307,7 +307,7 @@ float LUT_LookupTable (int tableIndex, float lookupIndex){
 				lookupIndex = 0.0f;
 
 			index = FloatToInt(lookupIndex);
-			index = min(index, table->size - 1);
+			index = Min(index, table->size - 1);
 		}
 		else {
 			if (lookupIndex < 0.0f)
@@ -329,8 +329,8 @@ float LUT_LookupTable (int tableIndex, float lookupIndex){
 
 		index = FloatToInt(lookupIndex);
 
-		oldIndex = min(index, table->size - 1);
-		newIndex = min(index + 1, table->size - 1);
+		oldIndex = Min(index, table->size - 1);
+		newIndex = Min(index + 1, table->size - 1);
 	}
 	else {
 		if (lookupIndex < 0.0f)
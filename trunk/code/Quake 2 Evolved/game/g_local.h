@@ -368,10 +368,10 @@ extern	int	meansOfDeath;
 
 extern	edict_t			*g_edicts;
 
-#define	FOFS(x) (int)&(((edict_t *)0)->x)
-#define	STOFS(x) (int)&(((spawn_temp_t *)0)->x)
-#define	LLOFS(x) (int)&(((levelLocals_t *)0)->x)
-#define	CLOFS(x) (int)&(((gclient_t *)0)->x)
+#define	FOFS(x) (int)(size_t)&(((edict_t *)0)->x)
+#define	STOFS(x) (int)(size_t)&(((spawn_temp_t *)0)->x)
+#define	LLOFS(x) (int)(size_t)&(((levelLocals_t *)0)->x)
+#define	CLOFS(x) (int)(size_t)&(((gclient_t *)0)->x)
 
 #define random()	((rand () & 0x7fff) / ((float)0x7fff))
 #define crandom()	(2.0 * (random() - 0.5))
@@ -35,6 +35,10 @@
 typedef unsigned char 		byte;
 typedef enum {false, true}	qboolean;
 
+#if !defined __cplusplus && !defined bool
+typedef qboolean			bool;
+#endif
+
 
 #ifndef NULL
 #define NULL ((void *)0)
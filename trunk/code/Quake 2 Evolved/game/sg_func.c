@@ -51,8 +51,8 @@ typedef enum {
 
 #define AccelerationDistance(target, rate)	(target * ((target / rate) + 1) / 2)
 
-void SG_PlatAccelerateMovement_Think (edict_t *entity);
-void SG_PlatGoDown (edict_t *entity);
+static void SG_PlatAccelerateMovement_Think (edict_t *entity);
+static void SG_PlatGoDown (edict_t *entity);
 
 
 /*
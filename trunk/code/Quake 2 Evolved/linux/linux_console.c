@@ -0,0 +1,194 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// linux_console.c - Dedicated server console on the standard streams
+//
+
+
+#include "../common/common.h"
+#include "linux_local.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+
+#define MAX_INPUT_LENGTH			1024
+
+typedef struct {
+	bool					initialized;
+
+	bool					readInput;				// False if stdin was closed or redirected from nothing
+	int						inputFlags;				// Original stdin file status flags
+
+	char					inputBuffer[MAX_INPUT_LENGTH];
+	int						inputLength;
+} sysConsole_t;
+
+static sysConsole_t			sys_console;
+
+
+/*
+ ==================
+ Sys_ConsoleInput
+
+ Reads whatever is pending on stdin without blocking and appends every
+ complete line to the command buffer
+ ==================
+*/
+void Sys_ConsoleInput (){
+
+	char	buffer[256];
+	int		result;
+	int		i;
+
+	if (!sys_console.initialized || !sys_console.readInput)
+		return;
+
+	while (1){
+		result = read(STDIN_FILENO, buffer, sizeof(buffer));
+
+		if (result == 0){
+			// End of file, so stop polling
+			sys_console.readInput = false;
+			return;
+		}
+
+		if (result < 0){
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				sys_console.readInput = false;
+
+			return;
+		}
+
+		for (i = 0; i < result; i++){
+			if (buffer[i] == '\r')
+				continue;
+
+			if (buffer[i] != '\n'){
+				// Truncate overly long lines
+				if (sys_console.inputLength < MAX_INPUT_LENGTH - 1)
+					sys_console.inputBuffer[sys_console.inputLength++] = buffer[i];
+
+				continue;
+			}
+
+			sys_console.inputBuffer[sys_console.inputLength] = 0;
+
+			// Echo and execute the command
+			if (sys_console.inputLength){
+				Com_Printf("]%s\n", sys_console.inputBuffer);
+
+				Cmd_AppendText(sys_console.inputBuffer);
+				Cmd_AppendText("\n");
+			}
+
+			sys_console.inputLength = 0;
+		}
+	}
+}
+
+/*
+ ==================
+ Sys_ConsolePrint
+ ==================
+*/
+void Sys_ConsolePrint (const char *text){
+
+	char	buffer[MAX_PRINT_MESSAGE];
+	int		length = 0;
+
+	if (!sys_console.initialized)
+		return;
+
+	// Copy into an intermediate buffer
+	while (*text && (length < MAX_PRINT_MESSAGE - 1)){
+		// Ignore color escape sequences
+		if (Str_IsColor(text)){
+			text += 2;
+			continue;
+		}
+
+		// Copy the character
+		buffer[length++] = *text++;
+	}
+
+	buffer[length] = 0;
+
+	fputs(buffer, stdout);
+	fflush(stdout);
+}
+
+/*
+ ==================
+ Sys_ShowConsole
+
+ The dedicated server console is always the terminal
+ ==================
+*/
+void Sys_ShowConsole (bool show){
+
+}
+
+/*
+ ==================
+ Sys_CreateConsole
+ ==================
+*/
+void Sys_CreateConsole (){
+
+	if (sys_console.initialized)
+		return;
+
+	// Make stdin non-blocking so it can be polled every frame
+	sys_console.inputFlags = fcntl(STDIN_FILENO, F_GETFL, 0);
+
+	if (sys_console.inputFlags != -1 && fcntl(STDIN_FILENO, F_SETFL, sys_console.inputFlags | O_NONBLOCK) != -1)
+		sys_console.readInput = true;
+	else
+		sys_console.readInput = false;
+
+	sys_console.inputLength = 0;
+
+	sys_console.initialized = true;
+}
+
+/*
+ ==================
+ Sys_DestroyConsole
+ ==================
+*/
+void Sys_DestroyConsole (){
+
+	if (!sys_console.initialized)
+		return;
+
+	// Restore the original stdin flags
+	if (sys_console.inputFlags != -1)
+		fcntl(STDIN_FILENO, F_SETFL, sys_console.inputFlags);
+
+	fflush(stdout);
+
+	Mem_Fill(&sys_console, 0, sizeof(sysConsole_t));
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// linux_local.h - Linux-specific header
+//
+
+
+#ifndef __LINUX_LOCAL_H__
+#define __LINUX_LOCAL_H__
+
+
+#ifndef __linux__
+#error "You should not be including this file on this platform"
+#endif
+
+
+typedef enum {
+	CPUID_GENERIC					= BIT(0),	// Unrecognized processor
+	CPUID_AMD						= BIT(1),	// AMD processor
+	CPUID_INTEL						= BIT(2),	// Intel processor
+	CPUID_MMX						= BIT(4),	// MMX
+	CPUID_SSE						= BIT(8),	// Streaming SIMD Extensions
+	CPUID_SSE2						= BIT(9),	// Streaming SIMD Extensions 2
+	CPUID_SSE3						= BIT(10),	// Streaming SIMD Extensions 3
+	CPUID_SSSE3						= BIT(11),	// Supplemental Streaming SIMD Extensions 3
+	CPUID_SSE41						= BIT(12),	// Streaming SIMD Extensions 4.1
+	CPUID_SSE42						= BIT(13),	// Streaming SIMD Extensions 4.2
+	CPUID_AVX						= BIT(17)	// Advanced Vector Extensions
+} cpuId_t;
+
+typedef struct {
+	int						cpuId;
+	int						cpuCount;
+	char					cpuString[256];
+
+	char					currentDirectory[MAX_PATH_LENGTH];
+} sysLinux_t;
+
+extern sysLinux_t			sys;
+
+void			Sys_CreateConsole ();
+void			Sys_DestroyConsole ();
+
+void			Sys_ConsolePrint (const char *text);
+void			Sys_ConsoleInput ();
+
+
+#endif	// __LINUX_LOCAL_H__
\ No newline at end of file
@@ -0,0 +1,1425 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// linux_system.c - Linux system-specific code
+//
+
+
+#define _GNU_SOURCE		// For pthread_setname_np
+
+#include "../common/common.h"
+#include "linux_local.h"
+#include <unistd.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/statvfs.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <pwd.h>
+#include <signal.h>
+
+#if defined __i386__ || defined __x86_64__
+#include <cpuid.h>
+#endif
+
+
+typedef struct {
+	pthread_t				handle;
+
+	void					(*function)(void *);
+	void *					data;
+} thread_t;
+
+typedef struct {
+	pthread_mutex_t			mutex;
+	pthread_cond_t			cond;
+
+	bool					manualReset;
+	bool					signaled;
+} event_t;
+
+static cvar_t *				sys_osVersion;
+static cvar_t *				sys_processor;
+static cvar_t *				sys_memory;
+static cvar_t *				sys_userName;
+
+sysLinux_t					sys;
+
+
+/*
+ ==============================================================================
+
+ FILE SYSTEM
+
+ ==============================================================================
+*/
+
+#define MAX_LIST_FILES				32768
+#define MAX_MAPPED_FILES			1024
+
+typedef struct {
+	const void *			data;
+	size_t					size;
+} mappedFile_t;
+
+static mappedFile_t			sys_mappedFiles[MAX_MAPPED_FILES];
+
+
+/*
+ ==================
+ Sys_SortFileList
+ ==================
+*/
+static int Sys_SortFileList (const void *elem1, const void *elem2){
+
+	const char	*name1 = *(const char **)elem1;
+	const char	*name2 = *(const char **)elem2;
+
+	return Str_Compare(name1, name2);
+}
+
+/*
+ ==================
+ Sys_AddFileToList
+ ==================
+*/
+static int Sys_AddFileToList (const char *name, const char **files, int fileCount){
+
+	if (fileCount == MAX_LIST_FILES)
+		return fileCount;	// Too many files
+
+	// Add it
+	files[fileCount++] = Mem_DupString(name, TAG_TEMPORARY);
+
+	return fileCount;
+}
+
+/*
+ ==================
+ Sys_IsDirectory
+ ==================
+*/
+static bool Sys_IsDirectory (const char *directory, const char *name){
+
+	struct stat	st;
+	char		path[MAX_PATH_LENGTH];
+
+	Str_SPrintf(path, sizeof(path), "%s/%s", directory, name);
+
+	if (stat(path, &st) == -1)
+		return false;
+
+	return S_ISDIR(st.st_mode);
+}
+
+/*
+ ==================
+ Sys_IgnoreDirectory
+ ==================
+*/
+static bool Sys_IgnoreDirectory (const char *name){
+
+	if (!Str_ICompare(name, CODE_DIRECTORY) || !Str_ICompare(name, DOCS_DIRECTORY) || !Str_ICompare(name, SVN_DIRECTORY))
+		return true;
+
+	return false;
+}
+
+/*
+ ==================
+ Sys_ListFiles
+ ==================
+*/
+const char **Sys_ListFiles (const char *directory, const char *extension, bool sort, int *numFiles){
+
+	DIR				*dir;
+	struct dirent	*entry;
+	bool			listDirectories, listFiles;
+	bool			isDirectory;
+	char			name[MAX_PATH_LENGTH];
+	const char		**fileList;
+	const char		**files;
+	int				fileCount = 0;
+	int				i;
+
+	if (extension != NULL && !Str_Compare(extension, "/")){
+		listDirectories = true;
+		listFiles = false;
+	}
+	else {
+		listDirectories = false;
+		listFiles = true;
+	}
+
+	// Open the directory
+	dir = opendir(directory);
+	if (!dir){
+		*numFiles = 0;
+		return NULL;
+	}
+
+	// The list is too big for the default thread stack size
+	files = (const char **)Mem_Alloc(MAX_LIST_FILES * sizeof(char *), TAG_COMMON);
+
+	while ((entry = readdir(dir)) != NULL){
+		// Check for invalid file name
+		if (!Str_Compare(entry->d_name, ".") || !Str_Compare(entry->d_name, ".."))
+			continue;
+
+		isDirectory = Sys_IsDirectory(directory, entry->d_name);
+
+		// Ignore certain directories
+		if (isDirectory && Sys_IgnoreDirectory(entry->d_name))
+			continue;
+
+		// Add it
+		if (isDirectory){
+			if (listDirectories)
+				fileCount = Sys_AddFileToList(entry->d_name, files, fileCount);
+		}
+		else {
+			if (listFiles){
+				if (extension == NULL)
+					fileCount = Sys_AddFileToList(entry->d_name, files, fileCount);
+				else {
+					Str_ExtractFileExtension(entry->d_name, name, sizeof(name));
+
+					if (!Str_ICompare(extension, name))
+						fileCount = Sys_AddFileToList(entry->d_name, files, fileCount);
+				}
+			}
+		}
+	}
+
+	closedir(dir);
+
+	if (!fileCount){
+		Mem_Free(files);
+
+		*numFiles = 0;
+		return NULL;
+	}
+
+	// Sort the list if desired
+	if (sort)
+		qsort(files, fileCount, sizeof(char *), Sys_SortFileList);
+
+	// Copy the list
+	fileList = (const char **)Mem_Alloc((fileCount + 1) * sizeof(char *), TAG_TEMPORARY);
+
+	for (i = 0; i < fileCount; i++)
+		fileList[i] = files[i];
+
+	fileList[i] = NULL;
+
+	Mem_Free(files);
+
+	*numFiles = fileCount;
+
+	return fileList;
+}
+
+/*
+ ==================
+ Sys_RecursiveListFilteredFiles
+ ==================
+*/
+static int Sys_RecursiveListFilteredFiles (const char *directory, const char *subdirectory, const char *filter, const char **files, int fileCount){
+
+	DIR				*dir;
+	struct dirent	*entry;
+	bool			isDirectory;
+	char			path[MAX_PATH_LENGTH];
+	char			name[MAX_PATH_LENGTH];
+
+	if (subdirectory)
+		Str_SPrintf(path, sizeof(path), "%s/%s", directory, subdirectory);
+	else
+		Str_SPrintf(path, sizeof(path), "%s", directory);
+
+	// Open the directory
+	dir = opendir(path);
+	if (!dir)
+		return fileCount;
+
+	while ((entry = readdir(dir)) != NULL){
+		// Check for invalid file name
+		if (!Str_Compare(entry->d_name, ".") || !Str_Compare(entry->d_name, ".."))
+			continue;
+
+		isDirectory = Sys_IsDirectory(path, entry->d_name);
+
+		// Ignore certain directories
+		if (isDirectory && Sys_IgnoreDirectory(entry->d_name))
+			continue;
+
+		// Copy the name
+		if (subdirectory)
+			Str_SPrintf(name, sizeof(name), "%s/%s", subdirectory, entry->d_name);
+		else
+			Str_SPrintf(name, sizeof(name), "%s", entry->d_name);
+
+		// If a directory, recurse into it
+		if (isDirectory)
+			fileCount = Sys_RecursiveListFilteredFiles(directory, name, filter, files, fileCount);
+
+		// Match filter
+		if (!Str_MatchFilter(name, filter, false))
+			continue;
+
+		// Add it
+		fileCount = Sys_AddFileToList(name, files, fileCount);
+	}
+
+	closedir(dir);
+
+	return fileCount;
+}
+
+/*
+ ==================
+ Sys_ListFilteredFiles
+ ==================
+*/
+const char **Sys_ListFilteredFiles (const char *directory, const char *filter, bool sort, int *numFiles){
+
+	const char	**fileList;
+	const char	**files;
+	int			fileCount = 0;
+	int			i;
+
+	// The list is too big for the default thread stack size
+	files = (const char **)Mem_Alloc(MAX_LIST_FILES * sizeof(char *), TAG_COMMON);
+
+	// List files
+	fileCount = Sys_RecursiveListFilteredFiles(directory, NULL, filter, files, 0);
+	if (!fileCount){
+		Mem_Free(files);
+
+		*numFiles = 0;
+		return NULL;
+	}
+
+	// Sort the list if desired
+	if (sort)
+		qsort(files, fileCount, sizeof(char *), Sys_SortFileList);
+
+	// Copy the list
+	fileList = (const char **)Mem_Alloc((fileCount + 1) * sizeof(char *), TAG_TEMPORARY);
+
+	for (i = 0; i < fileCount; i++)
+		fileList[i] = files[i];
+
+	fileList[i] = NULL;
+
+	Mem_Free(files);
+
+	*numFiles = fileCount;
+
+	return fileList;
+}
+
+/*
+ ==================
+ Sys_FreeFileList
+ ==================
+*/
+void Sys_FreeFileList (const char **fileList){
+
+	int		i;
+
+	if (!fileList)
+		return;
+
+	for (i = 0; fileList[i]; i++)
+		Mem_Free(fileList[i]);
+
+	Mem_Free(fileList);
+}
+
+/*
+ ==================
+ Sys_CreateDirectory
+ ==================
+*/
+void Sys_CreateDirectory (const char *directory){
+
+	mkdir(directory, 0755);
+}
+
+/*
+ ==================
+ Sys_RemoveDirectory
+ ==================
+*/
+void Sys_RemoveDirectory (const char *directory){
+
+	DIR				*dir;
+	struct dirent	*entry;
+	char			name[MAX_PATH_LENGTH];
+
+	// Open the directory
+	dir = opendir(directory);
+	if (!dir){
+		rmdir(directory);
+		return;
+	}
+
+	while ((entry = readdir(dir)) != NULL){
+		// Check for invalid file name
+		if (!Str_Compare(entry->d_name, ".") || !Str_Compare(entry->d_name, ".."))
+			continue;
+
+		// Ignore certain directories
+		if (Sys_IsDirectory(directory, entry->d_name)){
+			if (Sys_IgnoreDirectory(entry->d_name))
+				continue;
+
+			// If a directory, recurse into it
+			Str_SPrintf(name, sizeof(name), "%s/%s", directory, entry->d_name);
+
+			Sys_RemoveDirectory(name);
+			continue;
+		}
+
+		// If a file, remove it
+		Str_SPrintf(name, sizeof(name), "%s/%s", directory, entry->d_name);
+
+		unlink(name);
+	}
+
+	closedir(dir);
+
+	// Remove this directory
+	rmdir(directory);
+}
+
+/*
+ ==================
+ Sys_CurrentDirectory
+ ==================
+*/
+const char *Sys_CurrentDirectory (){
+
+	return sys.currentDirectory;
+}
+
+/*
+ ==================
+ Sys_DefaultBaseDirectory
+ ==================
+*/
+const char *Sys_DefaultBaseDirectory (){
+
+	return sys.currentDirectory;
+}
+
+/*
+ ==================
+ Sys_DefaultSaveDirectory
+ ==================
+*/
+const char *Sys_DefaultSaveDirectory (){
+
+	return sys.currentDirectory;
+}
+
+/*
+ ==================
+ Sys_DiskFreeSpace
+ ==================
+*/
+int Sys_DiskFreeSpace (const char *directory){
+
+	struct statvfs	st;
+	ulonglong		freeBytes;
+	int				freeMegs;
+
+	if (statvfs(directory, &st) == -1)
+		return 0;
+
+	freeBytes = (ulonglong)st.f_bavail * st.f_frsize;
+
+	freeMegs = (int)(freeBytes >> 20);
+
+	return freeMegs;
+}
+
+/*
+ ==================
+ Sys_MapFile
+ ==================
+*/
+const void *Sys_MapFile (const char *path, int *size){
+
+	struct stat	st;
+	void		*data;
+	int			fd;
+	int			i;
+
+	*size = 0;
+
+	// Open the file
+	fd = open(path, O_RDONLY);
+	if (fd == -1)
+		return NULL;
+
+	if (fstat(fd, &st) == -1 || st.st_size <= 0 || st.st_size > 0x7FFFFFFF){
+		close(fd);
+		return NULL;
+	}
+
+	// Find a free slot to remember the mapping length
+	for (i = 0; i < MAX_MAPPED_FILES; i++){
+		if (!sys_mappedFiles[i].data)
+			break;
+	}
+
+	if (i == MAX_MAPPED_FILES){
+		close(fd);
+		return NULL;
+	}
+
+	// Map the entire file, read-only
+	data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+
+	if (data == MAP_FAILED)
+		return NULL;
+
+	sys_mappedFiles[i].data = data;
+	sys_mappedFiles[i].size = st.st_size;
+
+	*size = (int)st.st_size;
+
+	return data;
+}
+
+/*
+ ==================
+ Sys_UnmapFile
+ ==================
+*/
+void Sys_UnmapFile (const void *data){
+
+	int		i;
+
+	if (!data)
+		Com_Error(ERR_FATAL, "Sys_UnmapFile: NULL data");
+
+	// munmap needs the length of the mapping
+	for (i = 0; i < MAX_MAPPED_FILES; i++){
+		if (sys_mappedFiles[i].data != data)
+			continue;
+
+		munmap((void *)data, sys_mappedFiles[i].size);
+
+		sys_mappedFiles[i].data = NULL;
+		sys_mappedFiles[i].size = 0;
+
+		return;
+	}
+
+	Com_Error(ERR_FATAL, "Sys_UnmapFile: data was not mapped");
+}
+
+
+/*
+ ==============================================================================
+
+ DYNAMIC LIBRARY LOADING
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_LoadLibrary
+ ==================
+*/
+void *Sys_LoadLibrary (const char *libPath){
+
+	void	*libHandle;
+
+	libHandle = dlopen(libPath, RTLD_NOW);
+	if (!libHandle)
+		Com_DPrintf(S_COLOR_YELLOW "Sys_LoadLibrary: %s\n", dlerror());
+
+	return libHandle;
+}
+
+/*
+ ==================
+ Sys_FreeLibrary
+ ==================
+*/
+void Sys_FreeLibrary (void *libHandle){
+
+	if (!libHandle)
+		Com_Error(ERR_FATAL, "Sys_FreeLibrary: invalid libHandle");
+
+	if (dlclose(libHandle))
+		Com_Error(ERR_FATAL, "Sys_FreeLibrary: failed to free library");
+}
+
+/*
+ ==================
+ Sys_GetProcAddress
+ ==================
+*/
+void *Sys_GetProcAddress (void *libHandle, const char *procName){
+
+	if (!libHandle)
+		Com_Error(ERR_FATAL, "Sys_GetProcAddress: invalid libHandle");
+
+	return dlsym(libHandle, procName);
+}
+
+
+/*
+ ==============================================================================
+
+ SYNCHRONIZATION
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_ThreadProc
+ ==================
+*/
+static void *Sys_ThreadProc (void *param){
+
+	thread_t	*thread = (thread_t *)param;
+
+	thread->function(thread->data);
+
+	return NULL;
+}
+
+/*
+ ==================
+ Sys_CreateThread
+ ==================
+*/
+void *Sys_CreateThread (void (*function)(void *), void *data, const char *name){
+
+	thread_t	*thread;
+	char		threadName[16];
+
+	thread = (thread_t *)malloc(sizeof(thread_t));
+	if (!thread)
+		Com_Error(ERR_FATAL, "Sys_CreateThread: failed to allocate thread");
+
+	thread->function = function;
+	thread->data = data;
+
+	if (pthread_create(&thread->handle, NULL, Sys_ThreadProc, thread))
+		Com_Error(ERR_FATAL, "Sys_CreateThread: failed to create thread '%s'", name);
+
+	// Set the thread name displayed by debuggers and profilers (limited to 15
+	// characters)
+	Str_Copy(threadName, name, sizeof(threadName));
+
+	pthread_setname_np(thread->handle, threadName);
+
+	return thread;
+}
+
+/*
+ ==================
+ Sys_DestroyThread
+ ==================
+*/
+void Sys_DestroyThread (void *thread){
+
+	if (!thread)
+		Com_Error(ERR_FATAL, "Sys_DestroyThread: invalid thread");
+
+	pthread_join(((thread_t *)thread)->handle, NULL);
+
+	free(thread);
+}
+
+/*
+ ==================
+ Sys_CreateEvent
+ ==================
+*/
+void *Sys_CreateEvent (bool manualReset){
+
+	event_t	*event;
+
+	event = (event_t *)malloc(sizeof(event_t));
+	if (!event)
+		Com_Error(ERR_FATAL, "Sys_CreateEvent: failed to allocate event");
+
+	if (pthread_mutex_init(&event->mutex, NULL) || pthread_cond_init(&event->cond, NULL))
+		Com_Error(ERR_FATAL, "Sys_CreateEvent: failed to create event");
+
+	event->manualReset = manualReset;
+	event->signaled = false;
+
+	return event;
+}
+
+/*
+ ==================
+ Sys_DestroyEvent
+ ==================
+*/
+void Sys_DestroyEvent (void *event){
+
+	if (!event)
+		Com_Error(ERR_FATAL, "Sys_DestroyEvent: invalid event");
+
+	pthread_cond_destroy(&((event_t *)event)->cond);
+	pthread_mutex_destroy(&((event_t *)event)->mutex);
+
+	free(event);
+}
+
+/*
+ ==================
+ Sys_SignalEvent
+ ==================
+*/
+void Sys_SignalEvent (void *event){
+
+	event_t	*e = (event_t *)event;
+
+	pthread_mutex_lock(&e->mutex);
+
+	e->signaled = true;
+
+	// A manual-reset event releases all the waiting threads, an auto-reset
+	// event releases a single one
+	if (e->manualReset)
+		pthread_cond_broadcast(&e->cond);
+	else
+		pthread_cond_signal(&e->cond);
+
+	pthread_mutex_unlock(&e->mutex);
+}
+
+/*
+ ==================
+ Sys_ResetEvent
+ ==================
+*/
+void Sys_ResetEvent (void *event){
+
+	event_t	*e = (event_t *)event;
+
+	pthread_mutex_lock(&e->mutex);
+
+	e->signaled = false;
+
+	pthread_mutex_unlock(&e->mutex);
+}
+
+/*
+ ==================
+ Sys_WaitEvent
+ ==================
+*/
+bool Sys_WaitEvent (void *event, int msec){
+
+	event_t			*e = (event_t *)event;
+	struct timespec	ts;
+	bool			signaled;
+
+	if (msec >= 0){
+		clock_gettime(CLOCK_REALTIME, &ts);
+
+		ts.tv_sec += msec / 1000;
+		ts.tv_nsec += (msec % 1000) * 1000000;
+
+		if (ts.tv_nsec >= 1000000000){
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000;
+		}
+	}
+
+	pthread_mutex_lock(&e->mutex);
+
+	while (!e->signaled){
+		if (msec < 0)
+			pthread_cond_wait(&e->cond, &e->mutex);
+		else {
+			if (pthread_cond_timedwait(&e->cond, &e->mutex, &ts))
+				break;
+		}
+	}
+
+	signaled = e->signaled;
+
+	if (signaled && !e->manualReset)
+		e->signaled = false;
+
+	pthread_mutex_unlock(&e->mutex);
+
+	return signaled;
+}
+
+/*
+ ==================
+ Sys_CreateMutex
+ ==================
+*/
+void *Sys_CreateMutex (){
+
+	pthread_mutex_t		*mutex;
+	pthread_mutexattr_t	attr;
+
+	mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+	if (!mutex)
+		Com_Error(ERR_FATAL, "Sys_CreateMutex: failed to allocate mutex");
+
+	// Critical sections are recursive, so make the mutex recursive too
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+	if (pthread_mutex_init(mutex, &attr))
+		Com_Error(ERR_FATAL, "Sys_CreateMutex: failed to create mutex");
+
+	pthread_mutexattr_destroy(&attr);
+
+	return mutex;
+}
+
+/*
+ ==================
+ Sys_DestroyMutex
+ ==================
+*/
+void Sys_DestroyMutex (void *mutex){
+
+	if (!mutex)
+		Com_Error(ERR_FATAL, "Sys_DestroyMutex: invalid mutex");
+
+	pthread_mutex_destroy((pthread_mutex_t *)mutex);
+
+	free(mutex);
+}
+
+/*
+ ==================
+ Sys_LockMutex
+ ==================
+*/
+void Sys_LockMutex (void *mutex){
+
+	pthread_mutex_lock((pthread_mutex_t *)mutex);
+}
+
+/*
+ ==================
+ Sys_TryLockMutex
+ ==================
+*/
+bool Sys_TryLockMutex (void *mutex){
+
+	if (pthread_mutex_trylock((pthread_mutex_t *)mutex))
+		return false;
+
+	return true;
+}
+
+/*
+ ==================
+ Sys_UnlockMutex
+ ==================
+*/
+void Sys_UnlockMutex (void *mutex){
+
+	pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+/*
+ ==================
+ Sys_AtomicIncrement
+ ==================
+*/
+int Sys_AtomicIncrement (volatile int *value){
+
+	return __sync_add_and_fetch(value, 1);
+}
+
+/*
+ ==================
+ Sys_AtomicDecrement
+ ==================
+*/
+int Sys_AtomicDecrement (volatile int *value){
+
+	return __sync_sub_and_fetch(value, 1);
+}
+
+/*
+ ==================
+ Sys_AtomicAdd
+ ==================
+*/
+int Sys_AtomicAdd (volatile int *value, int amount){
+
+	return __sync_add_and_fetch(value, amount);
+}
+
+
+/*
+ ==============================================================================
+
+ PROCESSOR DETECTION
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_DetectProcessor
+ ==================
+*/
+static void Sys_DetectProcessor (){
+
+#if defined __i386__ || defined __x86_64__
+	char	cpuVendor[16];
+	uint	cpuInfo[4];
+	uint	stdBits[4];
+
+	// Get the CPU vendor string
+	__cpuid(0x00000000, cpuInfo[0], cpuInfo[1], cpuInfo[2], cpuInfo[3]);
+
+	((uint *)cpuVendor)[0] = cpuInfo[1];
+	((uint *)cpuVendor)[1] = cpuInfo[3];
+	((uint *)cpuVendor)[2] = cpuInfo[2];
+	((uint *)cpuVendor)[3] = 0;
+
+	// Get the standard feature bits
+	__cpuid(0x00000001, stdBits[0], stdBits[1], stdBits[2], stdBits[3]);
+
+	// Set the CPU id
+	if (!Str_Compare(cpuVendor, "AuthenticAMD"))
+		sys.cpuId = CPUID_AMD;
+	else if (!Str_Compare(cpuVendor, "GenuineIntel"))
+		sys.cpuId = CPUID_INTEL;
+	else
+		sys.cpuId = CPUID_GENERIC;
+
+	if (stdBits[3] & BIT(23))
+		sys.cpuId |= CPUID_MMX;
+	if (stdBits[3] & BIT(25))
+		sys.cpuId |= CPUID_SSE;
+	if (stdBits[3] & BIT(26))
+		sys.cpuId |= CPUID_SSE2;
+	if (stdBits[2] & BIT(0))
+		sys.cpuId |= CPUID_SSE3;
+	if (stdBits[2] & BIT(9))
+		sys.cpuId |= CPUID_SSSE3;
+	if (stdBits[2] & BIT(19))
+		sys.cpuId |= CPUID_SSE41;
+	if (stdBits[2] & BIT(20))
+		sys.cpuId |= CPUID_SSE42;
+	if (stdBits[2] & BIT(28))
+		sys.cpuId |= CPUID_AVX;
+#else
+	sys.cpuId = CPUID_GENERIC;
+#endif
+
+	// Set the CPU count
+	sys.cpuCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (sys.cpuCount < 1)
+		sys.cpuCount = 1;
+
+	// Set the CPU string
+	if (sys.cpuId & CPUID_AMD)
+		Str_Copy(sys.cpuString, "AMD", sizeof(sys.cpuString));
+	else if (sys.cpuId & CPUID_INTEL)
+		Str_Copy(sys.cpuString, "Intel", sizeof(sys.cpuString));
+	else
+		Str_Copy(sys.cpuString, "Generic", sizeof(sys.cpuString));
+
+	if (sys.cpuCount != 1)
+		Str_Append(sys.cpuString, Str_VarArgs(" (%i CPUs)", sys.cpuCount), sizeof(sys.cpuString));
+
+	if (sys.cpuId & CPUID_MMX){
+		Str_Append(sys.cpuString, " w/ MMX", sizeof(sys.cpuString));
+
+		if (sys.cpuId & CPUID_SSE)
+			Str_Append(sys.cpuString, " & SSE", sizeof(sys.cpuString));
+		if (sys.cpuId & CPUID_SSE2)
+			Str_Append(sys.cpuString, " & SSE2", sizeof(sys.cpuString));
+		if (sys.cpuId & (CPUID_SSE3 | CPUID_SSSE3))
+			Str_Append(sys.cpuString, " & SSE3", sizeof(sys.cpuString));
+		if (sys.cpuId & (CPUID_SSE41 | CPUID_SSE42))
+			Str_Append(sys.cpuString, " & SSE4", sizeof(sys.cpuString));
+
+		if (sys.cpuId & CPUID_AVX)
+			Str_Append(sys.cpuString, " & AVX", sizeof(sys.cpuString));
+	}
+}
+
+/*
+ ==================
+ Sys_GetProcessorId
+ ==================
+*/
+int Sys_GetProcessorId (){
+
+	return sys.cpuId;
+}
+
+/*
+ ==================
+ Sys_GetProcessorCount
+ ==================
+*/
+int Sys_GetProcessorCount (){
+
+	return sys.cpuCount;
+}
+
+/*
+ ==================
+ Sys_GetProcessorString
+ ==================
+*/
+const char *Sys_GetProcessorString (){
+
+	return sys.cpuString;
+}
+
+
+/*
+ ==============================================================================
+
+ MISCELLANEOUS FUNCTIONS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_Print
+ ==================
+*/
+void Sys_Print (const char *text){
+
+	// Print to console
+	Sys_ConsolePrint(text);
+}
+
+/*
+ ==================
+ Sys_Error
+ ==================
+*/
+void Sys_Error (const char *fmt, ...){
+
+	static bool	onError;
+	char		message[MAX_PRINT_MESSAGE];
+	va_list		argPtr;
+
+	// If recursively called, quit immediately
+	if (onError)
+		_exit(1);
+
+	onError = true;
+
+	// Get the message
+	va_start(argPtr, fmt);
+	Str_VSPrintf(message, sizeof(message), fmt, argPtr);
+	va_end(argPtr);
+
+	// Echo to console
+	Sys_Print("\n");
+	Sys_Print(message);
+	Sys_Print("\n");
+
+	// Destroy the system console
+	Sys_DestroyConsole();
+
+	// There is nobody to wait for on a headless server, so exit right away
+	// with a failure status
+	exit(1);
+}
+
+/*
+ ==================
+ Sys_DebugBreak
+ ==================
+*/
+void Sys_DebugBreak (){
+
+	__builtin_trap();
+}
+
+/*
+ ==================
+ Sys_Sleep
+ ==================
+*/
+void Sys_Sleep (int msec){
+
+	if (msec < 0)
+		msec = 0;
+
+	usleep(msec * 1000);
+}
+
+/*
+ ==================
+ Sys_ProcessEvents
+ ==================
+*/
+int Sys_ProcessEvents (){
+
+	// Read commands from the console
+	Sys_ConsoleInput();
+
+	// Return the current time
+	return Sys_Milliseconds();
+}
+
+/*
+ ==================
+ Sys_Milliseconds
+ ==================
+*/
+int Sys_Milliseconds (){
+
+	static bool		initialized;
+	static time_t	base;
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	if (!initialized){
+		base = ts.tv_sec;
+		initialized = true;
+	}
+
+	return (int)((ts.tv_sec - base) * 1000 + ts.tv_nsec / 1000000);
+}
+
+/*
+ ==================
+ Sys_ClockTicks
+ ==================
+*/
+longlong Sys_ClockTicks (){
+
+	struct timespec	ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1)
+		return 0;
+
+	return (longlong)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*
+ ==================
+ Sys_ClockTicksPerSecond
+ ==================
+*/
+longlong Sys_ClockTicksPerSecond (){
+
+	return 1000000000;
+}
+
+/*
+ ==================
+ Sys_IsWindowActive
+ ==================
+*/
+bool Sys_IsWindowActive (){
+
+	return false;
+}
+
+/*
+ ==================
+ Sys_IsWindowFullscreen
+ ==================
+*/
+bool Sys_IsWindowFullscreen (){
+
+	return false;
+}
+
+/*
+ ==================
+ Sys_SetEditorWindow
+ ==================
+*/
+void Sys_SetEditorWindow (void *wndHandle){
+
+}
+
+/*
+ ==================
+ Sys_GetInstanceHandle
+ ==================
+*/
+void *Sys_GetInstanceHandle (){
+
+	return NULL;
+}
+
+/*
+ ==================
+ Sys_GetIconHandle
+ ==================
+*/
+void *Sys_GetIconHandle (){
+
+	return NULL;
+}
+
+/*
+ ==================
+ Sys_GetClipboardText
+ ==================
+*/
+const char *Sys_GetClipboardText (){
+
+	return NULL;
+}
+
+/*
+ ==================
+ Sys_SetClipboardText
+ ==================
+*/
+void Sys_SetClipboardText (const char *text){
+
+}
+
+/*
+ ==================
+ Sys_OpenURL
+ ==================
+*/
+void Sys_OpenURL (const char *url, bool quit){
+
+	Com_Printf(S_COLOR_RED "Could not open URL \"%s\"\n", url);
+}
+
+
+/*
+ ==============================================================================
+
+ CONSOLE COMMANDS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_Info_f
+ ==================
+*/
+static void Sys_Info_f (){
+
+	Com_Printf("\n");
+	Com_Printf("OS: %s\n", sys_osVersion->value);
+	Com_Printf("CPU: %s\n", sys_processor->value);
+	Com_Printf("RAM: %s\n", sys_memory->value);
+	Com_Printf("\n");
+}
+
+
+/*
+ ==============================================================================
+
+ INITIALIZATION AND SHUTDOWN
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_Init
+ ==================
+*/
+void Sys_Init (){
+
+	struct utsname	name;
+	struct passwd	*user;
+	longlong		memory;
+	char			string[MAX_STRING_LENGTH];
+
+	Com_Printf("-------- System Initialization --------\n");
+
+	// Add commands
+	Cmd_AddCommand("sysInfo", Sys_Info_f, "Shows system information", NULL);
+
+	// Get OS version info
+	if (uname(&name) == -1)
+		Com_Error(ERR_FATAL, "Couldn't get OS version info");
+
+	Str_SPrintf(string, sizeof(string), "%s %s", name.sysname, name.release);
+
+	Com_Printf("OS: %s\n", string);
+	sys_osVersion = CVar_Register("sys_osVersion", string, CVAR_STRING, CVAR_READONLY, "OS version", 0, 0);
+
+	// Detect processor
+	Sys_DetectProcessor();
+
+	Com_Printf("CPU: %s\n", sys.cpuString);
+	sys_processor = CVar_Register("sys_processor", sys.cpuString, CVAR_STRING, CVAR_READONLY, "CPU string", 0, 0);
+
+	// Get system memory
+	memory = (longlong)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+
+	Str_SPrintf(string, sizeof(string), "%lld MB", memory >> 20);
+
+	Com_Printf("RAM: %s\n", string);
+	sys_memory = CVar_Register("sys_memory", string, CVAR_STRING, CVAR_READONLY, "System memory", 0, 0);
+
+	// Get user name
+	user = getpwuid(getuid());
+	if (user && user->pw_name)
+		Str_Copy(string, user->pw_name, sizeof(string));
+	else
+		Str_Copy(string, "", sizeof(string));
+
+	sys_userName = CVar_Register("sys_userName", string, CVAR_STRING, CVAR_READONLY, "User name", 0, 0);
+
+	// Get the current directory
+	if (!getcwd(sys.currentDirectory, sizeof(sys.currentDirectory)))
+		Com_Error(ERR_FATAL, "Couldn't get current directory");
+
+	Com_Printf("Working directory: %s\n", sys.currentDirectory);
+
+#if defined SIMD_X86
+
+	// Make sure the CPU supports the required instruction sets
+	if ((sys.cpuId & SIMD_X86_CPUID) != SIMD_X86_CPUID)
+		Com_Error(ERR_FATAL, ENGINE_NAME " requires a CPU w/ " SIMD_X86_NAME " for SIMD processing");
+
+	Com_Printf("Using " SIMD_X86_NAME " for SIMD processing\n");
+
+	// Enable Flush-To-Zero and Denormals-Are-Zero modes
+	_mm_setcsr(_mm_getcsr() | (_MM_FLUSH_ZERO_MASK | _MM_DENORMALS_ZERO_MASK));
+
+#endif
+
+	Com_Printf("---------------------------------------\n");
+}
+
+/*
+ ==================
+ Sys_Shutdown
+ ==================
+*/
+void Sys_Shutdown (){
+
+	// Remove commands
+	Cmd_RemoveCommand("sysInfo");
+}
+
+/*
+ ==================
+ Sys_Quit
+ ==================
+*/
+void Sys_Quit (){
+
+	// Shutdown all the subsystems
+	Com_Shutdown();
+
+	// Destroy the system console
+	Sys_DestroyConsole();
+
+	// Exit the process
+	exit(0);
+}
+
+
+// ============================================================================
+
+
+/*
+ ==================
+ main
+
+ This build only runs as a dedicated server, so the dedicated flag is forced
+ ahead of the user's command line. The command line is kept in static storage
+ because Com_Init keeps pointers into it.
+ ==================
+*/
+int main (int argc, char **argv){
+
+	static char	cmdLine[MAX_PRINT_MESSAGE];
+	int			i;
+
+	// Ignore broken pipes when the console output goes away
+	signal(SIGPIPE, SIG_IGN);
+
+	// Build the command line
+	Str_Copy(cmdLine, "+set dedicated 1", sizeof(cmdLine));
+
+	for (i = 1; i < argc; i++){
+		Str_Append(cmdLine, " ", sizeof(cmdLine));
+
+		// Quote arguments with spaces so they survive command tokenization
+		if (Str_FindChar(argv[i], ' '))
+			Str_Append(cmdLine, Str_VarArgs("\"%s\"", argv[i]), sizeof(cmdLine));
+		else
+			Str_Append(cmdLine, argv[i], sizeof(cmdLine));
+	}
+
+	// Create the system console
+	Sys_CreateConsole();
+
+	// Initialize all the subsystems
+	Com_Init(cmdLine);
+
+	// Main program loop
+	while (1){
+		// Don't hog the CPU
+		Sys_Sleep(1);
+
+		// Run a frame
+		Com_Frame();
+	}
+
+	// Never gets here
+	return 0;
+}
\ No newline at end of file
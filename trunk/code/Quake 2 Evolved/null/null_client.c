@@ -0,0 +1,161 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// null_client.c - Client stubs for the dedicated server build
+//
+
+
+#include "../common/common.h"
+
+
+/*
+ ==================
+ R_EnumMaterialDefs
+ ==================
+*/
+void R_EnumMaterialDefs (void (*callback)(const char *string)){
+
+}
+
+/*
+ ==================
+ S_EnumSoundShaderDefs
+ ==================
+*/
+void S_EnumSoundShaderDefs (void (*callback)(const char *string)){
+
+}
+
+/*
+ ==================
+ Con_Print
+ ==================
+*/
+void Con_Print (const char *text){
+
+}
+
+/*
+ ==================
+ Key_WriteBindings
+ ==================
+*/
+void Key_WriteBindings (fileHandle_t f){
+
+}
+
+/*
+ ==================
+ Key_Init
+ ==================
+*/
+void Key_Init (){
+
+}
+
+/*
+ ==================
+ Key_Shutdown
+ ==================
+*/
+void Key_Shutdown (){
+
+}
+
+/*
+ ==================
+ CL_UpdateScreen
+ ==================
+*/
+void CL_UpdateScreen (){
+
+}
+
+/*
+ ==================
+ CL_ForwardCommandToServer
+ ==================
+*/
+void CL_ForwardCommandToServer (){
+
+	Com_Printf("Unknown command \"%s\"\n", Cmd_Argv(0));
+}
+
+/*
+ ==================
+ CL_CanLaunchEditor
+ ==================
+*/
+bool CL_CanLaunchEditor (const char *editor){
+
+	Com_Printf("The %s editor is not available on a dedicated server\n", editor);
+
+	return false;
+}
+
+/*
+ ==================
+ CL_Drop
+ ==================
+*/
+void CL_Drop (){
+
+}
+
+/*
+ ==================
+ CL_MapLoading
+ ==================
+*/
+void CL_MapLoading (){
+
+}
+
+/*
+ ==================
+ CL_Frame
+ ==================
+*/
+void CL_Frame (int msec){
+
+}
+
+/*
+ ==================
+ CL_Init
+ ==================
+*/
+void CL_Init (){
+
+}
+
+/*
+ ==================
+ CL_Shutdown
+ ==================
+*/
+void CL_Shutdown (){
+
+}
\ No newline at end of file
@@ -0,0 +1,1342 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+//
+// null_qgl.c - Null GL driver that records calls instead of rendering
+//
+
+// This driver is selected by setting r_glDriver to "null". It binds all the
+// QGL function pointers to stubs that never touch a real OpenGL driver, but
+// record call counts, uploaded bytes and state changes, so the renderer can
+// be benchmarked without any GPU or driver overhead.
+// Just enough state is kept for the renderer to initialize: object names are
+// handed out, shaders always compile, programs always link, and the active
+// uniforms of a program are parsed from the source of its shaders.
+// Nothing in here depends on a window or display, so the platform code must
+// not create one for this driver. It only has to call QGL_NullSwapBuffers at
+// the end of every frame, and QGL_NullGetProcAddress for extensions.
+// The entry points themselves are listed in null_qglProcs.h.
+
+
+#include "../renderer/r_local.h"
+
+
+#define MAX_NULL_OBJECTS			(MAX_SHADERS + MAX_PROGRAMS)
+#define MAX_NULL_SHADERS			4
+#define MAX_NULL_ATTRIBS			16
+#define MAX_NULL_ATTRIB_NAME		32
+
+#define NULL_VENDOR_STRING			ENGINE_NAME
+#define NULL_RENDERER_STRING		"Null GL Driver"
+#define NULL_VERSION_STRING			"3.3.0"
+#define NULL_GLSL_VERSION_STRING	"3.30"
+#define NULL_EXTENSIONS_STRING		"GL_EXT_texture_compression_s3tc GL_EXT_texture_filter_anisotropic GL_EXT_depth_bounds_test GL_EXT_stencil_wrap GL_EXT_stencil_two_side"
+
+#define NULL_VOID(name, category, params)						NP_##name,
+#define NULL_RETURN(name, category, type, value, params)		NP_##name,
+#define NULL_CUSTOM(name, category)								NP_##name,
+
+typedef enum {
+#include "null_qglProcs.h"
+
+	NP_MAX
+} nullProcId_t;
+
+#undef NULL_VOID
+#undef NULL_RETURN
+#undef NULL_CUSTOM
+
+typedef enum {
+	NCAT_NONE,
+	NCAT_DRAW,
+	NCAT_STATE,
+	NCAT_TEXTURE,
+	NCAT_PROGRAM,
+	NCAT_BUFFER,
+	NCAT_UNIFORM,
+	NCAT_UPLOAD,
+	NCAT_QUERY,
+	NCAT_MAX
+} nullCategory_t;
+
+typedef struct {
+	const char *			name;
+	void *					proc;
+	nullCategory_t			category;
+} nullProc_t;
+
+typedef struct {
+	char					name[MAX_UNIFORM_NAME_LENGTH];
+	int						size;
+	uint					format;
+} nullUniform_t;
+
+typedef struct {
+	bool					inUse;
+	bool					isProgram;
+
+	// Shader source
+	char *					source;
+
+	// Attached shaders and bound vertex attribs
+	GLuint					shaders[MAX_NULL_SHADERS];
+	int						numShaders;
+
+	char					attribs[MAX_NULL_ATTRIBS][MAX_NULL_ATTRIB_NAME];
+
+	// Active uniforms, parsed when the program is linked
+	nullUniform_t *			uniforms;
+	int						numUniforms;
+} nullObject_t;
+
+typedef struct {
+	bool					initialized;
+
+	// Statistics
+	int						frames;
+	int						procCalls[NP_MAX];
+
+	longlong				vertices;
+	longlong				textureBytes;
+	longlong				bufferBytes;
+	longlong				readBytes;
+
+	// Object names
+	GLuint					nextName;
+
+	nullObject_t			objects[MAX_NULL_OBJECTS];
+
+	// Scratch memory handed out when mapping buffers
+	byte *					mapBuffer;
+	int						mapBufferSize;
+} nullState_t;
+
+static nullState_t			nullState;
+
+static const char *			nullCategoryNames[NCAT_MAX] = {
+	"other calls",
+	"draw calls",
+	"state changes",
+	"texture binds",
+	"program binds",
+	"buffer binds",
+	"uniform updates",
+	"uploads",
+	"queries"
+};
+
+static const char *			nullUniformTypeNames[] = {
+	"float", "vec2", "vec3", "vec4",
+	"int", "ivec2", "ivec3", "ivec4",
+	"bool", "bvec2", "bvec3", "bvec4",
+	"mat2", "mat3", "mat4",
+	"sampler1D", "sampler2D", "sampler3D", "samplerCube",
+	"sampler1DShadow", "sampler2DShadow", "samplerCubeShadow",
+	"sampler2DArray", "sampler2DArrayShadow", "sampler2DRect", "samplerBuffer",
+	NULL
+};
+
+static uint					nullUniformTypes[] = {
+	GL_FLOAT, GL_FLOAT_VEC2, GL_FLOAT_VEC3, GL_FLOAT_VEC4,
+	GL_INT, GL_INT_VEC2, GL_INT_VEC3, GL_INT_VEC4,
+	GL_BOOL, GL_BOOL_VEC2, GL_BOOL_VEC3, GL_BOOL_VEC4,
+	GL_FLOAT_MAT2, GL_FLOAT_MAT3, GL_FLOAT_MAT4,
+	GL_SAMPLER_1D, GL_SAMPLER_2D, GL_SAMPLER_3D, GL_SAMPLER_CUBE,
+	GL_SAMPLER_1D_SHADOW, GL_SAMPLER_2D_SHADOW, GL_SAMPLER_CUBE_SHADOW,
+	GL_SAMPLER_2D_ARRAY, GL_SAMPLER_2D_ARRAY_SHADOW, GL_SAMPLER_2D_RECT, GL_SAMPLER_BUFFER,
+	0
+};
+
+
+/*
+ ==============================================================================
+
+ OBJECTS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ QGL_NullGenNames
+ ==================
+*/
+static void QGL_NullGenNames (GLsizei n, GLuint *names){
+
+	int		i;
+
+	for (i = 0; i < n; i++)
+		names[i] = nullState.nextName++;
+}
+
+/*
+ ==================
+ QGL_NullAllocObject
+
+ Shaders and programs share the same name space
+ ==================
+*/
+static GLuint QGL_NullAllocObject (bool isProgram){
+
+	nullObject_t	*object;
+	int				i;
+
+	for (i = 0, object = nullState.objects; i < MAX_NULL_OBJECTS; i++, object++){
+		if (object->inUse)
+			continue;
+
+		Mem_Fill(object, 0, sizeof(nullObject_t));
+
+		object->inUse = true;
+		object->isProgram = isProgram;
+
+		return i + 1;
+	}
+
+	Com_Error(ERR_FATAL, "QGL_NullAllocObject: MAX_NULL_OBJECTS hit");
+
+	return 0;
+}
+
+/*
+ ==================
+ QGL_NullGetObject
+ ==================
+*/
+static nullObject_t *QGL_NullGetObject (GLuint name, bool isProgram){
+
+	nullObject_t	*object;
+
+	if (name < 1 || name > MAX_NULL_OBJECTS)
+		return NULL;
+
+	object = &nullState.objects[name - 1];
+
+	if (!object->inUse || object->isProgram != isProgram)
+		return NULL;
+
+	return object;
+}
+
+/*
+ ==================
+ QGL_NullFreeObject
+ ==================
+*/
+static void QGL_NullFreeObject (GLuint name, bool isProgram){
+
+	nullObject_t	*object;
+
+	object = QGL_NullGetObject(name, isProgram);
+	if (!object)
+		return;
+
+	if (object->source)
+		Mem_Free(object->source);
+
+	if (object->uniforms)
+		Mem_Free(object->uniforms);
+
+	Mem_Fill(object, 0, sizeof(nullObject_t));
+}
+
+/*
+ ==================
+ QGL_NullSkipToToken
+
+ Returns a pointer to the next occurrence of the given identifier in the
+ source, skipping comments
+ ==================
+*/
+static const char *QGL_NullSkipToToken (const char *source, const char *token){
+
+	const char	*start = source;
+	int			length;
+
+	length = Str_Length(token);
+
+	while (*source){
+		// Skip comments
+		if (source[0] == '/' && source[1] == '/'){
+			while (*source && *source != '\n')
+				source++;
+
+			continue;
+		}
+
+		if (source[0] == '/' && source[1] == '*'){
+			source += 2;
+
+			while (*source && !(source[0] == '*' && source[1] == '/'))
+				source++;
+
+			if (*source)
+				source += 2;
+
+			continue;
+		}
+
+		// Check for a whole word match
+		if (!Str_CompareChars(source, token, length) && !Str_CharIsAlphaNumeric(source[length]) && source[length] != '_'){
+			if (source == start || (!Str_CharIsAlphaNumeric(source[-1]) && source[-1] != '_'))
+				return source + length;
+		}
+
+		source++;
+	}
+
+	return NULL;
+}
+
+/*
+ ==================
+ QGL_NullParseIdentifier
+ ==================
+*/
+static const char *QGL_NullParseIdentifier (const char *source, char *name, int maxLength){
+
+	int		length = 0;
+
+	while (Str_CharIsWhiteSpace(*source))
+		source++;
+
+	while (Str_CharIsAlphaNumeric(*source) || *source == '_'){
+		if (length < maxLength - 1)
+			name[length++] = *source;
+
+		source++;
+	}
+
+	name[length] = 0;
+
+	return source;
+}
+
+/*
+ ==================
+ QGL_NullAddUniform
+ ==================
+*/
+static void QGL_NullAddUniform (nullUniform_t *uniforms, int *numUniforms, const char *name, int size, uint format){
+
+	nullUniform_t	*uniform;
+	int				i;
+
+	// Shaders in the same program may declare the same uniform
+	for (i = 0, uniform = uniforms; i < *numUniforms; i++, uniform++){
+		if (!Str_Compare(uniform->name, name))
+			return;
+	}
+
+	if (*numUniforms == MAX_PROGRAM_UNIFORMS)
+		return;
+
+	uniform = &uniforms[(*numUniforms)++];
+
+	Str_Copy(uniform->name, name, sizeof(uniform->name));
+	uniform->size = size;
+	uniform->format = format;
+}
+
+/*
+ ==================
+ QGL_NullParseUniforms
+ ==================
+*/
+static void QGL_NullParseUniforms (const char *source, nullUniform_t *uniforms, int *numUniforms){
+
+	char	type[MAX_UNIFORM_NAME_LENGTH], name[MAX_UNIFORM_NAME_LENGTH];
+	uint	format;
+	int		size;
+	int		i;
+
+	while (1){
+		// Find the next uniform declaration
+		source = QGL_NullSkipToToken(source, "uniform");
+		if (!source)
+			break;
+
+		// Parse the type, ignoring any precision qualifier
+		source = QGL_NullParseIdentifier(source, type, sizeof(type));
+
+		if (!Str_Compare(type, "lowp") || !Str_Compare(type, "mediump") || !Str_Compare(type, "highp"))
+			source = QGL_NullParseIdentifier(source, type, sizeof(type));
+
+		for (i = 0; nullUniformTypeNames[i]; i++){
+			if (!Str_Compare(nullUniformTypeNames[i], type))
+				break;
+		}
+
+		format = nullUniformTypes[i];
+		if (!format)
+			continue;
+
+		// Parse all the declared names
+		while (1){
+			source = QGL_NullParseIdentifier(source, name, sizeof(name));
+			if (!name[0])
+				break;
+
+			while (Str_CharIsWhiteSpace(*source))
+				source++;
+
+			size = 1;
+
+			if (*source == '['){
+				size = Str_ToInteger(source + 1);
+
+				while (*source && *source != ']')
+					source++;
+
+				if (*source)
+					source++;
+
+				while (Str_CharIsWhiteSpace(*source))
+					source++;
+			}
+
+			QGL_NullAddUniform(uniforms, numUniforms, name, Max(size, 1), format);
+
+			if (*source != ',')
+				break;
+
+			source++;
+		}
+	}
+}
+
+/*
+ ==================
+ QGL_NullPixelSize
+ ==================
+*/
+static int QGL_NullPixelSize (GLenum format, GLenum type){
+
+	int		components, bytes;
+
+	// Packed types store the whole pixel
+	switch (type){
+	case GL_UNSIGNED_BYTE_3_3_2:
+	case GL_UNSIGNED_BYTE_2_3_3_REV:
+		return 1;
+	case GL_UNSIGNED_SHORT_5_6_5:
+	case GL_UNSIGNED_SHORT_5_6_5_REV:
+	case GL_UNSIGNED_SHORT_4_4_4_4:
+	case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+	case GL_UNSIGNED_SHORT_5_5_5_1:
+	case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+		return 2;
+	case GL_UNSIGNED_INT_8_8_8_8:
+	case GL_UNSIGNED_INT_8_8_8_8_REV:
+	case GL_UNSIGNED_INT_10_10_10_2:
+	case GL_UNSIGNED_INT_2_10_10_10_REV:
+	case GL_UNSIGNED_INT_24_8:
+	case GL_UNSIGNED_INT_10F_11F_11F_REV:
+	case GL_UNSIGNED_INT_5_9_9_9_REV:
+		return 4;
+	}
+
+	switch (format){
+	case GL_LUMINANCE_ALPHA:
+	case GL_RG:
+		components = 2;
+		break;
+	case GL_RGB:
+	case GL_BGR:
+		components = 3;
+		break;
+	case GL_RGBA:
+	case GL_BGRA:
+		components = 4;
+		break;
+	default:
+		components = 1;
+		break;
+	}
+
+	switch (type){
+	case GL_SHORT:
+	case GL_UNSIGNED_SHORT:
+	case GL_HALF_FLOAT:
+		bytes = 2;
+		break;
+	case GL_INT:
+	case GL_UNSIGNED_INT:
+	case GL_FLOAT:
+		bytes = 4;
+		break;
+	default:
+		bytes = 1;
+		break;
+	}
+
+	return components * bytes;
+}
+
+
+/*
+ ==============================================================================
+
+ NULL FUNCTIONS
+
+ ==============================================================================
+*/
+
+static GLvoid APIENTRY nullAttachShader (GLuint program, GLuint shader){
+
+	nullObject_t	*object;
+
+	nullState.procCalls[NP_AttachShader]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object || object->numShaders == MAX_NULL_SHADERS)
+		return;
+
+	object->shaders[object->numShaders++] = shader;
+}
+
+static GLvoid APIENTRY nullBindAttribLocation (GLuint program, GLuint index, const GLchar *name){
+
+	nullObject_t	*object;
+
+	nullState.procCalls[NP_BindAttribLocation]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object || index >= MAX_NULL_ATTRIBS)
+		return;
+
+	Str_Copy(object->attribs[index], name, sizeof(object->attribs[index]));
+}
+
+static GLvoid APIENTRY nullBufferData (GLenum target, GLsizeiptr size, const GLvoid *data, GLenum usage){
+
+	nullState.procCalls[NP_BufferData]++;
+
+	if (data)
+		nullState.bufferBytes += size;
+}
+
+static GLvoid APIENTRY nullBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid *data){
+
+	nullState.procCalls[NP_BufferSubData]++;
+
+	nullState.bufferBytes += size;
+}
+
+static GLvoid APIENTRY nullCompressedTexImage2D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const GLvoid *pixels){
+
+	nullState.procCalls[NP_CompressedTexImage2D]++;
+
+	if (pixels)
+		nullState.textureBytes += imageSize;
+}
+
+static GLvoid APIENTRY nullCompressedTexImage3D (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const GLvoid *pixels){
+
+	nullState.procCalls[NP_CompressedTexImage3D]++;
+
+	if (pixels)
+		nullState.textureBytes += imageSize;
+}
+
+static GLvoid APIENTRY nullCompressedTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const GLvoid *pixels){
+
+	nullState.procCalls[NP_CompressedTexSubImage2D]++;
+
+	nullState.textureBytes += imageSize;
+}
+
+static GLvoid APIENTRY nullCompressedTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const GLvoid *pixels){
+
+	nullState.procCalls[NP_CompressedTexSubImage3D]++;
+
+	nullState.textureBytes += imageSize;
+}
+
+static GLuint APIENTRY nullCreateProgram (GLvoid){
+
+	nullState.procCalls[NP_CreateProgram]++;
+
+	return QGL_NullAllocObject(true);
+}
+
+static GLuint APIENTRY nullCreateShader (GLenum type){
+
+	nullState.procCalls[NP_CreateShader]++;
+
+	return QGL_NullAllocObject(false);
+}
+
+static GLvoid APIENTRY nullDeleteProgram (GLuint program){
+
+	nullState.procCalls[NP_DeleteProgram]++;
+
+	QGL_NullFreeObject(program, true);
+}
+
+static GLvoid APIENTRY nullDeleteShader (GLuint shader){
+
+	nullState.procCalls[NP_DeleteShader]++;
+
+	QGL_NullFreeObject(shader, false);
+}
+
+static GLvoid APIENTRY nullDetachShader (GLuint program, GLuint shader){
+
+	nullObject_t	*object;
+	int				i;
+
+	nullState.procCalls[NP_DetachShader]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object)
+		return;
+
+	for (i = 0; i < object->numShaders; i++){
+		if (object->shaders[i] != shader)
+			continue;
+
+		object->shaders[i] = object->shaders[--object->numShaders];
+		break;
+	}
+}
+
+static GLvoid APIENTRY nullDrawArrays (GLenum mode, GLint first, GLsizei count){
+
+	nullState.procCalls[NP_DrawArrays]++;
+
+	nullState.vertices += count;
+}
+
+static GLvoid APIENTRY nullDrawElements (GLenum mode, GLsizei count, GLenum type, const GLvoid *indices){
+
+	nullState.procCalls[NP_DrawElements]++;
+
+	nullState.vertices += count;
+}
+
+static GLvoid APIENTRY nullDrawRangeElements (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const GLvoid *indices){
+
+	nullState.procCalls[NP_DrawRangeElements]++;
+
+	nullState.vertices += count;
+}
+
+static GLsync APIENTRY nullFenceSync (GLenum condition, GLbitfield flags){
+
+	nullState.procCalls[NP_FenceSync]++;
+
+	return (GLsync)(size_t)nullState.nextName++;
+}
+
+static GLvoid APIENTRY nullGenBuffers (GLsizei n, GLuint *buffers){
+
+	nullState.procCalls[NP_GenBuffers]++;
+
+	QGL_NullGenNames(n, buffers);
+}
+
+static GLvoid APIENTRY nullGenFramebuffers (GLsizei n, GLuint *framebuffers){
+
+	nullState.procCalls[NP_GenFramebuffers]++;
+
+	QGL_NullGenNames(n, framebuffers);
+}
+
+static GLuint APIENTRY nullGenLists (GLsizei range){
+
+	GLuint	list;
+
+	nullState.procCalls[NP_GenLists]++;
+
+	list = nullState.nextName;
+	nullState.nextName += range;
+
+	return list;
+}
+
+static GLvoid APIENTRY nullGenQueries (GLsizei n, GLuint *ids){
+
+	nullState.procCalls[NP_GenQueries]++;
+
+	QGL_NullGenNames(n, ids);
+}
+
+static GLvoid APIENTRY nullGenRenderbuffers (GLsizei n, GLuint *renderbuffers){
+
+	nullState.procCalls[NP_GenRenderbuffers]++;
+
+	QGL_NullGenNames(n, renderbuffers);
+}
+
+static GLvoid APIENTRY nullGenSamplers (GLsizei n, GLuint *samplers){
+
+	nullState.procCalls[NP_GenSamplers]++;
+
+	QGL_NullGenNames(n, samplers);
+}
+
+static GLvoid APIENTRY nullGenTextures (GLsizei n, GLuint *textures){
+
+	nullState.procCalls[NP_GenTextures]++;
+
+	QGL_NullGenNames(n, textures);
+}
+
+static GLvoid APIENTRY nullGenVertexArrays (GLsizei n, GLuint *vertexArrays){
+
+	nullState.procCalls[NP_GenVertexArrays]++;
+
+	QGL_NullGenNames(n, vertexArrays);
+}
+
+static GLvoid APIENTRY nullGetActiveUniform (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name){
+
+	nullObject_t	*object;
+	nullUniform_t	*uniform;
+	char			string[MAX_UNIFORM_NAME_LENGTH + 4];
+
+	nullState.procCalls[NP_GetActiveUniform]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object || index >= (GLuint)object->numUniforms)
+		return;
+
+	uniform = &object->uniforms[index];
+
+	// Like real drivers, report arrays with a subscript
+	if (uniform->size > 1)
+		Str_SPrintf(string, sizeof(string), "%s[0]", uniform->name);
+	else
+		Str_Copy(string, uniform->name, sizeof(string));
+
+	Str_Copy(name, string, bufSize);
+
+	if (length)
+		*length = Str_Length(name);
+
+	*size = uniform->size;
+	*type = uniform->format;
+}
+
+static GLint APIENTRY nullGetAttribLocation (GLuint program, const GLchar *name){
+
+	nullObject_t	*object, *shader;
+	int				i, j;
+
+	nullState.procCalls[NP_GetAttribLocation]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object)
+		return -1;
+
+	// Only report the bound location if a shader actually uses the attrib
+	for (i = 0; i < MAX_NULL_ATTRIBS; i++){
+		if (Str_Compare(object->attribs[i], name))
+			continue;
+
+		for (j = 0; j < object->numShaders; j++){
+			shader = QGL_NullGetObject(object->shaders[j], false);
+			if (!shader || !shader->source)
+				continue;
+
+			if (QGL_NullSkipToToken(shader->source, name))
+				return i;
+		}
+	}
+
+	return -1;
+}
+
+static GLvoid APIENTRY nullGetBooleanv (GLenum pname, GLboolean *params){
+
+	nullState.procCalls[NP_GetBooleanv]++;
+
+	params[0] = GL_FALSE;
+}
+
+static GLvoid APIENTRY nullGetDoublev (GLenum pname, GLdouble *params){
+
+	nullState.procCalls[NP_GetDoublev]++;
+
+	params[0] = 0.0;
+}
+
+static GLvoid APIENTRY nullGetFloatv (GLenum pname, GLfloat *params){
+
+	nullState.procCalls[NP_GetFloatv]++;
+
+	switch (pname){
+	case GL_MAX_TEXTURE_LOD_BIAS:
+		params[0] = 16.0f;
+		break;
+	case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT:
+		params[0] = 16.0f;
+		break;
+	default:
+		params[0] = 0.0f;
+		break;
+	}
+}
+
+static GLvoid APIENTRY nullGetIntegerv (GLenum pname, GLint *params){
+
+	nullState.procCalls[NP_GetIntegerv]++;
+
+	switch (pname){
+	case GL_MAJOR_VERSION:
+		params[0] = 3;
+		break;
+	case GL_MINOR_VERSION:
+		params[0] = 3;
+		break;
+	case GL_MAX_TEXTURE_SIZE:
+	case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+	case GL_MAX_RENDERBUFFER_SIZE:
+		params[0] = 8192;
+		break;
+	case GL_MAX_3D_TEXTURE_SIZE:
+	case GL_MAX_ARRAY_TEXTURE_LAYERS:
+		params[0] = 2048;
+		break;
+	case GL_MAX_TEXTURE_UNITS:
+		params[0] = 4;
+		break;
+	case GL_MAX_TEXTURE_COORDS:
+	case GL_MAX_COLOR_ATTACHMENTS:
+		params[0] = 8;
+		break;
+	case GL_MAX_TEXTURE_IMAGE_UNITS:
+	case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+	case GL_MAX_VERTEX_ATTRIBS:
+		params[0] = 16;
+		break;
+	case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+		params[0] = 32;
+		break;
+	case GL_MAX_VARYING_COMPONENTS:
+		params[0] = 64;
+		break;
+	case GL_MAX_VERTEX_UNIFORM_COMPONENTS:
+	case GL_MAX_FRAGMENT_UNIFORM_COMPONENTS:
+		params[0] = 4096;
+		break;
+	default:
+		params[0] = 0;
+		break;
+	}
+}
+
+static GLvoid APIENTRY nullGetProgramInfoLog (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog){
+
+	nullState.procCalls[NP_GetProgramInfoLog]++;
+
+	if (bufSize > 0)
+		infoLog[0] = 0;
+
+	if (length)
+		*length = 0;
+}
+
+static GLvoid APIENTRY nullGetProgramiv (GLuint program, GLenum pname, GLint *params){
+
+	nullObject_t	*object;
+
+	nullState.procCalls[NP_GetProgramiv]++;
+
+	switch (pname){
+	case GL_LINK_STATUS:
+	case GL_VALIDATE_STATUS:
+		params[0] = GL_TRUE;
+		break;
+	case GL_ACTIVE_UNIFORMS:
+		object = QGL_NullGetObject(program, true);
+
+		params[0] = (object) ? object->numUniforms : 0;
+		break;
+	case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+		params[0] = MAX_UNIFORM_NAME_LENGTH;
+		break;
+	default:
+		params[0] = 0;
+		break;
+	}
+}
+
+static GLvoid APIENTRY nullGetShaderInfoLog (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog){
+
+	nullState.procCalls[NP_GetShaderInfoLog]++;
+
+	if (bufSize > 0)
+		infoLog[0] = 0;
+
+	if (length)
+		*length = 0;
+}
+
+static GLvoid APIENTRY nullGetShaderiv (GLuint shader, GLenum pname, GLint *params){
+
+	nullState.procCalls[NP_GetShaderiv]++;
+
+	switch (pname){
+	case GL_COMPILE_STATUS:
+		params[0] = GL_TRUE;
+		break;
+	default:
+		params[0] = 0;
+		break;
+	}
+}
+
+static const GLubyte * APIENTRY nullGetString (GLenum name){
+
+	nullState.procCalls[NP_GetString]++;
+
+	switch (name){
+	case GL_VENDOR:
+		return (const GLubyte *)NULL_VENDOR_STRING;
+	case GL_RENDERER:
+		return (const GLubyte *)NULL_RENDERER_STRING;
+	case GL_VERSION:
+		return (const GLubyte *)NULL_VERSION_STRING;
+	case GL_EXTENSIONS:
+		return (const GLubyte *)NULL_EXTENSIONS_STRING;
+	case GL_SHADING_LANGUAGE_VERSION:
+		return (const GLubyte *)NULL_GLSL_VERSION_STRING;
+	}
+
+	return (const GLubyte *)"";
+}
+
+static GLint APIENTRY nullGetUniformLocation (GLuint program, const GLchar *name){
+
+	nullObject_t	*object;
+	nullUniform_t	*uniform;
+	int				length;
+	int				i;
+
+	nullState.procCalls[NP_GetUniformLocation]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object)
+		return -1;
+
+	for (i = 0, uniform = object->uniforms; i < object->numUniforms; i++, uniform++){
+		length = Str_Length(uniform->name);
+
+		if (Str_CompareChars(uniform->name, name, length))
+			continue;
+
+		if (name[length] == 0 || !Str_Compare(name + length, "[0]"))
+			return i;
+	}
+
+	return -1;
+}
+
+static GLvoid APIENTRY nullLinkProgram (GLuint program){
+
+	nullObject_t	*object, *shader;
+	nullUniform_t	uniforms[MAX_PROGRAM_UNIFORMS];
+	int				numUniforms = 0;
+	int				i;
+
+	nullState.procCalls[NP_LinkProgram]++;
+
+	object = QGL_NullGetObject(program, true);
+	if (!object)
+		return;
+
+	// Parse the active uniforms from the attached shaders
+	for (i = 0; i < object->numShaders; i++){
+		shader = QGL_NullGetObject(object->shaders[i], false);
+		if (!shader || !shader->source)
+			continue;
+
+		QGL_NullParseUniforms(shader->source, uniforms, &numUniforms);
+	}
+
+	if (object->uniforms){
+		Mem_Free(object->uniforms);
+		object->uniforms = NULL;
+	}
+
+	object->numUniforms = numUniforms;
+
+	if (numUniforms){
+		object->uniforms = (nullUniform_t *)Mem_Alloc(numUniforms * sizeof(nullUniform_t), TAG_COMMON);
+		Mem_Copy(object->uniforms, uniforms, numUniforms * sizeof(nullUniform_t));
+	}
+}
+
+static GLvoid * APIENTRY nullMapBuffer (GLenum target, GLenum access){
+
+	nullState.procCalls[NP_MapBuffer]++;
+
+	// We don't know the buffer size, so just hand out the scratch memory, which
+	// is at least 1 MB
+	if (!nullState.mapBuffer){
+		nullState.mapBufferSize = 0x100000;
+		nullState.mapBuffer = (byte *)Mem_Alloc(nullState.mapBufferSize, TAG_COMMON);
+	}
+
+	return nullState.mapBuffer;
+}
+
+static GLvoid * APIENTRY nullMapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access){
+
+	nullState.procCalls[NP_MapBufferRange]++;
+
+	if (access & GL_MAP_WRITE_BIT)
+		nullState.bufferBytes += length;
+
+	// Grow the scratch memory if needed
+	if (length > nullState.mapBufferSize){
+		if (nullState.mapBuffer)
+			Mem_Free(nullState.mapBuffer);
+
+		nullState.mapBufferSize = Max((int)length, 0x100000);
+		nullState.mapBuffer = (byte *)Mem_Alloc(nullState.mapBufferSize, TAG_COMMON);
+	}
+
+	return nullState.mapBuffer;
+}
+
+static GLvoid APIENTRY nullReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid *pixels){
+
+	int		size;
+
+	nullState.procCalls[NP_ReadPixels]++;
+
+	size = width * height * QGL_NullPixelSize(format, type);
+
+	nullState.readBytes += size;
+
+	// Screenshots and debug tools read back all black pixels
+	if (pixels)
+		Mem_Fill(pixels, 0, size);
+}
+
+static GLvoid APIENTRY nullShaderSource (GLuint shader, GLsizei count, const GLchar **string, const GLint *length){
+
+	nullObject_t	*object;
+	int				size = 0;
+	int				i;
+
+	nullState.procCalls[NP_ShaderSource]++;
+
+	object = QGL_NullGetObject(shader, false);
+	if (!object)
+		return;
+
+	// Keep a copy of the source for parsing uniforms and vertex attribs
+	if (object->source)
+		Mem_Free(object->source);
+
+	for (i = 0; i < count; i++){
+		if (length && length[i] >= 0)
+			size += length[i];
+		else
+			size += Str_Length(string[i]);
+	}
+
+	object->source = (char *)Mem_Alloc(size + 1, TAG_COMMON);
+
+	for (i = 0, size = 0; i < count; i++){
+		if (length && length[i] >= 0){
+			Mem_Copy(object->source + size, string[i], length[i]);
+			size += length[i];
+		}
+		else {
+			Mem_Copy(object->source + size, string[i], Str_Length(string[i]));
+			size += Str_Length(string[i]);
+		}
+	}
+
+	object->source[size] = 0;
+}
+
+static GLvoid APIENTRY nullTexImage2D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels){
+
+	nullState.procCalls[NP_TexImage2D]++;
+
+	if (pixels)
+		nullState.textureBytes += width * height * QGL_NullPixelSize(format, type);
+}
+
+static GLvoid APIENTRY nullTexImage3D (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid *pixels){
+
+	nullState.procCalls[NP_TexImage3D]++;
+
+	if (pixels)
+		nullState.textureBytes += width * height * depth * QGL_NullPixelSize(format, type);
+}
+
+static GLvoid APIENTRY nullTexSubImage2D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels){
+
+	nullState.procCalls[NP_TexSubImage2D]++;
+
+	nullState.textureBytes += width * height * QGL_NullPixelSize(format, type);
+}
+
+static GLvoid APIENTRY nullTexSubImage3D (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const GLvoid *pixels){
+
+	nullState.procCalls[NP_TexSubImage3D]++;
+
+	nullState.textureBytes += width * height * depth * QGL_NullPixelSize(format, type);
+}
+
+// ============================================================================
+
+// Every other entry point only counts the call and returns a default value
+#define NULL_VOID(name, category, params)						static GLvoid APIENTRY null##name params { nullState.procCalls[NP_##name]++; }
+#define NULL_RETURN(name, category, type, value, params)		static type APIENTRY null##name params { nullState.procCalls[NP_##name]++; return value; }
+#define NULL_CUSTOM(name, category)
+
+#include "null_qglProcs.h"
+
+#undef NULL_VOID
+#undef NULL_RETURN
+#undef NULL_CUSTOM
+
+// ============================================================================
+
+#define NULL_VOID(name, category, params)						{"gl" #name, (void *)null##name, category},
+#define NULL_RETURN(name, category, type, value, params)		{"gl" #name, (void *)null##name, category},
+#define NULL_CUSTOM(name, category)								{"gl" #name, (void *)null##name, category},
+
+static nullProc_t			nullProcs[NP_MAX + 1] = {
+#include "null_qglProcs.h"
+
+	{NULL,					NULL,					NCAT_NONE}
+};
+
+#undef NULL_VOID
+#undef NULL_RETURN
+#undef NULL_CUSTOM
+
+
+/*
+ ==============================================================================
+
+ PLATFORM INTERFACE
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ QGL_NullGetProcAddress
+
+ Used by the platform code in place of the driver's own lookup function
+ ==================
+*/
+void *QGL_NullGetProcAddress (const char *procName){
+
+	nullProc_t	*proc;
+
+	for (proc = nullProcs; proc->name; proc++){
+		if (!Str_Compare(proc->name, procName))
+			return proc->proc;
+	}
+
+	return NULL;
+}
+
+/*
+ ==================
+ QGL_NullSwapBuffers
+
+ There is nothing to present, so this only counts the frame
+ ==================
+*/
+void QGL_NullSwapBuffers (){
+
+	nullState.frames++;
+}
+
+
+/*
+ ==============================================================================
+
+ STATISTICS
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ QGL_NullSortCalls
+ ==================
+*/
+static int QGL_NullSortCalls (const void *elem1, const void *elem2){
+
+	const int	proc1 = *(const int *)elem1;
+	const int	proc2 = *(const int *)elem2;
+
+	return nullState.procCalls[proc2] - nullState.procCalls[proc1];
+}
+
+/*
+ ==================
+ QGL_ResetNullStats
+ ==================
+*/
+void QGL_ResetNullStats (){
+
+	if (!nullState.initialized)
+		return;
+
+	Mem_Fill(nullState.procCalls, 0, sizeof(nullState.procCalls));
+
+	nullState.frames = 0;
+
+	nullState.vertices = 0;
+	nullState.textureBytes = 0;
+	nullState.bufferBytes = 0;
+	nullState.readBytes = 0;
+}
+
+/*
+ ==================
+ QGL_PrintNullStats
+ ==================
+*/
+void QGL_PrintNullStats (){
+
+	int		categoryCalls[NCAT_MAX];
+	int		sorted[NP_MAX];
+	int		calls = 0;
+	float	scale;
+	int		i;
+
+	if (!nullState.initialized)
+		return;
+
+	scale = 1.0f / Max(nullState.frames, 1);
+
+	Mem_Fill(categoryCalls, 0, sizeof(categoryCalls));
+
+	for (i = 0; i < NP_MAX; i++){
+		calls += nullState.procCalls[i];
+
+		categoryCalls[nullProcs[i].category] += nullState.procCalls[i];
+
+		sorted[i] = i;
+	}
+
+	Com_Printf("---------- Null GL Driver Statistics ----------\n");
+	Com_Printf("%i frames, %i GL calls (%.1f per frame)\n", nullState.frames, calls, calls * scale);
+
+	for (i = NCAT_DRAW; i < NCAT_MAX; i++)
+		Com_Printf("%8i %-16s (%.1f per frame)\n", categoryCalls[i], nullCategoryNames[i], categoryCalls[i] * scale);
+
+	Com_Printf("%8i %-16s (%.1f per frame)\n", categoryCalls[NCAT_NONE], nullCategoryNames[NCAT_NONE], categoryCalls[NCAT_NONE] * scale);
+
+	Com_Printf("vertices: %.2f K per frame\n", nullState.vertices * scale * (1.0f / 1000.0f));
+	Com_Printf("texture uploads: %.2f MB (%.2f KB per frame)\n", nullState.textureBytes * (1.0f / 1048576.0f), nullState.textureBytes * scale * (1.0f / 1024.0f));
+	Com_Printf("buffer uploads: %.2f MB (%.2f KB per frame)\n", nullState.bufferBytes * (1.0f / 1048576.0f), nullState.bufferBytes * scale * (1.0f / 1024.0f));
+	Com_Printf("read backs: %.2f MB\n", nullState.readBytes * (1.0f / 1048576.0f));
+
+	// Print the most frequently called functions
+	qsort(sorted, NP_MAX, sizeof(int), QGL_NullSortCalls);
+
+	Com_Printf("most frequent calls:\n");
+
+	for (i = 0; i < 10; i++){
+		if (!nullState.procCalls[sorted[i]])
+			break;
+
+		Com_Printf("%8i %s (%.1f per frame)\n", nullState.procCalls[sorted[i]], nullProcs[sorted[i]].name, nullState.procCalls[sorted[i]] * scale);
+	}
+
+	Com_Printf("-----------------------------------------------\n");
+}
+
+
+/*
+ ==============================================================================
+
+ INITIALIZATION AND SHUTDOWN
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ QGL_InitNull
+
+ Binds our QGL function pointers to the null driver
+ ==================
+*/
+bool QGL_InitNull (){
+
+	Com_Printf("...using null GL driver\n");
+
+	Mem_Fill(&nullState, 0, sizeof(nullState_t));
+
+	nullState.initialized = true;
+	nullState.nextName = 1;
+
+#define NULL_VOID(name, category, params)						qgl##name = null##name;
+#define NULL_RETURN(name, category, type, value, params)		qgl##name = null##name;
+#define NULL_CUSTOM(name, category)								qgl##name = null##name;
+
+#include "null_qglProcs.h"
+
+#undef NULL_VOID
+#undef NULL_RETURN
+#undef NULL_CUSTOM
+
+	return true;
+}
+
+/*
+ ==================
+ QGL_ShutdownNull
+ ==================
+*/
+void QGL_ShutdownNull (){
+
+	int		i;
+
+	if (!nullState.initialized)
+		return;
+
+	for (i = 0; i < MAX_NULL_OBJECTS; i++){
+		if (nullState.objects[i].source)
+			Mem_Free(nullState.objects[i].source);
+
+		if (nullState.objects[i].uniforms)
+			Mem_Free(nullState.objects[i].uniforms);
+	}
+
+	if (nullState.mapBuffer)
+		Mem_Free(nullState.mapBuffer);
+
+	Mem_Fill(&nullState, 0, sizeof(nullState_t));
+}
\ No newline at end of file
@@ -0,0 +1,769 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+//
+// null_qglProcs.h - Entry points of the null GL driver
+//
+
+// This file is included several times by null_qgl.c, with the macros below
+// defined to expand each entry into the call counters, the stubs, the name
+// table and the QGL bindings. It must have an entry for every gl* function
+// pointer declared in qgl.h, and must not have include guards.
+//
+// NULL_VOID(name, category, params)
+//	Generated stub that only counts the call.
+//
+// NULL_RETURN(name, category, type, value, params)
+//	Generated stub that counts the call and returns the given value.
+//
+// NULL_CUSTOM(name, category)
+//	Stub written by hand in null_qgl.c, because it has to keep some state.
+
+
+NULL_VOID(Accum,							NCAT_NONE,		(GLenum op, GLfloat value))
+NULL_VOID(ActiveStencilFaceEXT,				NCAT_STATE,		(GLenum face))
+NULL_VOID(ActiveTexture,					NCAT_STATE,		(GLenum texture))
+NULL_VOID(AlphaFunc,						NCAT_STATE,		(GLenum func, GLclampf ref))
+NULL_RETURN(AreTexturesResident,			NCAT_NONE,		GLboolean, GL_FALSE, (GLsizei n, const GLuint *textures, GLboolean *residences))
+NULL_VOID(ArrayElement,						NCAT_NONE,		(GLint i))
+NULL_CUSTOM(AttachShader,					NCAT_NONE)
+NULL_VOID(Begin,							NCAT_DRAW,		(GLenum mode))
+NULL_VOID(BeginConditionalRender,			NCAT_NONE,		(GLuint id, GLenum mode))
+NULL_VOID(BeginQuery,						NCAT_NONE,		(GLenum target, GLuint id))
+NULL_VOID(BeginTransformFeedback,			NCAT_NONE,		(GLenum primitiveMode))
+NULL_CUSTOM(BindAttribLocation,				NCAT_NONE)
+NULL_VOID(BindBuffer,						NCAT_BUFFER,	(GLenum target, GLuint buffer))
+NULL_VOID(BindBufferBase,					NCAT_BUFFER,	(GLenum target, GLuint index, GLuint buffer))
+NULL_VOID(BindBufferRange,					NCAT_BUFFER,	(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size))
+NULL_VOID(BindFragDataLocation,				NCAT_NONE,		(GLuint program, GLuint color, const GLchar *name))
+NULL_VOID(BindFragDataLocationIndexed,		NCAT_NONE,		(GLuint program, GLuint color, GLuint index, const GLchar *name))
+NULL_VOID(BindFramebuffer,					NCAT_BUFFER,	(GLenum target, GLuint framebuffer))
+NULL_VOID(BindRenderbuffer,					NCAT_BUFFER,	(GLenum target, GLuint renderbuffer))
+NULL_VOID(BindSampler,						NCAT_TEXTURE,	(GLuint unit, GLuint sampler))
+NULL_VOID(BindTexture,						NCAT_TEXTURE,	(GLenum target, GLuint texture))
+NULL_VOID(BindVertexArray,					NCAT_BUFFER,	(GLuint vertexArray))
+NULL_VOID(Bitmap,							NCAT_NONE,		(GLsizei width, GLsizei height, GLfloat xorig, GLfloat yorig, GLfloat xmove, GLfloat ymove, const GLubyte *bitmap))
+NULL_VOID(BlendColor,						NCAT_STATE,		(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha))
+NULL_VOID(BlendEquation,					NCAT_STATE,		(GLenum mode))
+NULL_VOID(BlendEquationSeparate,			NCAT_STATE,		(GLenum modeRGB, GLenum modeAlpha))
+NULL_VOID(BlendFunc,						NCAT_STATE,		(GLenum sfactor, GLenum dfactor))
+NULL_VOID(BlendFuncSeparate,				NCAT_STATE,		(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha))
+NULL_VOID(BlitFramebuffer,					NCAT_NONE,		(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter))
+NULL_CUSTOM(BufferData,						NCAT_UPLOAD)
+NULL_CUSTOM(BufferSubData,					NCAT_UPLOAD)
+NULL_VOID(CallList,							NCAT_DRAW,		(GLuint list))
+NULL_VOID(CallLists,						NCAT_DRAW,		(GLsizei n, GLenum type, const GLvoid *lists))
+NULL_RETURN(CheckFramebufferStatus,			NCAT_QUERY,		GLenum, GL_FRAMEBUFFER_COMPLETE, (GLenum target))
+NULL_VOID(ClampColor,						NCAT_NONE,		(GLenum target, GLenum clamp))
+NULL_VOID(Clear,							NCAT_NONE,		(GLbitfield mask))
+NULL_VOID(ClearAccum,						NCAT_NONE,		(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha))
+NULL_VOID(ClearBufferfi,					NCAT_NONE,		(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil))
+NULL_VOID(ClearBufferfv,					NCAT_NONE,		(GLenum buffer, GLint drawbuffer, const GLfloat *value))
+NULL_VOID(ClearBufferiv,					NCAT_NONE,		(GLenum buffer, GLint drawbuffer, const GLint *value))
+NULL_VOID(ClearBufferuiv,					NCAT_NONE,		(GLenum buffer, GLint drawbuffer, const GLuint *value))
+NULL_VOID(ClearColor,						NCAT_NONE,		(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha))
+NULL_VOID(ClearDepth,						NCAT_NONE,		(GLclampd depth))
+NULL_VOID(ClearIndex,						NCAT_NONE,		(GLfloat c))
+NULL_VOID(ClearStencil,						NCAT_NONE,		(GLint s))
+NULL_VOID(ClientActiveTexture,				NCAT_NONE,		(GLenum texture))
+NULL_RETURN(ClientWaitSync,					NCAT_QUERY,		GLenum, GL_ALREADY_SIGNALED, (GLsync sync, GLbitfield flags, GLuint64 timeout))
+NULL_VOID(ClipPlane,						NCAT_STATE,		(GLenum plane, const GLdouble *equation))
+NULL_VOID(Color3b,							NCAT_NONE,		(GLbyte red, GLbyte green, GLbyte blue))
+NULL_VOID(Color3bv,							NCAT_NONE,		(const GLbyte *v))
+NULL_VOID(Color3d,							NCAT_NONE,		(GLdouble red, GLdouble green, GLdouble blue))
+NULL_VOID(Color3dv,							NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(Color3f,							NCAT_NONE,		(GLfloat red, GLfloat green, GLfloat blue))
+NULL_VOID(Color3fv,							NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Color3i,							NCAT_NONE,		(GLint red, GLint green, GLint blue))
+NULL_VOID(Color3iv,							NCAT_NONE,		(const GLint *v))
+NULL_VOID(Color3s,							NCAT_NONE,		(GLshort red, GLshort green, GLshort blue))
+NULL_VOID(Color3sv,							NCAT_NONE,		(const GLshort *v))
+NULL_VOID(Color3ub,							NCAT_NONE,		(GLubyte red, GLubyte green, GLubyte blue))
+NULL_VOID(Color3ubv,						NCAT_NONE,		(const GLubyte *v))
+NULL_VOID(Color3ui,							NCAT_NONE,		(GLuint red, GLuint green, GLuint blue))
+NULL_VOID(Color3uiv,						NCAT_NONE,		(const GLuint *v))
+NULL_VOID(Color3us,							NCAT_NONE,		(GLushort red, GLushort green, GLushort blue))
+NULL_VOID(Color3usv,						NCAT_NONE,		(const GLushort *v))
+NULL_VOID(Color4b,							NCAT_NONE,		(GLbyte red, GLbyte green, GLbyte blue, GLbyte alpha))
+NULL_VOID(Color4bv,							NCAT_NONE,		(const GLbyte *v))
+NULL_VOID(Color4d,							NCAT_NONE,		(GLdouble red, GLdouble green, GLdouble blue, GLdouble alpha))
+NULL_VOID(Color4dv,							NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(Color4f,							NCAT_NONE,		(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha))
+NULL_VOID(Color4fv,							NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Color4i,							NCAT_NONE,		(GLint red, GLint green, GLint blue, GLint alpha))
+NULL_VOID(Color4iv,							NCAT_NONE,		(const GLint *v))
+NULL_VOID(Color4s,							NCAT_NONE,		(GLshort red, GLshort green, GLshort blue, GLshort alpha))
+NULL_VOID(Color4sv,							NCAT_NONE,		(const GLshort *v))
+NULL_VOID(Color4ub,							NCAT_NONE,		(GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha))
+NULL_VOID(Color4ubv,						NCAT_NONE,		(const GLubyte *v))
+NULL_VOID(Color4ui,							NCAT_NONE,		(GLuint red, GLuint green, GLuint blue, GLuint alpha))
+NULL_VOID(Color4uiv,						NCAT_NONE,		(const GLuint *v))
+NULL_VOID(Color4us,							NCAT_NONE,		(GLushort red, GLushort green, GLushort blue, GLushort alpha))
+NULL_VOID(Color4usv,						NCAT_NONE,		(const GLushort *v))
+NULL_VOID(ColorMask,						NCAT_STATE,		(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha))
+NULL_VOID(ColorMaski,						NCAT_STATE,		(GLuint index, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha))
+NULL_VOID(ColorMaterial,					NCAT_NONE,		(GLenum face, GLenum mode))
+NULL_VOID(ColorP3ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(ColorP3uiv,						NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(ColorP4ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(ColorP4uiv,						NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(ColorPointer,						NCAT_NONE,		(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(CompileShader,					NCAT_NONE,		(GLuint shader))
+NULL_VOID(CompressedTexImage1D,				NCAT_UPLOAD,	(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const GLvoid *pixels))
+NULL_CUSTOM(CompressedTexImage2D,			NCAT_UPLOAD)
+NULL_CUSTOM(CompressedTexImage3D,			NCAT_UPLOAD)
+NULL_VOID(CompressedTexSubImage1D,			NCAT_UPLOAD,	(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const GLvoid *pixels))
+NULL_CUSTOM(CompressedTexSubImage2D,		NCAT_UPLOAD)
+NULL_CUSTOM(CompressedTexSubImage3D,		NCAT_UPLOAD)
+NULL_VOID(CopyBufferSubData,				NCAT_NONE,		(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size))
+NULL_VOID(CopyPixels,						NCAT_NONE,		(GLint x, GLint y, GLsizei width, GLsizei height, GLenum type))
+NULL_VOID(CopyTexImage1D,					NCAT_NONE,		(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border))
+NULL_VOID(CopyTexImage2D,					NCAT_NONE,		(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border))
+NULL_VOID(CopyTexSubImage1D,				NCAT_NONE,		(GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width))
+NULL_VOID(CopyTexSubImage2D,				NCAT_NONE,		(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height))
+NULL_VOID(CopyTexSubImage3D,				NCAT_NONE,		(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height))
+NULL_CUSTOM(CreateProgram,					NCAT_NONE)
+NULL_CUSTOM(CreateShader,					NCAT_NONE)
+NULL_VOID(CullFace,							NCAT_STATE,		(GLenum mode))
+NULL_VOID(DeleteBuffers,					NCAT_NONE,		(GLsizei n, const GLuint *buffers))
+NULL_VOID(DeleteFramebuffers,				NCAT_NONE,		(GLsizei n, const GLuint *framebuffers))
+NULL_VOID(DeleteLists,						NCAT_NONE,		(GLuint list, GLsizei range))
+NULL_CUSTOM(DeleteProgram,					NCAT_NONE)
+NULL_VOID(DeleteQueries,					NCAT_NONE,		(GLsizei n, const GLuint *ids))
+NULL_VOID(DeleteRenderbuffers,				NCAT_NONE,		(GLsizei n, const GLuint *renderbuffers))
+NULL_VOID(DeleteSamplers,					NCAT_NONE,		(GLsizei n, const GLuint *samplers))
+NULL_CUSTOM(DeleteShader,					NCAT_NONE)
+NULL_VOID(DeleteSync,						NCAT_NONE,		(GLsync sync))
+NULL_VOID(DeleteTextures,					NCAT_NONE,		(GLsizei n, const GLuint *textures))
+NULL_VOID(DeleteVertexArrays,				NCAT_NONE,		(GLsizei n, const GLuint *vertexArrays))
+NULL_VOID(DepthBoundsEXT,					NCAT_STATE,		(GLclampd zmin, GLclampd zmax))
+NULL_VOID(DepthFunc,						NCAT_STATE,		(GLenum func))
+NULL_VOID(DepthMask,						NCAT_STATE,		(GLboolean flag))
+NULL_VOID(DepthRange,						NCAT_STATE,		(GLclampd zNear, GLclampd zFar))
+NULL_CUSTOM(DetachShader,					NCAT_NONE)
+NULL_VOID(Disable,							NCAT_STATE,		(GLenum cap))
+NULL_VOID(DisableClientState,				NCAT_NONE,		(GLenum array))
+NULL_VOID(DisableVertexAttribArray,			NCAT_NONE,		(GLuint index))
+NULL_VOID(Disablei,							NCAT_STATE,		(GLenum target, GLuint index))
+NULL_CUSTOM(DrawArrays,						NCAT_DRAW)
+NULL_VOID(DrawArraysInstanced,				NCAT_DRAW,		(GLenum mode, GLint first, GLsizei count, GLsizei primcount))
+NULL_VOID(DrawBuffer,						NCAT_STATE,		(GLenum buffer))
+NULL_VOID(DrawBuffers,						NCAT_STATE,		(GLsizei n, const GLenum *buffers))
+NULL_CUSTOM(DrawElements,					NCAT_DRAW)
+NULL_VOID(DrawElementsBaseVertex,			NCAT_DRAW,		(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLint basevertex))
+NULL_VOID(DrawElementsInstanced,			NCAT_DRAW,		(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLsizei primcount))
+NULL_VOID(DrawElementsInstancedBaseVertex,	NCAT_DRAW,		(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLsizei primcount, GLint basevertex))
+NULL_VOID(DrawPixels,						NCAT_NONE,		(GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels))
+NULL_CUSTOM(DrawRangeElements,				NCAT_DRAW)
+NULL_VOID(DrawRangeElementsBaseVertex,		NCAT_DRAW,		(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const GLvoid *indices, GLint basevertex))
+NULL_VOID(EdgeFlag,							NCAT_NONE,		(GLboolean flag))
+NULL_VOID(EdgeFlagPointer,					NCAT_NONE,		(GLsizei stride, const GLvoid *pointer))
+NULL_VOID(EdgeFlagv,						NCAT_NONE,		(const GLboolean *flag))
+NULL_VOID(Enable,							NCAT_STATE,		(GLenum cap))
+NULL_VOID(EnableClientState,				NCAT_NONE,		(GLenum array))
+NULL_VOID(EnableVertexAttribArray,			NCAT_NONE,		(GLuint index))
+NULL_VOID(Enablei,							NCAT_STATE,		(GLenum target, GLuint index))
+NULL_VOID(End,								NCAT_NONE,		(GLvoid))
+NULL_VOID(EndConditionalRender,				NCAT_NONE,		(GLvoid))
+NULL_VOID(EndList,							NCAT_NONE,		(GLvoid))
+NULL_VOID(EndQuery,							NCAT_NONE,		(GLenum target))
+NULL_VOID(EndTransformFeedback,				NCAT_NONE,		(GLvoid))
+NULL_VOID(EvalCoord1d,						NCAT_NONE,		(GLdouble u))
+NULL_VOID(EvalCoord1dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(EvalCoord1f,						NCAT_NONE,		(GLfloat u))
+NULL_VOID(EvalCoord1fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(EvalCoord2d,						NCAT_NONE,		(GLdouble u, GLdouble v))
+NULL_VOID(EvalCoord2dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(EvalCoord2f,						NCAT_NONE,		(GLfloat u, GLfloat v))
+NULL_VOID(EvalCoord2fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(EvalMesh1,						NCAT_NONE,		(GLenum mode, GLint i1, GLint i2))
+NULL_VOID(EvalMesh2,						NCAT_NONE,		(GLenum mode, GLint i1, GLint i2, GLint j1, GLint j2))
+NULL_VOID(EvalPoint1,						NCAT_NONE,		(GLint i))
+NULL_VOID(EvalPoint2,						NCAT_NONE,		(GLint i, GLint j))
+NULL_VOID(FeedbackBuffer,					NCAT_NONE,		(GLsizei size, GLenum type, GLfloat *buffer))
+NULL_CUSTOM(FenceSync,						NCAT_NONE)
+NULL_VOID(Finish,							NCAT_QUERY,		(GLvoid))
+NULL_VOID(Flush,							NCAT_QUERY,		(GLvoid))
+NULL_VOID(FlushMappedBufferRange,			NCAT_NONE,		(GLenum target, GLintptr offset, GLsizeiptr length))
+NULL_VOID(FogCoordPointer,					NCAT_NONE,		(GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(FogCoordd,						NCAT_NONE,		(GLdouble coord))
+NULL_VOID(FogCoorddv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(FogCoordf,						NCAT_NONE,		(GLfloat coord))
+NULL_VOID(FogCoordfv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Fogf,								NCAT_NONE,		(GLenum pname, GLfloat param))
+NULL_VOID(Fogfv,							NCAT_NONE,		(GLenum pname, const GLfloat *params))
+NULL_VOID(Fogi,								NCAT_NONE,		(GLenum pname, GLint param))
+NULL_VOID(Fogiv,							NCAT_NONE,		(GLenum pname, const GLint *params))
+NULL_VOID(FramebufferRenderbuffer,			NCAT_NONE,		(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer))
+NULL_VOID(FramebufferTexture,				NCAT_NONE,		(GLenum target, GLenum attachment, GLuint texture, GLint level))
+NULL_VOID(FramebufferTexture1D,				NCAT_NONE,		(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level))
+NULL_VOID(FramebufferTexture2D,				NCAT_NONE,		(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level))
+NULL_VOID(FramebufferTexture3D,				NCAT_NONE,		(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint layer))
+NULL_VOID(FramebufferTextureLayer,			NCAT_NONE,		(GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer))
+NULL_VOID(FrontFace,						NCAT_STATE,		(GLenum mode))
+NULL_VOID(Frustum,							NCAT_NONE,		(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar))
+NULL_CUSTOM(GenBuffers,						NCAT_NONE)
+NULL_CUSTOM(GenFramebuffers,				NCAT_NONE)
+NULL_CUSTOM(GenLists,						NCAT_NONE)
+NULL_CUSTOM(GenQueries,						NCAT_NONE)
+NULL_CUSTOM(GenRenderbuffers,				NCAT_NONE)
+NULL_CUSTOM(GenSamplers,					NCAT_NONE)
+NULL_CUSTOM(GenTextures,					NCAT_NONE)
+NULL_CUSTOM(GenVertexArrays,				NCAT_NONE)
+NULL_VOID(GenerateMipmap,					NCAT_NONE,		(GLenum target))
+NULL_VOID(GetActiveAttrib,					NCAT_QUERY,		(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name))
+NULL_CUSTOM(GetActiveUniform,				NCAT_QUERY)
+NULL_VOID(GetActiveUniformBlockName,		NCAT_QUERY,		(GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName))
+NULL_VOID(GetActiveUniformBlockiv,			NCAT_QUERY,		(GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params))
+NULL_VOID(GetActiveUniformName,				NCAT_QUERY,		(GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName))
+NULL_VOID(GetActiveUniformsiv,				NCAT_QUERY,		(GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params))
+NULL_VOID(GetAttachedShaders,				NCAT_QUERY,		(GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders))
+NULL_CUSTOM(GetAttribLocation,				NCAT_QUERY)
+NULL_VOID(GetBooleani_v,					NCAT_QUERY,		(GLenum target, GLuint index, GLboolean *params))
+NULL_CUSTOM(GetBooleanv,					NCAT_QUERY)
+NULL_VOID(GetBufferParameteri64v,			NCAT_QUERY,		(GLenum target, GLenum pname, GLint64 *params))
+NULL_VOID(GetBufferParameteriv,				NCAT_QUERY,		(GLenum target, GLenum pname, GLint *params))
+NULL_VOID(GetBufferPointerv,				NCAT_QUERY,		(GLenum target, GLenum pname, GLvoid **params))
+NULL_VOID(GetBufferSubData,					NCAT_QUERY,		(GLenum target, GLintptr offset, GLsizeiptr size, GLvoid *data))
+NULL_VOID(GetClipPlane,						NCAT_QUERY,		(GLenum plane, GLdouble *equation))
+NULL_VOID(GetCompressedTexImage,			NCAT_QUERY,		(GLenum target, GLint level, GLvoid *pixels))
+NULL_CUSTOM(GetDoublev,						NCAT_QUERY)
+NULL_RETURN(GetError,						NCAT_QUERY,		GLenum, 0, (GLvoid))
+NULL_CUSTOM(GetFloatv,						NCAT_QUERY)
+NULL_RETURN(GetFragDataIndex,				NCAT_QUERY,		GLint, 0, (GLuint program, const GLchar *name))
+NULL_RETURN(GetFragDataLocation,			NCAT_QUERY,		GLint, 0, (GLuint program, const GLchar *name))
+NULL_VOID(GetFramebufferAttachmentParameteriv,	NCAT_QUERY,		(GLenum target, GLenum attachment, GLenum pname, GLint *params))
+NULL_VOID(GetInteger64i_v,					NCAT_QUERY,		(GLenum target, GLuint index, GLint64 *params))
+NULL_VOID(GetInteger64v,					NCAT_QUERY,		(GLenum pname, GLint64 *params))
+NULL_VOID(GetIntegeri_v,					NCAT_QUERY,		(GLenum target, GLuint index, GLint *params))
+NULL_CUSTOM(GetIntegerv,					NCAT_QUERY)
+NULL_VOID(GetLightfv,						NCAT_QUERY,		(GLenum light, GLenum pname, GLfloat *params))
+NULL_VOID(GetLightiv,						NCAT_QUERY,		(GLenum light, GLenum pname, GLint *params))
+NULL_VOID(GetMapdv,							NCAT_QUERY,		(GLenum target, GLenum query, GLdouble *v))
+NULL_VOID(GetMapfv,							NCAT_QUERY,		(GLenum target, GLenum query, GLfloat *v))
+NULL_VOID(GetMapiv,							NCAT_QUERY,		(GLenum target, GLenum query, GLint *v))
+NULL_VOID(GetMaterialfv,					NCAT_QUERY,		(GLenum face, GLenum pname, GLfloat *params))
+NULL_VOID(GetMaterialiv,					NCAT_QUERY,		(GLenum face, GLenum pname, GLint *params))
+NULL_VOID(GetMultisamplefv,					NCAT_QUERY,		(GLenum pname, GLuint index, GLfloat *params))
+NULL_VOID(GetPixelMapfv,					NCAT_QUERY,		(GLenum map, GLfloat *values))
+NULL_VOID(GetPixelMapuiv,					NCAT_QUERY,		(GLenum map, GLuint *values))
+NULL_VOID(GetPixelMapusv,					NCAT_QUERY,		(GLenum map, GLushort *values))
+NULL_VOID(GetPointerv,						NCAT_QUERY,		(GLenum pname, GLvoid **params))
+NULL_VOID(GetPolygonStipple,				NCAT_QUERY,		(GLubyte *mask))
+NULL_CUSTOM(GetProgramInfoLog,				NCAT_QUERY)
+NULL_CUSTOM(GetProgramiv,					NCAT_QUERY)
+NULL_VOID(GetQueryObjecti64v,				NCAT_QUERY,		(GLuint id, GLenum pname, GLint64 *params))
+NULL_VOID(GetQueryObjectiv,					NCAT_QUERY,		(GLuint id, GLenum pname, GLint *params))
+NULL_VOID(GetQueryObjectui64v,				NCAT_QUERY,		(GLuint id, GLenum pname, GLuint64 *params))
+NULL_VOID(GetQueryObjectuiv,				NCAT_QUERY,		(GLuint id, GLenum pname, GLuint *params))
+NULL_VOID(GetQueryiv,						NCAT_QUERY,		(GLenum target, GLenum pname, GLint *params))
+NULL_VOID(GetRenderbufferParameteriv,		NCAT_QUERY,		(GLenum target, GLenum pname, GLint *params))
+NULL_VOID(GetSamplerParameterIiv,			NCAT_QUERY,		(GLuint sampler, GLenum pname, GLint *params))
+NULL_VOID(GetSamplerParameterIuiv,			NCAT_QUERY,		(GLuint sampler, GLenum pname, GLuint *params))
+NULL_VOID(GetSamplerParameterfv,			NCAT_QUERY,		(GLuint sampler, GLenum pname, GLfloat *params))
+NULL_VOID(GetSamplerParameteriv,			NCAT_QUERY,		(GLuint sampler, GLenum pname, GLint *params))
+NULL_CUSTOM(GetShaderInfoLog,				NCAT_QUERY)
+NULL_VOID(GetShaderSource,					NCAT_QUERY,		(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source))
+NULL_CUSTOM(GetShaderiv,					NCAT_QUERY)
+NULL_CUSTOM(GetString,						NCAT_QUERY)
+NULL_RETURN(GetStringi,						NCAT_QUERY,		const GLubyte *, NULL, (GLenum name, GLuint index))
+NULL_VOID(GetSynciv,						NCAT_QUERY,		(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei *length, GLint *values))
+NULL_VOID(GetTexEnvfv,						NCAT_QUERY,		(GLenum target, GLenum pname, GLfloat *params))
+NULL_VOID(GetTexEnviv,						NCAT_QUERY,		(GLenum target, GLenum pname, GLint *params))
+NULL_VOID(GetTexGendv,						NCAT_QUERY,		(GLenum coord, GLenum pname, GLdouble *params))
+NULL_VOID(GetTexGenfv,						NCAT_QUERY,		(GLenum coord, GLenum pname, GLfloat *params))
+NULL_VOID(GetTexGeniv,						NCAT_QUERY,		(GLenum coord, GLenum pname, GLint *params))
+NULL_VOID(GetTexImage,						NCAT_QUERY,		(GLenum target, GLint level, GLenum format, GLenum type, GLvoid *pixels))
+NULL_VOID(GetTexLevelParameterfv,			NCAT_QUERY,		(GLenum target, GLint level, GLenum pname, GLfloat *params))
+NULL_VOID(GetTexLevelParameteriv,			NCAT_QUERY,		(GLenum target, GLint level, GLenum pname, GLint *params))
+NULL_VOID(GetTexParameterIiv,				NCAT_QUERY,		(GLenum target, GLenum pname, GLint *params))
+NULL_VOID(GetTexParameterIuiv,				NCAT_QUERY,		(GLenum target, GLenum pname, GLuint *params))
+NULL_VOID(GetTexParameterfv,				NCAT_QUERY,		(GLenum target, GLenum pname, GLfloat *params))
+NULL_VOID(GetTexParameteriv,				NCAT_QUERY,		(GLenum target, GLenum pname, GLint *params))
+NULL_VOID(GetTransformFeedbackVarying,		NCAT_QUERY,		(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name))
+NULL_RETURN(GetUniformBlockIndex,			NCAT_QUERY,		GLuint, 0, (GLuint program, const GLchar *uniformBlockName))
+NULL_VOID(GetUniformIndices,				NCAT_QUERY,		(GLuint program, GLsizei uniformCount, const GLchar **uniformNames, GLuint *uniformIndices))
+NULL_CUSTOM(GetUniformLocation,				NCAT_QUERY)
+NULL_VOID(GetUniformfv,						NCAT_QUERY,		(GLuint program, GLint location, GLfloat *params))
+NULL_VOID(GetUniformiv,						NCAT_QUERY,		(GLuint program, GLint location, GLint *params))
+NULL_VOID(GetUniformuiv,					NCAT_QUERY,		(GLuint program, GLint location, GLuint *params))
+NULL_VOID(GetVertexAttribIiv,				NCAT_QUERY,		(GLuint index, GLenum pname, GLint *params))
+NULL_VOID(GetVertexAttribIuiv,				NCAT_QUERY,		(GLuint index, GLenum pname, GLuint *params))
+NULL_VOID(GetVertexAttribPointerv,			NCAT_QUERY,		(GLuint index, GLenum pname, GLvoid **params))
+NULL_VOID(GetVertexAttribdv,				NCAT_QUERY,		(GLuint index, GLenum pname, GLdouble *params))
+NULL_VOID(GetVertexAttribfv,				NCAT_QUERY,		(GLuint index, GLenum pname, GLfloat *params))
+NULL_VOID(GetVertexAttribiv,				NCAT_QUERY,		(GLuint index, GLenum pname, GLint *params))
+NULL_VOID(Hint,								NCAT_NONE,		(GLenum target, GLenum mode))
+NULL_VOID(IndexMask,						NCAT_NONE,		(GLuint mask))
+NULL_VOID(IndexPointer,						NCAT_NONE,		(GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(Indexd,							NCAT_NONE,		(GLdouble c))
+NULL_VOID(Indexdv,							NCAT_NONE,		(const GLdouble *c))
+NULL_VOID(Indexf,							NCAT_NONE,		(GLfloat c))
+NULL_VOID(Indexfv,							NCAT_NONE,		(const GLfloat *c))
+NULL_VOID(Indexi,							NCAT_NONE,		(GLint c))
+NULL_VOID(Indexiv,							NCAT_NONE,		(const GLint *c))
+NULL_VOID(Indexs,							NCAT_NONE,		(GLshort c))
+NULL_VOID(Indexsv,							NCAT_NONE,		(const GLshort *c))
+NULL_VOID(Indexub,							NCAT_NONE,		(GLubyte c))
+NULL_VOID(Indexubv,							NCAT_NONE,		(const GLubyte *c))
+NULL_VOID(InitNames,						NCAT_NONE,		(GLvoid))
+NULL_VOID(InterleavedArrays,				NCAT_NONE,		(GLenum format, GLsizei stride, const GLvoid *pointer))
+NULL_RETURN(IsBuffer,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint buffer))
+NULL_RETURN(IsEnabled,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLenum cap))
+NULL_RETURN(IsEnabledi,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLenum target, GLuint index))
+NULL_RETURN(IsFramebuffer,					NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint framebuffer))
+NULL_RETURN(IsList,							NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint list))
+NULL_RETURN(IsProgram,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint program))
+NULL_RETURN(IsQuery,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint id))
+NULL_RETURN(IsRenderbuffer,					NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint renderbuffer))
+NULL_RETURN(IsSampler,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint sampler))
+NULL_RETURN(IsShader,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint shader))
+NULL_RETURN(IsSync,							NCAT_QUERY,		GLboolean, GL_FALSE, (GLsync sync))
+NULL_RETURN(IsTexture,						NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint texture))
+NULL_RETURN(IsVertexArray,					NCAT_QUERY,		GLboolean, GL_FALSE, (GLuint vertexArray))
+NULL_VOID(LightModelf,						NCAT_NONE,		(GLenum pname, GLfloat param))
+NULL_VOID(LightModelfv,						NCAT_NONE,		(GLenum pname, const GLfloat *params))
+NULL_VOID(LightModeli,						NCAT_NONE,		(GLenum pname, GLint param))
+NULL_VOID(LightModeliv,						NCAT_NONE,		(GLenum pname, const GLint *params))
+NULL_VOID(Lightf,							NCAT_NONE,		(GLenum light, GLenum pname, GLfloat param))
+NULL_VOID(Lightfv,							NCAT_NONE,		(GLenum light, GLenum pname, const GLfloat *params))
+NULL_VOID(Lighti,							NCAT_NONE,		(GLenum light, GLenum pname, GLint param))
+NULL_VOID(Lightiv,							NCAT_NONE,		(GLenum light, GLenum pname, const GLint *params))
+NULL_VOID(LineStipple,						NCAT_NONE,		(GLint factor, GLushort pattern))
+NULL_VOID(LineWidth,						NCAT_STATE,		(GLfloat width))
+NULL_CUSTOM(LinkProgram,					NCAT_NONE)
+NULL_VOID(ListBase,							NCAT_NONE,		(GLuint base))
+NULL_VOID(LoadIdentity,						NCAT_NONE,		(GLvoid))
+NULL_VOID(LoadMatrixd,						NCAT_NONE,		(const GLdouble *m))
+NULL_VOID(LoadMatrixf,						NCAT_NONE,		(const GLfloat *m))
+NULL_VOID(LoadName,							NCAT_NONE,		(GLuint name))
+NULL_VOID(LoadTransposeMatrixd,				NCAT_NONE,		(const GLdouble *m))
+NULL_VOID(LoadTransposeMatrixf,				NCAT_NONE,		(const GLfloat *m))
+NULL_VOID(LogicOp,							NCAT_STATE,		(GLenum opcode))
+NULL_VOID(Map1d,							NCAT_NONE,		(GLenum target, GLdouble u1, GLdouble u2, GLint stride, GLint order, const GLdouble *points))
+NULL_VOID(Map1f,							NCAT_NONE,		(GLenum target, GLfloat u1, GLfloat u2, GLint stride, GLint order, const GLfloat *points))
+NULL_VOID(Map2d,							NCAT_NONE,		(GLenum target, GLdouble u1, GLdouble u2, GLint ustride, GLint uorder, GLdouble v1, GLdouble v2, GLint vstride, GLint vorder, const GLdouble *points))
+NULL_VOID(Map2f,							NCAT_NONE,		(GLenum target, GLfloat u1, GLfloat u2, GLint ustride, GLint uorder, GLfloat v1, GLfloat v2, GLint vstride, GLint vorder, const GLfloat *points))
+NULL_CUSTOM(MapBuffer,						NCAT_UPLOAD)
+NULL_CUSTOM(MapBufferRange,					NCAT_UPLOAD)
+NULL_VOID(MapGrid1d,						NCAT_NONE,		(GLint un, GLdouble u1, GLdouble u2))
+NULL_VOID(MapGrid1f,						NCAT_NONE,		(GLint un, GLfloat u1, GLfloat u2))
+NULL_VOID(MapGrid2d,						NCAT_NONE,		(GLint un, GLdouble u1, GLdouble u2, GLint vn, GLdouble v1, GLdouble v2))
+NULL_VOID(MapGrid2f,						NCAT_NONE,		(GLint un, GLfloat u1, GLfloat u2, GLint vn, GLfloat v1, GLfloat v2))
+NULL_VOID(Materialf,						NCAT_NONE,		(GLenum face, GLenum pname, GLfloat param))
+NULL_VOID(Materialfv,						NCAT_NONE,		(GLenum face, GLenum pname, const GLfloat *params))
+NULL_VOID(Materiali,						NCAT_NONE,		(GLenum face, GLenum pname, GLint param))
+NULL_VOID(Materialiv,						NCAT_NONE,		(GLenum face, GLenum pname, const GLint *params))
+NULL_VOID(MatrixMode,						NCAT_NONE,		(GLenum mode))
+NULL_VOID(MultMatrixd,						NCAT_NONE,		(const GLdouble *m))
+NULL_VOID(MultMatrixf,						NCAT_NONE,		(const GLfloat *m))
+NULL_VOID(MultTransposeMatrixd,				NCAT_NONE,		(const GLdouble *m))
+NULL_VOID(MultTransposeMatrixf,				NCAT_NONE,		(const GLfloat *m))
+NULL_VOID(MultiDrawArrays,					NCAT_DRAW,		(GLenum mode, const GLint *first, const GLsizei *count, GLsizei primcount))
+NULL_VOID(MultiDrawElements,				NCAT_DRAW,		(GLenum mode, const GLsizei *count, GLenum type, const GLvoid **indices, GLsizei primcount))
+NULL_VOID(MultiDrawElementsBaseVertex,		NCAT_DRAW,		(GLenum mode, const GLsizei *count, GLenum type, const GLvoid **indices, GLsizei primcount, const GLint *basevertex))
+NULL_VOID(MultiTexCoord1d,					NCAT_NONE,		(GLenum target, GLdouble s))
+NULL_VOID(MultiTexCoord1dv,					NCAT_NONE,		(GLenum target, const GLdouble *v))
+NULL_VOID(MultiTexCoord1f,					NCAT_NONE,		(GLenum target, GLfloat s))
+NULL_VOID(MultiTexCoord1fv,					NCAT_NONE,		(GLenum target, const GLfloat *v))
+NULL_VOID(MultiTexCoord1i,					NCAT_NONE,		(GLenum target, GLint s))
+NULL_VOID(MultiTexCoord1iv,					NCAT_NONE,		(GLenum target, const GLint *v))
+NULL_VOID(MultiTexCoord1s,					NCAT_NONE,		(GLenum target, GLshort s))
+NULL_VOID(MultiTexCoord1sv,					NCAT_NONE,		(GLenum target, const GLshort *v))
+NULL_VOID(MultiTexCoord2d,					NCAT_NONE,		(GLenum target, GLdouble s, GLdouble t))
+NULL_VOID(MultiTexCoord2dv,					NCAT_NONE,		(GLenum target, const GLdouble *v))
+NULL_VOID(MultiTexCoord2f,					NCAT_NONE,		(GLenum target, GLfloat s, GLfloat t))
+NULL_VOID(MultiTexCoord2fv,					NCAT_NONE,		(GLenum target, const GLfloat *v))
+NULL_VOID(MultiTexCoord2i,					NCAT_NONE,		(GLenum target, GLint s, GLint t))
+NULL_VOID(MultiTexCoord2iv,					NCAT_NONE,		(GLenum target, const GLint *v))
+NULL_VOID(MultiTexCoord2s,					NCAT_NONE,		(GLenum target, GLshort s, GLshort t))
+NULL_VOID(MultiTexCoord2sv,					NCAT_NONE,		(GLenum target, const GLshort *v))
+NULL_VOID(MultiTexCoord3d,					NCAT_NONE,		(GLenum target, GLdouble s, GLdouble t, GLdouble r))
+NULL_VOID(MultiTexCoord3dv,					NCAT_NONE,		(GLenum target, const GLdouble *v))
+NULL_VOID(MultiTexCoord3f,					NCAT_NONE,		(GLenum target, GLfloat s, GLfloat t, GLfloat r))
+NULL_VOID(MultiTexCoord3fv,					NCAT_NONE,		(GLenum target, const GLfloat *v))
+NULL_VOID(MultiTexCoord3i,					NCAT_NONE,		(GLenum target, GLint s, GLint t, GLint r))
+NULL_VOID(MultiTexCoord3iv,					NCAT_NONE,		(GLenum target, const GLint *v))
+NULL_VOID(MultiTexCoord3s,					NCAT_NONE,		(GLenum target, GLshort s, GLshort t, GLshort r))
+NULL_VOID(MultiTexCoord3sv,					NCAT_NONE,		(GLenum target, const GLshort *v))
+NULL_VOID(MultiTexCoord4d,					NCAT_NONE,		(GLenum target, GLdouble s, GLdouble t, GLdouble r, GLdouble q))
+NULL_VOID(MultiTexCoord4dv,					NCAT_NONE,		(GLenum target, const GLdouble *v))
+NULL_VOID(MultiTexCoord4f,					NCAT_NONE,		(GLenum target, GLfloat s, GLfloat t, GLfloat r, GLfloat q))
+NULL_VOID(MultiTexCoord4fv,					NCAT_NONE,		(GLenum target, const GLfloat *v))
+NULL_VOID(MultiTexCoord4i,					NCAT_NONE,		(GLenum target, GLint s, GLint t, GLint r, GLint q))
+NULL_VOID(MultiTexCoord4iv,					NCAT_NONE,		(GLenum target, const GLint *v))
+NULL_VOID(MultiTexCoord4s,					NCAT_NONE,		(GLenum target, GLshort s, GLshort t, GLshort r, GLshort q))
+NULL_VOID(MultiTexCoord4sv,					NCAT_NONE,		(GLenum target, const GLshort *v))
+NULL_VOID(MultiTexCoordP1ui,				NCAT_NONE,		(GLenum target, GLenum type, GLuint v))
+NULL_VOID(MultiTexCoordP1uiv,				NCAT_NONE,		(GLenum target, GLenum type, const GLuint *v))
+NULL_VOID(MultiTexCoordP2ui,				NCAT_NONE,		(GLenum target, GLenum type, GLuint v))
+NULL_VOID(MultiTexCoordP2uiv,				NCAT_NONE,		(GLenum target, GLenum type, const GLuint *v))
+NULL_VOID(MultiTexCoordP3ui,				NCAT_NONE,		(GLenum target, GLenum type, GLuint v))
+NULL_VOID(MultiTexCoordP3uiv,				NCAT_NONE,		(GLenum target, GLenum type, const GLuint *v))
+NULL_VOID(MultiTexCoordP4ui,				NCAT_NONE,		(GLenum target, GLenum type, GLuint v))
+NULL_VOID(MultiTexCoordP4uiv,				NCAT_NONE,		(GLenum target, GLenum type, const GLuint *v))
+NULL_VOID(NewList,							NCAT_NONE,		(GLuint list, GLenum mode))
+NULL_VOID(Normal3b,							NCAT_NONE,		(GLbyte nx, GLbyte ny, GLbyte nz))
+NULL_VOID(Normal3bv,						NCAT_NONE,		(const GLbyte *v))
+NULL_VOID(Normal3d,							NCAT_NONE,		(GLdouble nx, GLdouble ny, GLdouble nz))
+NULL_VOID(Normal3dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(Normal3f,							NCAT_NONE,		(GLfloat nx, GLfloat ny, GLfloat nz))
+NULL_VOID(Normal3fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Normal3i,							NCAT_NONE,		(GLint nx, GLint ny, GLint nz))
+NULL_VOID(Normal3iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(Normal3s,							NCAT_NONE,		(GLshort nx, GLshort ny, GLshort nz))
+NULL_VOID(Normal3sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(NormalP3ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(NormalP3uiv,						NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(NormalPointer,					NCAT_NONE,		(GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(Ortho,							NCAT_NONE,		(GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar))
+NULL_VOID(PassThrough,						NCAT_NONE,		(GLfloat token))
+NULL_VOID(PixelMapfv,						NCAT_NONE,		(GLenum map, GLsizei mapsize, const GLfloat *values))
+NULL_VOID(PixelMapuiv,						NCAT_NONE,		(GLenum map, GLsizei mapsize, const GLuint *values))
+NULL_VOID(PixelMapusv,						NCAT_NONE,		(GLenum map, GLsizei mapsize, const GLushort *values))
+NULL_VOID(PixelStoref,						NCAT_NONE,		(GLenum pname, GLfloat param))
+NULL_VOID(PixelStorei,						NCAT_NONE,		(GLenum pname, GLint param))
+NULL_VOID(PixelTransferf,					NCAT_NONE,		(GLenum pname, GLfloat param))
+NULL_VOID(PixelTransferi,					NCAT_NONE,		(GLenum pname, GLint param))
+NULL_VOID(PixelZoom,						NCAT_NONE,		(GLfloat xfactor, GLfloat yfactor))
+NULL_VOID(PointParameterf,					NCAT_NONE,		(GLenum pname, GLfloat param))
+NULL_VOID(PointParameterfv,					NCAT_NONE,		(GLenum pname, const GLfloat *params))
+NULL_VOID(PointParameteri,					NCAT_NONE,		(GLenum pname, GLint param))
+NULL_VOID(PointParameteriv,					NCAT_NONE,		(GLenum pname, const GLint *params))
+NULL_VOID(PointSize,						NCAT_STATE,		(GLfloat size))
+NULL_VOID(PolygonMode,						NCAT_STATE,		(GLenum face, GLenum mode))
+NULL_VOID(PolygonOffset,					NCAT_STATE,		(GLfloat factor, GLfloat units))
+NULL_VOID(PolygonStipple,					NCAT_NONE,		(const GLubyte *mask))
+NULL_VOID(PopAttrib,						NCAT_NONE,		(GLvoid))
+NULL_VOID(PopClientAttrib,					NCAT_NONE,		(GLvoid))
+NULL_VOID(PopMatrix,						NCAT_NONE,		(GLvoid))
+NULL_VOID(PopName,							NCAT_NONE,		(GLvoid))
+NULL_VOID(PrimitiveRestartIndex,			NCAT_NONE,		(GLuint index))
+NULL_VOID(PrioritizeTextures,				NCAT_NONE,		(GLsizei n, const GLuint *textures, const GLclampf *priorities))
+NULL_VOID(ProvokingVertex,					NCAT_STATE,		(GLenum mode))
+NULL_VOID(PushAttrib,						NCAT_NONE,		(GLbitfield mask))
+NULL_VOID(PushClientAttrib,					NCAT_NONE,		(GLbitfield mask))
+NULL_VOID(PushMatrix,						NCAT_NONE,		(GLvoid))
+NULL_VOID(PushName,							NCAT_NONE,		(GLuint name))
+NULL_VOID(QueryCounter,						NCAT_NONE,		(GLuint id, GLenum target))
+NULL_VOID(RasterPos2d,						NCAT_NONE,		(GLdouble x, GLdouble y))
+NULL_VOID(RasterPos2dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(RasterPos2f,						NCAT_NONE,		(GLfloat x, GLfloat y))
+NULL_VOID(RasterPos2fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(RasterPos2i,						NCAT_NONE,		(GLint x, GLint y))
+NULL_VOID(RasterPos2iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(RasterPos2s,						NCAT_NONE,		(GLshort x, GLshort y))
+NULL_VOID(RasterPos2sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(RasterPos3d,						NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(RasterPos3dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(RasterPos3f,						NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(RasterPos3fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(RasterPos3i,						NCAT_NONE,		(GLint x, GLint y, GLint z))
+NULL_VOID(RasterPos3iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(RasterPos3s,						NCAT_NONE,		(GLshort x, GLshort y, GLshort z))
+NULL_VOID(RasterPos3sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(RasterPos4d,						NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z, GLdouble w))
+NULL_VOID(RasterPos4dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(RasterPos4f,						NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z, GLfloat w))
+NULL_VOID(RasterPos4fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(RasterPos4i,						NCAT_NONE,		(GLint x, GLint y, GLint z, GLint w))
+NULL_VOID(RasterPos4iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(RasterPos4s,						NCAT_NONE,		(GLshort x, GLshort y, GLshort z, GLshort w))
+NULL_VOID(RasterPos4sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(ReadBuffer,						NCAT_STATE,		(GLenum buffer))
+NULL_CUSTOM(ReadPixels,						NCAT_QUERY)
+NULL_VOID(Rectd,							NCAT_NONE,		(GLdouble x1, GLdouble y1, GLdouble x2, GLdouble y2))
+NULL_VOID(Rectdv,							NCAT_NONE,		(const GLdouble *v1, const GLdouble *v2))
+NULL_VOID(Rectf,							NCAT_NONE,		(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2))
+NULL_VOID(Rectfv,							NCAT_NONE,		(const GLfloat *v1, const GLfloat *v2))
+NULL_VOID(Recti,							NCAT_NONE,		(GLint x1, GLint y1, GLint x2, GLint y2))
+NULL_VOID(Rectiv,							NCAT_NONE,		(const GLint *v1, const GLint *v2))
+NULL_VOID(Rects,							NCAT_NONE,		(GLshort x1, GLshort y1, GLshort x2, GLshort y2))
+NULL_VOID(Rectsv,							NCAT_NONE,		(const GLshort *v1, const GLshort *v2))
+NULL_RETURN(RenderMode,						NCAT_NONE,		GLint, 0, (GLenum mode))
+NULL_VOID(RenderbufferStorage,				NCAT_NONE,		(GLenum target, GLenum internalformat, GLsizei width, GLsizei height))
+NULL_VOID(RenderbufferStorageMultisample,	NCAT_NONE,		(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height))
+NULL_VOID(Rotated,							NCAT_NONE,		(GLdouble angle, GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(Rotatef,							NCAT_NONE,		(GLfloat angle, GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(SampleCoverage,					NCAT_STATE,		(GLclampf value, GLboolean invert))
+NULL_VOID(SampleMaski,						NCAT_NONE,		(GLuint index, GLbitfield mask))
+NULL_VOID(SamplerParameterIiv,				NCAT_NONE,		(GLuint sampler, GLenum pname, const GLint *params))
+NULL_VOID(SamplerParameterIuiv,				NCAT_NONE,		(GLuint sampler, GLenum pname, const GLuint *params))
+NULL_VOID(SamplerParameterf,				NCAT_NONE,		(GLuint sampler, GLenum pname, GLfloat param))
+NULL_VOID(SamplerParameterfv,				NCAT_NONE,		(GLuint sampler, GLenum pname, const GLfloat *params))
+NULL_VOID(SamplerParameteri,				NCAT_NONE,		(GLuint sampler, GLenum pname, GLint param))
+NULL_VOID(SamplerParameteriv,				NCAT_NONE,		(GLuint sampler, GLenum pname, const GLint *params))
+NULL_VOID(Scaled,							NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(Scalef,							NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(Scissor,							NCAT_STATE,		(GLint x, GLint y, GLsizei width, GLsizei height))
+NULL_VOID(SecondaryColor3b,					NCAT_NONE,		(GLbyte red, GLbyte green, GLbyte blue))
+NULL_VOID(SecondaryColor3bv,				NCAT_NONE,		(const GLbyte *v))
+NULL_VOID(SecondaryColor3d,					NCAT_NONE,		(GLdouble red, GLdouble green, GLdouble blue))
+NULL_VOID(SecondaryColor3dv,				NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(SecondaryColor3f,					NCAT_NONE,		(GLfloat red, GLfloat green, GLfloat blue))
+NULL_VOID(SecondaryColor3fv,				NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(SecondaryColor3i,					NCAT_NONE,		(GLint red, GLint green, GLint blue))
+NULL_VOID(SecondaryColor3iv,				NCAT_NONE,		(const GLint *v))
+NULL_VOID(SecondaryColor3s,					NCAT_NONE,		(GLshort red, GLshort green, GLshort blue))
+NULL_VOID(SecondaryColor3sv,				NCAT_NONE,		(const GLshort *v))
+NULL_VOID(SecondaryColor3ub,				NCAT_NONE,		(GLubyte red, GLubyte green, GLubyte blue))
+NULL_VOID(SecondaryColor3ubv,				NCAT_NONE,		(const GLubyte *v))
+NULL_VOID(SecondaryColor3ui,				NCAT_NONE,		(GLuint red, GLuint green, GLuint blue))
+NULL_VOID(SecondaryColor3uiv,				NCAT_NONE,		(const GLuint *v))
+NULL_VOID(SecondaryColor3us,				NCAT_NONE,		(GLushort red, GLushort green, GLushort blue))
+NULL_VOID(SecondaryColor3usv,				NCAT_NONE,		(const GLushort *v))
+NULL_VOID(SecondaryColorP3ui,				NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(SecondaryColorP3uiv,				NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(SecondaryColorPointer,			NCAT_NONE,		(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(SelectBuffer,						NCAT_NONE,		(GLsizei size, GLuint *buffer))
+NULL_VOID(ShadeModel,						NCAT_STATE,		(GLenum mode))
+NULL_CUSTOM(ShaderSource,					NCAT_NONE)
+NULL_VOID(StencilFunc,						NCAT_STATE,		(GLenum func, GLint ref, GLuint mask))
+NULL_VOID(StencilFuncSeparate,				NCAT_STATE,		(GLenum face, GLenum func, GLint ref, GLuint mask))
+NULL_VOID(StencilFuncSeparateATI,			NCAT_STATE,		(GLenum frontfunc, GLenum backfunc, GLint ref, GLuint mask))
+NULL_VOID(StencilMask,						NCAT_STATE,		(GLuint mask))
+NULL_VOID(StencilMaskSeparate,				NCAT_STATE,		(GLenum face, GLuint mask))
+NULL_VOID(StencilOp,						NCAT_STATE,		(GLenum fail, GLenum zfail, GLenum zpass))
+NULL_VOID(StencilOpSeparate,				NCAT_STATE,		(GLenum face, GLenum fail, GLenum zfail, GLenum zpass))
+NULL_VOID(StencilOpSeparateATI,				NCAT_STATE,		(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass))
+NULL_VOID(TexBuffer,						NCAT_NONE,		(GLenum target, GLenum internalformat, GLuint buffer))
+NULL_VOID(TexCoord1d,						NCAT_NONE,		(GLdouble s))
+NULL_VOID(TexCoord1dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(TexCoord1f,						NCAT_NONE,		(GLfloat s))
+NULL_VOID(TexCoord1fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(TexCoord1i,						NCAT_NONE,		(GLint s))
+NULL_VOID(TexCoord1iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(TexCoord1s,						NCAT_NONE,		(GLshort s))
+NULL_VOID(TexCoord1sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(TexCoord2d,						NCAT_NONE,		(GLdouble s, GLdouble t))
+NULL_VOID(TexCoord2dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(TexCoord2f,						NCAT_NONE,		(GLfloat s, GLfloat t))
+NULL_VOID(TexCoord2fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(TexCoord2i,						NCAT_NONE,		(GLint s, GLint t))
+NULL_VOID(TexCoord2iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(TexCoord2s,						NCAT_NONE,		(GLshort s, GLshort t))
+NULL_VOID(TexCoord2sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(TexCoord3d,						NCAT_NONE,		(GLdouble s, GLdouble t, GLdouble r))
+NULL_VOID(TexCoord3dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(TexCoord3f,						NCAT_NONE,		(GLfloat s, GLfloat t, GLfloat r))
+NULL_VOID(TexCoord3fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(TexCoord3i,						NCAT_NONE,		(GLint s, GLint t, GLint r))
+NULL_VOID(TexCoord3iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(TexCoord3s,						NCAT_NONE,		(GLshort s, GLshort t, GLshort r))
+NULL_VOID(TexCoord3sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(TexCoord4d,						NCAT_NONE,		(GLdouble s, GLdouble t, GLdouble r, GLdouble q))
+NULL_VOID(TexCoord4dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(TexCoord4f,						NCAT_NONE,		(GLfloat s, GLfloat t, GLfloat r, GLfloat q))
+NULL_VOID(TexCoord4fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(TexCoord4i,						NCAT_NONE,		(GLint s, GLint t, GLint r, GLint q))
+NULL_VOID(TexCoord4iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(TexCoord4s,						NCAT_NONE,		(GLshort s, GLshort t, GLshort r, GLshort q))
+NULL_VOID(TexCoord4sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(TexCoordP1ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(TexCoordP1uiv,					NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(TexCoordP2ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(TexCoordP2uiv,					NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(TexCoordP3ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(TexCoordP3uiv,					NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(TexCoordP4ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(TexCoordP4uiv,					NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(TexCoordPointer,					NCAT_NONE,		(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(TexEnvf,							NCAT_NONE,		(GLenum target, GLenum pname, GLfloat param))
+NULL_VOID(TexEnvfv,							NCAT_NONE,		(GLenum target, GLenum pname, const GLfloat *params))
+NULL_VOID(TexEnvi,							NCAT_NONE,		(GLenum target, GLenum pname, GLint param))
+NULL_VOID(TexEnviv,							NCAT_NONE,		(GLenum target, GLenum pname, const GLint *params))
+NULL_VOID(TexGend,							NCAT_NONE,		(GLenum coord, GLenum pname, GLdouble param))
+NULL_VOID(TexGendv,							NCAT_NONE,		(GLenum coord, GLenum pname, const GLdouble *params))
+NULL_VOID(TexGenf,							NCAT_NONE,		(GLenum coord, GLenum pname, GLfloat param))
+NULL_VOID(TexGenfv,							NCAT_NONE,		(GLenum coord, GLenum pname, const GLfloat *params))
+NULL_VOID(TexGeni,							NCAT_NONE,		(GLenum coord, GLenum pname, GLint param))
+NULL_VOID(TexGeniv,							NCAT_NONE,		(GLenum coord, GLenum pname, const GLint *params))
+NULL_VOID(TexImage1D,						NCAT_UPLOAD,	(GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const GLvoid *pixels))
+NULL_CUSTOM(TexImage2D,						NCAT_UPLOAD)
+NULL_VOID(TexImage2DMultisample,			NCAT_NONE,		(GLenum target, GLsizei samples, GLint internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations))
+NULL_CUSTOM(TexImage3D,						NCAT_UPLOAD)
+NULL_VOID(TexImage3DMultisample,			NCAT_NONE,		(GLenum target, GLsizei samples, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations))
+NULL_VOID(TexParameterIiv,					NCAT_NONE,		(GLenum target, GLenum pname, const GLint *params))
+NULL_VOID(TexParameterIuiv,					NCAT_NONE,		(GLenum target, GLenum pname, const GLuint *params))
+NULL_VOID(TexParameterf,					NCAT_NONE,		(GLenum target, GLenum pname, GLfloat param))
+NULL_VOID(TexParameterfv,					NCAT_NONE,		(GLenum target, GLenum pname, const GLfloat *params))
+NULL_VOID(TexParameteri,					NCAT_NONE,		(GLenum target, GLenum pname, GLint param))
+NULL_VOID(TexParameteriv,					NCAT_NONE,		(GLenum target, GLenum pname, const GLint *params))
+NULL_VOID(TexSubImage1D,					NCAT_UPLOAD,	(GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const GLvoid *pixels))
+NULL_CUSTOM(TexSubImage2D,					NCAT_UPLOAD)
+NULL_CUSTOM(TexSubImage3D,					NCAT_UPLOAD)
+NULL_VOID(TransformFeedbackVaryings,		NCAT_NONE,		(GLuint program, GLsizei count, const GLchar **varyings, GLenum bufferMode))
+NULL_VOID(Translated,						NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(Translatef,						NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(Uniform1f,						NCAT_UNIFORM,	(GLint location, GLfloat v0))
+NULL_VOID(Uniform1fv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLfloat *v))
+NULL_VOID(Uniform1i,						NCAT_UNIFORM,	(GLint location, GLint v0))
+NULL_VOID(Uniform1iv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLint *v))
+NULL_VOID(Uniform1ui,						NCAT_UNIFORM,	(GLint location, GLuint v0))
+NULL_VOID(Uniform1uiv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLuint *v))
+NULL_VOID(Uniform2f,						NCAT_UNIFORM,	(GLint location, GLfloat v0, GLfloat v1))
+NULL_VOID(Uniform2fv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLfloat *v))
+NULL_VOID(Uniform2i,						NCAT_UNIFORM,	(GLint location, GLint v0, GLint v1))
+NULL_VOID(Uniform2iv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLint *v))
+NULL_VOID(Uniform2ui,						NCAT_UNIFORM,	(GLint location, GLuint v0, GLuint v1))
+NULL_VOID(Uniform2uiv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLuint *v))
+NULL_VOID(Uniform3f,						NCAT_UNIFORM,	(GLint location, GLfloat v0, GLfloat v1, GLfloat v2))
+NULL_VOID(Uniform3fv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLfloat *v))
+NULL_VOID(Uniform3i,						NCAT_UNIFORM,	(GLint location, GLint v0, GLint v1, GLint v2))
+NULL_VOID(Uniform3iv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLint *v))
+NULL_VOID(Uniform3ui,						NCAT_UNIFORM,	(GLint location, GLuint v0, GLuint v1, GLuint v2))
+NULL_VOID(Uniform3uiv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLuint *v))
+NULL_VOID(Uniform4f,						NCAT_UNIFORM,	(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3))
+NULL_VOID(Uniform4fv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLfloat *v))
+NULL_VOID(Uniform4i,						NCAT_UNIFORM,	(GLint location, GLint v0, GLint v1, GLint v2, GLint v3))
+NULL_VOID(Uniform4iv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLint *v))
+NULL_VOID(Uniform4ui,						NCAT_UNIFORM,	(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3))
+NULL_VOID(Uniform4uiv,						NCAT_UNIFORM,	(GLint location, GLsizei count, const GLuint *v))
+NULL_VOID(UniformBlockBinding,				NCAT_NONE,		(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding))
+NULL_VOID(UniformMatrix2fv,					NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix2x3fv,				NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix2x4fv,				NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix3fv,					NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix3x2fv,				NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix3x4fv,				NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix4fv,					NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix4x2fv,				NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_VOID(UniformMatrix4x3fv,				NCAT_UNIFORM,	(GLint location, GLsizei count, GLboolean transpose, const GLfloat *v))
+NULL_RETURN(UnmapBuffer,					NCAT_NONE,		GLboolean, GL_TRUE, (GLenum target))
+NULL_VOID(UseProgram,						NCAT_PROGRAM,	(GLuint program))
+NULL_VOID(ValidateProgram,					NCAT_NONE,		(GLuint program))
+NULL_VOID(Vertex2d,							NCAT_NONE,		(GLdouble x, GLdouble y))
+NULL_VOID(Vertex2dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(Vertex2f,							NCAT_NONE,		(GLfloat x, GLfloat y))
+NULL_VOID(Vertex2fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Vertex2i,							NCAT_NONE,		(GLint x, GLint y))
+NULL_VOID(Vertex2iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(Vertex2s,							NCAT_NONE,		(GLshort x, GLshort y))
+NULL_VOID(Vertex2sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(Vertex3d,							NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(Vertex3dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(Vertex3f,							NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(Vertex3fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Vertex3i,							NCAT_NONE,		(GLint x, GLint y, GLint z))
+NULL_VOID(Vertex3iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(Vertex3s,							NCAT_NONE,		(GLshort x, GLshort y, GLshort z))
+NULL_VOID(Vertex3sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(Vertex4d,							NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z, GLdouble w))
+NULL_VOID(Vertex4dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(Vertex4f,							NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z, GLfloat w))
+NULL_VOID(Vertex4fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(Vertex4i,							NCAT_NONE,		(GLint x, GLint y, GLint z, GLint w))
+NULL_VOID(Vertex4iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(Vertex4s,							NCAT_NONE,		(GLshort x, GLshort y, GLshort z, GLshort w))
+NULL_VOID(Vertex4sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(VertexAttrib1d,					NCAT_NONE,		(GLuint index, GLdouble x))
+NULL_VOID(VertexAttrib1dv,					NCAT_NONE,		(GLuint index, const GLdouble *v))
+NULL_VOID(VertexAttrib1f,					NCAT_NONE,		(GLuint index, GLfloat x))
+NULL_VOID(VertexAttrib1fv,					NCAT_NONE,		(GLuint index, const GLfloat *v))
+NULL_VOID(VertexAttrib1s,					NCAT_NONE,		(GLuint index, GLshort x))
+NULL_VOID(VertexAttrib1sv,					NCAT_NONE,		(GLuint index, const GLshort *v))
+NULL_VOID(VertexAttrib2d,					NCAT_NONE,		(GLuint index, GLdouble x, GLdouble y))
+NULL_VOID(VertexAttrib2dv,					NCAT_NONE,		(GLuint index, const GLdouble *v))
+NULL_VOID(VertexAttrib2f,					NCAT_NONE,		(GLuint index, GLfloat x, GLfloat y))
+NULL_VOID(VertexAttrib2fv,					NCAT_NONE,		(GLuint index, const GLfloat *v))
+NULL_VOID(VertexAttrib2s,					NCAT_NONE,		(GLuint index, GLshort x, GLshort y))
+NULL_VOID(VertexAttrib2sv,					NCAT_NONE,		(GLuint index, const GLshort *v))
+NULL_VOID(VertexAttrib3d,					NCAT_NONE,		(GLuint index, GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(VertexAttrib3dv,					NCAT_NONE,		(GLuint index, const GLdouble *v))
+NULL_VOID(VertexAttrib3f,					NCAT_NONE,		(GLuint index, GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(VertexAttrib3fv,					NCAT_NONE,		(GLuint index, const GLfloat *v))
+NULL_VOID(VertexAttrib3s,					NCAT_NONE,		(GLuint index, GLshort x, GLshort y, GLshort z))
+NULL_VOID(VertexAttrib3sv,					NCAT_NONE,		(GLuint index, const GLshort *v))
+NULL_VOID(VertexAttrib4Nbv,					NCAT_NONE,		(GLuint index, const GLbyte *v))
+NULL_VOID(VertexAttrib4Niv,					NCAT_NONE,		(GLuint index, const GLint *v))
+NULL_VOID(VertexAttrib4Nsv,					NCAT_NONE,		(GLuint index, const GLshort *v))
+NULL_VOID(VertexAttrib4Nub,					NCAT_NONE,		(GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w))
+NULL_VOID(VertexAttrib4Nubv,				NCAT_NONE,		(GLuint index, const GLubyte *v))
+NULL_VOID(VertexAttrib4Nuiv,				NCAT_NONE,		(GLuint index, const GLuint *v))
+NULL_VOID(VertexAttrib4Nusv,				NCAT_NONE,		(GLuint index, const GLushort *v))
+NULL_VOID(VertexAttrib4bv,					NCAT_NONE,		(GLuint index, const GLbyte *v))
+NULL_VOID(VertexAttrib4d,					NCAT_NONE,		(GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w))
+NULL_VOID(VertexAttrib4dv,					NCAT_NONE,		(GLuint index, const GLdouble *v))
+NULL_VOID(VertexAttrib4f,					NCAT_NONE,		(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w))
+NULL_VOID(VertexAttrib4fv,					NCAT_NONE,		(GLuint index, const GLfloat *v))
+NULL_VOID(VertexAttrib4iv,					NCAT_NONE,		(GLuint index, const GLint *v))
+NULL_VOID(VertexAttrib4s,					NCAT_NONE,		(GLuint index, GLshort x, GLshort y, GLshort z, GLshort w))
+NULL_VOID(VertexAttrib4sv,					NCAT_NONE,		(GLuint index, const GLshort *v))
+NULL_VOID(VertexAttrib4ubv,					NCAT_NONE,		(GLuint index, const GLubyte *v))
+NULL_VOID(VertexAttrib4uiv,					NCAT_NONE,		(GLuint index, const GLuint *v))
+NULL_VOID(VertexAttrib4usv,					NCAT_NONE,		(GLuint index, const GLushort *v))
+NULL_VOID(VertexAttribI1i,					NCAT_NONE,		(GLuint index, GLint x))
+NULL_VOID(VertexAttribI1iv,					NCAT_NONE,		(GLuint index, const GLint *v))
+NULL_VOID(VertexAttribI1ui,					NCAT_NONE,		(GLuint index, GLuint x))
+NULL_VOID(VertexAttribI1uiv,				NCAT_NONE,		(GLuint index, const GLuint *v))
+NULL_VOID(VertexAttribI2i,					NCAT_NONE,		(GLuint index, GLint x, GLint y))
+NULL_VOID(VertexAttribI2iv,					NCAT_NONE,		(GLuint index, const GLint *v))
+NULL_VOID(VertexAttribI2ui,					NCAT_NONE,		(GLuint index, GLuint x, GLuint y))
+NULL_VOID(VertexAttribI2uiv,				NCAT_NONE,		(GLuint index, const GLuint *v))
+NULL_VOID(VertexAttribI3i,					NCAT_NONE,		(GLuint index, GLint x, GLint y, GLint z))
+NULL_VOID(VertexAttribI3iv,					NCAT_NONE,		(GLuint index, const GLint *v))
+NULL_VOID(VertexAttribI3ui,					NCAT_NONE,		(GLuint index, GLuint x, GLuint y, GLuint z))
+NULL_VOID(VertexAttribI3uiv,				NCAT_NONE,		(GLuint index, const GLuint *v))
+NULL_VOID(VertexAttribI4bv,					NCAT_NONE,		(GLuint index, const GLbyte *v))
+NULL_VOID(VertexAttribI4i,					NCAT_NONE,		(GLuint index, GLint x, GLint y, GLint z, GLint w))
+NULL_VOID(VertexAttribI4iv,					NCAT_NONE,		(GLuint index, const GLint *v))
+NULL_VOID(VertexAttribI4sv,					NCAT_NONE,		(GLuint index, const GLshort *v))
+NULL_VOID(VertexAttribI4ubv,				NCAT_NONE,		(GLuint index, const GLubyte *v))
+NULL_VOID(VertexAttribI4ui,					NCAT_NONE,		(GLuint index, GLuint x, GLuint y, GLuint z, GLuint w))
+NULL_VOID(VertexAttribI4uiv,				NCAT_NONE,		(GLuint index, const GLuint *v))
+NULL_VOID(VertexAttribI4usv,				NCAT_NONE,		(GLuint index, const GLushort *v))
+NULL_VOID(VertexAttribIPointer,				NCAT_NONE,		(GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(VertexAttribP1ui,					NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, GLuint v))
+NULL_VOID(VertexAttribP1uiv,				NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, const GLuint *v))
+NULL_VOID(VertexAttribP2ui,					NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, GLuint v))
+NULL_VOID(VertexAttribP2uiv,				NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, const GLuint *v))
+NULL_VOID(VertexAttribP3ui,					NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, GLuint v))
+NULL_VOID(VertexAttribP3uiv,				NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, const GLuint *v))
+NULL_VOID(VertexAttribP4ui,					NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, GLuint v))
+NULL_VOID(VertexAttribP4uiv,				NCAT_NONE,		(GLuint index, GLenum type, GLboolean normalized, const GLuint *v))
+NULL_VOID(VertexAttribPointer,				NCAT_NONE,		(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(VertexP2ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(VertexP2uiv,						NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(VertexP3ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(VertexP3uiv,						NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(VertexP4ui,						NCAT_NONE,		(GLenum type, GLuint v))
+NULL_VOID(VertexP4uiv,						NCAT_NONE,		(GLenum type, const GLuint *v))
+NULL_VOID(VertexPointer,					NCAT_NONE,		(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
+NULL_VOID(Viewport,							NCAT_STATE,		(GLint x, GLint y, GLsizei width, GLsizei height))
+NULL_VOID(WaitSync,							NCAT_NONE,		(GLsync sync, GLbitfield flags, GLuint64 timeout))
+NULL_VOID(WindowPos2d,						NCAT_NONE,		(GLdouble x, GLdouble y))
+NULL_VOID(WindowPos2dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(WindowPos2f,						NCAT_NONE,		(GLfloat x, GLfloat y))
+NULL_VOID(WindowPos2fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(WindowPos2i,						NCAT_NONE,		(GLint x, GLint y))
+NULL_VOID(WindowPos2iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(WindowPos2s,						NCAT_NONE,		(GLshort x, GLshort y))
+NULL_VOID(WindowPos2sv,						NCAT_NONE,		(const GLshort *v))
+NULL_VOID(WindowPos3d,						NCAT_NONE,		(GLdouble x, GLdouble y, GLdouble z))
+NULL_VOID(WindowPos3dv,						NCAT_NONE,		(const GLdouble *v))
+NULL_VOID(WindowPos3f,						NCAT_NONE,		(GLfloat x, GLfloat y, GLfloat z))
+NULL_VOID(WindowPos3fv,						NCAT_NONE,		(const GLfloat *v))
+NULL_VOID(WindowPos3i,						NCAT_NONE,		(GLint x, GLint y, GLint z))
+NULL_VOID(WindowPos3iv,						NCAT_NONE,		(const GLint *v))
+NULL_VOID(WindowPos3s,						NCAT_NONE,		(GLshort x, GLshort y, GLshort z))
+NULL_VOID(WindowPos3sv,						NCAT_NONE,		(const GLshort *v))
\ No newline at end of file
@@ -0,0 +1,153 @@
+/*
+ ------------------------------------------------------------------------------
+ Copyright (C) 1997-2001 Id Software.
+
+ This file is part of the Quake 2 source code.
+
+ The Quake 2 source code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 2 of the License, or (at your
+ option) any later version.
+
+ The Quake 2 source code is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ more details.
+
+ You should have received a copy of the GNU General Public License along with
+ the Quake 2 source code; if not, write to the Free Software Foundation, Inc.,
+ 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ ------------------------------------------------------------------------------
+*/
+
+
+
+//
+// null_unzip.c - Stand-in for the minizip library when it is not available.
+// Every .pk3 file fails to open, so only .pak files and loose files are used.
+//
+
+
+#include "../common/common.h"
+#include "../include/ZLib/unzip.h"
+
+
+/*
+ ==================
+ unzOpen
+ ==================
+*/
+unzFile ZEXPORT unzOpen (const char *path){
+
+	return NULL;
+}
+
+/*
+ ==================
+ unzClose
+ ==================
+*/
+int ZEXPORT unzClose (unzFile file){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unzGetGlobalInfo
+ ==================
+*/
+int ZEXPORT unzGetGlobalInfo (unzFile file, unz_global_info *pglobal_info){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unzGoToFirstFile
+ ==================
+*/
+int ZEXPORT unzGoToFirstFile (unzFile file){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unzGoToNextFile
+ ==================
+*/
+int ZEXPORT unzGoToNextFile (unzFile file){
+
+	return UNZ_END_OF_LIST_OF_FILE;
+}
+
+/*
+ ==================
+ unzLocateFile
+ ==================
+*/
+int ZEXPORT unzLocateFile (unzFile file, const char *szFileName, int iCaseSensitivity){
+
+	return UNZ_END_OF_LIST_OF_FILE;
+}
+
+/*
+ ==================
+ unzGetCurrentFileInfo
+ ==================
+*/
+int ZEXPORT unzGetCurrentFileInfo (unzFile file, unz_file_info *pfile_info, char *szFileName, uLong fileNameBufferSize, void *extraField, uLong extraFieldBufferSize, char *szComment, uLong commentBufferSize){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unzGetOffset
+ ==================
+*/
+uLong ZEXPORT unzGetOffset (unzFile file){
+
+	return 0;
+}
+
+/*
+ ==================
+ unzOpenCurrentFile
+ ==================
+*/
+int ZEXPORT unzOpenCurrentFile (unzFile file){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unzCloseCurrentFile
+ ==================
+*/
+int ZEXPORT unzCloseCurrentFile (unzFile file){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unzReadCurrentFile
+ ==================
+*/
+int ZEXPORT unzReadCurrentFile (unzFile file, voidp buf, unsigned len){
+
+	return UNZ_PARAMERROR;
+}
+
+/*
+ ==================
+ unztell
+ ==================
+*/
+z_off_t ZEXPORT unztell (unzFile file){
+
+	return 0;
+}
\ No newline at end of file
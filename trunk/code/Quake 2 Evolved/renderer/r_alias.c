@@ -96,11 +96,11 @@ static bool R_CullAliasModel (renderEntity_t *entity, mdl_t *alias){
 	}
 
 	if (aggregateMask){
-		rg.pc.cullBoundsOut++;
+		R_GetPerformanceCounters()->cullBoundsOut++;
 		return true;
 	}
 
-	rg.pc.cullBoundsIn++;
+	R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return false;
 }
@@ -132,7 +132,7 @@ void R_AddAliasModel (renderEntity_t *entity){
 	// Mark as visible for this view
 	entity->viewCount = rg.viewCount;
 
-	rg.pc.entities++;
+	R_GetPerformanceCounters()->entities++;
 
 	// Add all the surfaces
 	for (i = 0, surface = alias->surfaces; i < alias->numSurfaces; i++, surface++){
@@ -253,7 +253,7 @@ bool R_UnmapIndexBuffer (arrayBuffer_t *indexBuffer){
  R_AllocVertexBuffer
  ==================
 */
-arrayBuffer_t *R_AllocVertexBuffer (const char *name, bool dynamic, int vertexCount, const void *vertexData){
+arrayBuffer_t *R_AllocVertexBuffer (const char *name, bool dynamic, int vertexCount, int vertexSize, const void *vertexData){
 
 	arrayBuffer_t	*vertexBuffer;
 
@@ -280,11 +280,8 @@ arrayBuffer_t *R_AllocVertexBuffer (const char *name, bool dynamic, int vertexCo
 	Str_Copy(vertexBuffer->name, name, sizeof(vertexBuffer->name));
 	vertexBuffer->dynamic = dynamic;
 	vertexBuffer->count = vertexCount;
-
-	if (backEnd.stencilShadow)
-		vertexBuffer->size = vertexCount * sizeof(glShadowVertex_t);
-	else
-		vertexBuffer->size = vertexCount * sizeof(glVertex_t);
+	vertexBuffer->vertexSize = vertexSize;
+	vertexBuffer->size = vertexCount * vertexSize;
 
 	vertexBuffer->mapped = false;
 	vertexBuffer->frameUsed = 0;
@@ -316,11 +313,7 @@ void R_ReallocVertexBuffer (arrayBuffer_t *vertexBuffer, int vertexCount, const
 
 	// Fill it in
 	vertexBuffer->count = vertexCount;
-
-	if (backEnd.stencilShadow)
-		vertexBuffer->size = vertexCount * sizeof(glShadowVertex_t);
-	else
-		vertexBuffer->size = vertexCount * sizeof(glVertex_t);
+	vertexBuffer->size = vertexCount * vertexBuffer->vertexSize;
 
 	vertexBuffer->frameUsed = 0;
 
@@ -31,6 +31,8 @@
 
 backEnd_t					backEnd;
 
+static void					RB_ExecuteCommandList (const void *data);
+
 
 /*
  ==============================================================================
@@ -195,7 +197,7 @@ static void RB_ShowTextures (){
 		return;
 
 	// Switch to 2D mode
-	GL_Setup2D(rg.time);
+	GL_Setup2D(backEnd.frameTime);
 
 	qglFinish();
 
@@ -261,6 +263,22 @@ static void RB_ShowTextures (){
 */
 
 
+/*
+ ==================
+ RB_RenderScene
+
+ Executes the render view commands the front-end thread generated for a scene
+ ==================
+*/
+static const void *RB_RenderScene (const void *data){
+
+	const renderSceneCommand_t	*cmd = (const renderSceneCommand_t *)data;
+
+	RB_ExecuteCommandList(cmd->scene->commands);
+
+	return (const void *)(cmd + 1);
+}
+
 /*
  ==================
  RB_RenderView
@@ -280,7 +298,7 @@ static const void *RB_RenderView (const void *data){
 
 	QGL_LogPrintf("---------- RB_RenderView ----------\n");
 
-	rg.pc.views++;
+	R_GetPerformanceCounters()->views++;
 
 	backEnd.viewParms = cmd->viewParms;
 
@@ -453,7 +471,7 @@ static const void *RB_DrawStretchPic (const void *data){
 
 	// Switch to 2D mode if needed
 	if (!backEnd.projection2D){
-		GL_Setup2D(rg.time);
+		GL_Setup2D(backEnd.frameTime);
 
 		// Clear the batch state
 		backEnd.entity = NULL;
@@ -548,7 +566,7 @@ static const void *RB_DrawCinematic (const void *data){
 
 	// Switch to 2D mode if needed
 	if (!backEnd.projection2D){
-		GL_Setup2D(rg.time);
+		GL_Setup2D(backEnd.frameTime);
 
 		// Clear the batch state
 		backEnd.entity = NULL;
@@ -692,6 +710,9 @@ static const void *RB_SetupBuffers (const void *data){
 
 	QGL_LogPrintf("---------- RB_SetupBuffers ----------\n");
 
+	// Set the frame time for 2D rendering
+	backEnd.frameTime = cmd->time;
+
 	// Set the draw and read buffers
 	if (r_frontBuffer->integerValue){
 		qglDrawBuffer(GL_FRONT);
@@ -762,31 +783,23 @@ static const void *RB_SwapBuffers (const void *data){
 
 /*
  ==================
- RB_ExecuteRenderCommands
+ RB_ExecuteCommandList
  ==================
 */
-void RB_ExecuteRenderCommands (const void *data){
+static void RB_ExecuteCommandList (const void *data){
 
 	renderCommand_t	commandId;
-	int				timeBackEnd;
-
-	if (r_skipBackEnd->integerValue)
-		return;
-
-	if (com_speeds->integerValue)
-		timeBackEnd = Sys_Milliseconds();
 
 	while (1){
 		commandId = *(const renderCommand_t *)data;
 
-		if (commandId == RC_END_OF_LIST){
-			if (com_speeds->integerValue)
-				com_timeBackEnd += (Sys_Milliseconds() - timeBackEnd);
-
+		if (commandId == RC_END_OF_LIST)
 			return;
-		}
 
 		switch (commandId){
+		case RC_RENDER_SCENE:
+			data = RB_RenderScene(data);
+			break;
 		case RC_RENDER_VIEW:
 			data = RB_RenderView(data);
 			break;
@@ -821,11 +834,39 @@ void RB_ExecuteRenderCommands (const void *data){
 			data = RB_SwapBuffers(data);
 			break;
 		default:
-			Com_Error(ERR_DROP, "RB_ExecuteRenderCommands: bad command id (%i)", commandId);
+			Com_Error(ERR_DROP, "RB_ExecuteCommandList: bad command id (%i)", commandId);
 		}
 	}
 }
 
+/*
+ ==================
+ RB_ExecuteRenderCommands
+ ==================
+*/
+void RB_ExecuteRenderCommands (const void *data){
+
+	int			timeBackEnd;
+	longlong	ticks;
+
+	if (r_skipBackEnd->integerValue)
+		return;
+
+	if (com_speeds->integerValue)
+		timeBackEnd = Sys_Milliseconds();
+
+	if (com_timeDemo->integerValue)
+		ticks = Sys_ClockTicks();
+
+	RB_ExecuteCommandList(data);
+
+	if (com_speeds->integerValue)
+		com_timeBackEnd += (Sys_Milliseconds() - timeBackEnd);
+
+	if (com_timeDemo->integerValue)
+		rg.timeDemo.backEnd += Sys_ClockTicks() - ticks;
+}
+
 
 /*
  ==============================================================================
@@ -1166,9 +1207,6 @@ static void RB_SetupPostProcessShaders (){
 */
 void RB_InitBackEnd (){
 
-	// Allocate the render command buffer
-	backEnd.commandBuffer.data = (byte *)Mem_Alloc(MAX_COMMAND_BUFFER_SIZE, TAG_RENDERER);
-
 	// Allocate index and vertex arrays
 	backEnd.indices = (glIndex_t *)Mem_Alloc(MAX_INDICES * sizeof(glIndex_t), TAG_RENDERER);
 	backEnd.vertices = (glVertex_t *)Mem_Alloc16(MAX_VERTICES * sizeof(glVertex_t), TAG_RENDERER);
@@ -1180,8 +1218,8 @@ void RB_InitBackEnd (){
 	backEnd.dynamicIndexBuffers[0] = R_AllocIndexBuffer("streamBuffer1", true, MAX_DYNAMIC_INDICES, NULL);
 	backEnd.dynamicIndexBuffers[1] = R_AllocIndexBuffer("streamBuffer2", true, MAX_DYNAMIC_INDICES, NULL);
 
-	backEnd.dynamicVertexBuffers[0] = R_AllocVertexBuffer("streamBuffer1", true, MAX_DYNAMIC_VERTICES, NULL);
-	backEnd.dynamicVertexBuffers[1] = R_AllocVertexBuffer("streamBuffer2", true, MAX_DYNAMIC_VERTICES, NULL);
+	backEnd.dynamicVertexBuffers[0] = R_AllocVertexBuffer("streamBuffer1", true, MAX_DYNAMIC_VERTICES, sizeof(glVertex_t), NULL);
+	backEnd.dynamicVertexBuffers[1] = R_AllocVertexBuffer("streamBuffer2", true, MAX_DYNAMIC_VERTICES, sizeof(glVertex_t), NULL);
 
 	// Set up shaders
 	RB_SetupInteractionShaders();
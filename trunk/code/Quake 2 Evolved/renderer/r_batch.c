@@ -65,6 +65,8 @@ void RB_SetupBatch (renderEntity_t *entity, material_t *material, bool stencilSh
 	backEnd.stencilShadow = stencilShadow;
 	backEnd.shadowCaps = shadowCaps;
 
+	backEnd.indexOffset = 0;
+
 	if (backEnd.stencilShadow){
 		backEnd.indexBuffer = NULL;
 		backEnd.indexPointer = backEnd.shadowIndices;
@@ -304,9 +306,9 @@ static void RB_BatchSprite (){
 	float		rad, s, c;
 	int			i;
 
-	rg.pc.dynamicSprite++;
-	rg.pc.dynamicIndices += 6;
-	rg.pc.dynamicVertices += 4;
+	R_GetPerformanceCounters()->dynamicSprite++;
+	R_GetPerformanceCounters()->dynamicIndices += 6;
+	R_GetPerformanceCounters()->dynamicVertices += 4;
 
 	// Compute left and up vectors
 	if (backEnd.entity->spriteOriented){
@@ -415,12 +417,12 @@ static void RB_BatchBeam (){
 	float		scale, length;
 	int			i;
 
-	rg.pc.dynamicBeam++;
-	rg.pc.dynamicIndices += 6;
-	rg.pc.dynamicVertices += 4;
+	R_GetPerformanceCounters()->dynamicBeam++;
+	R_GetPerformanceCounters()->dynamicIndices += 6;
+	R_GetPerformanceCounters()->dynamicVertices += 4;
 
 	// Compute view and side vectors
-	VectorSubtract(rg.renderView.origin, backEnd.entity->origin, view);
+	VectorSubtract(backEnd.viewParms.origin, backEnd.entity->origin, view);
 	VectorSubtract(backEnd.entity->beamEnd, backEnd.entity->origin, side);
 
 	// Compute direction
@@ -503,9 +505,9 @@ static void RB_BatchParticle (meshData_t *data){
 	vec3_t				axis[3];
 	int					i;
 
-	rg.pc.dynamicParticle++;
-	rg.pc.dynamicIndices += 6;
-	rg.pc.dynamicVertices += 4;
+	R_GetPerformanceCounters()->dynamicParticle++;
+	R_GetPerformanceCounters()->dynamicIndices += 6;
+	R_GetPerformanceCounters()->dynamicVertices += 4;
 
 	// Check for overflow
 	RB_CheckMeshOverflow(6, 4);
@@ -527,7 +529,7 @@ static void RB_BatchParticle (meshData_t *data){
 
 	if (particle->length != 1.0f){
 		// Find orientation vectors
-		VectorSubtract(rg.renderView.origin, particle->origin, axis[0]);
+		VectorSubtract(backEnd.viewParms.origin, particle->origin, axis[0]);
 		VectorSubtract(particle->oldOrigin, particle->origin, axis[1]);
 		CrossProduct(axis[0], axis[1], axis[2]);
 
@@ -557,11 +559,11 @@ static void RB_BatchParticle (meshData_t *data){
 	else {
 		if (particle->rotation){
 			// Rotate it around its normal
-			RotatePointAroundVector(axis[1], rg.renderView.axis[0], rg.renderView.axis[1], particle->rotation);
-			CrossProduct(rg.renderView.axis[0], axis[1], axis[2]);
+			RotatePointAroundVector(axis[1], backEnd.viewParms.axis[0], backEnd.viewParms.axis[1], particle->rotation);
+			CrossProduct(backEnd.viewParms.axis[0], axis[1], axis[2]);
 
 			// The normal should point at the viewer
-			VectorNegate(rg.renderView.axis[0], axis[0]);
+			VectorNegate(backEnd.viewParms.axis[0], axis[0]);
 
 			// Scale the axes by radius
 			VectorScale(axis[1], particle->radius, axis[1]);
@@ -569,11 +571,11 @@ static void RB_BatchParticle (meshData_t *data){
 		}
 		else {
 			// The normal should point at the viewer
-			VectorNegate(rg.renderView.axis[0], axis[0]);
+			VectorNegate(backEnd.viewParms.axis[0], axis[0]);
 
 			// Scale the axes by radius
-			VectorScale(rg.renderView.axis[1], particle->radius, axis[1]);
-			VectorScale(rg.renderView.axis[2], particle->radius, axis[2]);
+			VectorScale(backEnd.viewParms.axis[1], particle->radius, axis[1]);
+			VectorScale(backEnd.viewParms.axis[2], particle->radius, axis[2]);
 		}
 
 		vertices[0].xyz[0] = particle->origin[0] + axis[1][0] + axis[2][0];
@@ -936,6 +938,65 @@ static void RB_BatchAliasModelShadow (meshData_t *data){
 	}
 }
 
+/*
+ ==================
+ RB_BatchStaticSurfaceShadow
+
+ The shadow volume was built at load time, so nothing is generated here. The
+ batch is drawn straight from the static index buffer as long as the index
+ ranges are contiguous, otherwise the prebuilt indices are copied.
+ ==================
+*/
+static void RB_BatchStaticSurfaceShadow (meshData_t *data){
+
+	staticShadow_t	*shadow = (staticShadow_t *)data;
+	int				numIndices;
+
+	// The debug tools read the batched geometry from system memory
+	if (backEnd.debugRendering){
+		backEnd.meshData = shadow->surface;
+
+		RB_BatchSurfaceShadow(shadow->surface);
+		return;
+	}
+
+	if (backEnd.shadowCaps)
+		numIndices = shadow->numSilhouetteIndices + shadow->numCapIndices;
+	else
+		numIndices = shadow->numSilhouetteIndices;
+
+	// Check for overflow. The vertices stay in the static vertex buffer, so
+	// only the indices count against the batch limits.
+	RB_CheckMeshOverflow(numIndices, 0);
+
+	R_GetPerformanceCounters()->staticShadows++;
+	R_GetPerformanceCounters()->staticShadowVertices += shadow->numVertices;
+
+	// Start a new batch with the static buffers
+	if (!backEnd.numIndices){
+		backEnd.indexBuffer = shadow->indexBuffer;
+		backEnd.indexOffset = shadow->indexOffset;
+
+		backEnd.vertexBuffer = shadow->vertexBuffer;
+	}
+	else if (backEnd.indexBuffer && backEnd.indexOffset + backEnd.numIndices != shadow->indexOffset){
+		// Not contiguous, so copy the indices batched so far and continue in
+		// system memory
+		Mem_Copy(backEnd.shadowIndices, shadow->indices + backEnd.indexOffset, backEnd.numIndices * sizeof(glIndex_t));
+
+		backEnd.indexBuffer = NULL;
+		backEnd.indexOffset = 0;
+		backEnd.indexPointer = backEnd.shadowIndices;
+	}
+
+	// Batch indices if needed
+	if (!backEnd.indexBuffer)
+		Mem_Copy(backEnd.shadowIndices + backEnd.numIndices, shadow->indices + shadow->indexOffset, numIndices * sizeof(glIndex_t));
+
+	backEnd.numIndices += numIndices;
+	backEnd.numVertices += shadow->numVertices;
+}
+
 /*
  ==================
  RB_BatchShadowGeometry
@@ -952,6 +1013,9 @@ void RB_BatchShadowGeometry (meshType_t type, meshData_t *data){
 	case MESH_ALIASMODEL:
 		RB_BatchAliasModelShadow(data);
 		break;
+	case MESH_STATICSHADOW:
+		RB_BatchStaticSurfaceShadow(data);
+		break;
 	default:
 		Com_Error(ERR_DROP, "RB_BatchShadowGeometry: bad mesh type (%i)", type);
 	}
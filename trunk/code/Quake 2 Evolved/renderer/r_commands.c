@@ -29,47 +29,132 @@
 #include "r_local.h"
 
 
+typedef struct {
+	void *					thread;
+
+	void *					wakeEvent;
+	void *					doneEvent;
+
+	volatile bool			shutdown;
+
+	renderFrame_t *			frontEndFrame;		// Frame the front-end thread is working on
+	renderFrame_t *			backEndFrame;		// Frame waiting to be rendered by the back-end
+} frontEndThread_t;
+
+static renderFrame_t		r_renderFrames[MAX_RENDER_FRAMES];
+static int					r_currentFrame;
+
+static frontEndThread_t		r_frontEnd;
+
+// Frame and command buffer the calling thread adds commands to. The main thread
+// records into the current frame, and the front-end thread generates render
+// view commands for the frame it is working on.
+static THREAD_LOCAL renderFrame_t *		r_renderFrame;
+static THREAD_LOCAL commandBuffer_t *	r_commandBuffer;
+
+// Performance counters of every thread doing renderer work. The main thread and
+// the front-end thread use the first two slots, the job threads get one when
+// they first count something.
+#define MAX_COUNTER_SLOTS			(MAX_JOB_THREADS + 2)
+
+static performanceCounters_t		r_counterSlots[MAX_COUNTER_SLOTS];
+static volatile int					r_numCounterSlots = 2;
+
+static THREAD_LOCAL performanceCounters_t *	r_counters;
+
+
+/*
+ ==================
+ R_AddPerformanceCounters
+
+ Adds the given counters to the frame counters and clears them
+ ==================
+*/
+static void R_AddPerformanceCounters (renderFrame_t *frame, performanceCounters_t *counters){
+
+	int		*dst = (int *)&frame->pc, *src = (int *)counters;
+	int		numInts;
+	int		i;
+
+	// Everything before the overdraw counters is an integer
+	numInts = ((byte *)&counters->overdraw - (byte *)counters) / sizeof(int);
+
+	for (i = 0; i < numInts; i++)
+		dst[i] += src[i];
+
+	frame->pc.overdraw += counters->overdraw;
+	frame->pc.overdrawLights += counters->overdrawLights;
+
+	Mem_Fill(counters, 0, sizeof(performanceCounters_t));
+}
+
+/*
+ ==================
+ R_GatherPerformanceCounters
+
+ Adds the counters of the calling thread to the frame counters. The job threads
+ only do renderer work for the front-end, and they are idle once it is done with
+ a frame, so their counters are gathered by the front-end.
+ ==================
+*/
+static void R_GatherPerformanceCounters (renderFrame_t *frame, bool frontEnd){
+
+	int		i;
+
+	R_AddPerformanceCounters(frame, R_GetPerformanceCounters());
+
+	if (!frontEnd)
+		return;
+
+	for (i = 2; i < r_numCounterSlots && i < MAX_COUNTER_SLOTS; i++)
+		R_AddPerformanceCounters(frame, &r_counterSlots[i]);
+}
+
 /*
  ==================
  R_PerformanceCounters
  ==================
 */
-static void R_PerformanceCounters (){
+static void R_PerformanceCounters (renderFrame_t *frame){
+
+	performanceCounters_t	*pc = &frame->pc;
 
 	if (r_showCull->integerValue || r_showCull->integerValue == 3)
-		Com_Printf("in: %i (b: %i, s: %i, l: %i), clip: %i (b: %i, s: %i, l: %i), out: %i (b: %i, s: %i, l: %i)\n", rg.pc.cullBoundsIn + rg.pc.cullSphereIn + rg.pc.cullLineIn, rg.pc.cullBoundsIn, rg.pc.cullSphereIn, rg.pc.cullLineIn, rg.pc.cullBoundsClip + rg.pc.cullSphereClip + rg.pc.cullLineClip, rg.pc.cullBoundsClip, rg.pc.cullSphereClip, rg.pc.cullLineClip, rg.pc.cullBoundsOut + rg.pc.cullSphereOut + rg.pc.cullLineOut, rg.pc.cullBoundsOut, rg.pc.cullSphereOut, rg.pc.cullLineOut);
+		Com_Printf("in: %i (b: %i, s: %i, l: %i), clip: %i (b: %i, s: %i, l: %i), out: %i (b: %i, s: %i, l: %i)\n", pc->cullBoundsIn + pc->cullSphereIn + pc->cullLineIn, pc->cullBoundsIn, pc->cullSphereIn, pc->cullLineIn, pc->cullBoundsClip + pc->cullSphereClip + pc->cullLineClip, pc->cullBoundsClip, pc->cullSphereClip, pc->cullLineClip, pc->cullBoundsOut + pc->cullSphereOut + pc->cullLineOut, pc->cullBoundsOut, pc->cullSphereOut, pc->cullLineOut);
 
 	if (r_showScene->integerValue)
-		Com_Printf("entities: %i, lights: %i, particles: %i, decals: %i\n", rg.pc.entities, rg.pc.lights, rg.pc.particles, rg.pc.decals);
+		Com_Printf("entities: %i, lights: %i, particles: %i, decals: %i\n", pc->entities, pc->lights, pc->particles, pc->decals);
 
-	if (r_showLights->integerValue)
-		Com_Printf("lights: %i (static: %i, dynamic: %i)\n", rg.pc.lights, rg.pc.staticLights, rg.pc.dynamicLights);
+	if (r_showLights->integerValue){
+		Com_Printf("lights: %i (static: %i, dynamic: %i)\n", pc->lights, pc->staticLights, pc->dynamicLights);
+		Com_Printf("static shadows: %i (saved verts: %i)\n", pc->staticShadows, pc->staticShadowVertices);
+	}
 
 	if (r_showDynamic->integerValue)
-		Com_Printf("tris: %i verts: %i (sprite: %i, beam: %i, particle: %i, decal: %i)\n", rg.pc.dynamicIndices / 3, rg.pc.dynamicVertices, rg.pc.dynamicSprite, rg.pc.dynamicBeam, rg.pc.dynamicParticle,  rg.pc.dynamicDecal);
+		Com_Printf("tris: %i verts: %i (sprite: %i, beam: %i, particle: %i, decal: %i)\n", pc->dynamicIndices / 3, pc->dynamicVertices, pc->dynamicSprite, pc->dynamicBeam, pc->dynamicParticle,  pc->dynamicDecal);
 
 	if (r_showDeforms->integerValue)
-		Com_Printf("tris: %i verts: %i (expand: %i, move: %i, sprite: %i, tube: %i, beam: %i)\n", rg.pc.deformIndices / 3, rg.pc.deformVertices, rg.pc.deformExpand, rg.pc.deformMove, rg.pc.deformSprite, rg.pc.deformTube, rg.pc.deformBeam);
+		Com_Printf("tris: %i verts: %i (expand: %i, move: %i, sprite: %i, tube: %i, beam: %i)\n", pc->deformIndices / 3, pc->deformVertices, pc->deformExpand, pc->deformMove, pc->deformSprite, pc->deformTube, pc->deformBeam);
 
 	// TODO: r_showPrimitives
 
 	if (r_showIndexBuffers->integerValue)
-		Com_Printf("index buffers: %i = %i KB (static: %i = %i KB, dynamic: %i = %i KB)\n", rg.pc.indexBuffers[0] + rg.pc.indexBuffers[1], (rg.pc.indexBufferBytes[0] + rg.pc.indexBufferBytes[1]) >> 10, rg.pc.indexBuffers[0], rg.pc.indexBufferBytes[0] >> 10, rg.pc.indexBuffers[1], rg.pc.indexBufferBytes[1] >> 10);
+		Com_Printf("index buffers: %i = %i KB (static: %i = %i KB, dynamic: %i = %i KB)\n", pc->indexBuffers[0] + pc->indexBuffers[1], (pc->indexBufferBytes[0] + pc->indexBufferBytes[1]) >> 10, pc->indexBuffers[0], pc->indexBufferBytes[0] >> 10, pc->indexBuffers[1], pc->indexBufferBytes[1] >> 10);
 
 	if (r_showVertexBuffers->integerValue)
-		Com_Printf("vertex buffers: %i = %i KB (static: %i = %i KB, dynamic: %i = %i KB)\n", rg.pc.vertexBuffers[0] + rg.pc.vertexBuffers[1], (rg.pc.vertexBufferBytes[0] + rg.pc.vertexBufferBytes[1]) >> 10, rg.pc.vertexBuffers[0], rg.pc.vertexBufferBytes[0] >> 10, rg.pc.vertexBuffers[1], rg.pc.vertexBufferBytes[1] >> 10);
+		Com_Printf("vertex buffers: %i = %i KB (static: %i = %i KB, dynamic: %i = %i KB)\n", pc->vertexBuffers[0] + pc->vertexBuffers[1], (pc->vertexBufferBytes[0] + pc->vertexBufferBytes[1]) >> 10, pc->vertexBuffers[0], pc->vertexBufferBytes[0] >> 10, pc->vertexBuffers[1], pc->vertexBufferBytes[1] >> 10);
 
 	if (r_showTextureUsage->integerValue)
-		Com_Printf("textures: %i = %.2f MB\n", rg.pc.textures, rg.pc.textureBytes * (1.0f / 1048576.0f));
+		Com_Printf("textures: %i = %.2f MB\n", pc->textures, pc->textureBytes * (1.0f / 1048576.0f));
 
 	if (r_showOverdraw->integerValue)
-		Com_Printf("overdraw: %.2f\n", rg.pc.overdraw);
+		Com_Printf("overdraw: %.2f\n", pc->overdraw);
 
 	if (r_showLightCount->integerValue)
-		Com_Printf("light overdraw: %.2f\n", rg.pc.overdrawLights);
+		Com_Printf("light overdraw: %.2f\n", pc->overdrawLights);
 
 	// Clear for next frame
-	Mem_Fill(&rg.pc, 0, sizeof(performanceCounters_t));
+	Mem_Fill(pc, 0, sizeof(performanceCounters_t));
 }
 
 /*
@@ -79,7 +164,7 @@ static void R_PerformanceCounters (){
 */
 static void *R_GetCommandBuffer (int size){
 
-	commandBuffer_t	*commandBuffer = &backEnd.commandBuffer;
+	commandBuffer_t	*commandBuffer = r_commandBuffer;
 
 	// Always leave room for the end of list command
 	if (commandBuffer->size + size + sizeof(renderCommand_t) > MAX_COMMAND_BUFFER_SIZE)
@@ -90,14 +175,55 @@ static void *R_GetCommandBuffer (int size){
 	return commandBuffer->data + commandBuffer->size - size;
 }
 
+/*
+ ==================
+ R_CopyCommandImage
+
+ When the front-end runs on its own thread, the back-end renders a frame after
+ the caller has moved on, so images passed to render commands must be copied.
+ The copy is only freed when the frame is issued during the next engine frame,
+ after the frame arena of this thread has been reset, so it can't be frame
+ memory.
+ ==================
+*/
+static const byte *R_CopyCommandImage (const byte *image, int width, int height){
+
+	renderFrame_t	*frame = r_renderFrame;
+	byte			*copy;
+
+	if (!rg.smpActive || !image)
+		return image;
+
+	if (frame->numImages == MAX_FRAME_IMAGES){
+		Com_DPrintf(S_COLOR_YELLOW "R_CopyCommandImage: MAX_FRAME_IMAGES hit\n");
+		return NULL;
+	}
+
+	copy = (byte *)Mem_Alloc(width * height * 4, TAG_RENDERER);
+	Mem_Copy(copy, image, width * height * 4);
+
+	frame->images[frame->numImages++] = copy;
+
+	return copy;
+}
+
 /*
  ==================
  R_IssueRenderCommands
  ==================
 */
-static void R_IssueRenderCommands (){
+static void R_IssueRenderCommands (renderFrame_t *frame){
 
-	commandBuffer_t	*commandBuffer = &backEnd.commandBuffer;
+	commandBuffer_t	*commandBuffer = &frame->commandBuffer;
+	int				i;
+
+	// Edit the post-process parameters of the current view area if needed. The
+	// area comes from the front-end, so it is only looked at here.
+	if (frame->hasViewArea){
+		frame->hasViewArea = false;
+
+		R_EditAreaPostProcess(frame->viewArea);
+	}
 
 	if (!commandBuffer->size)
 		return;
@@ -109,15 +235,180 @@ static void R_IssueRenderCommands (){
 	commandBuffer->size = 0;
 
 	// Execute the commands
+	backEnd.frame = frame;
+
 	RB_ExecuteRenderCommands(commandBuffer->data);
 
+	// Free the copied images
+	for (i = 0; i < frame->numImages; i++)
+		Mem_Free(frame->images[i]);
+
+	frame->numImages = 0;
+
 	// Clear any debug polygons, lines, and text
 	RB_ClearDebugPolygons();
 	RB_ClearDebugLines();
 	RB_ClearDebugText();
 
-	// Look at the performance counters
-	R_PerformanceCounters();
+	// Look at the performance counters. Without the front-end thread, the
+	// front-end work was also done on this thread.
+	R_GatherPerformanceCounters(frame, !rg.smpActive);
+
+	R_PerformanceCounters(frame);
+}
+
+
+/*
+ ==============================================================================
+
+ FRONT-END THREAD
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ R_RunFrontEnd
+
+ Generates the render view commands for all the scenes queued in the given
+ frame
+ ==================
+*/
+static void R_RunFrontEnd (renderFrame_t *frame){
+
+	renderScene_t	*scene;
+	int				i;
+
+	r_renderFrame = frame;
+
+	r_commandBuffer = &frame->viewCommandBuffer;
+	r_commandBuffer->size = 0;
+
+	// Switch to the mesh and light lists of this frame
+	for (i = 0; i < 4; i++){
+		rg.meshes[i] = frame->meshes[i];
+		rg.lights[i] = frame->lights[i];
+	}
+
+	rg.lightMeshes.shadows = frame->shadowMeshes;
+	rg.lightMeshes.interactions = frame->interactionMeshes;
+
+	// Clear light interaction meshes
+	R_ClearLightMeshes();
+
+	// Clear mesh and light lists
+	R_ClearMeshes();
+	R_ClearLights();
+
+	// Render all the scenes
+	for (i = 0, scene = frame->scenes; i < frame->numScenes; i++, scene++){
+		scene->commands = r_commandBuffer->data + r_commandBuffer->size;
+
+		R_RenderSceneViews(scene);
+
+		// Add an end of list command for the back-end
+		*(renderCommand_t *)R_GetCommandBuffer(sizeof(renderCommand_t)) = RC_END_OF_LIST;
+	}
+
+	// Gather the performance counters for the back-end
+	R_GatherPerformanceCounters(frame, true);
+}
+
+/*
+ ==================
+ R_FrontEndThread
+ ==================
+*/
+static void R_FrontEndThread (void *data){
+
+	Mem_AttachThread("frontEnd");
+
+	r_counters = &r_counterSlots[1];
+
+	while (1){
+		Sys_WaitEvent(r_frontEnd.wakeEvent, -1);
+
+		if (r_frontEnd.shutdown)
+			break;
+
+		R_RunFrontEnd(r_frontEnd.frontEndFrame);
+
+		Sys_SignalEvent(r_frontEnd.doneEvent);
+	}
+
+	Mem_DetachThread();
+}
+
+/*
+ ==================
+ R_WaitForFrontEnd
+ ==================
+*/
+static void R_WaitForFrontEnd (){
+
+	if (!r_frontEnd.frontEndFrame)
+		return;
+
+	Sys_WaitEvent(r_frontEnd.doneEvent, -1);
+
+	// The frame is now ready for the back-end
+	r_frontEnd.backEndFrame = r_frontEnd.frontEndFrame;
+	r_frontEnd.frontEndFrame = NULL;
+}
+
+/*
+ ==================
+ R_SyncFrontEnd
+ ==================
+*/
+void R_SyncFrontEnd (){
+
+	if (!rg.smpActive)
+		return;
+
+	R_WaitForFrontEnd();
+
+	// Render the frame if needed
+	if (!r_frontEnd.backEndFrame)
+		return;
+
+	R_IssueRenderCommands(r_frontEnd.backEndFrame);
+
+	r_frontEnd.backEndFrame = NULL;
+}
+
+/*
+ ==================
+ R_GetRenderFrame
+ ==================
+*/
+renderFrame_t *R_GetRenderFrame (){
+
+	return r_renderFrame;
+}
+
+/*
+ ==================
+ R_GetPerformanceCounters
+ ==================
+*/
+performanceCounters_t *R_GetPerformanceCounters (){
+
+	int		slot;
+
+	if (r_counters)
+		return r_counters;
+
+	// First time on this job thread, so bind a slot to it. If there are more
+	// threads than slots, the last one is shared and the counts are not exact.
+	slot = Sys_AtomicIncrement(&r_numCounterSlots) - 1;
+	if (slot >= MAX_COUNTER_SLOTS)
+		slot = MAX_COUNTER_SLOTS - 1;
+
+	r_counters = &r_counterSlots[slot];
+
+	return r_counters;
 }
 
 
@@ -150,6 +441,8 @@ void R_AddRenderViewCommand (){
 	cmd->viewParms.primaryView = rg.viewParms.primaryView;
 	cmd->viewParms.viewType = rg.viewParms.viewType;
 
+	cmd->viewParms.envShotRendering = rg.viewParms.envShotRendering;
+
 	cmd->viewParms.viewport = rg.viewParms.viewport;
 	cmd->viewParms.scissor = rg.viewParms.scissor;
 
@@ -186,6 +479,65 @@ void R_AddRenderViewCommand (){
 	Mem_Copy(&cmd->postProcessParms, &rg.postProcess.postProcessParms, sizeof(postProcessParms_t));
 }
 
+/*
+ ==================
+ R_AddRenderSceneCommand
+
+ Queues a scene for the front-end thread. The scene render lists, light styles,
+ and area bits are copied, because the front-end will only get to them after
+ the main thread has moved on to the next frame.
+ ==================
+*/
+void R_AddRenderSceneCommand (const renderScene_t *scene){
+
+	renderFrame_t			*frame = r_renderFrame;
+	renderSceneCommand_t	*cmd;
+	renderScene_t			*queuedScene;
+	int						index;
+
+	if (frame->numScenes == MAX_FRAME_SCENES){
+		Com_DPrintf(S_COLOR_YELLOW "R_AddRenderSceneCommand: MAX_FRAME_SCENES hit\n");
+		return;
+	}
+
+	queuedScene = &frame->scenes[frame->numScenes++];
+
+	*queuedScene = *scene;
+
+	// Copy the scene render lists, keeping the same indices
+	index = scene->renderEntities - rg.scene.entities;
+
+	Mem_Copy(&frame->scene->entities[index], scene->renderEntities, scene->numRenderEntities * sizeof(renderEntity_t));
+	queuedScene->renderEntities = &frame->scene->entities[index];
+
+	index = scene->renderLights - rg.scene.lights;
+
+	Mem_Copy(&frame->scene->lights[index], scene->renderLights, scene->numRenderLights * sizeof(renderLight_t));
+	queuedScene->renderLights = &frame->scene->lights[index];
+
+	index = scene->renderParticles - rg.scene.particles;
+
+	Mem_Copy(&frame->scene->particles[index], scene->renderParticles, scene->numRenderParticles * sizeof(renderParticle_t));
+	queuedScene->renderParticles = &frame->scene->particles[index];
+
+	// Copy the light styles
+	Mem_Copy(frame->lightStyles, scene->lightStyles, MAX_LIGHTSTYLES * sizeof(lightStyle_t));
+	queuedScene->lightStyles = frame->lightStyles;
+
+	// Copy the area bits
+	if (scene->renderView.areaBits){
+		Mem_Copy(queuedScene->areaBits, scene->renderView.areaBits, sizeof(queuedScene->areaBits));
+		queuedScene->renderView.areaBits = queuedScene->areaBits;
+	}
+
+	// Add a render scene command
+	cmd = (renderSceneCommand_t *)R_GetCommandBuffer(sizeof(renderSceneCommand_t));
+
+	cmd->commandId = RC_RENDER_SCENE;
+
+	cmd->scene = queuedScene;
+}
+
 /*
  ==================
  R_CaptureRenderToTexture
@@ -232,6 +584,11 @@ bool R_UpdateTextureImage (const char *name, const byte *image, int width, int h
 	if (texture->type != TT_2D || !(texture->flags & TF_ALLOWUPDATE))
 		return false;
 
+	// Copy the image if needed
+	image = R_CopyCommandImage(image, width, height);
+	if (!image)
+		return false;
+
 	// Add an update texture command
 	cmd = (updateTextureCommand_t *)R_GetCommandBuffer(sizeof(updateTextureCommand_t));
 
@@ -380,8 +737,8 @@ void R_DrawStretchPic (float x, float y, float w, float h, float s1, float t1, f
 	float					x1, y1, x2, y2;
 
 	// Scale the coordinates and correct the aspect ratio if needed
-	R_AdjustHorzCoords(horzAdjust, horzPercent, x, w, &x, &w);
-	R_AdjustVertCoords(vertAdjust, vertPercent, y, h, &y, &h);
+	R_AdjustHorzCoords(&rg.renderCrops[rg.currentRenderCrop], horzAdjust, horzPercent, x, w, &x, &w);
+	R_AdjustVertCoords(&rg.renderCrops[rg.currentRenderCrop], vertAdjust, vertPercent, y, h, &y, &h);
 
 	// Set up the coordinates
 	x1 = x;
@@ -426,8 +783,8 @@ void R_DrawStretchPicEx (float x, float y, float w, float h, float s1, float t1,
 	float					s, c;
 
 	// Scale the coordinates and correct the aspect ratio if needed
-	R_AdjustHorzCoords(horzAdjust, horzPercent, x, w, &x, &w);
-	R_AdjustVertCoords(vertAdjust, vertPercent, y, h, &y, &h);
+	R_AdjustHorzCoords(&rg.renderCrops[rg.currentRenderCrop], horzAdjust, horzPercent, x, w, &x, &w);
+	R_AdjustVertCoords(&rg.renderCrops[rg.currentRenderCrop], vertAdjust, vertPercent, y, h, &y, &h);
 
 	// Set up the coordinates
 	x1 = x;
@@ -578,8 +935,8 @@ void R_DrawCinematic (int x, int y, int w, int h, horzAdjust_t horzAdjust, float
 		Com_Error(ERR_DROP, "R_DrawCinematic: handle out of range");
 
 	// Scale the coordinates and correct the aspect ratio if needed
-	R_AdjustHorzCoordsInt(horzAdjust, horzPercent, x, w, &x, &w);
-	R_AdjustVertCoordsInt(vertAdjust, vertPercent, y, h, &y, &h);
+	R_AdjustHorzCoordsInt(&rg.renderCrops[rg.currentRenderCrop], horzAdjust, horzPercent, x, w, &x, &w);
+	R_AdjustVertCoordsInt(&rg.renderCrops[rg.currentRenderCrop], vertAdjust, vertPercent, y, h, &y, &h);
 
 	// Set up the coordinates
 	x1 = x;
@@ -587,6 +944,13 @@ void R_DrawCinematic (int x, int y, int w, int h, horzAdjust_t horzAdjust, float
 	x2 = x + w;
 	y2 = y + h;
 
+	// Copy the image if needed
+	if (dirty){
+		image = R_CopyCommandImage(image, width, height);
+		if (!image)
+			dirty = false;
+	}
+
 	// Add a draw cinematic command
 	cmd = (drawCinematicCommand_t *)R_GetCommandBuffer(sizeof(drawCinematicCommand_t));
 
@@ -633,66 +997,88 @@ void R_DrawCinematic (int x, int y, int w, int h, horzAdjust_t horzAdjust, float
 
 /*
  ==================
- R_ResetCropSize
+ R_SetupRenderCrop
  ==================
 */
-static void R_ResetCropSize (){
-
-	cropSizeCommand_t	*cmd;
-	int					width, height;
-	int					size;
-
-	// Calculate the crop size
-	if (rg.envShotRendering){
-		width = rg.envShotSize;
-		height = rg.envShotSize;
-	}
-	else {
-		width = FloatToInt(glConfig.videoWidth * r_screenFraction->floatValue);
-		height = FloatToInt(glConfig.videoHeight * r_screenFraction->floatValue);
-	}
+static void R_SetupRenderCrop (renderCrop_t *renderCrop, int width, int height){
 
-	// Set up the current render crop
-	rg.currentRenderCrop = 0;
+	int		size;
 
-	rg.renderCrops[rg.currentRenderCrop].width = width;
-	rg.renderCrops[rg.currentRenderCrop].height = height;
+	renderCrop->width = width;
+	renderCrop->height = height;
 
-	rg.renderCrops[rg.currentRenderCrop].rect.x = 0;
-	rg.renderCrops[rg.currentRenderCrop].rect.y = 0;
-	rg.renderCrops[rg.currentRenderCrop].rect.width = width;
-	rg.renderCrops[rg.currentRenderCrop].rect.height = height;
+	renderCrop->rect.x = 0;
+	renderCrop->rect.y = 0;
+	renderCrop->rect.width = width;
+	renderCrop->rect.height = height;
 
-	rg.renderCrops[rg.currentRenderCrop].xScale = width * (1.0f / SCREEN_WIDTH);
-	rg.renderCrops[rg.currentRenderCrop].yScale = height * (1.0f / SCREEN_HEIGHT);
+	renderCrop->xScale = width * (1.0f / SCREEN_WIDTH);
+	renderCrop->yScale = height * (1.0f / SCREEN_HEIGHT);
 
 	if (width * SCREEN_HEIGHT > height * SCREEN_WIDTH){
 		size = height * SCREEN_WIDTH / SCREEN_HEIGHT;
 
-		rg.renderCrops[rg.currentRenderCrop].aspectRatio = ASPECT_WIDE;
-		rg.renderCrops[rg.currentRenderCrop].aspectScale = size * (1.0f / SCREEN_WIDTH);
-		rg.renderCrops[rg.currentRenderCrop].aspectBias = (width - size) * 0.5f;
+		renderCrop->aspectRatio = ASPECT_WIDE;
+		renderCrop->aspectScale = size * (1.0f / SCREEN_WIDTH);
+		renderCrop->aspectBias = (width - size) * 0.5f;
 	}
 	else if (width * SCREEN_HEIGHT < height * SCREEN_WIDTH){
 		size = width * SCREEN_HEIGHT / SCREEN_WIDTH;
 
-		rg.renderCrops[rg.currentRenderCrop].aspectRatio = ASPECT_HIGH;
-		rg.renderCrops[rg.currentRenderCrop].aspectScale = size * (1.0f / SCREEN_HEIGHT);
-		rg.renderCrops[rg.currentRenderCrop].aspectBias = (height - size) * 0.5f;
+		renderCrop->aspectRatio = ASPECT_HIGH;
+		renderCrop->aspectScale = size * (1.0f / SCREEN_HEIGHT);
+		renderCrop->aspectBias = (height - size) * 0.5f;
 	}
 	else {
-		rg.renderCrops[rg.currentRenderCrop].aspectRatio = ASPECT_NORMAL;
-		rg.renderCrops[rg.currentRenderCrop].aspectScale = width * (1.0f / SCREEN_WIDTH);
-		rg.renderCrops[rg.currentRenderCrop].aspectBias = 0.0f;
+		renderCrop->aspectRatio = ASPECT_NORMAL;
+		renderCrop->aspectScale = width * (1.0f / SCREEN_WIDTH);
+		renderCrop->aspectBias = 0.0f;
 	}
+}
+
+/*
+ ==================
+ R_AddCropSizeCommand
+ ==================
+*/
+static void R_AddCropSizeCommand (const renderCrop_t *renderCrop){
+
+	cropSizeCommand_t	*cmd;
 
-	// Add a crop size command
 	cmd = (cropSizeCommand_t *)R_GetCommandBuffer(sizeof(cropSizeCommand_t));
 
 	cmd->commandId = RC_CROP_SIZE;
 
-	cmd->width = rg.renderCrops[rg.currentRenderCrop].width;
-	cmd->height = rg.renderCrops[rg.currentRenderCrop].height;
+	cmd->width = renderCrop->width;
+	cmd->height = renderCrop->height;
+}
+
+/*
+ ==================
+ R_ResetCropSize
+ ==================
+*/
+static void R_ResetCropSize (){
+
+	int		width, height;
+
+	// Calculate the crop size
+	if (rg.envShotRendering){
+		width = rg.envShotSize;
+		height = rg.envShotSize;
+	}
+	else {
+		width = FloatToInt(glConfig.videoWidth * r_screenFraction->floatValue);
+		height = FloatToInt(glConfig.videoHeight * r_screenFraction->floatValue);
+	}
+
+	// Set up the current render crop
+	rg.currentRenderCrop = 0;
+
+	R_SetupRenderCrop(&rg.renderCrops[rg.currentRenderCrop], width, height);
+
+	// Add a crop size command
+	R_AddCropSizeCommand(&rg.renderCrops[rg.currentRenderCrop]);
 }
 
 /*
@@ -702,9 +1088,6 @@ static void R_ResetCropSize (){
 */
 void R_CropRenderSize (int width, int height, bool forceDimensions){
 
-	cropSizeCommand_t	*cmd;
-	int					size;
-
 	// Calculate the crop size
 	if (rg.envShotRendering){
 		width = rg.envShotSize;
@@ -733,44 +1116,10 @@ void R_CropRenderSize (int width, int height, bool forceDimensions){
 	if (rg.currentRenderCrop == MAX_RENDER_CROPS)
 		Com_Error(ERR_DROP, "R_CropRenderSize: MAX_RENDER_CROPS hit");
 
-	rg.renderCrops[rg.currentRenderCrop].width = width;
-	rg.renderCrops[rg.currentRenderCrop].height = height;
-
-	rg.renderCrops[rg.currentRenderCrop].rect.x = 0;
-	rg.renderCrops[rg.currentRenderCrop].rect.y = 0;
-	rg.renderCrops[rg.currentRenderCrop].rect.width = width;
-	rg.renderCrops[rg.currentRenderCrop].rect.height = height;
-
-	rg.renderCrops[rg.currentRenderCrop].xScale = width * (1.0f / SCREEN_WIDTH);
-	rg.renderCrops[rg.currentRenderCrop].yScale = height * (1.0f / SCREEN_HEIGHT);
-
-	if (width * SCREEN_HEIGHT > height * SCREEN_WIDTH){
-		size = height * SCREEN_WIDTH / SCREEN_HEIGHT;
-
-		rg.renderCrops[rg.currentRenderCrop].aspectRatio = ASPECT_WIDE;
-		rg.renderCrops[rg.currentRenderCrop].aspectScale = size * (1.0f / SCREEN_WIDTH);
-		rg.renderCrops[rg.currentRenderCrop].aspectBias = (width - size) * 0.5f;
-	}
-	else if (width * SCREEN_HEIGHT < height * SCREEN_WIDTH){
-		size = width * SCREEN_HEIGHT / SCREEN_WIDTH;
-
-		rg.renderCrops[rg.currentRenderCrop].aspectRatio = ASPECT_HIGH;
-		rg.renderCrops[rg.currentRenderCrop].aspectScale = size * (1.0f / SCREEN_HEIGHT);
-		rg.renderCrops[rg.currentRenderCrop].aspectBias = (height - size) * 0.5f;
-	}
-	else {
-		rg.renderCrops[rg.currentRenderCrop].aspectRatio = ASPECT_NORMAL;
-		rg.renderCrops[rg.currentRenderCrop].aspectScale = width * (1.0f / SCREEN_WIDTH);
-		rg.renderCrops[rg.currentRenderCrop].aspectBias = 0.0f;
-	}
+	R_SetupRenderCrop(&rg.renderCrops[rg.currentRenderCrop], width, height);
 
 	// Add a crop size command
-	cmd = (cropSizeCommand_t *)R_GetCommandBuffer(sizeof(cropSizeCommand_t));
-
-	cmd->commandId = RC_CROP_SIZE;
-
-	cmd->width = rg.renderCrops[rg.currentRenderCrop].width;
-	cmd->height = rg.renderCrops[rg.currentRenderCrop].height;
+	R_AddCropSizeCommand(&rg.renderCrops[rg.currentRenderCrop]);
 }
 
 /*
@@ -780,8 +1129,6 @@ void R_CropRenderSize (int width, int height, bool forceDimensions){
 */
 void R_UnCropRenderSize (){
 
-	cropSizeCommand_t	*cmd;
-
 	// Set up the current render crop
 	if (rg.currentRenderCrop < 1)
 		Com_Error(ERR_DROP, "R_UnCropRenderSize: currentRenderCrop < 1");
@@ -789,12 +1136,53 @@ void R_UnCropRenderSize (){
 	rg.currentRenderCrop--;
 
 	// Add a crop size command
-	cmd = (cropSizeCommand_t *)R_GetCommandBuffer(sizeof(cropSizeCommand_t));
+	R_AddCropSizeCommand(&rg.renderCrops[rg.currentRenderCrop]);
+}
 
-	cmd->commandId = RC_CROP_SIZE;
+/*
+ ==================
+ R_CropViewRenderSize
 
-	cmd->width = rg.renderCrops[rg.currentRenderCrop].width;
-	cmd->height = rg.renderCrops[rg.currentRenderCrop].height;
+ Used by the front-end for subviews. The crop is set up in the view parms, so
+ the render crops of the main thread are left alone.
+ ==================
+*/
+void R_CropViewRenderSize (int width, int height){
+
+	renderCrop_t	*renderCrop = &rg.viewParms.renderCrop;
+
+	// Calculate the crop size
+	if (rg.viewParms.envShotRendering){
+		width = renderCrop->width;
+		height = renderCrop->height;
+	}
+	else {
+		if (width < 1 || height < 1 || width > SCREEN_WIDTH || height > SCREEN_HEIGHT)
+			Com_Error(ERR_DROP, "R_CropViewRenderSize: bad crop size (%i x %i)", width, height);
+
+		width = FloatToInt(width * renderCrop->xScale);
+		height = FloatToInt(height * renderCrop->yScale);
+	}
+
+	// Set up the view render crop
+	R_SetupRenderCrop(renderCrop, width, height);
+
+	// Add a crop size command
+	R_AddCropSizeCommand(renderCrop);
+}
+
+/*
+ ==================
+ R_UnCropViewRenderSize
+ ==================
+*/
+void R_UnCropViewRenderSize (const renderCrop_t *renderCrop){
+
+	// Set up the view render crop
+	rg.viewParms.renderCrop = *renderCrop;
+
+	// Add a crop size command
+	R_AddCropSizeCommand(renderCrop);
 }
 
 
@@ -979,12 +1367,16 @@ void R_BeginFrame (int time){
 	// Clear primary view
 	rg.primaryViewAvailable = false;
 
-	// Clear light interaction meshes
-	R_ClearLightMeshes();
+	// Clear mesh and light lists. If the front-end runs on its own thread, it
+	// will do this when it starts working on the frame.
+	if (!rg.smpActive){
+		// Clear light interaction meshes
+		R_ClearLightMeshes();
 
-	// Clear mesh and light lists
-	R_ClearMeshes();
-	R_ClearLights();
+		// Clear mesh and light lists
+		R_ClearMeshes();
+		R_ClearLights();
+	}
 
 	// Clear scene render lists
 	rg.scene.numEntities = rg.scene.firstEntity = 1;
@@ -1019,6 +1411,8 @@ void R_BeginFrame (int time){
 	cmd = (setupBuffersCommand_t *)R_GetCommandBuffer(sizeof(setupBuffersCommand_t));
 
 	cmd->commandId = RC_SETUP_BUFFERS;
+
+	cmd->time = rg.time;
 }
 
 /*
@@ -1036,9 +1430,186 @@ void R_EndFrame (){
 	cmd->commandId = RC_SWAP_BUFFERS;
 
 	// Issue all commands
-	R_IssueRenderCommands();
+	if (!rg.smpActive)
+		R_IssueRenderCommands(r_renderFrame);
+	else {
+		// Wait for the front-end thread to finish the previous frame
+		R_WaitForFrontEnd();
+
+		// Let it work on this frame
+		r_frontEnd.frontEndFrame = r_renderFrame;
+
+		Sys_SignalEvent(r_frontEnd.wakeEvent);
+
+		// Render the previous frame in the meantime
+		if (r_frontEnd.backEndFrame){
+			R_IssueRenderCommands(r_frontEnd.backEndFrame);
+
+			r_frontEnd.backEndFrame = NULL;
+		}
+
+		// Record the next frame into the other buffer
+		r_currentFrame = (r_currentFrame + 1) % MAX_RENDER_FRAMES;
+
+		r_renderFrame = &r_renderFrames[r_currentFrame];
+		r_renderFrame->numScenes = 0;
+
+		r_commandBuffer = &r_renderFrame->commandBuffer;
+	}
+
+	// Time demo statistics
+	if (com_timeDemo->integerValue)
+		rg.timeDemo.frames++;
 
 	// Log file
 	if (r_logFile->integerValue > 0)
 		CVar_SetInteger(r_logFile, r_logFile->integerValue - 1);
+}
+
+/*
+ ==================
+ R_ClearTimeDemoStats
+ ==================
+*/
+void R_ClearTimeDemoStats (){
+
+	Mem_Fill(&rg.timeDemo, 0, sizeof(timeDemoStats_t));
+
+	QGL_ResetNullStats();
+}
+
+/*
+ ==================
+ R_PrintTimeDemoStats
+ ==================
+*/
+void R_PrintTimeDemoStats (){
+
+	double	scale;
+
+	if (!rg.timeDemo.frames)
+		return;
+
+	scale = 1000.0 / ((double)Sys_ClockTicksPerSecond() * rg.timeDemo.frames);
+
+	Com_Printf("%i frames, msec per frame:\n", rg.timeDemo.frames);
+	Com_Printf("front-end: %.3f (meshes: %.3f, lights: %.3f)\n", rg.timeDemo.frontEnd * scale, rg.timeDemo.meshes * scale, rg.timeDemo.lights * scale);
+	Com_Printf("back-end:  %.3f\n", rg.timeDemo.backEnd * scale);
+
+	QGL_PrintNullStats();
+}
+
+/*
+ ==============================================================================
+
+ INITIALIZATION AND SHUTDOWN
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ R_InitRenderCommands
+ ==================
+*/
+void R_InitRenderCommands (){
+
+	renderFrame_t	*frame;
+	int				i, j;
+
+	// The first frame uses the mesh and light lists allocated by the
+	// front-end
+	frame = &r_renderFrames[0];
+
+	frame->commandBuffer.data = (byte *)Mem_Alloc(MAX_COMMAND_BUFFER_SIZE, TAG_RENDERER);
+
+	for (i = 0; i < 4; i++){
+		frame->meshes[i] = rg.meshes[i];
+		frame->lights[i] = rg.lights[i];
+	}
+
+	frame->shadowMeshes = rg.lightMeshes.shadows;
+	frame->interactionMeshes = rg.lightMeshes.interactions;
+
+	// Record into the first frame
+	r_currentFrame = 0;
+
+	r_renderFrame = frame;
+	r_commandBuffer = &frame->commandBuffer;
+
+	r_counters = &r_counterSlots[0];
+
+	backEnd.frame = frame;
+
+	if (!r_smp->integerValue)
+		return;
+
+	Com_Printf("Starting renderer front-end thread\n");
+
+	// Allocate the buffers needed by the front-end thread
+	for (i = 0, frame = r_renderFrames; i < MAX_RENDER_FRAMES; i++, frame++){
+		if (!frame->commandBuffer.data)
+			frame->commandBuffer.data = (byte *)Mem_Alloc(MAX_COMMAND_BUFFER_SIZE, TAG_RENDERER);
+
+		frame->viewCommandBuffer.data = (byte *)Mem_Alloc(MAX_COMMAND_BUFFER_SIZE, TAG_RENDERER);
+
+		frame->scene = (scene_t *)Mem_Alloc(sizeof(scene_t), TAG_RENDERER);
+
+		if (i == 0)
+			continue;
+
+		// Allocate the mesh and light lists with the same sizes as the first
+		// frame
+		for (j = 0; j < 4; j++){
+			frame->meshes[j] = (mesh_t *)Mem_Alloc(rg.maxMeshes[j] * sizeof(mesh_t), TAG_RENDERER);
+			frame->lights[j] = (light_t *)Mem_Alloc(rg.maxLights[j] * sizeof(light_t), TAG_RENDERER);
+		}
+
+		frame->shadowMeshes = (mesh_t *)Mem_Alloc(rg.lightMeshes.maxShadows * sizeof(mesh_t), TAG_RENDERER);
+		frame->interactionMeshes = (mesh_t *)Mem_Alloc(rg.lightMeshes.maxInteractions * sizeof(mesh_t), TAG_RENDERER);
+	}
+
+	// Start the front-end thread
+	r_frontEnd.wakeEvent = Sys_CreateEvent(false);
+	r_frontEnd.doneEvent = Sys_CreateEvent(false);
+
+	r_frontEnd.shutdown = false;
+
+	r_frontEnd.thread = Sys_CreateThread(R_FrontEndThread, NULL, "frontEnd");
+
+	rg.smpActive = true;
+}
+
+/*
+ ==================
+ R_ShutdownRenderCommands
+ ==================
+*/
+void R_ShutdownRenderCommands (){
+
+	if (rg.smpActive){
+		// Stop the front-end thread. Any frame that was not rendered yet is
+		// discarded.
+		R_WaitForFrontEnd();
+
+		r_frontEnd.shutdown = true;
+
+		Sys_SignalEvent(r_frontEnd.wakeEvent);
+
+		Sys_DestroyThread(r_frontEnd.thread);
+
+		Sys_DestroyEvent(r_frontEnd.wakeEvent);
+		Sys_DestroyEvent(r_frontEnd.doneEvent);
+
+		rg.smpActive = false;
+	}
+
+	Mem_Fill(&r_frontEnd, 0, sizeof(frontEndThread_t));
+
+	// The buffers will be freed with all the renderer allocations
+	Mem_Fill(r_renderFrames, 0, sizeof(r_renderFrames));
+
+	r_renderFrame = NULL;
+	r_commandBuffer = NULL;
 }
\ No newline at end of file
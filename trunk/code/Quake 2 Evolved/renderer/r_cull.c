@@ -61,7 +61,7 @@ int R_CullBounds (const vec3_t mins, const vec3_t maxs, int planeBits){
 		side = BoxOnPlaneSide(mins, maxs, plane);
 
 		if (side == PLANESIDE_BACK){
-			rg.pc.cullBoundsOut++;
+			R_GetPerformanceCounters()->cullBoundsOut++;
 			return CULL_OUT;
 		}
 
@@ -70,9 +70,9 @@ int R_CullBounds (const vec3_t mins, const vec3_t maxs, int planeBits){
 	}
 
 	if (cullBits != CULL_IN)
-		rg.pc.cullBoundsClip++;
+		R_GetPerformanceCounters()->cullBoundsClip++;
 	else
-		rg.pc.cullBoundsIn++;
+		R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return cullBits;
 }
@@ -118,7 +118,7 @@ int R_CullLocalBounds (const vec3_t mins, const vec3_t maxs, const vec3_t origin
 		}
 
 		if (side == PLANESIDE_BACK){
-			rg.pc.cullBoundsOut++;
+			R_GetPerformanceCounters()->cullBoundsOut++;
 			return CULL_OUT;
 		}
 
@@ -127,9 +127,9 @@ int R_CullLocalBounds (const vec3_t mins, const vec3_t maxs, const vec3_t origin
 	}
 
 	if (cullBits != CULL_IN)
-		rg.pc.cullBoundsClip++;
+		R_GetPerformanceCounters()->cullBoundsClip++;
 	else
-		rg.pc.cullBoundsIn++;
+		R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return cullBits;
 }
@@ -156,67 +156,67 @@ bool R_CullBox (const vec3_t mins, const vec3_t maxs, int clipFlags){
 		switch (plane->signbits){
 		case 0:
 			if (plane->normal[0] * maxs[0] + plane->normal[1] * maxs[1] + plane->normal[2] * maxs[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 1:
 			if (plane->normal[0] * mins[0] + plane->normal[1] * maxs[1] + plane->normal[2] * maxs[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 2:
 			if (plane->normal[0] * maxs[0] + plane->normal[1] * mins[1] + plane->normal[2] * maxs[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 3:
 			if (plane->normal[0] * mins[0] + plane->normal[1] * mins[1] + plane->normal[2] * maxs[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 4:
 			if (plane->normal[0] * maxs[0] + plane->normal[1] * maxs[1] + plane->normal[2] * mins[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 5:
 			if (plane->normal[0] * mins[0] + plane->normal[1] * maxs[1] + plane->normal[2] * mins[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 6:
 			if (plane->normal[0] * maxs[0] + plane->normal[1] * mins[1] + plane->normal[2] * mins[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		case 7:
 			if (plane->normal[0] * mins[0] + plane->normal[1] * mins[1] + plane->normal[2] * mins[2] < plane->dist){
-				rg.pc.cullBoundsOut++;
+				R_GetPerformanceCounters()->cullBoundsOut++;
 				return true;
 			}
 
 			break;
 		default:
-			rg.pc.cullBoundsIn++;
+			R_GetPerformanceCounters()->cullBoundsIn++;
 			return false;
 		}
 	}
 
-	rg.pc.cullBoundsIn++;
+	R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return false;
 }
@@ -241,12 +241,12 @@ bool R_CullSphere (const vec3_t origin, float radius, int clipFlags){
 			continue;
 
 		if (DotProduct(origin, plane->normal) - plane->dist <= -radius){
-			rg.pc.cullSphereOut++;
+			R_GetPerformanceCounters()->cullSphereOut++;
 			return true;
 		}
 	}
 
-	rg.pc.cullSphereIn++;
+	R_GetPerformanceCounters()->cullSphereIn++;
 
 	return false;
 }
@@ -284,7 +284,7 @@ int R_LightCullBounds (lightData_t *lightData, const vec3_t mins, const vec3_t m
 		side = BoxOnPlaneSide(mins, maxs, plane);
 
 		if (side == PLANESIDE_BACK){
-			rg.pc.cullBoundsOut++;
+			R_GetPerformanceCounters()->cullBoundsOut++;
 			return CULL_OUT;
 		}
 
@@ -293,9 +293,9 @@ int R_LightCullBounds (lightData_t *lightData, const vec3_t mins, const vec3_t m
 	}
 
 	if (cullBits != CULL_IN)
-		rg.pc.cullBoundsClip++;
+		R_GetPerformanceCounters()->cullBoundsClip++;
 	else
-		rg.pc.cullBoundsIn++;
+		R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return cullBits;
 }
@@ -341,7 +341,7 @@ int R_LightCullLocalBounds (lightData_t *lightData, const vec3_t mins, const vec
 		}
 
 		if (side == PLANESIDE_BACK){
-			rg.pc.cullBoundsOut++;
+			R_GetPerformanceCounters()->cullBoundsOut++;
 			return CULL_OUT;
 		}
 
@@ -350,9 +350,9 @@ int R_LightCullLocalBounds (lightData_t *lightData, const vec3_t mins, const vec
 	}
 
 	if (cullBits != CULL_IN)
-		rg.pc.cullBoundsClip++;
+		R_GetPerformanceCounters()->cullBoundsClip++;
 	else
-		rg.pc.cullBoundsIn++;
+		R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return cullBits;
 }
@@ -398,7 +398,7 @@ int R_CullLightBounds (lightData_t *lightData, int planeBits){
 		side = BoxOnPlaneSide(lightData->mins, lightData->maxs, plane);
 
 		if (side == PLANESIDE_BACK){
-			rg.pc.cullBoundsOut++;
+			R_GetPerformanceCounters()->cullBoundsOut++;
 			return CULL_OUT;
 		}
 
@@ -407,9 +407,9 @@ int R_CullLightBounds (lightData_t *lightData, int planeBits){
 	}
 
 	if (cullBits != CULL_IN)
-		rg.pc.cullBoundsClip++;
+		R_GetPerformanceCounters()->cullBoundsClip++;
 	else
-		rg.pc.cullBoundsIn++;
+		R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return cullBits;
 }
@@ -445,7 +445,7 @@ int R_CullLightVolume (lightData_t *lightData, int planeBits){
 		}
 
 		if (side == PLANESIDE_BACK){
-			rg.pc.cullBoundsOut++;
+			R_GetPerformanceCounters()->cullBoundsOut++;
 			return CULL_OUT;
 		}
 
@@ -454,9 +454,9 @@ int R_CullLightVolume (lightData_t *lightData, int planeBits){
 	}
 
 	if (cullBits != CULL_IN)
-		rg.pc.cullBoundsClip++;
+		R_GetPerformanceCounters()->cullBoundsClip++;
 	else
-		rg.pc.cullBoundsIn++;
+		R_GetPerformanceCounters()->cullBoundsIn++;
 
 	return cullBits;
 }
\ No newline at end of file
@@ -1652,13 +1652,14 @@ static float RB_ShowStencil (){
 */
 void RB_AddDebugPolygon (const vec4_t color, int numPoints, const vec3_t *points, bool fill, bool depthTest, int allowInView){
 
+	renderFrame_t	*frame = R_GetRenderFrame();
 	debugPolygon_t	*debugPolygon;
 
-	if (backEnd.numDebugPolygons == backEnd.maxDebugPolygons)
+	if (frame->numDebugPolygons == frame->maxDebugPolygons)
 		return;		// Silently ignore
 
 	// Add a debug polygon
-	debugPolygon = &backEnd.debugPolygons[backEnd.numDebugPolygons++];
+	debugPolygon = &frame->debugPolygons[frame->numDebugPolygons++];
 
 	debugPolygon->allowInView = allowInView;
 	debugPolygon->fill = fill;
@@ -1675,23 +1676,23 @@ void RB_AddDebugPolygon (const vec4_t color, int numPoints, const vec3_t *points
 */
 void RB_ClearDebugPolygons (){
 
-	backEnd.numDebugPolygons = 0;
+	backEnd.frame->numDebugPolygons = 0;
 
 	// Reallocate the debug polygons buffer if needed
-	if (backEnd.maxDebugPolygons == r_maxDebugPolygons->integerValue)
+	if (backEnd.frame->maxDebugPolygons == r_maxDebugPolygons->integerValue)
 		return;
 
-	backEnd.maxDebugPolygons = r_maxDebugPolygons->integerValue;
+	backEnd.frame->maxDebugPolygons = r_maxDebugPolygons->integerValue;
 
-	if (backEnd.debugPolygons){
-		Mem_Free(backEnd.debugPolygons);
-		backEnd.debugPolygons = NULL;
+	if (backEnd.frame->debugPolygons){
+		Mem_Free(backEnd.frame->debugPolygons);
+		backEnd.frame->debugPolygons = NULL;
 	}
 
-	if (backEnd.maxDebugPolygons <= 0)
+	if (backEnd.frame->maxDebugPolygons <= 0)
 		return;
 
-	backEnd.debugPolygons = (debugPolygon_t *)Mem_Alloc(backEnd.maxDebugPolygons * sizeof(debugPolygon_t), TAG_RENDERER);
+	backEnd.frame->debugPolygons = (debugPolygon_t *)Mem_Alloc(backEnd.frame->maxDebugPolygons * sizeof(debugPolygon_t), TAG_RENDERER);
 }
 
 /*
@@ -1704,7 +1705,7 @@ static void RB_DrawDebugPolygons (){
 	debugPolygon_t	*debugPolygon;
 	int				i, j;
 
-	if (!backEnd.numDebugPolygons)
+	if (!backEnd.frame->numDebugPolygons)
 		return;
 
 	// Set the GL state
@@ -1731,7 +1732,7 @@ static void RB_DrawDebugPolygons (){
 	GL_StencilMask(255);
 
 	// Draw all the debug polygons
-	for (i = 0, debugPolygon = backEnd.debugPolygons; i < backEnd.numDebugPolygons; i++, debugPolygon++){
+	for (i = 0, debugPolygon = backEnd.frame->debugPolygons; i < backEnd.frame->numDebugPolygons; i++, debugPolygon++){
 		// Check for view suppression
 		if (!r_skipSuppress->integerValue){
 			if (!(debugPolygon->allowInView & backEnd.viewParms.viewType))
@@ -1785,13 +1786,14 @@ static void RB_DrawDebugPolygons (){
 */
 void RB_AddDebugLine (const vec4_t color, const vec3_t start, const vec3_t end, bool depthTest, int allowInView){
 
-	debugLine_t	*debugLine;
+	renderFrame_t	*frame = R_GetRenderFrame();
+	debugLine_t		*debugLine;
 
-	if (backEnd.numDebugLines == backEnd.maxDebugLines)
+	if (frame->numDebugLines == frame->maxDebugLines)
 		return;		// Silently ignore
 
 	// Add a debug line
-	debugLine = &backEnd.debugLines[backEnd.numDebugLines++];
+	debugLine = &frame->debugLines[frame->numDebugLines++];
 
 	debugLine->allowInView = allowInView;
 	debugLine->depthTest = depthTest;
@@ -1807,23 +1809,23 @@ void RB_AddDebugLine (const vec4_t color, const vec3_t start, const vec3_t end,
 */
 void RB_ClearDebugLines (){
 
-	backEnd.numDebugLines = 0;
+	backEnd.frame->numDebugLines = 0;
 
 	// Reallocate the debug lines buffer if needed
-	if (backEnd.maxDebugLines == r_maxDebugLines->integerValue)
+	if (backEnd.frame->maxDebugLines == r_maxDebugLines->integerValue)
 		return;
 
-	backEnd.maxDebugLines = r_maxDebugLines->integerValue;
+	backEnd.frame->maxDebugLines = r_maxDebugLines->integerValue;
 
-	if (backEnd.debugLines){
-		Mem_Free(backEnd.debugLines);
-		backEnd.debugLines = NULL;
+	if (backEnd.frame->debugLines){
+		Mem_Free(backEnd.frame->debugLines);
+		backEnd.frame->debugLines = NULL;
 	}
 
-	if (backEnd.maxDebugLines <= 0)
+	if (backEnd.frame->maxDebugLines <= 0)
 		return;
 
-	backEnd.debugLines = (debugLine_t *)Mem_Alloc(backEnd.maxDebugLines * sizeof(debugLine_t), TAG_RENDERER);
+	backEnd.frame->debugLines = (debugLine_t *)Mem_Alloc(backEnd.frame->maxDebugLines * sizeof(debugLine_t), TAG_RENDERER);
 }
 
 /*
@@ -1836,7 +1838,7 @@ static void RB_DrawDebugLines (){
 	debugLine_t	*debugLine;
 	int			i;
 
-	if (!backEnd.numDebugLines)
+	if (!backEnd.frame->numDebugLines)
 		return;
 
 	// Set the GL state
@@ -1864,7 +1866,7 @@ static void RB_DrawDebugLines (){
 	GL_StencilMask(255);
 
 	// Draw all the debug lines
-	for (i = 0, debugLine = backEnd.debugLines; i < backEnd.numDebugLines; i++, debugLine++){
+	for (i = 0, debugLine = backEnd.frame->debugLines; i < backEnd.frame->numDebugLines; i++, debugLine++){
 		// Check for view suppression
 		if (!r_skipSuppress->integerValue){
 			if (!(debugLine->allowInView & backEnd.viewParms.viewType))
@@ -1901,13 +1903,14 @@ static void RB_DrawDebugLines (){
 */
 void RB_AddDebugText (const vec4_t color, bool forceColor, const vec3_t origin, float cw, float ch, const char *text, bool depthTest, int allowInView){
 
-	debugText_t	*debugText;
+	renderFrame_t	*frame = R_GetRenderFrame();
+	debugText_t		*debugText;
 
-	if (backEnd.numDebugText == backEnd.maxDebugText)
+	if (frame->numDebugText == frame->maxDebugText)
 		return;		// Silently ignore
 
 	// Add a debug text string
-	debugText = &backEnd.debugText[backEnd.numDebugText++];
+	debugText = &frame->debugText[frame->numDebugText++];
 
 	debugText->allowInView = allowInView;
 	debugText->depthTest = depthTest;
@@ -1926,23 +1929,23 @@ void RB_AddDebugText (const vec4_t color, bool forceColor, const vec3_t origin,
 */
 void RB_ClearDebugText (){
 
-	backEnd.numDebugText = 0;
+	backEnd.frame->numDebugText = 0;
 
 	// Reallocate the debug text buffer if needed
-	if (backEnd.maxDebugText == r_maxDebugText->integerValue)
+	if (backEnd.frame->maxDebugText == r_maxDebugText->integerValue)
 		return;
 
-	backEnd.maxDebugText = r_maxDebugText->integerValue;
+	backEnd.frame->maxDebugText = r_maxDebugText->integerValue;
 
-	if (backEnd.debugText){
-		Mem_Free(backEnd.debugText);
-		backEnd.debugText = NULL;
+	if (backEnd.frame->debugText){
+		Mem_Free(backEnd.frame->debugText);
+		backEnd.frame->debugText = NULL;
 	}
 
-	if (backEnd.maxDebugText <= 0)
+	if (backEnd.frame->maxDebugText <= 0)
 		return;
 
-	backEnd.debugText = (debugText_t *)Mem_Alloc(backEnd.maxDebugText * sizeof(debugText_t), TAG_RENDERER);
+	backEnd.frame->debugText = (debugText_t *)Mem_Alloc(backEnd.frame->maxDebugText * sizeof(debugText_t), TAG_RENDERER);
 }
 
 /*
@@ -1969,7 +1972,7 @@ void RB_RenderDebugTools (){
 	stage_t	*stage;
 	int		i, j, k;
 
-	if (rg.envShotRendering)
+	if (backEnd.viewParms.envShotRendering)
 		return;
 
 	QGL_LogPrintf("---------- RB_RenderDebugTools ----------\n");
@@ -2041,7 +2044,7 @@ void RB_RenderDebugTools (){
 		}
 
 		// Draw the stencil buffer contents
-		rg.pc.overdraw += RB_ShowStencil();
+		R_GetPerformanceCounters()->overdraw += RB_ShowStencil();
 	}
 
 	if (r_showLightCount->integerValue){
@@ -2080,7 +2083,7 @@ void RB_RenderDebugTools (){
 		GL_Scissor(backEnd.scissor);
 
 		// Draw the stencil buffer contents
-		rg.pc.overdrawLights += RB_ShowStencil();
+		R_GetPerformanceCounters()->overdrawLights += RB_ShowStencil();
 	}
 
 	if (r_showLightVolumes->integerValue){
@@ -233,7 +233,7 @@ void R_AddDecals (){
 		if (decal->parentSurface->viewCount != rg.viewCount)
 			continue;
 
-		rg.pc.decals++;
+		R_GetPerformanceCounters()->decals++;
 
 		// Add it
 	}
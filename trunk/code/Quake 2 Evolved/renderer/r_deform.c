@@ -40,9 +40,9 @@ static void RB_DeformExpand (material_t *material){
 	float		expand;
 	int			i;
 
-	rg.pc.deformExpand++;
-	rg.pc.deformIndices += backEnd.numIndices;
-	rg.pc.deformVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->deformExpand++;
+	R_GetPerformanceCounters()->deformIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->deformVertices += backEnd.numVertices;
 
 	expand = material->expressionRegisters[material->deformRegisters[0]];
 
@@ -61,9 +61,9 @@ static void RB_DeformMove (material_t *material){
 	vec3_t		move;
 	int			i;
 
-	rg.pc.deformMove++;
-	rg.pc.deformIndices += backEnd.numIndices;
-	rg.pc.deformVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->deformMove++;
+	R_GetPerformanceCounters()->deformIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->deformVertices += backEnd.numVertices;
 
 	move[0] = material->expressionRegisters[material->deformRegisters[0]];
 	move[1] = material->expressionRegisters[material->deformRegisters[1]];
@@ -96,9 +96,9 @@ static void RB_DeformSprite (material_t *material){
 		return;
 	}
 
-	rg.pc.deformSprite++;
-	rg.pc.deformIndices += backEnd.numIndices;
-	rg.pc.deformVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->deformSprite++;
+	R_GetPerformanceCounters()->deformIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->deformVertices += backEnd.numVertices;
 
 	// Assume all the triangles are independent quads
 	for (i = 0; i < backEnd.numVertices; i += 4){
@@ -183,9 +183,9 @@ static void RB_DeformTube (material_t *material){
 		return;
 	}
 
-	rg.pc.deformTube++;
-	rg.pc.deformIndices += backEnd.numIndices;
-	rg.pc.deformVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->deformTube++;
+	R_GetPerformanceCounters()->deformIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->deformVertices += backEnd.numVertices;
 
 	// Assume all the triangles are independent quads
 	for (i = 0; i < backEnd.numVertices; i += 4){
@@ -271,9 +271,9 @@ static void RB_DeformBeam (material_t *material){
 		return;
 	}
 
-	rg.pc.deformBeam++;
-	rg.pc.deformIndices += backEnd.numIndices;
-	rg.pc.deformVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->deformBeam++;
+	R_GetPerformanceCounters()->deformIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->deformVertices += backEnd.numVertices;
 
 	// Assume all the triangles are independent quads
 	for (i = 0; i < backEnd.numVertices; i += 4){
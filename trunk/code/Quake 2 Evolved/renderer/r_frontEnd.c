@@ -124,9 +124,7 @@ void R_SetFarClip (){
  R_AdjustHorzCoords
  ==================
 */
-void R_AdjustHorzCoords (horzAdjust_t adjust, float percent, float xIn, float wIn, float *xOut, float *wOut){
-
-	renderCrop_t	*renderCrop;
+void R_AdjustHorzCoords (const renderCrop_t *renderCrop, horzAdjust_t adjust, float percent, float xIn, float wIn, float *xOut, float *wOut){
 
 	if (adjust == H_NONE){
 		*xOut = xIn * r_screenFraction->floatValue;
@@ -135,8 +133,6 @@ void R_AdjustHorzCoords (horzAdjust_t adjust, float percent, float xIn, float wI
 		return;
 	}
 
-	renderCrop = &rg.renderCrops[rg.currentRenderCrop];
-
 	if (renderCrop->aspectRatio != ASPECT_WIDE){
 		*xOut = xIn * renderCrop->xScale;
 		*wOut = wIn * renderCrop->xScale;
@@ -188,9 +184,7 @@ void R_AdjustHorzCoords (horzAdjust_t adjust, float percent, float xIn, float wI
  R_AdjustVertCoords
  ==================
 */
-void R_AdjustVertCoords (vertAdjust_t adjust, float percent, float yIn, float hIn, float *yOut, float *hOut){
-
-	renderCrop_t	*renderCrop;
+void R_AdjustVertCoords (const renderCrop_t *renderCrop, vertAdjust_t adjust, float percent, float yIn, float hIn, float *yOut, float *hOut){
 
 	if (adjust == V_NONE){
 		*yOut = yIn * r_screenFraction->floatValue;
@@ -199,8 +193,6 @@ void R_AdjustVertCoords (vertAdjust_t adjust, float percent, float yIn, float hI
 		return;
 	}
 
-	renderCrop = &rg.renderCrops[rg.currentRenderCrop];
-
 	if (renderCrop->aspectRatio != ASPECT_HIGH){
 		*yOut = yIn * renderCrop->yScale;
 		*hOut = hIn * renderCrop->yScale;
@@ -252,9 +244,7 @@ void R_AdjustVertCoords (vertAdjust_t adjust, float percent, float yIn, float hI
  R_AdjustHorzCoordsInt
  ==================
 */
-void R_AdjustHorzCoordsInt (horzAdjust_t adjust, float percent, int xIn, int wIn, int *xOut, int *wOut){
-
-	renderCrop_t	*renderCrop;
+void R_AdjustHorzCoordsInt (const renderCrop_t *renderCrop, horzAdjust_t adjust, float percent, int xIn, int wIn, int *xOut, int *wOut){
 
 	if (adjust == H_NONE){
 		*xOut = FloatToInt(xIn * r_screenFraction->floatValue);
@@ -263,8 +253,6 @@ void R_AdjustHorzCoordsInt (horzAdjust_t adjust, float percent, int xIn, int wIn
 		return;
 	}
 
-	renderCrop = &rg.renderCrops[rg.currentRenderCrop];
-
 	if (renderCrop->aspectRatio != ASPECT_WIDE){
 		*xOut = FloatToInt(xIn * renderCrop->xScale);
 		*wOut = FloatToInt(wIn * renderCrop->xScale);
@@ -316,9 +304,7 @@ void R_AdjustHorzCoordsInt (horzAdjust_t adjust, float percent, int xIn, int wIn
  R_AdjustVertCoordsInt
  ==================
 */
-void R_AdjustVertCoordsInt (vertAdjust_t adjust, float percent, int yIn, int hIn, int *yOut, int *hOut){
-
-	renderCrop_t	*renderCrop;
+void R_AdjustVertCoordsInt (const renderCrop_t *renderCrop, vertAdjust_t adjust, float percent, int yIn, int hIn, int *yOut, int *hOut){
 
 	if (adjust == V_NONE){
 		*yOut = FloatToInt(yIn * r_screenFraction->floatValue);
@@ -327,8 +313,6 @@ void R_AdjustVertCoordsInt (vertAdjust_t adjust, float percent, int yIn, int hIn
 		return;
 	}
 
-	renderCrop = &rg.renderCrops[rg.currentRenderCrop];
-
 	if (renderCrop->aspectRatio != ASPECT_HIGH){
 		*yOut = FloatToInt(yIn * renderCrop->yScale);
 		*hOut = FloatToInt(hIn * renderCrop->yScale);
@@ -387,60 +371,57 @@ void R_AdjustVertCoordsInt (vertAdjust_t adjust, float percent, int yIn, int hIn
 
 /*
  ==================
-
+ R_SetupViewportAndScissor
  ==================
 */
-static void R_SetupViewportAndScissor (){
+void R_SetupViewportAndScissor (const renderView_t *renderView, const renderCrop_t *renderCrop, bool envShotRendering, int viewType, rect_t *viewport, rect_t *scissor){
 
-	renderCrop_t	*renderCrop;
-	int				x, y, w, h;
+	int		x, y, w, h;
 
-	if (rg.envShotRendering){
-		rg.viewParms.viewport.x = 0;
-		rg.viewParms.viewport.y = 0;
-		rg.viewParms.viewport.width = rg.envShotSize;
-		rg.viewParms.viewport.height = rg.envShotSize;
+	if (envShotRendering){
+		viewport->x = 0;
+		viewport->y = 0;
+		viewport->width = renderCrop->width;
+		viewport->height = renderCrop->height;
 
-		rg.viewParms.scissor.x = 0;
-		rg.viewParms.scissor.y = 0;
-		rg.viewParms.scissor.width = rg.envShotSize;
-		rg.viewParms.scissor.height = rg.envShotSize;
+		scissor->x = 0;
+		scissor->y = 0;
+		scissor->width = renderCrop->width;
+		scissor->height = renderCrop->height;
 
 		return;
 	}
 
-	renderCrop = &rg.renderCrops[rg.currentRenderCrop];
-
 	// Scale the coordinates and correct the aspect ratio if needed
-	R_AdjustHorzCoordsInt(rg.renderView.horzAdjust, rg.renderView.horzPercent, rg.renderView.x, rg.renderView.width, &x, &w);
-	R_AdjustVertCoordsInt(rg.renderView.vertAdjust, rg.renderView.vertPercent, rg.renderView.y, rg.renderView.height, &y, &h);
+	R_AdjustHorzCoordsInt(renderCrop, renderView->horzAdjust, renderView->horzPercent, renderView->x, renderView->width, &x, &w);
+	R_AdjustVertCoordsInt(renderCrop, renderView->vertAdjust, renderView->vertPercent, renderView->y, renderView->height, &y, &h);
 
 	// Convert origin from top-left to bottom-left
 	y = renderCrop->height - (y + h);
 
 	// Set up the viewport
-	rg.viewParms.viewport.x = x;
-	rg.viewParms.viewport.y = y;
-	rg.viewParms.viewport.width = x + w;
-	rg.viewParms.viewport.height = y + h;
+	viewport->x = x;
+	viewport->y = y;
+	viewport->width = x + w;
+	viewport->height = y + h;
 
-	RectClip(renderCrop->rect, rg.viewParms.viewport.x, rg.viewParms.viewport.y, rg.viewParms.viewport.width, rg.viewParms.viewport.height);
+	RectClip(renderCrop->rect, viewport->x, viewport->y, viewport->width, viewport->height);
 
 	// Set up the scissor
 	if (r_skipScissors->integerValue){
-		rg.viewParms.scissor.x = rg.viewParms.viewport.x;
-		rg.viewParms.scissor.y = rg.viewParms.viewport.y;
-		rg.viewParms.scissor.width = rg.viewParms.viewport.width;
-		rg.viewParms.scissor.height = rg.viewParms.viewport.height;
+		scissor->x = viewport->x;
+		scissor->y = viewport->y;
+		scissor->width = viewport->width;
+		scissor->height = viewport->height;
 
 		return;
 	}
 
-	if (rg.viewParms.viewType == VIEW_MAIN || rg.viewParms.viewType == VIEW_REMOTE){
-		rg.viewParms.scissor.x = rg.viewParms.viewport.x;
-		rg.viewParms.scissor.y = rg.viewParms.viewport.y;
-		rg.viewParms.scissor.width = rg.viewParms.viewport.width;
-		rg.viewParms.scissor.height = rg.viewParms.viewport.height;
+	if (viewType == VIEW_MAIN || viewType == VIEW_REMOTE){
+		scissor->x = viewport->x;
+		scissor->y = viewport->y;
+		scissor->width = viewport->width;
+		scissor->height = viewport->height;
 	}
 	else {
 		// Transform into screen space
@@ -448,7 +429,7 @@ static void R_SetupViewportAndScissor (){
 		// Set up the scissor
 
 		// Flip it horizontally if needed
-		if (rg.viewParms.viewType == VIEW_MIRROR){
+		if (viewType == VIEW_MIRROR){
 
 		}
 	}
@@ -463,7 +444,7 @@ static void R_SetupFOV (){
 
 	float	f;
 
-	if (rg.envShotRendering){
+	if (rg.viewParms.envShotRendering){
 		rg.viewParms.fovX = 90.0f;
 		rg.viewParms.fovY = 90.0f;
 		rg.viewParms.fovScale = 1.0f;
@@ -618,6 +599,8 @@ static void R_SetupMatrices (){
 */
 void R_RenderView (bool primaryView, int viewType){
 
+	longlong	ticks;
+
 	// Bump view count
 	rg.viewCount++;
 
@@ -630,8 +613,10 @@ void R_RenderView (bool primaryView, int viewType){
 	else
 		rg.viewParms.zFar = FAR_PLANE_DISTANCE;
 
-	// Set up the viewport and scissor
-	R_SetupViewportAndScissor();
+	// Set up the viewport and scissor. For the main view this was already done
+	// when the scene was set up, because it depends on the current crop size.
+	if (viewType != VIEW_MAIN)
+		R_SetupViewportAndScissor(&rg.renderView, &rg.viewParms.renderCrop, rg.viewParms.envShotRendering, viewType, &rg.viewParms.viewport, &rg.viewParms.scissor);
 
 	if (!RectSize(rg.viewParms.viewport) || !RectSize(rg.viewParms.scissor))
 		return;
@@ -642,8 +627,19 @@ void R_RenderView (bool primaryView, int viewType){
 	R_SetupMatrices();
 
 	// Generate mesh and light lists
-	R_GenerateMeshes();
-	R_GenerateLights();
+	if (com_timeDemo->integerValue){
+		ticks = Sys_ClockTicks();
+		R_GenerateMeshes();
+		rg.timeDemo.meshes += Sys_ClockTicks() - ticks;
+
+		ticks = Sys_ClockTicks();
+		R_GenerateLights();
+		rg.timeDemo.lights += Sys_ClockTicks() - ticks;
+	}
+	else {
+		R_GenerateMeshes();
+		R_GenerateLights();
+	}
 
 	// Update post-process parameters if needed
 	R_UpdatePostProcess();
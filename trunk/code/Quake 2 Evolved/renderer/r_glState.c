@@ -145,8 +145,8 @@ void GL_BindTexture (texture_t *texture){
 	if (texture->frameUsed != rg.frameCount){
 		texture->frameUsed = rg.frameCount;
 
-		rg.pc.textures++;
-		rg.pc.textureBytes += texture->size;
+		R_GetPerformanceCounters()->textures++;
+		R_GetPerformanceCounters()->textureBytes += texture->size;
 	}
 
 	if (glState.texture[glState.texUnit] == texture)
@@ -166,8 +166,8 @@ void GL_BindMultitexture (texture_t *texture, int unit){
 	if (texture->frameUsed != rg.frameCount){
 		texture->frameUsed = rg.frameCount;
 
-		rg.pc.textures++;
-		rg.pc.textureBytes += texture->size;
+		R_GetPerformanceCounters()->textures++;
+		R_GetPerformanceCounters()->textureBytes += texture->size;
 	}
 
 	if (glState.texture[unit] == texture)
@@ -343,8 +343,8 @@ void GL_BindIndexBuffer (arrayBuffer_t *indexBuffer){
 	if (indexBuffer->frameUsed != rg.frameCount){
 		indexBuffer->frameUsed = rg.frameCount;
 
-		rg.pc.indexBuffers[indexBuffer->dynamic]++;
-		rg.pc.indexBufferBytes[indexBuffer->dynamic] += indexBuffer->size;
+		R_GetPerformanceCounters()->indexBuffers[indexBuffer->dynamic]++;
+		R_GetPerformanceCounters()->indexBufferBytes[indexBuffer->dynamic] += indexBuffer->size;
 	}
 
 	if (glState.indexBuffer == indexBuffer)
@@ -373,8 +373,8 @@ void GL_BindVertexBuffer (arrayBuffer_t *vertexBuffer){
 	if (vertexBuffer->frameUsed != rg.frameCount){
 		vertexBuffer->frameUsed = rg.frameCount;
 
-		rg.pc.vertexBuffers[vertexBuffer->dynamic]++;
-		rg.pc.vertexBufferBytes[vertexBuffer->dynamic] += vertexBuffer->size;
+		R_GetPerformanceCounters()->vertexBuffers[vertexBuffer->dynamic]++;
+		R_GetPerformanceCounters()->vertexBufferBytes[vertexBuffer->dynamic] += vertexBuffer->size;
 	}
 
 	if (glState.vertexBuffer == vertexBuffer)
@@ -2527,6 +2527,9 @@ static void R_EnvShot_f (){
 	buffer[15] = size >> 8;
 	buffer[16] = 24;
 
+	// Make sure the front-end thread is idle
+	R_SyncFrontEnd();
+
 	// Backup primary view
 	Mem_Copy(&oldPrimaryView, &rg.primaryView, sizeof(primaryView_t));
 
@@ -2554,6 +2557,10 @@ static void R_EnvShot_f (){
 
 		R_EndFrame();
 
+		// If the front-end runs on its own thread, wait for this frame to be
+		// rendered
+		R_SyncFrontEnd();
+
 		// Read the pixels
 		qglPixelStorei(GL_PACK_ALIGNMENT, 1);
 
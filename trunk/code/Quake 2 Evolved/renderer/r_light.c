@@ -26,7 +26,6 @@
 //
 
 // TODO:
-// - R_ClusterPVS is messed up for static lights
 // - culling
 // - fog and the other light stuff
 // - make sure the frustum is right for R_SetupNearClipVolume
@@ -36,6 +35,9 @@
 #include "r_local.h"
 
 
+static void		R_SetupStaticLightData (lightData_t *lightData, bool inWorld);
+
+
 /*
  ==============================================================================
 
@@ -273,6 +275,11 @@ void R_LoadLights (const char *name){
 
 	script_t	*script;
 	token_t		token;
+	lightData_t	*lightData;
+	int			i;
+
+	// Make sure the front-end thread is not using the static lights
+	R_SyncFrontEnd();
 
 	// Copy the name
 	Str_Copy(rg.staticLights->fileName, name, sizeof(rg.staticLights->fileName));
@@ -303,6 +310,22 @@ void R_LoadLights (const char *name){
 
 	// Free the script file
 	PS_FreeScript(script);
+
+	// Precache the static light data and world interactions, so they don't
+	// have to be computed during the first frames
+	if (!rg.worldModel)
+		return;
+
+	R_LoadLightCache(name);
+
+	for (i = 0, lightData = rg.staticLights; i < rg.numStaticLights; i++, lightData++)
+		R_SetupStaticLightData(lightData, true);
+
+	R_WriteLightCache(name);
+	R_FreeLightCache();
+
+	// Build the shadow volumes of the precached world surfaces
+	R_BuildStaticShadows();
 }
 
 
@@ -378,7 +401,6 @@ static void R_SetupStaticLightData (lightData_t *lightData, bool inWorld){
 
 	material_t	*material;
 	leaf_t		*leaf;
-	byte		pvs[MAX_MAP_LEAFS/8];
 	vec3_t		origin, axis[3];
 	vec3_t		direction, corner;
 	vec3_t		lVector, rVector;
@@ -397,11 +419,6 @@ static void R_SetupStaticLightData (lightData_t *lightData, bool inWorld){
 	lightData->valid = true;
 	lightData->precached = false;
 
-	// If the light data was precached, copy it and return immediately
-	if (!r_skipLightCache->integerValue){
-
-	}
-
 	// Set the name
 	Str_Copy(lightData->name, lightData->parms.name, sizeof(lightData->name));
 
@@ -611,8 +628,6 @@ static void R_SetupStaticLightData (lightData_t *lightData, bool inWorld){
 	// Set style
 	lightData->style = lightData->parms.style;
 
-	// TODO: R_ClusterPVS makes black surfaces..?
-
 	// Set up the PVS and area
 	if (lightData->type == RL_DIRECTIONAL || lightData->material->lightType != LT_GENERIC || !inWorld){
 		lightData->pvs = NULL;
@@ -626,12 +641,25 @@ static void R_SetupStaticLightData (lightData_t *lightData, bool inWorld){
 			lightData->area = -1;
 		}
 		else {
-//			R_ClusterPVS(leaf->cluster, pvs);
+			// This may run on the front-end thread, so decompress into a row
+			// owned by the light instead of using the collision rows
+			if (rg.worldModel->vis){
+				if (!lightData->pvsRow)
+					lightData->pvsRow = (byte *)Mem_Alloc((rg.worldModel->vis->numClusters + 7) >> 3, TAG_RENDERER);
 
-			lightData->pvs = CM_ClusterPVS(leaf->cluster);
+				R_ClusterPVS(leaf->cluster, lightData->pvsRow);
+			}
+
+			lightData->pvs = lightData->pvsRow;
 			lightData->area = leaf->area;
 		}
 	}
+
+	// Precache the world interactions
+	if (inWorld)
+		lightData->precached = R_PrecachedLightData(lightData);
+	else
+		R_FreePrecachedLightData(lightData);
 }
 
 /*
@@ -1182,9 +1210,9 @@ static void R_AddLight (lightData_t *lightData, material_t *material, bool viewI
 	// Fill it in
 	light->data = *lightData;
 	light->material = material;
-	light->materialParms[0] = lightData->materialParms[0] * rg.lightStyles[lightData->style].rgb[0];
-	light->materialParms[1] = lightData->materialParms[1] * rg.lightStyles[lightData->style].rgb[1];
-	light->materialParms[2] = lightData->materialParms[2] * rg.lightStyles[lightData->style].rgb[2];
+	light->materialParms[0] = lightData->materialParms[0] * rg.viewParms.lightStyles[lightData->style].rgb[0];
+	light->materialParms[1] = lightData->materialParms[1] * rg.viewParms.lightStyles[lightData->style].rgb[1];
+	light->materialParms[2] = lightData->materialParms[2] * rg.viewParms.lightStyles[lightData->style].rgb[2];
 	light->materialParms[3] = lightData->materialParms[3];
 	light->materialParms[4] = lightData->materialParms[4];
 	light->materialParms[5] = lightData->materialParms[5];
@@ -1216,13 +1244,10 @@ static void R_AddLight (lightData_t *lightData, material_t *material, bool viewI
 		}
 	}
 
-	// Generate light interaction meshes
-	R_GenerateLightMeshes(light);
-
 	if (light->data.precached)
-		rg.pc.staticLights++;
+		R_GetPerformanceCounters()->staticLights++;
 	else
-		rg.pc.dynamicLights++;
+		R_GetPerformanceCounters()->dynamicLights++;
 
 	rg.numLights[index]++;
 }
@@ -1380,7 +1405,10 @@ void R_GenerateLights (){
 	rg.viewParms.lights[2] = &rg.lights[2][rg.firstLight[2]];
 	rg.viewParms.lights[3] = &rg.lights[3][rg.firstLight[3]];
 
-	rg.pc.lights += rg.viewParms.numLights[0] + rg.viewParms.numLights[1] + rg.viewParms.numLights[2] + rg.viewParms.numLights[3];
+	// Generate light interaction meshes
+	R_GenerateLightMeshes(rg.viewParms.numLights, rg.viewParms.lights);
+
+	R_GetPerformanceCounters()->lights += rg.viewParms.numLights[0] + rg.viewParms.numLights[1] + rg.viewParms.numLights[2] + rg.viewParms.numLights[3];
 
 	// The next view rendered in this frame will tack on after this one
 	rg.firstLight[0] = rg.numLights[0];
@@ -29,7 +29,805 @@
 #include "r_local.h"
 
 
-bool R_PrecachedLightData (lightData_t *lightData){
+#define LIGHT_CACHE_ID				(('C' << 24) + ('L' << 16) + ('2' << 8) + 'Q')
+#define LIGHT_CACHE_VERSION			1
+
+typedef struct {
+	int						id;
+	int						version;
+
+	uint					mapChecksum;
+	int						numSurfaces;
+
+	int						numLights;
+} lightCacheHeader_t;
+
+typedef struct {
+	uint					checksum;
+	int						numSurfaces;		// -1 if not precached
+} lightCacheLight_t;
+
+typedef struct {
+	byte *					buffer;
+	int						size;
+
+	int						numLights;
+	const int **			lights;				// Points to the light headers inside buffer
+
+	bool					modified;			// Needs to be written
+} lightCache_t;
+
+static lightCache_t			r_lightCache;
+
+
+/*
+ ==================
+ R_LightCacheChecksum
+
+ Computes a checksum of everything that affects the precached interactions of
+ the given light, so changed lights can be detected
+ ==================
+*/
+static uint R_LightCacheChecksum (lightData_t *lightData){
+
+	float	values[6*4 + 3 + 1];
+	int		i;
+
+	for (i = 0; i < 6; i++){
+		values[i*4+0] = lightData->frustum[i].normal[0];
+		values[i*4+1] = lightData->frustum[i].normal[1];
+		values[i*4+2] = lightData->frustum[i].normal[2];
+		values[i*4+3] = lightData->frustum[i].dist;
+	}
+
+	values[24] = lightData->origin[0];
+	values[25] = lightData->origin[1];
+	values[26] = lightData->origin[2];
+
+	values[27] = (float)lightData->type;
+
+	return MD4_BlockChecksum(values, sizeof(values)) ^ MD4_BlockChecksum(lightData->material->name, Str_Length(lightData->material->name));
+}
+
+
+/*
+ ==============================================================================
+
+ LIGHT INTERACTION PRECACHING
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ R_LightCacheFaceCulled
+
+ Performs the same face culling as R_CullLightSurface. Static lights never move,
+ so the result can be precached.
+ ==================
+*/
+static bool R_LightCacheFaceCulled (lightData_t *lightData, surface_t *surface){
+
+	material_t	*material = surface->texInfo->material;
+
+	if (lightData->material->lightType != LT_GENERIC)
+		return false;
+
+	if (!surface->plane || material->deform != DFRM_NONE)
+		return false;
+
+	if (lightData->type == RL_DIRECTIONAL){
+		if (material->cullType == CT_FRONT_SIDED){
+			if (!(surface->flags & SURF_PLANEBACK)){
+				if (DotProduct(lightData->direction, surface->plane->normal) >= 0.0f)
+					return true;
+			}
+		}
+		else if (material->cullType == CT_BACK_SIDED){
+			if (DotProduct(lightData->direction, surface->plane->normal) <= 0.0f)
+				return true;
+		}
+	}
+	else {
+		if (material->cullType == CT_FRONT_SIDED){
+			if (!(surface->flags & SURF_PLANEBACK)){
+				if (PointOnPlaneSide(lightData->origin, 0.0f, surface->plane) != PLANESIDE_FRONT)
+					return true;
+			}
+		}
+		else if (material->cullType == CT_BACK_SIDED){
+			if (PointOnPlaneSide(lightData->origin, 0.0f, surface->plane) != PLANESIDE_BACK)
+				return true;
+		}
+	}
 
 	return false;
+}
+
+/*
+ ==================
+ R_RecursiveLightCacheNode
+
+ Walks the BSP tree the same way R_RecursiveWorldLightNode does, but only does
+ the tests that don't depend on the view
+ ==================
+*/
+static void R_RecursiveLightCacheNode (lightData_t *lightData, node_t *node, int cullBits, byte *added, lightCacheSurface_t *surfaces, int *numSurfaces){
+
+	leaf_t		*leaf;
+	surface_t	*surface, **mark;
+	int			index;
+	int			i;
+
+	// Check for solid content
+	if (node->contents == CONTENTS_SOLID)
+		return;
+
+	// Cull
+	if (cullBits != CULL_IN){
+		cullBits = R_LightCullBounds(lightData, node->mins, node->maxs, cullBits);
+
+		if (cullBits == CULL_OUT)
+			return;
+	}
+
+	// Recurse down the children
+	if (node->contents == -1){
+		R_RecursiveLightCacheNode(lightData, node->children[0], cullBits, added, surfaces, numSurfaces);
+		R_RecursiveLightCacheNode(lightData, node->children[1], cullBits, added, surfaces, numSurfaces);
+		return;
+	}
+
+	// Leaf node
+	leaf = (leaf_t *)node;
+
+	if (!leaf->numMarkSurfaces)
+		return;
+
+	// Check if the node is in the light PVS
+	if (lightData->pvs){
+		if (!(lightData->pvs[leaf->cluster >> 3] & BIT(leaf->cluster & 7)))
+			return;
+	}
+
+	// If it has a single surface, no need to cull again
+	if (leaf->numMarkSurfaces == 1)
+		cullBits = CULL_IN;
+
+	// Add all the surfaces
+	for (i = 0, mark = leaf->firstMarkSurface; i < leaf->numMarkSurfaces; i++, mark++){
+		surface = *mark;
+
+		index = surface - rg.worldModel->surfaces;
+
+		if (added[index])
+			continue;		// Already added this surface from another leaf
+		added[index] = 1;
+
+		// Cull the surface
+		if (cullBits != CULL_IN){
+			if (R_LightCullBounds(lightData, surface->mins, surface->maxs, cullBits) == CULL_OUT)
+				continue;
+		}
+
+		// Add the surface
+		surfaces[*numSurfaces].index = index;
+		surfaces[*numSurfaces].flags = 0;
+
+		if (R_LightCacheFaceCulled(lightData, surface))
+			surfaces[*numSurfaces].flags |= LCS_FACECULLED;
+
+		(*numSurfaces)++;
+	}
+}
+
+/*
+ ==================
+ R_BuildLightCache
+ ==================
+*/
+static void R_BuildLightCache (lightData_t *lightData){
+
+	lightCacheSurface_t	*surfaces;
+	byte				*added;
+	int					numSurfaces;
+
+	surfaces = (lightCacheSurface_t *)Mem_Alloc(rg.worldModel->numSurfaces * sizeof(lightCacheSurface_t), TAG_RENDERER);
+	added = (byte *)Mem_ClearedAlloc(rg.worldModel->numSurfaces, TAG_RENDERER);
+
+	numSurfaces = 0;
+
+	R_RecursiveLightCacheNode(lightData, rg.worldModel->nodes, LIGHT_PLANEBITS, added, surfaces, &numSurfaces);
+
+	// Copy the surface list
+	lightData->numCachedSurfaces = numSurfaces;
+
+	if (numSurfaces)
+		lightData->cachedSurfaces = (lightCacheSurface_t *)Mem_DupData(surfaces, numSurfaces * sizeof(lightCacheSurface_t), TAG_RENDERER);
+
+	Mem_Free(surfaces);
+	Mem_Free(added);
+}
+
+/*
+ ==================
+ R_LoadCachedLight
+
+ Copies the surface list of the given light from the cache file. Returns false
+ if the cache file doesn't have a valid list for it.
+ ==================
+*/
+static bool R_LoadCachedLight (lightData_t *lightData, uint checksum){
+
+	const int	*data;
+	int			numSurfaces;
+	int			i;
+
+	if (lightData->index < 0 || lightData->index >= r_lightCache.numLights)
+		return false;
+
+	data = r_lightCache.lights[lightData->index];
+
+	if ((uint)LittleLong(data[0]) != checksum)
+		return false;		// The light was changed
+
+	numSurfaces = LittleLong(data[1]);
+
+	if (numSurfaces < 0)
+		return false;
+
+	// Copy the surface list
+	lightData->numCachedSurfaces = numSurfaces;
+
+	if (!numSurfaces)
+		return true;
+
+	lightData->cachedSurfaces = (lightCacheSurface_t *)Mem_Alloc(numSurfaces * sizeof(lightCacheSurface_t), TAG_RENDERER);
+
+	for (i = 0, data += 2; i < numSurfaces; i++, data += 2){
+		lightData->cachedSurfaces[i].index = LittleLong(data[0]);
+		lightData->cachedSurfaces[i].flags = LittleLong(data[1]);
+
+		if (lightData->cachedSurfaces[i].index < 0 || lightData->cachedSurfaces[i].index >= rg.worldModel->numSurfaces){
+			R_FreePrecachedLightData(lightData);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ ==================
+ R_PrecachedLightData
+
+ Sets up the precached world interactions of the given static light, either
+ from the cache file or by walking the BSP tree. Returns false if the light
+ can't be precached.
+ ==================
+*/
+bool R_PrecachedLightData (lightData_t *lightData){
+
+	uint	checksum;
+
+	R_FreePrecachedLightData(lightData);
+
+	if (!rg.worldModel)
+		return false;
+
+	checksum = R_LightCacheChecksum(lightData);
+
+	// Try the cache file first
+	if (R_LoadCachedLight(lightData, checksum)){
+		lightData->cacheChecksum = checksum;
+		return true;
+	}
+
+	// Build the surface list
+	R_BuildLightCache(lightData);
+
+	lightData->cacheChecksum = checksum;
+
+	r_lightCache.modified = true;
+
+	return true;
+}
+
+/*
+ ==================
+ R_FreePrecachedLightData
+ ==================
+*/
+void R_FreePrecachedLightData (lightData_t *lightData){
+
+	if (lightData->cachedSurfaces)
+		Mem_Free(lightData->cachedSurfaces);
+
+	lightData->numCachedSurfaces = 0;
+	lightData->cachedSurfaces = NULL;
+
+	lightData->cacheChecksum = 0;
+}
+
+
+/*
+ ==============================================================================
+
+ LIGHT CACHE FILE
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ R_LightCacheFileName
+ ==================
+*/
+static void R_LightCacheFileName (const char *name, char *fileName, int maxLength){
+
+	Str_Copy(fileName, name, maxLength);
+	Str_StripFileExtension(fileName);
+	Str_DefaultFileExtension(fileName, maxLength, ".lightCache");
+}
+
+/*
+ ==================
+ R_LoadLightCache
+
+ Loads the light cache file that goes with the given light file. Called before
+ the static lights are precached.
+ ==================
+*/
+void R_LoadLightCache (const char *name){
+
+	char				fileName[MAX_PATH_LENGTH];
+	lightCacheHeader_t	*header;
+	const int			*data, *end;
+	int					numSurfaces;
+	int					i;
+
+	R_FreeLightCache();
+
+	// Assume it will need to be written
+	r_lightCache.modified = true;
+
+	if (!rg.worldModel)
+		return;
+
+	// Load the file
+	R_LightCacheFileName(name, fileName, sizeof(fileName));
+
+	r_lightCache.size = FS_ReadFile(fileName, (void **)&r_lightCache.buffer);
+	if (!r_lightCache.buffer)
+		return;
+
+	if (r_lightCache.size < sizeof(lightCacheHeader_t)){
+		R_FreeLightCache();
+		return;
+	}
+
+	header = (lightCacheHeader_t *)r_lightCache.buffer;
+
+	header->id = LittleLong(header->id);
+	header->version = LittleLong(header->version);
+	header->mapChecksum = LittleLong(header->mapChecksum);
+	header->numSurfaces = LittleLong(header->numSurfaces);
+	header->numLights = LittleLong(header->numLights);
+
+	// Make sure it was written for this map
+	if (header->id != LIGHT_CACHE_ID || header->version != LIGHT_CACHE_VERSION){
+		Com_DPrintf(S_COLOR_YELLOW "R_LoadLightCache: ignoring outdated light cache %s\n", fileName);
+
+		R_FreeLightCache();
+		return;
+	}
+
+	if (header->mapChecksum != rg.worldModel->checksum || header->numSurfaces != rg.worldModel->numSurfaces || header->numLights < 0 || header->numLights > MAX_STATIC_LIGHTS){
+		Com_DPrintf(S_COLOR_YELLOW "R_LoadLightCache: ignoring light cache %s from a different map\n", fileName);
+
+		R_FreeLightCache();
+		return;
+	}
+
+	// Find the lights
+	r_lightCache.numLights = header->numLights;
+	r_lightCache.lights = (const int **)Mem_Alloc(r_lightCache.numLights * sizeof(const int *), TAG_RENDERER);
+
+	data = (const int *)(r_lightCache.buffer + sizeof(lightCacheHeader_t));
+	end = (const int *)(r_lightCache.buffer + r_lightCache.size);
+
+	for (i = 0; i < r_lightCache.numLights; i++){
+		if (data + 2 > end){
+			Com_DPrintf(S_COLOR_YELLOW "R_LoadLightCache: truncated light cache %s\n", fileName);
+
+			R_FreeLightCache();
+			return;
+		}
+
+		r_lightCache.lights[i] = data;
+
+		numSurfaces = LittleLong(data[1]);
+
+		if (numSurfaces > 0){
+			if (numSurfaces > (end - data - 2) >> 1){
+				Com_DPrintf(S_COLOR_YELLOW "R_LoadLightCache: truncated light cache %s\n", fileName);
+
+				R_FreeLightCache();
+				return;
+			}
+
+			data += numSurfaces << 1;
+		}
+
+		data += 2;
+	}
+
+	// Lights that were added or removed since it was written need an update
+	r_lightCache.modified = (r_lightCache.numLights != rg.numStaticLights);
+}
+
+/*
+ ==================
+ R_WriteLightCache
+
+ Writes the precached interactions of all the static lights to the light cache
+ file that goes with the given light file, if r_writeLightCache is enabled and
+ anything changed since it was loaded
+ ==================
+*/
+void R_WriteLightCache (const char *name){
+
+	char				fileName[MAX_PATH_LENGTH];
+	fileHandle_t		f;
+	lightCacheHeader_t	header;
+	lightCacheLight_t	light;
+	lightData_t			*lightData;
+	int					data[2];
+	int					i, j;
+
+	if (!r_writeLightCache->integerValue || !r_lightCache.modified)
+		return;
+
+	if (!rg.worldModel || !rg.numStaticLights)
+		return;
+
+	R_LightCacheFileName(name, fileName, sizeof(fileName));
+
+	FS_OpenFile(fileName, FS_WRITE, &f);
+	if (!f){
+		Com_Printf("Couldn't write light cache %s\n", fileName);
+		return;
+	}
+
+	// Write the header
+	header.id = LittleLong(LIGHT_CACHE_ID);
+	header.version = LittleLong(LIGHT_CACHE_VERSION);
+	header.mapChecksum = LittleLong(rg.worldModel->checksum);
+	header.numSurfaces = LittleLong(rg.worldModel->numSurfaces);
+	header.numLights = LittleLong(rg.numStaticLights);
+
+	FS_Write(f, &header, sizeof(lightCacheHeader_t));
+
+	// Write the lights
+	for (i = 0, lightData = rg.staticLights; i < rg.numStaticLights; i++, lightData++){
+		if (!lightData->precached){
+			light.checksum = 0;
+			light.numSurfaces = LittleLong(-1);
+
+			FS_Write(f, &light, sizeof(lightCacheLight_t));
+			continue;
+		}
+
+		light.checksum = LittleLong(lightData->cacheChecksum);
+		light.numSurfaces = LittleLong(lightData->numCachedSurfaces);
+
+		FS_Write(f, &light, sizeof(lightCacheLight_t));
+
+		for (j = 0; j < lightData->numCachedSurfaces; j++){
+			data[0] = LittleLong(lightData->cachedSurfaces[j].index);
+			data[1] = LittleLong(lightData->cachedSurfaces[j].flags);
+
+			FS_Write(f, data, sizeof(data));
+		}
+	}
+
+	FS_CloseFile(f);
+
+	r_lightCache.modified = false;
+
+	Com_Printf("Wrote light cache %s with %i lights\n", fileName, rg.numStaticLights);
+}
+
+/*
+ ==================
+ R_FreeLightCache
+
+ Frees the light cache file. The precached interactions of the static lights
+ are kept.
+ ==================
+*/
+void R_FreeLightCache (){
+
+	if (r_lightCache.buffer)
+		FS_FreeFile(r_lightCache.buffer);
+
+	if (r_lightCache.lights)
+		Mem_Free(r_lightCache.lights);
+
+	r_lightCache.buffer = NULL;
+	r_lightCache.size = 0;
+
+	r_lightCache.numLights = 0;
+	r_lightCache.lights = NULL;
+}
+
+
+/*
+ ==============================================================================
+
+ STATIC SHADOW VOLUMES
+
+ ==============================================================================
+*/
+
+#define MAX_STATIC_SHADOW_VERTICES	1048576
+
+
+/*
+ ==================
+ R_StaticShadowSize
+
+ Returns false if the given surface can't have a prebuilt shadow volume
+ ==================
+*/
+static bool R_StaticShadowSize (surface_t *surface, int *numSilhouetteIndices, int *numCapIndices, int *numVertices){
+
+	surfTriangle_t	*triangle;
+	int				i;
+
+	if (surface->texInfo->material->flags & MF_NOSHADOWS)
+		return false;
+
+	// Deformed surfaces have their shadow volumes generated dynamically
+	if (surface->texInfo->material->deform != DFRM_NONE)
+		return false;
+
+	*numSilhouetteIndices = 0;
+
+	for (i = 0, triangle = surface->triangles; i < surface->numTriangles; i++, triangle++){
+		if (triangle->neighbor[0] < 0)
+			*numSilhouetteIndices += 6;
+		if (triangle->neighbor[1] < 0)
+			*numSilhouetteIndices += 6;
+		if (triangle->neighbor[2] < 0)
+			*numSilhouetteIndices += 6;
+	}
+
+	*numCapIndices = surface->numTriangles * 6;
+	*numVertices = surface->numVertices * 2;
+
+	if (!*numSilhouetteIndices)
+		return false;
+
+	return true;
+}
+
+/*
+ ==================
+ R_BuildStaticShadowVolume
+
+ Builds the same shadow volume as RB_BatchSurfaceShadow does at run time, with
+ the silhouette indices followed by the cap indices
+ ==================
+*/
+static void R_BuildStaticShadowVolume (lightData_t *lightData, staticShadow_t *shadow, glIndex_t *indices, glShadowVertex_t *vertices, int firstVertex){
+
+	surface_t		*surface = shadow->surface;
+	surfTriangle_t	*triangle;
+	glVertex_t		*vertex;
+	glIndex_t		indexRemap[MAX_INDICES];
+	int				i;
+
+	// Build vertices
+	for (i = 0, vertex = surface->vertices; i < surface->numVertices; i++, vertex++){
+		vertices[0].xyzw[0] = vertex->xyz[0];
+		vertices[0].xyzw[1] = vertex->xyz[1];
+		vertices[0].xyzw[2] = vertex->xyz[2];
+		vertices[0].xyzw[3] = 1.0f;
+
+		vertices[1].xyzw[0] = vertex->xyz[0] - lightData->origin[0];
+		vertices[1].xyzw[1] = vertex->xyz[1] - lightData->origin[1];
+		vertices[1].xyzw[2] = vertex->xyz[2] - lightData->origin[2];
+		vertices[1].xyzw[3] = 0.0f;
+
+		vertices += 2;
+
+		indexRemap[i] = firstVertex + (i << 1);
+	}
+
+	// Build indices for silhouette edges
+	indices += shadow->indexOffset;
+
+	for (i = 0, triangle = surface->triangles; i < surface->numTriangles; i++, triangle++){
+		if (triangle->neighbor[0] < 0){
+			indices[0] = indexRemap[triangle->index[1]];
+			indices[1] = indexRemap[triangle->index[0]];
+			indices[2] = indexRemap[triangle->index[0]] + 1;
+			indices[3] = indexRemap[triangle->index[1]];
+			indices[4] = indexRemap[triangle->index[0]] + 1;
+			indices[5] = indexRemap[triangle->index[1]] + 1;
+
+			indices += 6;
+		}
+
+		if (triangle->neighbor[1] < 0){
+			indices[0] = indexRemap[triangle->index[2]];
+			indices[1] = indexRemap[triangle->index[1]];
+			indices[2] = indexRemap[triangle->index[1]] + 1;
+			indices[3] = indexRemap[triangle->index[2]];
+			indices[4] = indexRemap[triangle->index[1]] + 1;
+			indices[5] = indexRemap[triangle->index[2]] + 1;
+
+			indices += 6;
+		}
+
+		if (triangle->neighbor[2] < 0){
+			indices[0] = indexRemap[triangle->index[0]];
+			indices[1] = indexRemap[triangle->index[2]];
+			indices[2] = indexRemap[triangle->index[2]] + 1;
+			indices[3] = indexRemap[triangle->index[0]];
+			indices[4] = indexRemap[triangle->index[2]] + 1;
+			indices[5] = indexRemap[triangle->index[0]] + 1;
+
+			indices += 6;
+		}
+	}
+
+	// Build indices for front and back caps
+	for (i = 0, triangle = surface->triangles; i < surface->numTriangles; i++, triangle++){
+		indices[0] = indexRemap[triangle->index[0]];
+		indices[1] = indexRemap[triangle->index[1]];
+		indices[2] = indexRemap[triangle->index[2]];
+		indices[3] = indexRemap[triangle->index[2]] + 1;
+		indices[4] = indexRemap[triangle->index[1]] + 1;
+		indices[5] = indexRemap[triangle->index[0]] + 1;
+
+		indices += 6;
+	}
+}
+
+/*
+ ==================
+ R_BuildStaticShadows
+
+ Builds the shadow volumes of the precached world surfaces of all the static
+ lights into a single static index and vertex buffer, so the back-end doesn't
+ have to generate them every frame. Must be called after the static lights
+ have been precached.
+
+ Surfaces without a prebuilt shadow volume, and lights that changed after
+ loading, fall back to dynamically generated shadow volumes.
+ ==================
+*/
+void R_BuildStaticShadows (){
+
+	lightData_t			*lightData;
+	staticShadow_t		*shadow;
+	arrayBuffer_t		*indexBuffer, *vertexBuffer;
+	glIndex_t			*indices;
+	glShadowVertex_t	*vertices;
+	int					numSilhouetteIndices, numCapIndices, numVertices;
+	int					lightIndices, lightVertices;
+	int					totalIndices = 0, totalVertices = 0;
+	int					numLights = 0;
+	int					i, j;
+
+	if (!rg.worldModel || !r_shadows->integerValue)
+		return;
+
+	if (r_vertexBuffers->integerValue < 1)
+		return;		// Not using static vertex buffers
+
+	// Lay out the shadow volumes of all the precached world surfaces
+	for (i = 0, lightData = rg.staticLights; i < rg.numStaticLights; i++, lightData++){
+		if (!lightData->precached || lightData->noShadows)
+			continue;
+
+		lightIndices = 0;
+		lightVertices = 0;
+
+		for (j = 0; j < lightData->numCachedSurfaces; j++){
+			if (!R_StaticShadowSize(rg.worldModel->surfaces + lightData->cachedSurfaces[j].index, &numSilhouetteIndices, &numCapIndices, &numVertices))
+				continue;
+
+			lightIndices += numSilhouetteIndices + numCapIndices;
+			lightVertices += numVertices;
+		}
+
+		if (!lightVertices || totalVertices + lightVertices > MAX_STATIC_SHADOW_VERTICES)
+			continue;
+
+		lightData->staticShadows = (staticShadow_t *)Mem_ClearedAlloc(lightData->numCachedSurfaces * sizeof(staticShadow_t), TAG_RENDERER);
+
+		for (j = 0, shadow = lightData->staticShadows; j < lightData->numCachedSurfaces; j++, shadow++){
+			shadow->surface = rg.worldModel->surfaces + lightData->cachedSurfaces[j].index;
+
+			if (!R_StaticShadowSize(shadow->surface, &numSilhouetteIndices, &numCapIndices, &numVertices))
+				continue;
+
+			shadow->indexOffset = totalIndices;
+			shadow->numSilhouetteIndices = numSilhouetteIndices;
+			shadow->numCapIndices = numCapIndices;
+			shadow->numVertices = numVertices;
+
+			totalIndices += numSilhouetteIndices + numCapIndices;
+		}
+
+		totalVertices += lightVertices;
+
+		numLights++;
+	}
+
+	if (!numLights)
+		return;
+
+	// Build the shadow volumes
+	indices = (glIndex_t *)Mem_Alloc(totalIndices * sizeof(glIndex_t), TAG_RENDERER);
+	vertices = (glShadowVertex_t *)Mem_Alloc(totalVertices * sizeof(glShadowVertex_t), TAG_RENDERER);
+
+	totalVertices = 0;
+
+	for (i = 0, lightData = rg.staticLights; i < rg.numStaticLights; i++, lightData++){
+		if (!lightData->staticShadows)
+			continue;
+
+		for (j = 0, shadow = lightData->staticShadows; j < lightData->numCachedSurfaces; j++, shadow++){
+			if (!shadow->numVertices)
+				continue;
+
+			R_BuildStaticShadowVolume(lightData, shadow, indices, vertices + totalVertices, totalVertices);
+
+			totalVertices += shadow->numVertices;
+		}
+	}
+
+	// Upload them
+	vertexBuffer = R_AllocVertexBuffer("staticShadows", false, totalVertices, sizeof(glShadowVertex_t), vertices);
+
+	// Without a static index buffer the back-end copies the indices instead
+	indexBuffer = R_AllocIndexBuffer("staticShadows", false, totalIndices, indices);
+
+	Mem_Free(vertices);
+
+	// Link the buffers to the lights
+	for (i = 0, lightData = rg.staticLights; i < rg.numStaticLights; i++, lightData++){
+		if (!lightData->staticShadows)
+			continue;
+
+		if (!vertexBuffer){
+			Mem_Free(lightData->staticShadows);
+			lightData->staticShadows = NULL;
+			continue;
+		}
+
+		for (j = 0, shadow = lightData->staticShadows; j < lightData->numCachedSurfaces; j++, shadow++){
+			shadow->indexBuffer = indexBuffer;
+			shadow->vertexBuffer = vertexBuffer;
+			shadow->indices = indices;
+		}
+
+		lightData->staticShadowChecksum = lightData->cacheChecksum;
+	}
+
+	if (!vertexBuffer){
+		if (indexBuffer)
+			R_FreeIndexBuffer(indexBuffer);
+
+		Mem_Free(indices);
+		return;
+	}
+
+	Com_DPrintf("Built static shadow volumes for %i lights (%i KB)\n", numLights, (int)(totalIndices * sizeof(glIndex_t) + totalVertices * sizeof(glShadowVertex_t)) >> 10);
 }
\ No newline at end of file
@@ -69,8 +69,8 @@ void R_RefreshLightEditor (){
 	r_lightEditor.focusLight = NULL;
 
 	// Get the current view origin, forward vector, and angles
-	VectorCopy(rg.renderView.origin, origin);
-	VectorMA(origin, 8192.0f, rg.renderView.axis[0], forward);
+	VectorCopy(rg.primaryView.renderView.origin, origin);
+	VectorMA(origin, 8192.0f, rg.primaryView.renderView.axis[0], forward);
 	VectorClear(angles);
 
 	// Find visible lights
@@ -191,6 +191,9 @@ void R_LightEditorUpdateCallback (int index, lightParms_t *parms){
 	if (index < 0 || index >= MAX_STATIC_LIGHTS)
 		return;			// Out of range
 
+	// Make sure the front-end thread is not using the static lights
+	R_SyncFrontEnd();
+
 	lightData = &rg.staticLights[index];
 
 	lightData->valid = false;
@@ -245,15 +248,33 @@ void R_LightEditorRemoveCallback (int index){
 	if (!r_lightEditor.active)
 		return;			// Not active
 
+	// Make sure the front-end thread is not using the static lights
+	R_SyncFrontEnd();
+
 	// Remove the light
 	for (i = 0, lightData = rg.staticLights; i < rg.numStaticLights; i++, lightData++){
 		if (lightData != r_lightEditor.editLight)
 			continue;
 
+		R_FreePrecachedLightData(lightData);
+
+		// Free the static shadows. The buffers are shared with the other
+		// lights, so they are left alone.
+		if (lightData->staticShadows){
+			Mem_Free(lightData->staticShadows);
+			lightData->staticShadows = NULL;
+		}
+
+		if (lightData->pvsRow)
+			Mem_Free(lightData->pvsRow);
+
 		for (j = i; j < rg.numStaticLights - 1; j++)
 			Mem_Copy(&rg.staticLights[j], &rg.staticLights[j+1], sizeof(lightData_t));
 
 		rg.numStaticLights--;
+
+		// Clear the unused slot so it doesn't share data with the last light
+		Mem_Fill(&rg.staticLights[rg.numStaticLights], 0, sizeof(lightData_t));
 		break;
 	}
 
@@ -460,9 +481,12 @@ static void R_AddLight_f (){
 		return;
 	}
 
+	// Make sure the front-end thread is not using the static lights
+	R_SyncFrontEnd();
+
 	lightData = &rg.staticLights[rg.numStaticLights++];
 
-	VectorMA(rg.renderView.origin, 100.0f, rg.renderView.axis[0], origin);
+	VectorMA(rg.primaryView.renderView.origin, 100.0f, rg.primaryView.renderView.axis[0], origin);
 	SnapVector(origin);
 
 	// Edit the new light
@@ -29,6 +29,97 @@
 #include "r_local.h"
 
 
+#define LIGHT_MESH_BLOCK_SHIFT		5
+#define LIGHT_MESH_BLOCK_SIZE		(1 << LIGHT_MESH_BLOCK_SHIFT)
+
+#define MAX_LIGHT_MESH_BLOCKS		((MAX_MESHES << 1) >> LIGHT_MESH_BLOCK_SHIFT)
+
+typedef struct {
+	int						numMeshes;
+	int						firstBlock;
+	int						lastBlock;
+} lightMeshChain_t;
+
+typedef struct {
+	volatile int			nextBlock;
+	int *					blockLinks;			// Next block in the chain, or -1
+	mesh_t *				meshes;
+} lightMeshPool_t;
+
+typedef struct {
+	int						lightCount;
+	int						maxSurfaces;
+	int *					surfaceLightCounts;	// Avoids adding a world surface twice
+} lightMeshSlot_t;
+
+typedef struct {
+	light_t *				light;
+	lightMeshSlot_t *		slot;
+
+	bool					generated;			// Meshes are in the block chains
+	bool					overflowed;			// Ran out of blocks, must be generated again
+
+	lightMeshChain_t		shadows;
+	lightMeshChain_t		interactions;
+} lightMeshJob_t;
+
+typedef struct {
+	int						maxJobs;
+	lightMeshJob_t *		jobs;
+
+	int						sequence;			// Bumped every time the slots are reallocated
+	volatile int			numSlots;
+	int						maxSlots;
+	lightMeshSlot_t *		slots;
+
+	lightMeshPool_t			shadows;
+	lightMeshPool_t			interactions;
+} lightMeshJobs_t;
+
+static lightMeshJobs_t		r_lightMeshJobs;
+
+static THREAD_LOCAL lightMeshJob_t *	r_lightMeshJob;
+static THREAD_LOCAL lightMeshSlot_t *	r_lightMeshSlot;
+static THREAD_LOCAL int					r_lightMeshSlotSequence;
+
+
+/*
+ ==================
+ R_AllocLightMeshBlock
+
+ Returns a mesh from the block chain of the current job, or NULL if the pool
+ ran out of blocks
+ ==================
+*/
+static mesh_t *R_AllocLightMeshBlock (lightMeshJob_t *job, lightMeshChain_t *chain, lightMeshPool_t *pool){
+
+	int		block;
+
+	if (job->overflowed)
+		return NULL;
+
+	// Link a new block to the chain if needed
+	if (!(chain->numMeshes & (LIGHT_MESH_BLOCK_SIZE - 1))){
+		block = Sys_AtomicIncrement(&pool->nextBlock) - 1;
+
+		if (block >= MAX_LIGHT_MESH_BLOCKS){
+			job->overflowed = true;
+			return NULL;
+		}
+
+		pool->blockLinks[block] = -1;
+
+		if (chain->numMeshes)
+			pool->blockLinks[chain->lastBlock] = block;
+		else
+			chain->firstBlock = block;
+
+		chain->lastBlock = block;
+	}
+
+	return &pool->meshes[(chain->lastBlock << LIGHT_MESH_BLOCK_SHIFT) + (chain->numMeshes++ & (LIGHT_MESH_BLOCK_SIZE - 1))];
+}
+
 /*
  ==================
  R_AddShadowMesh
@@ -36,15 +127,23 @@
 */
 static void R_AddShadowMesh (light_t *light, meshType_t type, meshData_t *data, renderEntity_t *entity, material_t *material, bool caps){
 
-	mesh_t	*mesh;
+	lightMeshJob_t	*job = r_lightMeshJob;
+	mesh_t			*mesh;
 
 	// Add a new mesh
-	if (rg.lightMeshes.numShadows == rg.lightMeshes.maxShadows){
-		Com_DPrintf(S_COLOR_YELLOW "R_AddShadowMesh: overflow\n");
-		return;
+	if (job->generated){
+		mesh = R_AllocLightMeshBlock(job, &job->shadows, &r_lightMeshJobs.shadows);
+		if (!mesh)
+			return;
 	}
+	else {
+		if (rg.lightMeshes.numShadows == rg.lightMeshes.maxShadows){
+			Com_DPrintf(S_COLOR_YELLOW "R_AddShadowMesh: overflow\n");
+			return;
+		}
 
-	mesh = &rg.lightMeshes.shadows[rg.lightMeshes.numShadows++];
+		mesh = &rg.lightMeshes.shadows[rg.lightMeshes.numShadows++];
+	}
 
 	// Fill it in
 	mesh->type = type;
@@ -64,15 +163,23 @@ static void R_AddShadowMesh (light_t *light, meshType_t type, meshData_t *data,
 */
 static void R_AddInteractionMesh (light_t *light, meshType_t type, meshData_t *data, renderEntity_t *entity, material_t *material, bool caps){
 
-	mesh_t	*mesh;
+	lightMeshJob_t	*job = r_lightMeshJob;
+	mesh_t			*mesh;
 
 	// Add a new mesh
-	if (rg.lightMeshes.numInteractions == rg.lightMeshes.maxInteractions){
-		Com_DPrintf(S_COLOR_YELLOW "R_AddInteractionMesh: overflow\n");
-		return;
+	if (job->generated){
+		mesh = R_AllocLightMeshBlock(job, &job->interactions, &r_lightMeshJobs.interactions);
+		if (!mesh)
+			return;
 	}
+	else {
+		if (rg.lightMeshes.numInteractions == rg.lightMeshes.maxInteractions){
+			Com_DPrintf(S_COLOR_YELLOW "R_AddInteractionMesh: overflow\n");
+			return;
+		}
 
-	mesh = &rg.lightMeshes.interactions[rg.lightMeshes.numInteractions++];
+		mesh = &rg.lightMeshes.interactions[rg.lightMeshes.numInteractions++];
+	}
 
 	// Fill it in
 	mesh->type = type;
@@ -212,11 +319,73 @@ static void R_AddLightSurface (light_t *light, surface_t *surface, material_t *m
 
 /*
  ==================
- 
+ R_PrecachedWorldLightNode
+
+ Adds the precached world surfaces of a static light. Only the tests that
+ depend on the view are done here, the rest was done when precaching.
  ==================
 */
-static void R_PrecachedWorldLightNode (){
+static void R_PrecachedWorldLightNode (light_t *light, bool lightInFrustum, bool castShadows, int skipFlag){
+
+	lightCacheSurface_t	*cachedSurface;
+	staticShadow_t		*staticShadows = NULL;
+	surface_t			*surface;
+	bool				caps;
+	bool				addShadow, addInteraction;
+	int					i;
+
+	// Use the prebuilt shadow volumes if they match the precached surfaces
+	if (castShadows && !r_skipStaticShadows->integerValue){
+		if (light->data.staticShadows && light->data.staticShadowChecksum == light->data.cacheChecksum)
+			staticShadows = light->data.staticShadows;
+	}
+
+	for (i = 0, cachedSurface = light->data.cachedSurfaces; i < light->data.numCachedSurfaces; i++, cachedSurface++){
+		surface = rg.worldModel->surfaces + cachedSurface->index;
+
+		if (surface->texInfo->material->spectrum != light->material->spectrum)
+			continue;		// Not illuminated by this light
+
+		// Check visibility
+		if (surface->viewCount != rg.viewCount){
+			// Not visible, but may still cast visible shadows
+			if (lightInFrustum || !castShadows)
+				continue;
+		}
+
+		// Determine if we should add the shadow
+		if (castShadows)
+			addShadow = !(surface->texInfo->material->flags & MF_NOSHADOWS);
+		else
+			addShadow = false;
+
+		// Determine if we should add the interaction
+		if (surface->viewCount == rg.viewCount)
+			addInteraction = !(surface->texInfo->material->flags & skipFlag);
+		else
+			addInteraction = false;
+
+		// Check if there's nothing to be added
+		if (!addShadow && !addInteraction)
+			continue;
+
+		// Cull face
+		if (!r_skipFaceCulling->integerValue && (cachedSurface->flags & LCS_FACECULLED))
+			continue;
+
+		// Select rendering method for shadows
+		caps = R_BoxInNearClipVolume(light, surface->mins, surface->maxs);
+
+		// Add the prebuilt shadow volume if available
+		if (addShadow && staticShadows && staticShadows[i].numVertices){
+			R_AddShadowMesh(light, MESH_STATICSHADOW, &staticShadows[i], rg.worldEntity, surface->texInfo->material, caps);
 
+			addShadow = false;
+		}
+
+		// Add the surface
+		R_AddLightSurface(light, surface, surface->texInfo->material, rg.worldEntity, caps, addShadow, addInteraction);
+	}
 }
 
 /*
@@ -226,11 +395,12 @@ static void R_PrecachedWorldLightNode (){
 */
 static void R_RecursiveWorldLightNode (light_t *light, node_t *node, bool lightInFrustum, bool castShadows, int skipFlag, int cullBits){
 
-	leaf_t		*leaf;
-	surface_t	*surface, **mark;
-	bool		caps;
-	bool		addShadow, addInteraction;
-	int			i;
+	lightMeshSlot_t	*slot = r_lightMeshJob->slot;
+	leaf_t			*leaf;
+	surface_t		*surface, **mark;
+	bool			caps;
+	bool			addShadow, addInteraction;
+	int				i;
 
 	// Check for solid content
 	if (node->contents == CONTENTS_SOLID)
@@ -280,9 +450,9 @@ static void R_RecursiveWorldLightNode (light_t *light, node_t *node, bool lightI
 	for (i = 0, mark = leaf->firstMarkSurface; i < leaf->numMarkSurfaces; i++, mark++){
 		surface = *mark;
 
-		if (surface->lightCount == rg.lightCount)
+		if (slot->surfaceLightCounts[surface - rg.worldModel->surfaces] == slot->lightCount)
 			continue;		// Already added this surface from another leaf
-		surface->lightCount = rg.lightCount;
+		slot->surfaceLightCounts[surface - rg.worldModel->surfaces] = slot->lightCount;
 
 		if (surface->texInfo->material->spectrum != light->material->spectrum)
 			continue;		// Not illuminated by this light
@@ -333,11 +503,11 @@ static void R_AddWorldLightInteractions (light_t *light, bool lightInFrustum, bo
 		return;
 
 	// Bump light count
-	rg.lightCount++;
+	r_lightMeshJob->slot->lightCount++;
 
-	// If we have precached lists of nodes and surfaces
-	if (!r_skipLightCache->integerValue && light->data.precached){
-		R_PrecachedWorldLightNode();
+	// If we have precached lists of surfaces
+	if (!r_skipLightCache->integerValue && !r_skipVisibility->integerValue && !r_skipCulling->integerValue && light->data.precached){
+		R_PrecachedWorldLightNode(light, lightInFrustum, castShadows, skipFlag);
 		return;
 	}
 
@@ -596,39 +766,47 @@ static void R_AddEntityLightInteractions (light_t *light, bool lightInFrustum, b
 
 /*
  ==================
- R_AllocLightMeshes
+ R_GetLightMeshSlot
+
+ Returns the slot bound to the calling thread, binding a new one the first time
+ a thread runs a light mesh job after the slots were allocated
  ==================
 */
-void R_AllocLightMeshes (){
+static lightMeshSlot_t *R_GetLightMeshSlot (){
 
-	rg.lightMeshes.maxShadows = MAX_MESHES << 2;
-	rg.lightMeshes.maxInteractions = MAX_MESHES << 2;
+	int		index;
 
-	rg.lightMeshes.shadows = (mesh_t *)Mem_Alloc(rg.lightMeshes.maxShadows * sizeof(mesh_t), TAG_RENDERER);
-	rg.lightMeshes.interactions = (mesh_t *)Mem_Alloc(rg.lightMeshes.maxInteractions * sizeof(mesh_t), TAG_RENDERER);
+	if (r_lightMeshSlotSequence == r_lightMeshJobs.sequence)
+		return r_lightMeshSlot;
+
+	index = Sys_AtomicIncrement(&r_lightMeshJobs.numSlots) - 1;
+
+	if (index >= r_lightMeshJobs.maxSlots)
+		Com_Error(ERR_FATAL, "R_GetLightMeshSlot: too many threads");
+
+	r_lightMeshSlot = &r_lightMeshJobs.slots[index];
+	r_lightMeshSlotSequence = r_lightMeshJobs.sequence;
+
+	return r_lightMeshSlot;
 }
 
 /*
  ==================
- R_GenerateLightMeshes
-
- FIXME: seems like lightInFrustum is always = false
+ R_AddLightInteractions
  ==================
 */
-void R_GenerateLightMeshes (light_t *light){
+static void R_AddLightInteractions (lightMeshJob_t *job){
 
+	light_t		*light = job->light;
 	cplane_t	*plane;
 	bool		lightInFrustum;
 	bool		castShadows;
 	int			skipFlag;
 	int			i;
 
-	// Clear
-	light->numShadowMeshes = 0;
-	light->shadowMeshes = NULL;
+	r_lightMeshJob = job;
 
-	light->numInteractionMeshes = 0;
-	light->interactionMeshes = NULL;
+	job->slot = R_GetLightMeshSlot();
 
 	// Determine if the light origin is inside the view frustum
 	if (light->data.type == RL_DIRECTIONAL)
@@ -670,26 +848,218 @@ void R_GenerateLightMeshes (light_t *light){
 	R_AddWorldLightInteractions(light, lightInFrustum, castShadows, skipFlag);
 	R_AddEntityLightInteractions(light, lightInFrustum, castShadows, skipFlag);
 
-	// Set up the interaction meshes
-	light->numShadowMeshes = rg.lightMeshes.numShadows - rg.lightMeshes.firstShadow;
-	light->shadowMeshes = &rg.lightMeshes.shadows[rg.lightMeshes.firstShadow];
+	r_lightMeshJob = NULL;
+}
+
+/*
+ ==================
+ R_LightInteractionsJob
+
+ Runs on the job threads. The meshes are added to block chains, so every light
+ gets its own mesh ranges without touching the shared rg.lightMeshes cursor.
+ ==================
+*/
+static void R_LightInteractionsJob (void *data, int index){
+
+	lightMeshJob_t	*job = &((lightMeshJob_t *)data)[index];
+
+	job->generated = true;
+
+	R_AddLightInteractions(job);
+
+	// If it ran out of blocks, it will be generated again on the calling thread
+	if (job->overflowed)
+		job->generated = false;
+}
+
+/*
+ ==================
+ R_SortLightMeshesJob
+ ==================
+*/
+static void R_SortLightMeshesJob (void *data, int index){
+
+	light_t	*light = ((lightMeshJob_t *)data)[index].light;
+
+	R_SortMeshes(light->numShadowMeshes, light->shadowMeshes);
+	R_SortMeshes(light->numInteractionMeshes, light->interactionMeshes);
+}
+
+/*
+ ==================
+ R_CopyLightMeshChain
+
+ Copies a block chain to the given mesh list, dropping whatever doesn't fit
+ just like R_AddShadowMesh and R_AddInteractionMesh do
+ ==================
+*/
+static void R_CopyLightMeshChain (lightMeshChain_t *chain, lightMeshPool_t *pool, mesh_t *meshes, int *numMeshes, int maxMeshes, const char *name){
+
+	int		block = chain->firstBlock;
+	int		count = chain->numMeshes;
+	int		copy;
+
+	while (count){
+		if (count > LIGHT_MESH_BLOCK_SIZE)
+			copy = LIGHT_MESH_BLOCK_SIZE;
+		else
+			copy = count;
+
+		if (*numMeshes + copy > maxMeshes){
+			Com_DPrintf(S_COLOR_YELLOW "%s: overflow\n", name);
+
+			Mem_Copy(&meshes[*numMeshes], &pool->meshes[block << LIGHT_MESH_BLOCK_SHIFT], (maxMeshes - *numMeshes) * sizeof(mesh_t));
+			*numMeshes = maxMeshes;
+
+			return;
+		}
+
+		Mem_Copy(&meshes[*numMeshes], &pool->meshes[block << LIGHT_MESH_BLOCK_SHIFT], copy * sizeof(mesh_t));
+		*numMeshes += copy;
 
-	light->numInteractionMeshes = rg.lightMeshes.numInteractions - rg.lightMeshes.firstInteraction;
-	light->interactionMeshes = &rg.lightMeshes.interactions[rg.lightMeshes.firstInteraction];
+		count -= copy;
 
-	rg.pc.shadowMeshes += light->numShadowMeshes;
-	rg.pc.interactionMeshes += light->numInteractionMeshes;
+		block = pool->blockLinks[block];
+	}
+}
 
-	// The next light rendered in this frame will tack on after this one
-	rg.lightMeshes.firstShadow = rg.lightMeshes.numShadows;
-	rg.lightMeshes.firstInteraction = rg.lightMeshes.numInteractions;
+/*
+ ==================
+ R_AllocLightMeshes
+ ==================
+*/
+void R_AllocLightMeshes (){
+
+	rg.lightMeshes.maxShadows = MAX_MESHES << 2;
+	rg.lightMeshes.maxInteractions = MAX_MESHES << 2;
+
+	rg.lightMeshes.shadows = (mesh_t *)Mem_Alloc(rg.lightMeshes.maxShadows * sizeof(mesh_t), TAG_RENDERER);
+	rg.lightMeshes.interactions = (mesh_t *)Mem_Alloc(rg.lightMeshes.maxInteractions * sizeof(mesh_t), TAG_RENDERER);
+
+	// Allocate a job for every light that can be added in a frame
+	r_lightMeshJobs.maxJobs = rg.maxLights[0] + rg.maxLights[1] + rg.maxLights[2] + rg.maxLights[3];
+	r_lightMeshJobs.jobs = (lightMeshJob_t *)Mem_Alloc(r_lightMeshJobs.maxJobs * sizeof(lightMeshJob_t), TAG_RENDERER);
+
+	// Allocate a slot for every job thread, plus the front-end thread that can
+	// be the main thread or a separate one. The surface lists are allocated when
+	// needed, because they depend on the world model.
+	r_lightMeshJobs.sequence++;
+	r_lightMeshJobs.numSlots = 0;
+	r_lightMeshJobs.maxSlots = Job_NumThreads() + 1;
+	r_lightMeshJobs.slots = (lightMeshSlot_t *)Mem_ClearedAlloc(r_lightMeshJobs.maxSlots * sizeof(lightMeshSlot_t), TAG_RENDERER);
+
+	// Allocate the block pools
+	r_lightMeshJobs.shadows.blockLinks = (int *)Mem_Alloc(MAX_LIGHT_MESH_BLOCKS * sizeof(int), TAG_RENDERER);
+	r_lightMeshJobs.shadows.meshes = (mesh_t *)Mem_Alloc((MAX_LIGHT_MESH_BLOCKS << LIGHT_MESH_BLOCK_SHIFT) * sizeof(mesh_t), TAG_RENDERER);
+
+	r_lightMeshJobs.interactions.blockLinks = (int *)Mem_Alloc(MAX_LIGHT_MESH_BLOCKS * sizeof(int), TAG_RENDERER);
+	r_lightMeshJobs.interactions.meshes = (mesh_t *)Mem_Alloc((MAX_LIGHT_MESH_BLOCKS << LIGHT_MESH_BLOCK_SHIFT) * sizeof(mesh_t), TAG_RENDERER);
+
+}
+
+/*
+ ==================
+ R_GenerateLightMeshes
+
+ Generates the shadow and interaction meshes for the given lights. Every light
+ is a separate job, and the results are copied to rg.lightMeshes in the order
+ the lights were added, so they are identical to what generating them one
+ after the other would give.
+
+ FIXME: seems like lightInFrustum is always = false
+ ==================
+*/
+void R_GenerateLightMeshes (const int numLights[4], light_t *lights[4]){
+
+	lightMeshJob_t	*job;
+	lightMeshSlot_t	*slot;
+	light_t			*light;
+	bool			parallel;
+	int				numJobs;
+	int				i, j;
+
+	// Set up a job for every light
+	numJobs = 0;
+
+	for (i = 0; i < 4; i++){
+		for (j = 0; j < numLights[i]; j++){
+			if (numJobs == r_lightMeshJobs.maxJobs)
+				Com_Error(ERR_DROP, "R_GenerateLightMeshes: MAX_LIGHTS hit");
+
+			job = &r_lightMeshJobs.jobs[numJobs++];
+
+			Mem_Fill(job, 0, sizeof(lightMeshJob_t));
+
+			job->light = &lights[i][j];
+		}
+	}
+
+	if (!numJobs)
+		return;
+
+	// Make sure the slots can hold all the world surfaces
+	if (rg.worldModel){
+		for (i = 0, slot = r_lightMeshJobs.slots; i < r_lightMeshJobs.maxSlots; i++, slot++){
+			if (slot->maxSurfaces >= rg.worldModel->numSurfaces)
+				continue;
+
+			if (slot->surfaceLightCounts)
+				Mem_Free(slot->surfaceLightCounts);
+
+			slot->lightCount = 0;
+			slot->maxSurfaces = rg.worldModel->numSurfaces;
+			slot->surfaceLightCounts = (int *)Mem_ClearedAlloc(slot->maxSurfaces * sizeof(int), TAG_RENDERER);
+		}
+	}
+
+	// Generate the meshes on the job threads if possible
+	parallel = (r_parallelLights->integerValue && Job_NumThreads() > 1 && numJobs > 1);
+
+	if (parallel){
+		r_lightMeshJobs.shadows.nextBlock = 0;
+		r_lightMeshJobs.interactions.nextBlock = 0;
+
+		Job_Run(R_LightInteractionsJob, r_lightMeshJobs.jobs, numJobs);
+	}
+
+	// Set up the interaction meshes in light order
+	for (i = 0, job = r_lightMeshJobs.jobs; i < numJobs; i++, job++){
+		light = job->light;
+
+		if (job->generated){
+			R_CopyLightMeshChain(&job->shadows, &r_lightMeshJobs.shadows, rg.lightMeshes.shadows, &rg.lightMeshes.numShadows, rg.lightMeshes.maxShadows, "R_AddShadowMesh");
+			R_CopyLightMeshChain(&job->interactions, &r_lightMeshJobs.interactions, rg.lightMeshes.interactions, &rg.lightMeshes.numInteractions, rg.lightMeshes.maxInteractions, "R_AddInteractionMesh");
+		}
+		else {
+			job->overflowed = false;
+
+			R_AddLightInteractions(job);
+		}
+
+		light->numShadowMeshes = rg.lightMeshes.numShadows - rg.lightMeshes.firstShadow;
+		light->shadowMeshes = &rg.lightMeshes.shadows[rg.lightMeshes.firstShadow];
+
+		light->numInteractionMeshes = rg.lightMeshes.numInteractions - rg.lightMeshes.firstInteraction;
+		light->interactionMeshes = &rg.lightMeshes.interactions[rg.lightMeshes.firstInteraction];
+
+		R_GetPerformanceCounters()->shadowMeshes += light->numShadowMeshes;
+		R_GetPerformanceCounters()->interactionMeshes += light->numInteractionMeshes;
+
+		// The next light rendered in this frame will tack on after this one
+		rg.lightMeshes.firstShadow = rg.lightMeshes.numShadows;
+		rg.lightMeshes.firstInteraction = rg.lightMeshes.numInteractions;
+	}
 
 	// Sort the interaction meshes
 	if (r_skipSorting->integerValue)
 		return;
 
-	R_SortMeshes(light->numShadowMeshes, light->shadowMeshes);
-	R_SortMeshes(light->numInteractionMeshes, light->interactionMeshes);
+	if (parallel)
+		Job_Run(R_SortLightMeshesJob, r_lightMeshJobs.jobs, numJobs);
+	else {
+		for (i = 0; i < numJobs; i++)
+			R_SortLightMeshesJob(r_lightMeshJobs.jobs, i);
+	}
 }
 
 /*
@@ -669,6 +669,7 @@ typedef struct arrayBuffer_s {
 
 	bool					dynamic;
 	int						count;
+	int						vertexSize;			// Vertex layout size, not used by index buffers
 
 	int						size;
 	uint					usage;
@@ -688,7 +689,7 @@ bool			R_UpdateIndexBuffer (arrayBuffer_t *indexBuffer, int indexOffset, int ind
 glIndex_t *		R_MapIndexBuffer (arrayBuffer_t *indexBuffer, int indexOffset, int indexCount, bool discard, bool synchronize);
 bool			R_UnmapIndexBuffer (arrayBuffer_t *indexBuffer);
 
-arrayBuffer_t *	R_AllocVertexBuffer (const char *name, bool dynamic, int vertexCount, const void *vertexData);
+arrayBuffer_t *	R_AllocVertexBuffer (const char *name, bool dynamic, int vertexCount, int vertexSize, const void *vertexData);
 void			R_ReallocVertexBuffer (arrayBuffer_t *vertexBuffer, int vertexCount, const void *vertexData);
 void			R_FreeVertexBuffer (arrayBuffer_t *vertexBuffer);
 bool			R_UpdateVertexBuffer (arrayBuffer_t *vertexBuffer, int vertexOffset, int vertexCount, const void *vertexData, bool discard, bool synchronize);
@@ -766,7 +767,6 @@ typedef struct {
 	// Frame counters
 	int						viewCount;
 	int						worldCount;
-	int						lightCount;
 	int						fragmentCount;
 } surface_t;
 
@@ -937,6 +937,8 @@ typedef struct model_s {
 	void *					data;
 	int						size;
 
+	uint					checksum;			// Only set for the world model
+
 	struct model_s *		nextHash;
 
 	// Volume occupied by the model
@@ -1047,10 +1049,42 @@ void			R_ShutdownImages ();
 
 #define LIGHT_PLANEBITS				(BIT(6) - 1)
 
+// Precached surface flags
+#define LCS_FACECULLED				BIT(0)		// Culled by face culling
+
+typedef struct {
+	int						index;				// Index into the world surfaces
+	int						flags;
+} lightCacheSurface_t;
+
+// Prebuilt shadow volume of a precached world surface, only for static lights
+typedef struct {
+	surface_t *				surface;
+
+	arrayBuffer_t *			indexBuffer;		// Silhouette indices followed by cap indices
+	arrayBuffer_t *			vertexBuffer;
+	const glIndex_t *		indices;			// Copy of all the index buffer indices in system memory
+
+	int						indexOffset;
+	int						numSilhouetteIndices;
+	int						numCapIndices;
+
+	int						numVertices;
+} staticShadow_t;
+
 typedef struct {
 	bool					valid;
 	bool					precached;
 
+	// Precached world interactions, only for static lights
+	int						numCachedSurfaces;
+	lightCacheSurface_t *	cachedSurfaces;
+	uint					cacheChecksum;
+
+	// Prebuilt world shadow volumes, only valid while the checksum matches
+	staticShadow_t *		staticShadows;		// Parallel to cachedSurfaces, NULL if not built
+	uint					staticShadowChecksum;
+
 	char					fileName[64];
 	char					name[64];
 
@@ -1088,6 +1122,8 @@ typedef struct {
 	const byte *			pvs;
 	int						area;
 
+	byte *					pvsRow;				// Static lights only, NULL if the map has no vis
+
 	lightParms_t			parms;
 } lightData_t;
 
@@ -1103,10 +1139,6 @@ typedef struct {
 	struct mesh_s *			interactions;
 } lightMeshes_t;
 
-void			R_AllocLightMeshes ();
-void			R_GenerateLightMeshes (struct light_s *light);
-void			R_ClearLightMeshes ();
-
 void			R_RefreshLightEditor ();
 
 void			R_InitLightEditor ();
@@ -1126,6 +1158,8 @@ typedef struct {
 	bool					editing;
 	int						editingArea;
 
+	int						viewArea;			// Area of the last rendered primary view, for the main thread
+
 	postProcessParms_t		postProcessGeneric;
 
 	char					postProcessName[MAX_PATH_LENGTH];
@@ -1301,7 +1335,8 @@ typedef enum {
 	MESH_SPRITE,
 	MESH_BEAM,
 	MESH_PARTICLE,
-	MESH_DECAL
+	MESH_DECAL,
+	MESH_STATICSHADOW
 } meshType_t;
 
 typedef struct mesh_s {
@@ -1366,6 +1401,19 @@ void			R_AllocLights ();
 void			R_GenerateLights ();
 void			R_ClearLights ();
 
+void			R_AllocLightMeshes ();
+void			R_GenerateLightMeshes (const int numLights[4], light_t *lights[4]);
+void			R_ClearLightMeshes ();
+
+bool			R_PrecachedLightData (lightData_t *lightData);
+void			R_FreePrecachedLightData (lightData_t *lightData);
+
+void			R_LoadLightCache (const char *name);
+void			R_WriteLightCache (const char *name);
+void			R_FreeLightCache ();
+
+void			R_BuildStaticShadows ();
+
 /*
  ==============================================================================
 
@@ -1417,6 +1465,20 @@ typedef enum {
 	NUM_BLUR_FILTERS
 } blurFilter_t;
 
+typedef struct {
+	int						width;
+	int						height;
+
+	rect_t					rect;
+
+	float					xScale;
+	float					yScale;
+
+	aspectRatio_t			aspectRatio;
+	float					aspectScale;
+	float					aspectBias;
+} renderCrop_t;
+
 typedef struct {
 	bool					primaryView;
 	int						viewType;
@@ -1459,6 +1521,13 @@ typedef struct {
 
 	renderParticle_t *		renderParticles;
 	int						numRenderParticles;
+
+	// Light styles
+	const lightStyle_t *	lightStyles;
+
+	// Render crop and environment shot state of the scene
+	renderCrop_t			renderCrop;
+	bool					envShotRendering;
 } viewParms_t;
 
 typedef struct {
@@ -1475,20 +1544,6 @@ typedef struct {
 	float					fovScale;
 } subviewParms_t;
 
-typedef struct {
-	int						width;
-	int						height;
-
-	rect_t					rect;
-
-	float					xScale;
-	float					yScale;
-
-	aspectRatio_t			aspectRatio;
-	float					aspectScale;
-	float					aspectBias;
-} renderCrop_t;
-
 typedef struct {
 	renderEntity_t			entities[MAX_RENDER_ENTITIES];
 	int						numEntities;
@@ -1516,6 +1571,40 @@ typedef struct {
 	renderView_t			renderView;
 } primaryView_t;
 
+// A scene passed to R_RenderScene, with everything the front-end needs to
+// generate the render views for it
+typedef struct {
+	renderView_t			renderView;
+	bool					primaryView;
+
+	rect_t					viewport;
+	rect_t					scissor;
+
+	// Copy of the render crop and environment shot state, used by all the
+	// views of the scene
+	renderCrop_t			renderCrop;
+	bool					envShotRendering;
+
+	// Scene render lists
+	renderEntity_t *		renderEntities;
+	int						numRenderEntities;
+
+	renderLight_t *			renderLights;
+	int						numRenderLights;
+
+	renderParticle_t *		renderParticles;
+	int						numRenderParticles;
+
+	// Light styles
+	const lightStyle_t *	lightStyles;
+
+	// Copy of the area bits, used when the scene is queued
+	byte					areaBits[BSP_MAX_AREAS/8];
+
+	// Render view commands generated by the front-end thread
+	const byte *			commands;
+} renderScene_t;
+
 typedef struct {
 	int						cullBoundsIn;
 	int						cullBoundsClip;
@@ -1541,6 +1630,9 @@ typedef struct {
 	int						staticLights;
 	int						dynamicLights;
 
+	int						staticShadows;
+	int						staticShadowVertices;
+
 	int						dynamicIndices;
 	int						dynamicVertices;
 	int						dynamicSprite;
@@ -1581,14 +1673,27 @@ typedef struct {
 	float					overdrawLights;
 } performanceCounters_t;
 
+// Accumulated clock ticks for each stage while a time demo is running
+typedef struct {
+	int						frames;
+
+	longlong				frontEnd;
+	longlong				meshes;
+	longlong				lights;
+	longlong				backEnd;
+} timeDemoStats_t;
+
 typedef struct {
 	int						time;
 
+	// Set if the front-end runs on its own thread
+	bool					smpActive;
+
 	// Frame counters
 	int						frameCount;
+	int						worldCount;
 	int						viewCount;
 	int						visCount;
-	int						lightCount;
 	int						fragmentCount;
 
 	// View cluster and area
@@ -1651,8 +1756,8 @@ typedef struct {
 	// Development tools
 	texture_t *				testTexture;
 
-	// Performance counters
-	performanceCounters_t	pc;
+	// Time demo statistics
+	timeDemoStats_t			timeDemo;
 
 	// Internal assets
 	texture_t *				defaultTexture;
@@ -1774,6 +1879,8 @@ extern cvar_t *				r_skipDecals;
 extern cvar_t *				r_skipExpressions;
 extern cvar_t *				r_skipConstantExpressions;
 extern cvar_t *				r_skipLightCache;
+extern cvar_t *				r_writeLightCache;
+extern cvar_t *				r_skipStaticShadows;
 extern cvar_t *				r_skipDeforms;
 extern cvar_t *				r_skipAmbient;
 extern cvar_t *				r_skipBump;
@@ -1797,6 +1904,8 @@ extern cvar_t *				r_skipRenderContext;
 extern cvar_t *				r_skipFrontEnd;
 extern cvar_t *				r_skipBackEnd;
 extern cvar_t *				r_glDriver;
+extern cvar_t *				r_smp;
+extern cvar_t *				r_parallelLights;
 extern cvar_t *				r_mode;
 extern cvar_t *				r_fullscreen;
 extern cvar_t *				r_customWidth;
@@ -1866,11 +1975,11 @@ int				R_LightCullLocalSphere (lightData_t *lightData, const float radius, const
 int				R_CullLightBounds (lightData_t *lightData, int planeBits);
 int				R_CullLightVolume (lightData_t *lightData, int planeBits);
 
-void			R_AdjustHorzCoords (horzAdjust_t adjust, float percent, float xIn, float wIn, float *xOut, float *wOut);
-void			R_AdjustVertCoords (vertAdjust_t adjust, float percent, float yIn, float hIn, float *yOut, float *hOut);
+void			R_AdjustHorzCoords (const renderCrop_t *renderCrop, horzAdjust_t adjust, float percent, float xIn, float wIn, float *xOut, float *wOut);
+void			R_AdjustVertCoords (const renderCrop_t *renderCrop, vertAdjust_t adjust, float percent, float yIn, float hIn, float *yOut, float *hOut);
 
-void			R_AdjustHorzCoordsInt (horzAdjust_t adjust, float percent, int xIn, int wIn, int *xOut, int *wOut);
-void			R_AdjustVertCoordsInt (vertAdjust_t adjust, float percent, int yIn, int hIn, int *yOut, int *hOut);
+void			R_AdjustHorzCoordsInt (const renderCrop_t *renderCrop, horzAdjust_t adjust, float percent, int xIn, int wIn, int *xOut, int *wOut);
+void			R_AdjustVertCoordsInt (const renderCrop_t *renderCrop, vertAdjust_t adjust, float percent, int yIn, int hIn, int *yOut, int *hOut);
 
 void			R_SetGamma ();
 
@@ -1880,9 +1989,26 @@ bool			R_AddSubviewSurface (meshType_t type,  meshData_t *data, renderEntity_t *
 
 bool			R_RenderSubview ();
 
+void			R_SetupViewportAndScissor (const renderView_t *renderView, const renderCrop_t *renderCrop, bool envShotRendering, int viewType, rect_t *viewport, rect_t *scissor);
+
 void			R_RenderView (bool primaryView, int viewType);
 
+void			R_RenderSceneViews (const renderScene_t *scene);
+
 void			R_AddRenderViewCommand ();
+void			R_AddRenderSceneCommand (const renderScene_t *scene);
+
+void			R_CropViewRenderSize (int width, int height);
+void			R_UnCropViewRenderSize (const renderCrop_t *renderCrop);
+
+// Waits for the front-end thread to finish the frame it is working on and
+// renders it. Must be called before changing anything the front-end thread
+// could be reading, like the world map, static lights, or post-process
+// parameters.
+void			R_SyncFrontEnd ();
+
+void			R_InitRenderCommands ();
+void			R_ShutdownRenderCommands ();
 
 void			R_RenderShadows ();
 
@@ -1899,6 +2025,11 @@ void			R_AddWorldSurfaces ();
 
 #define MAX_COMMAND_BUFFER_SIZE		1048576
 
+#define MAX_RENDER_FRAMES			2
+
+#define MAX_FRAME_SCENES			16
+#define MAX_FRAME_IMAGES			16
+
 #define MAX_INDICES					16384 * 3
 #define MAX_VERTICES				8192
 
@@ -1924,6 +2055,7 @@ typedef enum {
 } ambientPass_t;
 
 typedef enum {
+	RC_RENDER_SCENE,
 	RC_RENDER_VIEW,
 	RC_CAPTURE_RENDER,
 	RC_UPDATE_TEXTURE,
@@ -1986,6 +2118,8 @@ typedef struct {
 	bool					primaryView;
 	int						viewType;
 
+	bool					envShotRendering;
+
 	rect_t					viewport;
 	rect_t					scissor;
 
@@ -2114,12 +2248,73 @@ typedef struct {
 
 typedef struct {
 	renderCommand_t			commandId;
+
+	int						time;
 } setupBuffersCommand_t;
 
 typedef struct {
 	renderCommand_t			commandId;
 } swapBuffersCommand_t;
 
+typedef struct {
+	renderCommand_t			commandId;
+
+	const renderScene_t *	scene;
+} renderSceneCommand_t;
+
+// Everything recorded for a frame. When the front-end runs on its own thread
+// there are two of these, so the main thread can record a frame while the
+// front-end works on the previous one and the back-end renders the one before
+typedef struct {
+	// Render commands added by the main thread
+	commandBuffer_t			commandBuffer;
+
+	// Render view commands generated by the front-end
+	commandBuffer_t			viewCommandBuffer;
+
+	// Scenes queued for the front-end
+	renderScene_t			scenes[MAX_FRAME_SCENES];
+	int						numScenes;
+
+	// Copy of the scene render lists used by the queued scenes
+	scene_t *				scene;
+
+	// Area of the primary view, passed back to the main thread for the
+	// post-process editor
+	bool					hasViewArea;
+	int						viewArea;
+
+	// Performance counters gathered from all the threads that worked on this
+	// frame
+	performanceCounters_t	pc;
+
+	lightStyle_t			lightStyles[MAX_LIGHTSTYLES];
+
+	// Mesh and light lists
+	mesh_t *				meshes[4];
+	light_t *				lights[4];
+
+	mesh_t *				shadowMeshes;
+	mesh_t *				interactionMeshes;
+
+	// Copies of the images passed to render commands
+	byte *					images[MAX_FRAME_IMAGES];
+	int						numImages;
+
+	// Debug visualization
+	int						numDebugPolygons;
+	int						maxDebugPolygons;
+	debugPolygon_t *		debugPolygons;
+
+	int						numDebugLines;
+	int						maxDebugLines;
+	debugLine_t *			debugLines;
+
+	int						numDebugText;
+	int						maxDebugText;
+	debugText_t *			debugText;
+} renderFrame_t;
+
 typedef struct {
 	uniform_t *				viewOrigin;
 	uniform_t *				lightOrigin;
@@ -2211,6 +2406,8 @@ typedef struct {
 	int						time;
 	float					floatTime;
 
+	int						frameTime;
+
 	rect_t					viewport;
 	rect_t					scissor;
 
@@ -2227,8 +2424,8 @@ typedef struct {
 	int						cropWidth;
 	int						cropHeight;
 
-	// Render commands
-	commandBuffer_t			commandBuffer;
+	// Frame being rendered
+	renderFrame_t *			frame;
 
 	// Program uniforms
 	interactionParms_t		interactionParms[NUM_INTERACTION_TYPES][4];
@@ -2239,19 +2436,6 @@ typedef struct {
 	bloomParms_t			bloomParms;
 	colorCorrectionParms_t	colorCorrectionParms;
 
-	// Debug visualization
-	int						numDebugPolygons;
-	int						maxDebugPolygons;
-	debugPolygon_t *		debugPolygons;
-
-	int						numDebugLines;
-	int						maxDebugLines;
-	debugLine_t *			debugLines;
-
-	int						numDebugText;
-	int						maxDebugText;
-	debugText_t *			debugText;
-
 	// View parms
 	renderViewParms_t		viewParms;
 
@@ -2273,6 +2457,7 @@ typedef struct {
 	meshData_t *			meshData;
 
 	arrayBuffer_t *			indexBuffer;
+	int						indexOffset;		// Offset into a static index buffer
 	const void *			indexPointer;
 
 	arrayBuffer_t *			vertexBuffer;
@@ -2384,6 +2569,9 @@ void			RB_ClearDebugText ();
 
 void			RB_ExecuteRenderCommands (const void *data);
 
+renderFrame_t *	R_GetRenderFrame ();
+performanceCounters_t *	R_GetPerformanceCounters ();
+
 void			RB_InitBackEnd ();
 void			RB_ShutdownBackEnd ();
 
@@ -2395,7 +2583,10 @@ void			RB_ShutdownBackEnd ();
  ==============================================================================
 */
 
-#ifdef _WIN32
+// The null driver has no window or display, so it is available everywhere
+#define GL_DRIVER_NULL				"null"
+
+#if defined(_WIN32)
 
 #define GL_DRIVER_OPENGL			"OpenGL32"
 
@@ -2413,6 +2604,10 @@ void			GLW_SwapBuffers ();
 void			GLW_Init ();
 void			GLW_Shutdown ();
 
+#elif defined(__linux__)
+
+// There is no GLX implementation yet, so only the null driver builds here
+
 #else
 
 #error "GLImp not available for this platform"
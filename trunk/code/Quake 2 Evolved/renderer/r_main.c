@@ -145,6 +145,8 @@ cvar_t *					r_skipDecals;
 cvar_t *					r_skipExpressions;
 cvar_t *					r_skipConstantExpressions;
 cvar_t *					r_skipLightCache;
+cvar_t *					r_writeLightCache;
+cvar_t *					r_skipStaticShadows;
 cvar_t *					r_skipDeforms;
 cvar_t *					r_skipAmbient;
 cvar_t *					r_skipBump;
@@ -168,6 +170,8 @@ cvar_t *					r_skipRenderContext;
 cvar_t *					r_skipFrontEnd;
 cvar_t *					r_skipBackEnd;
 cvar_t *					r_glDriver;
+cvar_t *					r_smp;
+cvar_t *					r_parallelLights;
 cvar_t *					r_mode;
 cvar_t *					r_fullscreen;
 cvar_t *					r_customWidth;
@@ -344,6 +348,7 @@ static void R_ClearRender (){
 	rg.viewCluster2 = rg.oldViewCluster2 = -1;
 
 	rg.viewArea = -1;
+	rg.postProcess.viewArea = -1;
 
 	// Clear light styles
 	for (i = 0; i < MAX_LIGHTSTYLES; i++){
@@ -561,6 +566,8 @@ static void R_Register (){
 	r_skipExpressions = CVar_Register("r_skipExpressions", "0", CVAR_BOOL, CVAR_CHEAT, "Skip expression evaluation in materials, making everything static", 0, 0);
 	r_skipConstantExpressions = CVar_Register("r_skipConstantExpressions", "0", CVAR_BOOL, CVAR_CHEAT, "Skip constant expressions in materials, re-evaluating everything each frame", 0, 0);	
 	r_skipLightCache = CVar_Register("r_skipLightCache", "0", CVAR_BOOL, CVAR_CHEAT, "Skip precached shadow and interaction lists and generate them dynamically", 0, 0);
+	r_writeLightCache = CVar_Register("r_writeLightCache", "0", CVAR_BOOL, CVAR_ARCHIVE, "Write the precached static light interactions to a file when loading a map", 0, 0);
+	r_skipStaticShadows = CVar_Register("r_skipStaticShadows", "0", CVAR_BOOL, CVAR_CHEAT, "Skip prebuilt static light shadow volumes and generate them dynamically", 0, 0);
 	r_skipDeforms = CVar_Register("r_skipDeforms", "0", CVAR_BOOL, CVAR_CHEAT, "Skip material deforms", 0, 0);
 	r_skipAmbient = CVar_Register("r_skipAmbient", "0", CVAR_BOOL, CVAR_CHEAT, "Skip rendering ambient stages", 0, 0);
 	r_skipBump = CVar_Register("r_skipBump", "0", CVAR_BOOL, CVAR_CHEAT, "Skip rendering bump stages", 0, 0);
@@ -584,6 +591,8 @@ static void R_Register (){
 	r_skipFrontEnd = CVar_Register("r_skipFrontEnd", "0", CVAR_BOOL, CVAR_CHEAT, "Skip all front-end work", 0, 0);
 	r_skipBackEnd = CVar_Register("r_skipBackEnd", "0", CVAR_BOOL, CVAR_CHEAT, "Skip all back-end work", 0, 0);
 	r_glDriver = CVar_Register("r_glDriver", "", CVAR_STRING, CVAR_ARCHIVE | CVAR_LATCH, "GL driver", 0, 0);
+	r_smp = CVar_Register("r_smp", "0", CVAR_BOOL, CVAR_ARCHIVE | CVAR_LATCH, "Run the renderer front-end on its own thread", 0, 0);
+	r_parallelLights = CVar_Register("r_parallelLights", "1", CVAR_BOOL, CVAR_ARCHIVE, "Generate light interaction meshes on the job threads", 0, 0);
 	r_mode = CVar_Register("r_mode", "0", CVAR_INTEGER, CVAR_ARCHIVE | CVAR_LATCH, "Video mode index (-1 = custom)", -1, NUM_VIDEO_MODES - 1);
 	r_fullscreen = CVar_Register("r_fullscreen", "1", CVAR_BOOL, CVAR_ARCHIVE | CVAR_LATCH, "Enable fullscreen video mode", 0, 0);
 	r_customWidth = CVar_Register("r_customWidth", "720", CVAR_INTEGER, CVAR_ARCHIVE | CVAR_LATCH, "Custom screen width", 256, 65536);
@@ -676,13 +685,13 @@ void R_Init (bool all){
 	// Build gamma table and set device gamma ramp
 	R_SetGamma();
 
-	// Allocate light mesh interactions
-	R_AllocLightMeshes();
-
 	// Allocate mesh and light lists
 	R_AllocMeshes();
 	R_AllocLights();
 
+	// Allocate light mesh interactions
+	R_AllocLightMeshes();
+
 	// Initialize all the renderer modules
 	R_InitImages();
 	R_InitTextures();
@@ -697,6 +706,9 @@ void R_Init (bool all){
 
 	RB_InitBackEnd();
 
+	// Initialize render commands and start the front-end thread if needed
+	R_InitRenderCommands();
+
 	if (!r_ignoreGLErrors->integerValue)
 		GL_CheckForErrors();
 
@@ -713,6 +725,9 @@ void R_Shutdown (bool all){
 	if (!glConfig.initialized)
 		return;
 
+	// Stop the front-end thread
+	R_ShutdownRenderCommands();
+
 	// Shutdown all the renderer modules
 	RB_ShutdownBackEnd();
 
@@ -98,7 +98,7 @@ static void R_AddSprite (renderEntity_t *entity){
 	// Mark as visible for this view
 	entity->viewCount = rg.viewCount;
 
-	rg.pc.entities++;
+	R_GetPerformanceCounters()->entities++;
 
 	// Get the material
 	if (entity->material)
@@ -140,7 +140,7 @@ static void R_AddBeam (renderEntity_t *entity){
 	// Mark as visible for this view
 	entity->viewCount = rg.viewCount;
 
-	rg.pc.entities++;
+	R_GetPerformanceCounters()->entities++;
 
 	// Get the material
 	if (entity->material)
@@ -242,7 +242,7 @@ static void R_AddParticles (){
 		if (!particle->material->numStages)
 			continue;
 
-		rg.pc.particles++;
+		R_GetPerformanceCounters()->particles++;
 
 		// Add it
 		R_AddMeshToList(MESH_PARTICLE, particle, rg.worldEntity, particle->material);
@@ -448,7 +448,7 @@ void R_GenerateMeshes (){
 	rg.viewParms.meshes[2] = &rg.meshes[2][rg.firstMesh[2]];
 	rg.viewParms.meshes[3] = &rg.meshes[3][rg.firstMesh[3]];
 
-	rg.pc.meshes += rg.viewParms.numMeshes[0] + rg.viewParms.numMeshes[1] + rg.viewParms.numMeshes[2] + rg.viewParms.numMeshes[3];
+	R_GetPerformanceCounters()->meshes += rg.viewParms.numMeshes[0] + rg.viewParms.numMeshes[1] + rg.viewParms.numMeshes[2] + rg.viewParms.numMeshes[3];
 
 	// The next view rendered in this frame will tack on after this one
 	rg.firstMesh[0] = rg.numMeshes[0];
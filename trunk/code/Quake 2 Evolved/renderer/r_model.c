@@ -1011,7 +1011,7 @@ static void R_CacheGeometry (){
 		Str_SPrintf(name, sizeof(name), "bspCache%i", count);
 
 		indexBuffer = R_AllocIndexBuffer(name, false, indexCount[i], NULL);
-		vertexBuffer = R_AllocVertexBuffer(name, false, vertexCount[i], NULL);
+		vertexBuffer = R_AllocVertexBuffer(name, false, vertexCount[i], sizeof(glVertex_t), NULL);
 
 		if (!indexBuffer && !vertexBuffer)
 			continue;
@@ -1058,8 +1058,9 @@ static void R_CacheGeometry (){
 */
 void R_LoadMap (const char *name, const char *skyName, float skyRotate, const vec3_t skyAxis){
 
-	bspHeader_t	*header;
-	byte		*data;
+	bspHeader_t	header;
+	const byte	*data;
+	int			length;
 	int			i;
 	uint		hashKey;
 
@@ -1071,8 +1072,11 @@ void R_LoadMap (const char *name, const char *skyName, float skyRotate, const ve
 		Com_Error(ERR_DROP, "R_LoadMap: can't load '%s' because another world map is already loaded", name);
 	}
 
+	// Make sure the front-end thread is idle
+	R_SyncFrontEnd();
+
 	// Load the file
-	FS_ReadFile(name, (void **)&data);
+	length = FS_MapFile(name, (const void **)&data);
 	if (!data)
 		Com_Error(ERR_DROP, "R_LoadMap: '%s' not found", name);
 
@@ -1084,32 +1088,35 @@ void R_LoadMap (const char *name, const char *skyName, float skyRotate, const ve
 	rg.worldModel->type = MODEL_INLINE;
 	rg.worldModel->size = 0;
 
-	// Byte swap the header fields and sanity check
-	header = (bspHeader_t *)data;
+	rg.worldModel->checksum = MD4_BlockChecksum(data, length);
+
+	// Byte swap the header fields and sanity check.
+	// The file data may be memory-mapped, so we work on a copy.
+	Mem_Copy(&header, data, sizeof(bspHeader_t));
 
 	for (i = 0; i < sizeof(bspHeader_t) / 4; i++)
-		((int *)header)[i] = LittleLong(((int *)header)[i]);
+		((int *)&header)[i] = LittleLong(((int *)&header)[i]);
 
-	if (header->id != BSP_ID)
+	if (header.id != BSP_ID)
 		Com_Error(ERR_DROP, "R_LoadMap: wrong file id (%s)", rg.worldModel->name);
 
-	if (header->version != BSP_VERSION)
-		Com_Error(ERR_DROP, "R_LoadMap: wrong version number (%i should be %i) (%s)", header->version, BSP_VERSION, rg.worldModel->name);
+	if (header.version != BSP_VERSION)
+		Com_Error(ERR_DROP, "R_LoadMap: wrong version number (%i should be %i) (%s)", header.version, BSP_VERSION, rg.worldModel->name);
 
 	// Load the lumps
 	R_LoadSky(skyName, skyRotate, skyAxis);
 
-	R_LoadVertices(data, &header->lumps[LUMP_VERTICES]);
-	R_LoadEdges(data, &header->lumps[LUMP_EDGES]);
-	R_LoadSurfEdges(data, &header->lumps[LUMP_SURFEDGES]);
-	R_LoadPlanes(data, &header->lumps[LUMP_PLANES]);
-	R_LoadTexInfo(data, &header->lumps[LUMP_TEXINFO]);
-	R_LoadFaces(data, &header->lumps[LUMP_FACES]);
-	R_LoadMarkSurfaces(data, &header->lumps[LUMP_LEAFFACES]);
-	R_LoadVisibility(data, &header->lumps[LUMP_VISIBILITY]);
-	R_LoadLeafs(data, &header->lumps[LUMP_LEAFS]);
-	R_LoadNodes(data, &header->lumps[LUMP_NODES]);
-	R_LoadInlineModels(data, &header->lumps[LUMP_INLINEMODELS]);
+	R_LoadVertices(data, &header.lumps[LUMP_VERTICES]);
+	R_LoadEdges(data, &header.lumps[LUMP_EDGES]);
+	R_LoadSurfEdges(data, &header.lumps[LUMP_SURFEDGES]);
+	R_LoadPlanes(data, &header.lumps[LUMP_PLANES]);
+	R_LoadTexInfo(data, &header.lumps[LUMP_TEXINFO]);
+	R_LoadFaces(data, &header.lumps[LUMP_FACES]);
+	R_LoadMarkSurfaces(data, &header.lumps[LUMP_LEAFFACES]);
+	R_LoadVisibility(data, &header.lumps[LUMP_VISIBILITY]);
+	R_LoadLeafs(data, &header.lumps[LUMP_LEAFS]);
+	R_LoadNodes(data, &header.lumps[LUMP_NODES]);
+	R_LoadInlineModels(data, &header.lumps[LUMP_INLINEMODELS]);
 
 	FS_FreeFile(data);
 
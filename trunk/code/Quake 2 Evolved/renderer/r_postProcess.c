@@ -363,6 +363,9 @@ void R_LoadPostProcess (const char *name){
 	if (!r_postProcess->integerValue)
 		return;
 
+	// Make sure the front-end thread is not using the post-process parameters
+	R_SyncFrontEnd();
+
 	// Copy the name
 	Str_Copy(rg.postProcess.postProcessName, name, sizeof(rg.postProcess.postProcessName));
 
@@ -162,6 +162,8 @@ void R_UpdatePostProcess (){
 */
 void R_EditAreaPostProcess (int area){
 
+	rg.postProcess.viewArea = area;
+
 	if (!rg.postProcess.editing)
 		return;		// Not active
 
@@ -194,6 +196,9 @@ void R_PostProcessEditorUpdateCallback (int index, postProcessParms_t *parms){
 	if (index < 0 || index >= CM_NumAreas())
 		return;		// Out of range
 
+	// Make sure the front-end thread is not using the post-process parameters
+	R_SyncFrontEnd();
+
 	postProcessParms = &rg.postProcess.postProcessList[index];
 
 	// Copy the parameters
@@ -336,15 +341,15 @@ static void R_EditPostProcess_f (){
 		return;
 
 	rg.postProcess.editing = true;
-	rg.postProcess.editingArea = rg.viewArea;
+	rg.postProcess.editingArea = rg.postProcess.viewArea;
 
 	// Edit the current area post-process parameters
-	if (rg.viewArea == -1){
+	if (rg.postProcess.viewArea == -1){
 		WIN_EditPostProcessParameters(-1, NULL);
 		return;
 	}
 
-	WIN_EditPostProcessParameters(rg.viewArea, &rg.postProcess.postProcessList[rg.viewArea]);
+	WIN_EditPostProcessParameters(rg.postProcess.viewArea, &rg.postProcess.postProcessList[rg.postProcess.viewArea]);
 }
 
 
@@ -982,7 +982,7 @@ void RB_BindIndexBuffer (){
 
 	// If we already have an index buffer, bind it
 	if (backEnd.indexBuffer){
-		backEnd.indexPointer = NULL;
+		backEnd.indexPointer = INDEX_OFFSET(NULL, backEnd.indexOffset);
 
 		GL_BindIndexBuffer(backEnd.indexBuffer);
 		return;
@@ -1090,9 +1090,9 @@ void RB_DrawElements (){
 	if (r_skipDrawElements->integerValue)
 		return;
 
-	rg.pc.draws++;
-	rg.pc.totalIndices += backEnd.numIndices;
-	rg.pc.totalVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->draws++;
+	R_GetPerformanceCounters()->totalIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->totalVertices += backEnd.numVertices;
 
 	qglDrawElements(GL_TRIANGLES, backEnd.numIndices, GL_INDEX_TYPE, backEnd.indexPointer);
 }
@@ -1107,9 +1107,9 @@ void RB_DrawElementsWithCounters (int *totalIndices, int *totalVertices){
 	if (r_skipDrawElements->integerValue)
 		return;
 
-	rg.pc.draws++;
-	rg.pc.totalIndices += backEnd.numIndices;
-	rg.pc.totalVertices += backEnd.numVertices;
+	R_GetPerformanceCounters()->draws++;
+	R_GetPerformanceCounters()->totalIndices += backEnd.numIndices;
+	R_GetPerformanceCounters()->totalVertices += backEnd.numVertices;
 
 	if (totalIndices)
 		*totalIndices += backEnd.numIndices;
@@ -1129,9 +1129,9 @@ void RB_DrawElementsStaticIndices (int numVertices, int numIndices, const void *
 	if (r_skipDrawElements->integerValue)
 		return;
 
-	rg.pc.draws++;
-	rg.pc.totalIndices += numIndices;
-	rg.pc.totalVertices += numVertices;
+	R_GetPerformanceCounters()->draws++;
+	R_GetPerformanceCounters()->totalIndices += numIndices;
+	R_GetPerformanceCounters()->totalVertices += numVertices;
 
 	qglDrawElements(GL_TRIANGLES, numIndices, GL_INDEX_TYPE, indices);
 }
\ No newline at end of file
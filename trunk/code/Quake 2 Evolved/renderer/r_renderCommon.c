@@ -970,7 +970,7 @@ static void RB_DrawBlendLight (){
 		GL_BindMultitexture(backEnd.lightMaterial->lightFalloffImage, TMU_LIGHTFALLOFF);
 
 		// Draw it
-		RB_DrawElementsWithCounters(&rg.pc.interactionIndices, &rg.pc.interactionVertices);
+		RB_DrawElementsWithCounters(&R_GetPerformanceCounters()->interactionIndices, &R_GetPerformanceCounters()->interactionVertices);
 	}
 }
 
@@ -1169,7 +1169,7 @@ static void RB_DrawFogLight (){
 		GL_BindMultitexture(backEnd.lightMaterial->lightFalloffImage, TMU_LIGHTFALLOFF);
 
 		// Draw it
-		RB_DrawElementsWithCounters(&rg.pc.interactionIndices, &rg.pc.interactionVertices);
+		RB_DrawElementsWithCounters(&R_GetPerformanceCounters()->interactionIndices, &R_GetPerformanceCounters()->interactionVertices);
 	}
 }
 
@@ -1642,7 +1642,7 @@ void RB_PostProcess (const postProcessParms_t *postProcessParms){
 	rect_t	rect;
 	float	sScale, tScale;
 
-	if (!r_postProcess->integerValue || rg.envShotRendering)
+	if (!r_postProcess->integerValue || backEnd.viewParms.envShotRendering)
 		return;
 
 	if (!backEnd.viewParms.primaryView || backEnd.viewParms.viewType != VIEW_MAIN)
@@ -88,7 +88,7 @@ static void RB_DrawInteraction_Generic (const interaction_t *i){
 		GL_BindMultitexture(i->lightCubeTexture, TMU_LIGHTCUBE);
 
 	// Draw it
-	RB_DrawElementsWithCounters(&rg.pc.interactionIndices, &rg.pc.interactionVertices);
+	RB_DrawElementsWithCounters(&R_GetPerformanceCounters()->interactionIndices, &R_GetPerformanceCounters()->interactionVertices);
 }
 
 
@@ -130,7 +130,7 @@ static void RB_DrawAmbientInteraction_Generic (const interaction_t *i){
 	GL_BindMultitexture(i->lightFalloffTexture, TMU_LIGHTFALLOFF);
 
 	// Draw it
-	RB_DrawElementsWithCounters(&rg.pc.interactionIndices, &rg.pc.interactionVertices);
+	RB_DrawElementsWithCounters(&R_GetPerformanceCounters()->interactionIndices, &R_GetPerformanceCounters()->interactionVertices);
 }
 
 
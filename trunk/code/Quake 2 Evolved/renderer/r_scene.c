@@ -129,21 +129,72 @@ void R_AddParticleToScene (const renderParticle_t *renderParticle){
 
 /*
  ==================
- R_RenderScene
+ R_RenderSceneViews
  ==================
 */
-void R_RenderScene (const renderView_t *renderView, bool primaryView){
-
-	int		timeFrontEnd;
+void R_RenderSceneViews (const renderScene_t *scene){
 
-	if (r_skipFrontEnd->integerValue)
-		return;
+	renderFrame_t	*frame;
+	int				timeFrontEnd;
+	longlong		ticks;
 
 	if (com_speeds->integerValue)
 		timeFrontEnd = Sys_Milliseconds();
 
+	if (com_timeDemo->integerValue)
+		ticks = Sys_ClockTicks();
+
 	// Copy render view
-	rg.renderView = *renderView;
+	rg.renderView = scene->renderView;
+
+	// Set up the viewport and scissor
+	rg.viewParms.viewport = scene->viewport;
+	rg.viewParms.scissor = scene->scissor;
+
+	rg.viewParms.renderCrop = scene->renderCrop;
+	rg.viewParms.envShotRendering = scene->envShotRendering;
+
+	// Set up scene render lists
+	rg.viewParms.renderEntities = scene->renderEntities;
+	rg.viewParms.numRenderEntities = scene->numRenderEntities;
+
+	rg.viewParms.renderLights = scene->renderLights;
+	rg.viewParms.numRenderLights = scene->numRenderLights;
+
+	rg.viewParms.renderParticles = scene->renderParticles;
+	rg.viewParms.numRenderParticles = scene->numRenderParticles;
+
+	rg.viewParms.lightStyles = scene->lightStyles;
+
+	// Render main view
+	R_RenderView(scene->primaryView, VIEW_MAIN);
+
+	// Pass the view area to the main thread
+	if (scene->primaryView){
+		frame = R_GetRenderFrame();
+
+		frame->hasViewArea = true;
+		frame->viewArea = rg.viewArea;
+	}
+
+	if (com_speeds->integerValue)
+		com_timeFrontEnd += (Sys_Milliseconds() - timeFrontEnd);
+
+	if (com_timeDemo->integerValue)
+		rg.timeDemo.frontEnd += Sys_ClockTicks() - ticks;
+}
+
+/*
+ ==================
+ R_RenderScene
+ ==================
+*/
+void R_RenderScene (const renderView_t *renderView, bool primaryView){
+
+	renderScene_t	scene;
+
+	if (r_skipFrontEnd->integerValue)
+		return;
 
 	// If a primary view
 	if (primaryView){
@@ -162,24 +213,39 @@ void R_RenderScene (const renderView_t *renderView, bool primaryView){
 		rg.primaryView.numParticles = rg.scene.numParticles;
 		rg.primaryView.firstParticle = rg.scene.firstParticle;
 
-		rg.primaryView.renderView = rg.renderView;
+		rg.primaryView.renderView = *renderView;
 	}
 
-	// Set up scene render lists
-	rg.viewParms.renderEntities = &rg.scene.entities[rg.scene.firstEntity];
-	rg.viewParms.numRenderEntities = rg.scene.numEntities - rg.scene.firstEntity;
+	// Set up the scene
+	scene.renderView = *renderView;
+	scene.primaryView = primaryView;
 
-	rg.viewParms.renderLights = &rg.scene.lights[rg.scene.firstLight];
-	rg.viewParms.numRenderLights = rg.scene.numLights - rg.scene.firstLight;
+	scene.renderCrop = rg.renderCrops[rg.currentRenderCrop];
+	scene.envShotRendering = rg.envShotRendering;
 
-	rg.viewParms.renderParticles = &rg.scene.particles[rg.scene.firstParticle];
-	rg.viewParms.numRenderParticles = rg.scene.numParticles - rg.scene.firstParticle;
+	R_SetupViewportAndScissor(renderView, &scene.renderCrop, scene.envShotRendering, VIEW_MAIN, &scene.viewport, &scene.scissor);
 
-	// Render main view
-	R_RenderView(primaryView, VIEW_MAIN);
+	scene.renderEntities = &rg.scene.entities[rg.scene.firstEntity];
+	scene.numRenderEntities = rg.scene.numEntities - rg.scene.firstEntity;
 
-	if (com_speeds->integerValue)
-		com_timeFrontEnd += (Sys_Milliseconds() - timeFrontEnd);
+	scene.renderLights = &rg.scene.lights[rg.scene.firstLight];
+	scene.numRenderLights = rg.scene.numLights - rg.scene.firstLight;
+
+	scene.renderParticles = &rg.scene.particles[rg.scene.firstParticle];
+	scene.numRenderParticles = rg.scene.numParticles - rg.scene.firstParticle;
+
+	scene.lightStyles = rg.lightStyles;
+
+	scene.commands = NULL;
+
+	// If the front-end runs on its own thread, queue the scene for it
+	if (rg.smpActive){
+		R_AddRenderSceneCommand(&scene);
+		return;
+	}
+
+	// Render the scene
+	R_RenderSceneViews(&scene);
 }
 
 /*
@@ -150,10 +150,10 @@ bool R_RenderSubview (){
 	rg.renderView.fovScale = rg.subviewParms.fovScale;
 
 	// Render the subview to a texture
-	R_CropRenderSize(material->subviewWidth, material->subviewHeight, false);
+	R_CropViewRenderSize(material->subviewWidth, material->subviewHeight);
 	R_RenderView(rg.viewParms.primaryView, rg.subviewParms.viewType);
 	R_CaptureRenderToTexture(material->subviewTexture->name);
-	R_UnCropRenderSize();
+	R_UnCropViewRenderSize(&oldViewParms.renderCrop);
 
 	// Restore main view
 	Mem_Copy(&rg.renderView, &oldRenderView, sizeof(renderView_t));
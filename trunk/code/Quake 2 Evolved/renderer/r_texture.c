@@ -1137,8 +1137,8 @@ void R_UploadTextureImage (texture_t *texture, int unit, const byte *image, int
 	if (r_skipDynamicTextures->integerValue)
 		return;
 
-	rg.pc.updateTextures++;
-	rg.pc.updateTexturePixels += width * height;
+	R_GetPerformanceCounters()->updateTextures++;
+	R_GetPerformanceCounters()->updateTexturePixels += width * height;
 
 	// Update the texture
 	if (width == texture->width && height == texture->height){
@@ -1179,8 +1179,8 @@ void R_CopyFramebufferToTexture (texture_t *texture, int unit, int x, int y, int
 	if (r_skipCopyToTextures->integerValue)
 		return;
 
-	rg.pc.captureTextures++;
-	rg.pc.captureTexturePixels += width * height;
+	R_GetPerformanceCounters()->captureTextures++;
+	R_GetPerformanceCounters()->captureTexturePixels += width * height;
 
 	// Update the texture
 	if (width == texture->width && height == texture->height){
@@ -170,7 +170,7 @@ void R_AddInlineModel (renderEntity_t *entity){
 	// Mark as visible for this view
 	entity->viewCount = rg.viewCount;
 
-	rg.pc.entities++;
+	R_GetPerformanceCounters()->entities++;
 
 	// Add all the surfaces
 	surface = model->surfaces + model->firstModelSurface;
@@ -226,13 +226,9 @@ static void R_MarkLeaves (){
 
 	leaf = R_PointInLeaf(rg.renderView.origin);
 
-	// If the current view area has changed, edit the post-process parameters
-	if (rg.viewParms.viewType == VIEW_MAIN){
-		if (rg.viewArea != leaf->area)
-			R_EditAreaPostProcess(leaf->area);
-
+	// Set the current view area
+	if (rg.viewParms.viewType == VIEW_MAIN)
 		rg.viewArea = leaf->area;
-	}
 
 	// Development tool
 	if (r_showCluster->integerValue)
@@ -367,7 +363,7 @@ static void R_RecursiveWorldNode (node_t *node, int cullBits){
 	AddPointToBounds(leaf->mins, rg.viewParms.visMins, rg.viewParms.visMaxs);
 	AddPointToBounds(leaf->maxs, rg.viewParms.visMins, rg.viewParms.visMaxs);
 
-	rg.pc.leafs++;
+	R_GetPerformanceCounters()->leafs++;
 
 	// If it has a single surface, no need to cull again
 	if (leaf->numMarkSurfaces == 1)
@@ -377,9 +373,9 @@ static void R_RecursiveWorldNode (node_t *node, int cullBits){
 	for (i = 0, mark = leaf->firstMarkSurface; i < leaf->numMarkSurfaces; i++, mark++){
 		surface = *mark;
 
-		if (surface->worldCount == rg.frameCount)
+		if (surface->worldCount == rg.worldCount)
 			continue;		// Already added this surface from another leaf
-		surface->worldCount = rg.frameCount;
+		surface->worldCount = rg.worldCount;
 
 		if (!surface->texInfo->material->numStages)
 			continue;		// Don't bother drawing
@@ -403,8 +399,8 @@ void R_AddWorldSurfaces (){
 	if (!rg.viewParms.primaryView)
 		return;
 
-	// Bump frame count
-	rg.frameCount++;
+	// Bump world count
+	rg.worldCount++;
 
 	// Auto cycle the world frame for texture animation
 	rg.worldEntity->frame = (int)(rg.renderView.time * 2);
@@ -452,6 +452,10 @@ void			R_UnCropRenderSize ();
 void			R_BeginFrame (int time);
 void			R_EndFrame ();
 
+// Clears and prints the per-stage timings gathered while com_timeDemo is set
+void			R_ClearTimeDemoStats ();
+void			R_PrintTimeDemoStats ();
+
 // Returns the number of frames that the model has
 int				R_ModelFrames (model_t *model);
 
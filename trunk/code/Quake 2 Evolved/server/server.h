@@ -41,6 +41,11 @@
 // that could cycle all of them out before legitimate users connected
 #define	MAX_CHALLENGES				1024
 
+// Windowed downloads send several blocks before waiting for acknowledgements
+#define DOWNLOAD_BLOCK_SIZE			1024
+#define MAX_DOWNLOAD_WINDOW			64			// Max blocks in flight
+#define DOWNLOAD_TIMEOUT			1000		// Resend unacknowledged blocks after this many msec
+
 typedef enum {
 	SS_DEAD,		// No map loaded
 	SS_LOADING,		// Spawning level edicts
@@ -91,6 +96,30 @@ typedef struct {
 	int						sentTime;			// For ping calculations
 } clientFrame_t;
 
+// Snapshots are built and encoded in stages, some of which may run on the job
+// threads, so every client keeps its own intermediate results.
+// The visibility rows and the encoded frame are only needed until the frame is
+// sent, so they are allocated from the frame arenas and sized for the current
+// map and message.
+typedef struct {
+	bool					inGame;				// Entities are only culled once in game
+
+	vec3_t					origin;				// View origin used for culling
+	int						area;
+	byte *					fatPVS;				// Cluster rows, allocated by SV_SetupClientFrame
+	byte *					phs;
+
+	int						numEntities;		// Visible entities, in edict order
+	short					entities[MAX_EDICTS];
+
+	bool					overflowed;			// Encoded frame didn't fit
+	int						size;
+	byte *					data;				// Allocated by SV_EncodeClientFrame
+
+	int						cacheHits;			// Entity deltas copied from the encode cache
+	int						cacheMisses;
+} clientSnapshot_t;
+
 // A client can leave the server in one of four ways:
 //	- Dropping properly by quiting or disconnecting
 //	- Timing out if no valid messages are received for time-out seconds
@@ -100,6 +129,8 @@ typedef struct {
 typedef struct client_s {
 	clientState_t			state;
 
+	int						protocol;			// PROTOCOL_VERSION or PROTOCOL_VERSION_LEGACY
+
 	char					userInfo[MAX_INFO_STRING];
 
 	int						lastFrame;			// For delta compression
@@ -115,6 +146,17 @@ typedef struct client_s {
 	int						rate;
 	int						suppressCount;		// Number of messages rate suppressed
 
+	// Token bucket rate control. Snapshots are shaped to the bytes left in the
+	// bucket by deferring the least important entity updates.
+	float					rateTokens;			// Bytes that can be sent right now
+	int						rateTime;			// Time the bucket was last refilled
+	int						rateBudget;			// Bytes available for this snapshot, 0 if not limited
+	int						rateDeferred;		// Entity updates deferred on the last snapshot
+	int						rateShapedFrames;
+	int						rateSuppressedFrames;
+	longlong				rateDeferredTotal;
+	int						entityDeferred[MAX_EDICTS];	// sv.frameNum an update was first deferred, 0 if up to date
+
 	edict_t *				edict;				// EDICT_NUM(client number + 1)
 	char					name[32];			// Extracted from user info, high bits masked
 	int						messageLevel;		// For filtering printed messages
@@ -125,6 +167,7 @@ typedef struct client_s {
 	byte					datagramBuffer[MAX_MSGLEN];
 
 	clientFrame_t			frames[UPDATE_BACKUP];	// Updates can be delta'ed from here
+	clientSnapshot_t		snapshot;			// Snapshot being built this frame
 
 	int						lastMessage;		// sv.frameNum when packet was last received
 	int						lastConnect;
@@ -137,8 +180,32 @@ typedef struct client_s {
 	fileHandle_t			downloadFile;
 	int						downloadSize;
 	int						downloadOffset;
+
+	// Windowed file transfer, used with clients that accept fragmented
+	// messages. Blocks are sent unreliably and resent if lost.
+	bool					downloadWindowed;
+	bool					downloadRecovering;	// Resending blocks after a loss
+	int						downloadStart;		// File offset of the first block
+	int						downloadBlocks;		// Total number of blocks
+	int						downloadReadBlock;	// Next block to read from the file
+	int						downloadSendBlock;	// Next block to send
+	int						downloadAckBlock;	// Next block the client is waiting for
+	int						downloadDuplicateAcks;
+	int						downloadAckTime;	// Time the client last made progress
+	byte *					downloadWindow;		// [MAX_DOWNLOAD_WINDOW * DOWNLOAD_BLOCK_SIZE]
 } client_t;
 
+#define SNAPSHOT_BUCKET_SIZE		64			// Bytes per histogram bucket
+#define SNAPSHOT_BUCKETS			32			// The last bucket holds everything larger
+
+typedef struct {
+	int						snapshots;
+	longlong				totalBytes;
+	int						maxBytes;
+
+	int						buckets[SNAPSHOT_BUCKETS];
+} snapshotHistogram_t;
+
 typedef struct {
 	netAdr_t				address;
 
@@ -166,12 +233,29 @@ typedef struct {
 	// Game module handle
 	void *					gameLibHandle;
 
+	// Encoded snapshot sizes for the legacy and bit-packed protocols
+	snapshotHistogram_t		snapshotSizes[2];
+
+	// Entity delta encode cache statistics
+	longlong				encodeCacheHits;
+	longlong				encodeCacheMisses;
+
 	// Server record values
 	fileHandle_t			demoFile;
 	msg_t					demoMulticast;
 	byte					demoMulticastBuffer[MAX_MSGLEN];
 } serverStatic_t;
 
+typedef struct {
+	int						snapshots;			// Snapshots built this frame
+	int						timeSetup;			// Times are in microseconds
+	int						timeBuild;
+	int						timeCopy;
+	int						timeEncode;
+	int						timeTransmit;
+} serverStats_t;
+
+
 // =====================================================================
 
 #define EDICT_NUM(n)				((edict_t *)((byte *)ge->edicts + ge->edict_size*(n)))
@@ -193,6 +277,8 @@ extern edict_t *			sv_player;
 
 extern char					sv_outputBuf[OUTPUTBUF_LENGTH];
 
+extern serverStats_t		sv_stats;
+
 extern game_export_t *		ge;
 
 extern cvar_t *				sv_maxClients;
@@ -213,12 +299,22 @@ extern cvar_t *				sv_allowDownload;
 extern cvar_t *				sv_publicServer;
 extern cvar_t *				sv_rconPassword;
 extern cvar_t *				sv_loadGame;
+extern cvar_t *				sv_parallelSnapshots;
+extern cvar_t *				sv_snapshotCache;
+extern cvar_t *				sv_downloadWindow;
+extern cvar_t *				sv_rateControl;
+extern cvar_t *				sv_rateBurst;
+extern cvar_t *				sv_rateDistance;
+extern cvar_t *				sv_areaGrid;
+extern cvar_t *				sv_allowLegacyProtocol;
+extern cvar_t *				sv_showStats;
 
 int				SV_ModelIndex (char *name);
 int				SV_SoundIndex (char *name);
 int				SV_ImageIndex (char *name);
 
 void			SV_DropClient (client_t *cl);
+void			SV_CloseDownload (client_t *cl);
 void			SV_UserInfoChanged (client_t *cl);
 
 void			SV_LoadGame_f (void);
@@ -231,16 +327,21 @@ void			SV_Status_f (void);
 void			SV_Heartbeat_f (void);
 void			SV_ServerInfo_f (void);
 void			SV_DumpUser_f (void);
+void			SV_CompressionStats_f (void);
 void			SV_ServerRecord_f (void);
 void			SV_ServerStopRecord_f (void);
 void			SV_KillServer_f (void);
 void			SV_ServerCommand_f (void);
 void			SV_ConSay_f (void);
+void			SV_BenchmarkFatPVS_f (void);
+void			SV_BenchmarkAreaEdicts_f (void);
+void			SV_SnapshotHistogram_f (void);
+void			SV_RateStatus_f (void);
 
 void			SV_InitGame (void);
 void			SV_Map (const char *levelString, bool attractLoop, bool loadGame);
 
-void			SV_FlushRedirect (redirect_t redirect, char *outputBuf);
+void			SV_FlushRedirect (int redirect, const char *outputBuf);
 
 void			SV_SendClientMessages (void);
 void			SV_ParseClientMessage (client_t *cl);
@@ -257,7 +358,12 @@ void			SV_ReadLevelFile (void);
 
 void			SV_WriteFrameToClient (client_t *cl, msg_t *msg);
 void			SV_RecordDemoMessage (void);
-void			SV_BuildClientFrame (client_t *cl);
+void			SV_PrepareSnapshotEntities (void);
+void			SV_SetupClientFrame (client_t *cl);
+void			SV_CullClientFrame (client_t *cl);
+void			SV_CopyClientFrame (client_t *cl);
+void			SV_ResetEncodeCache (void);
+void			SV_EncodeClientFrame (client_t *cl);
 
 void			SG_Init ();
 void			SG_Shutdown ();
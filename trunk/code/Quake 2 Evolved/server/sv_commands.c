@@ -323,7 +323,7 @@ void SV_LoadGame_f (){
 	}
 
 	dir = Cmd_Argv(1);
-	if (Str_FindChar(dir, '..') || Str_FindChar(dir, '/') || Str_FindChar(dir, '\\')){
+	if (Str_FindText(dir, "..", false) || Str_FindChar(dir, '/') || Str_FindChar(dir, '\\')){
 		Com_Printf("Bad save directory\n");
 		return;
 	}
@@ -369,7 +369,7 @@ void SV_SaveGame_f (){
 	}
 
 	dir = Cmd_Argv(1);
-	if (Str_FindChar(dir, '..') || Str_FindChar(dir, '/') || Str_FindChar(dir, '\\')){
+	if (Str_FindText(dir, "..", false) || Str_FindChar(dir, '/') || Str_FindChar(dir, '\\')){
 		Com_Printf("Bad save directory\n");
 		return;
 	}
@@ -702,6 +702,9 @@ void SV_Status_f (){
 	Com_Printf("Map: %s\n", sv.name);
 	Com_Printf("Up time: %02i:%02i:%02i:%02i\n", d, h, m, s);
 
+	if (svs.encodeCacheHits + svs.encodeCacheMisses)
+		Com_Printf("Snapshot cache: %.1f%% hit rate (%.0f hits, %.0f misses)\n", (double)svs.encodeCacheHits * 100.0 / (svs.encodeCacheHits + svs.encodeCacheMisses), (double)svs.encodeCacheHits, (double)svs.encodeCacheMisses);
+
 	Com_Printf("\n");
 	Com_Printf("num score ping lastmsg address               cport  rate  name\n");
 	Com_Printf("--- ----- ---- ------- --------------------- ------ ----- ---------------\n");
@@ -806,6 +809,47 @@ void SV_DumpUser_f (){
 	Info_Print(sv_client->userInfo);
 }
 
+/*
+ ==================
+ SV_CompressionStats_f
+
+ Shows the packet compression ratio and CPU cost for every client
+ ==================
+*/
+void SV_CompressionStats_f (){
+
+	static const char	*modeNames[] = {"none", "huffman", "adaptive"};
+	client_t			*client;
+	netChan_t			*netChan;
+	float				ratio;
+	int					i;
+
+	if (!svs.initialized){
+		Com_Printf("Server is not running\n");
+		return;
+	}
+
+	Com_Printf("\n");
+	Com_Printf("num mode     payload KB sent KB    ratio  comp msec  decomp msec name\n");
+	Com_Printf("--- -------- ---------- ---------- ------ ---------- ----------- ---------------\n");
+
+	for (i = 0, client = svs.clients; i < sv_maxClients->integerValue; i++, client++){
+		if (client->state == CS_FREE)
+			continue;
+
+		netChan = &client->netChan;
+
+		if (netChan->payloadBytes)
+			ratio = 100.0f * netChan->compressedBytes / netChan->payloadBytes;
+		else
+			ratio = 100.0f;
+
+		Com_Printf("%3i %-8s %10i %10i %5.1f%% %10i %11i %s\n", i, modeNames[netChan->compression], (int)(netChan->payloadBytes >> 10), (int)(netChan->compressedBytes >> 10), ratio, (int)(netChan->compressionTime / 1000), (int)(netChan->decompressionTime / 1000), client->name);
+	}
+
+	Com_Printf("\n");
+}
+
 
 /*
  ==================
@@ -873,7 +917,7 @@ void SV_ServerRecord_f (){
 
 	// Send the server data
 	MSG_WriteByte(&msg, SVC_SERVERDATA);
-	MSG_WriteLong(&msg, PROTOCOL_VERSION);
+	MSG_WriteLong(&msg, PROTOCOL_VERSION_LEGACY);	// Server demos use the legacy protocol
 	MSG_WriteLong(&msg, svs.spawnCount);
 	MSG_WriteByte(&msg, 2);		// Demos are always attract loops (2 means server demo)
 	MSG_WriteString(&msg, CVar_GetVariableString("fs_game"));
@@ -31,6 +31,224 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 
+#define ENCODE_CACHE_SIZE			4096		// Must be a power of two
+#define MAX_ENCODED_ENTITY			128			// Larger deltas are not cached
+
+// Many clients usually delta the same entity from the same state (spectators,
+// players in the same room, entities entering the view from the baseline), so
+// the encoded deltas are shared between all the clients.
+// The cache is filled from the job threads. The first thread to claim a slot
+// during an encoding pass fills it, and the slot can be read after it has been
+// stamped with the current pass.
+typedef struct {
+	volatile int			pass;				// Encoding pass the slot was filled on
+
+	int						protocol;
+	bool					force;
+	bool					newEntity;
+	entity_state_t			from;
+	entity_state_t			to;
+
+	int						bits;
+	byte					data[MAX_ENCODED_ENTITY];
+} encodedEntity_t;
+
+#define UPDATE_PRIORITY_ALWAYS		1e30f		// Never deferred
+
+typedef struct {
+	int						index;				// Into the frame
+	int						bits;
+	float					priority;
+} entityUpdate_t;
+
+// Too large for the stacks of the job threads, so every thread that shapes a
+// frame during an encoding pass gets its own
+typedef struct {
+	entityUpdate_t			updates[MAX_EDICTS];
+	entity_state_t *		oldStates[MAX_EDICTS];
+	bool					deferred[MAX_EDICTS];
+} shapeScratch_t;
+
+static int					sv_encodePass;
+static volatile int			sv_encodeClaims[ENCODE_CACHE_SIZE];
+static encodedEntity_t		sv_encodeCache[ENCODE_CACHE_SIZE];
+
+static volatile int			sv_numShapeScratch;
+static shapeScratch_t		sv_shapeScratch[MAX_JOB_THREADS + 1];
+
+static THREAD_LOCAL shapeScratch_t *	sv_threadShapeScratch;
+static THREAD_LOCAL int					sv_threadShapeScratchPass;
+
+
+/*
+ =================
+ SV_ResetEncodeCache
+
+ Must be called on the main thread before encoding the client frames, so
+ every slot can be claimed again
+ =================
+*/
+void SV_ResetEncodeCache (void){
+
+	sv_encodePass++;
+
+	Mem_Fill((void *)sv_encodeClaims, 0, sizeof(sv_encodeClaims));
+
+	sv_numShapeScratch = 0;
+}
+
+/*
+ =================
+ SV_HashEncodedEntity
+ =================
+*/
+static uint SV_HashEncodedEntity (const entity_state_t *from, const entity_state_t *to, int protocol, bool force, bool newEntity){
+
+	const uint	*words;
+	uint		hash;
+	int			count = sizeof(entity_state_t) / sizeof(uint);
+	int			i;
+
+	hash = 2166136261U ^ (to->number << 3) ^ (protocol << 2) ^ (force << 1) ^ newEntity;
+
+	words = (const uint *)from;
+
+	for (i = 0; i < count; i++)
+		hash = (hash ^ words[i]) * 16777619U;
+
+	words = (const uint *)to;
+
+	for (i = 0; i < count; i++)
+		hash = (hash ^ words[i]) * 16777619U;
+
+	return hash ^ (hash >> 16);
+}
+
+/*
+ =================
+ SV_EncodeDeltaEntity
+ =================
+*/
+static void SV_EncodeDeltaEntity (msg_t *msg, int protocol, const entity_state_t *from, const entity_state_t *to, bool force, bool newEntity){
+
+	if (protocol == PROTOCOL_VERSION_LEGACY)
+		MSG_WriteDeltaEntity(msg, from, to, force, newEntity);
+	else
+		MSG_WritePackedDeltaEntity(msg, from, to, force, newEntity);
+}
+
+/*
+ =================
+ SV_CacheDeltaEntity
+
+ Returns the shared encoding of an entity delta, encoding it if no other
+ client did during this pass. Returns NULL if the delta can't be cached.
+ Rate shaping measures a delta before it is written, so only lookups done for
+ writing are counted in the cache statistics.
+ =================
+*/
+static const encodedEntity_t *SV_CacheDeltaEntity (client_t *cl, const entity_state_t *from, const entity_state_t *to, bool force, bool newEntity, bool count){
+
+	encodedEntity_t	*slot;
+	msg_t			encoded;
+	int				index;
+
+	if (!sv_snapshotCache->integerValue)
+		return NULL;
+
+	index = SV_HashEncodedEntity(from, to, cl->protocol, force, newEntity) & (ENCODE_CACHE_SIZE - 1);
+	slot = &sv_encodeCache[index];
+
+	// If another client already encoded the same delta during this pass, just
+	// use it
+	if (Sys_AtomicAdd(&slot->pass, 0) == sv_encodePass){
+		if (slot->protocol == cl->protocol && slot->force == force && slot->newEntity == newEntity){
+			if (Mem_Compare(&slot->from, from, sizeof(entity_state_t)) && Mem_Compare(&slot->to, to, sizeof(entity_state_t))){
+				if (count)
+					cl->snapshot.cacheHits++;
+
+				return slot;
+			}
+		}
+	}
+
+	if (count)
+		cl->snapshot.cacheMisses++;
+
+	// Only the first thread to claim the slot can fill it
+	if (Sys_AtomicIncrement(&sv_encodeClaims[index]) != 1)
+		return NULL;
+
+	// Encode the delta on its own so it can be copied
+	MSG_Init(&encoded, slot->data, sizeof(slot->data), true);
+
+	SV_EncodeDeltaEntity(&encoded, cl->protocol, from, to, force, newEntity);
+
+	if (encoded.overflowed)
+		return NULL;	// Too large to be cached
+
+	// Fill in the slot and make it visible to the other threads
+	slot->protocol = cl->protocol;
+	slot->force = force;
+	slot->newEntity = newEntity;
+	slot->from = *from;
+	slot->to = *to;
+	slot->bits = MSG_GetWrittenBits(&encoded);
+
+	Sys_AtomicAdd(&slot->pass, sv_encodePass - slot->pass);
+
+	return slot;
+}
+
+/*
+ =================
+ SV_WriteDeltaEntity
+
+ Writes an entity delta to the message, reusing the encoding from another
+ client if possible
+ =================
+*/
+static void SV_WriteDeltaEntity (client_t *cl, msg_t *msg, const entity_state_t *from, const entity_state_t *to, bool force, bool newEntity){
+
+	const encodedEntity_t	*slot;
+
+	slot = SV_CacheDeltaEntity(cl, from, to, force, newEntity, true);
+	if (!slot){
+		SV_EncodeDeltaEntity(msg, cl->protocol, from, to, force, newEntity);
+		return;
+	}
+
+	MSG_WriteBitStream(msg, slot->data, slot->bits);
+}
+
+/*
+ =================
+ SV_WriteRemoveEntity
+ =================
+*/
+static void SV_WriteRemoveEntity (msg_t *msg, int protocol, int number){
+
+	int		bits;
+
+	if (protocol != PROTOCOL_VERSION_LEGACY){
+		MSG_WritePackedRemoveEntity(msg, number);
+		return;
+	}
+
+	bits = U_REMOVE;
+	if (number >= 256)
+		bits |= U_NUMBER16 | U_MOREBITS1;
+
+	MSG_WriteByte(msg, bits&255);
+	if (bits & 0x0000ff00)
+		MSG_WriteByte(msg, (bits>>8)&255);
+
+	if (bits & U_NUMBER16)
+		MSG_WriteShort(msg, number);
+	else
+		MSG_WriteByte(msg, number);
+}
+
 /*
  =================
  SV_EmitPacketEntities
@@ -38,13 +256,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
  Writes a delta update of an entity_state_t list to the message
  =================
 */
-static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t *msg){
+static void SV_EmitPacketEntities (client_t *cl, clientFrame_t *from, clientFrame_t *to, msg_t *msg){
 
 	entity_state_t	*oldState, *newState;
 	int				oldIndex, newIndex;
 	int				oldNum, newNum;
 	int				fromNumEntities;
-	int				bits;
 
 	MSG_WriteByte(msg, SVC_PACKETENTITIES);
 
@@ -77,7 +294,7 @@ static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t
 			// all.
 			// Note that players are always 'newentities', this updates 
 			// their oldorigin always and prevents warping.
-			MSG_WriteDeltaEntity(msg, oldState, newState, false, newState->number <= sv_maxClients->integerValue);
+			SV_WriteDeltaEntity(cl, msg, oldState, newState, false, newState->number <= sv_maxClients->integerValue);
 
 			oldIndex++;
 			newIndex++;
@@ -86,7 +303,7 @@ static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t
 
 		if (newNum < oldNum){
 			// This is a new entity, send it from the baseline
-			MSG_WriteDeltaEntity(msg, &sv.baselines[newNum], newState, true, true);
+			SV_WriteDeltaEntity(cl, msg, &sv.baselines[newNum], newState, true, true);
 
 			newIndex++;
 			continue;
@@ -94,25 +311,18 @@ static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t
 
 		if (newNum > oldNum){
 			// The old entity isn't present in the new message
-			bits = U_REMOVE;
-			if (oldNum >= 256)
-				bits |= U_NUMBER16 | U_MOREBITS1;
-
-			MSG_WriteByte(msg, bits&255);
-			if (bits & 0x0000ff00)
-				MSG_WriteByte(msg, (bits>>8)&255);
-
-			if (bits & U_NUMBER16)
-				MSG_WriteShort(msg, oldNum);
-			else
-				MSG_WriteByte(msg, oldNum);
+			SV_WriteRemoveEntity(msg, cl->protocol, oldNum);
 
 			oldIndex++;
 			continue;
 		}
 	}
 
-	MSG_WriteShort(msg, 0);	// End of packet entities
+	// End of packet entities
+	if (cl->protocol == PROTOCOL_VERSION_LEGACY)
+		MSG_WriteShort(msg, 0);
+	else
+		MSG_WriteBits(msg, 0, ENTITYNUM_BITS);
 }
 
 /*
@@ -120,7 +330,7 @@ static void SV_EmitPacketEntities (clientFrame_t *from, clientFrame_t *to, msg_t
  SV_WritePlayerStateToClient
  =================
 */
-static void SV_WritePlayerStateToClient (clientFrame_t *from, clientFrame_t *to, msg_t *msg){
+static void SV_WritePlayerStateToClient (clientFrame_t *from, clientFrame_t *to, msg_t *msg, int protocol){
 
 	player_state_t	*newPS, *oldPS, dummy;
 	int				i, flags, statBits;
@@ -133,6 +343,13 @@ static void SV_WritePlayerStateToClient (clientFrame_t *from, clientFrame_t *to,
 	else
 		oldPS = &from->ps;
 
+	// The bit-packed protocol only sends the fields that changed
+	if (protocol != PROTOCOL_VERSION_LEGACY){
+		MSG_WriteByte(msg, SVC_PLAYERINFO);
+		MSG_WritePackedDeltaPlayerState(msg, oldPS, newPS);
+		return;
+	}
+
 	// Determine what needs to be sent
 	flags = 0;
 
@@ -275,6 +492,279 @@ static void SV_WritePlayerStateToClient (clientFrame_t *from, clientFrame_t *to,
 	}
 }
 
+/*
+ =================
+ SV_MeasureDeltaEntity
+
+ Returns the number of bits the entity delta would take. The delta goes into
+ the encode cache, so writing it afterwards is just a copy.
+ =================
+*/
+static int SV_MeasureDeltaEntity (client_t *cl, const entity_state_t *from, const entity_state_t *to, bool force, bool newEntity){
+
+	const encodedEntity_t	*slot;
+	msg_t					msg;
+	byte					data[MAX_ENCODED_ENTITY * 2];
+
+	slot = SV_CacheDeltaEntity(cl, from, to, force, newEntity, false);
+	if (slot)
+		return slot->bits;
+
+	MSG_Init(&msg, data, sizeof(data), true);
+
+	SV_EncodeDeltaEntity(&msg, cl->protocol, from, to, force, newEntity);
+
+	return MSG_GetWrittenBits(&msg);
+}
+
+/*
+ =================
+ SV_GetShapeScratch
+
+ Returns the scratch buffers bound to the calling thread, binding new ones the
+ first time a thread shapes a frame during an encoding pass
+ =================
+*/
+static shapeScratch_t *SV_GetShapeScratch (void){
+
+	int		index;
+
+	if (sv_threadShapeScratch && sv_threadShapeScratchPass == sv_encodePass)
+		return sv_threadShapeScratch;
+
+	index = Sys_AtomicIncrement(&sv_numShapeScratch) - 1;
+
+	if (index >= MAX_JOB_THREADS + 1)
+		Com_Error(ERR_FATAL, "SV_GetShapeScratch: too many threads");
+
+	sv_threadShapeScratch = &sv_shapeScratch[index];
+	sv_threadShapeScratchPass = sv_encodePass;
+
+	return sv_threadShapeScratch;
+}
+
+/*
+ =================
+ SV_SortEntityUpdates
+ =================
+*/
+static int SV_SortEntityUpdates (const void *elem1, const void *elem2){
+
+	const entityUpdate_t	*update1 = (const entityUpdate_t *)elem1;
+	const entityUpdate_t	*update2 = (const entityUpdate_t *)elem2;
+
+	if (update1->priority > update2->priority)
+		return -1;
+	if (update1->priority < update2->priority)
+		return 1;
+
+	return update1->index - update2->index;
+}
+
+/*
+ =================
+ SV_EntityUpdatePriority
+
+ Nearby entities, players, and entities that have been waiting for a while go
+ first. Events are never deferred because they would be lost.
+ =================
+*/
+static float SV_EntityUpdatePriority (client_t *cl, const entity_state_t *state, bool newEntity){
+
+	vec3_t	delta;
+	float	relevance;
+	int		age = 0;
+
+	if (state->event || state->number == NUM_FOR_EDICT(cl->edict))
+		return UPDATE_PRIORITY_ALWAYS;
+
+	if (state->number <= sv_maxClients->integerValue)
+		relevance = 4.0f;
+	else if (newEntity)
+		relevance = 2.0f;		// Popping in is more noticeable than lagging behind
+	else if (!state->modelindex)
+		relevance = 0.5f;		// Sounds and other invisible entities
+	else
+		relevance = 1.0f;
+
+	if (cl->entityDeferred[state->number])
+		age = sv.frameNum - cl->entityDeferred[state->number];
+
+	VectorSubtract(state->origin, cl->snapshot.origin, delta);
+
+	return relevance * (1 + age) / (1.0f + VectorLength(delta) / sv_rateDistance->floatValue);
+}
+
+/*
+ =================
+ SV_ShapeClientFrame
+
+ If the entity updates don't fit in the given number of bits, the least
+ important ones are deferred to a later frame.
+ A deferred entity keeps the state the client already has, so no bits are sent
+ for it, and the next frame will be delta'ed from that state. Deferred new
+ entities are left out of the frame until they fit.
+ =================
+*/
+static void SV_ShapeClientFrame (client_t *cl, const clientFrame_t *from, clientFrame_t *to, int budget){
+
+	shapeScratch_t	*scratch = SV_GetShapeScratch();
+	entityUpdate_t	*updates = scratch->updates;
+	entity_state_t	**oldStates = scratch->oldStates;
+	entity_state_t	*oldState, *newState, *state;
+	bool			*deferred = scratch->deferred;
+	int				oldIndex, newIndex;
+	int				oldNum, newNum;
+	int				fromNumEntities;
+	int				numUpdates = 0;
+	int				i, bits, total;
+	msg_t			msg;
+	byte			data[32];
+
+	cl->rateDeferred = 0;
+
+	if (!from)
+		fromNumEntities = 0;
+	else
+		fromNumEntities = from->numEntities;
+
+	// The packet entities header and the end marker
+	if (cl->protocol == PROTOCOL_VERSION_LEGACY)
+		total = 8 + 16;
+	else
+		total = 8 + ENTITYNUM_BITS;
+
+	// Measure every update, the removals are always sent
+	newIndex = 0;
+	oldIndex = 0;
+	while (newIndex < to->numEntities || oldIndex < fromNumEntities){
+		if (newIndex >= to->numEntities)
+			newNum = 9999;
+		else {
+			newState = &svs.clientEntities[(to->firstEntity+newIndex)%svs.numClientEntities];
+			newNum = newState->number;
+		}
+
+		if (oldIndex >= fromNumEntities)
+			oldNum = 9999;
+		else {
+			oldState = &svs.clientEntities[(from->firstEntity+oldIndex)%svs.numClientEntities];
+			oldNum = oldState->number;
+		}
+
+		if (newNum == oldNum){
+			oldStates[newIndex] = oldState;
+			deferred[newIndex] = false;
+
+			bits = SV_MeasureDeltaEntity(cl, oldState, newState, false, newNum <= sv_maxClients->integerValue);
+			if (bits){
+				updates[numUpdates].index = newIndex;
+				updates[numUpdates].bits = bits;
+				updates[numUpdates].priority = SV_EntityUpdatePriority(cl, newState, false);
+				numUpdates++;
+
+				total += bits;
+			}
+
+			oldIndex++;
+			newIndex++;
+			continue;
+		}
+
+		if (newNum < oldNum){
+			oldStates[newIndex] = NULL;
+			deferred[newIndex] = false;
+
+			bits = SV_MeasureDeltaEntity(cl, &sv.baselines[newNum], newState, true, true);
+
+			updates[numUpdates].index = newIndex;
+			updates[numUpdates].bits = bits;
+			updates[numUpdates].priority = SV_EntityUpdatePriority(cl, newState, true);
+			numUpdates++;
+
+			total += bits;
+
+			newIndex++;
+			continue;
+		}
+
+		if (newNum > oldNum){
+			MSG_Init(&msg, data, sizeof(data), false);
+
+			SV_WriteRemoveEntity(&msg, cl->protocol, oldNum);
+
+			budget -= MSG_GetWrittenBits(&msg);
+
+			oldIndex++;
+			continue;
+		}
+	}
+
+	// Everything fits, so any updates that were deferred are now up to date
+	if (total <= budget){
+		for (i = 0; i < to->numEntities; i++){
+			state = &svs.clientEntities[(to->firstEntity+i)%svs.numClientEntities];
+
+			cl->entityDeferred[state->number] = 0;
+		}
+
+		return;
+	}
+
+	cl->rateShapedFrames++;
+
+	// Send the most important updates that fit
+	qsort(updates, numUpdates, sizeof(entityUpdate_t), SV_SortEntityUpdates);
+
+	budget -= total;
+
+	for (i = 0; i < numUpdates; i++)
+		budget += updates[i].bits;
+
+	for (i = 0; i < numUpdates; i++){
+		if (updates[i].priority == UPDATE_PRIORITY_ALWAYS || updates[i].bits <= budget){
+			budget -= updates[i].bits;
+			continue;
+		}
+
+		deferred[updates[i].index] = true;
+	}
+
+	// Rewrite the frame with the deferred entities in the state the client
+	// already has
+	total = 0;
+
+	for (i = 0; i < to->numEntities; i++){
+		state = &svs.clientEntities[(to->firstEntity+i)%svs.numClientEntities];
+
+		if (!deferred[i])
+			cl->entityDeferred[state->number] = 0;
+		else {
+			if (!cl->entityDeferred[state->number])
+				cl->entityDeferred[state->number] = sv.frameNum;
+
+			cl->rateDeferred++;
+
+			// New entities are left out
+			if (!oldStates[i])
+				continue;
+
+			// Events are only valid for a single frame
+			*state = *oldStates[i];
+			state->event = 0;
+		}
+
+		if (total != i)
+			svs.clientEntities[(to->firstEntity+total)%svs.numClientEntities] = *state;
+
+		total++;
+	}
+
+	to->numEntities = total;
+
+	cl->rateDeferredTotal += cl->rateDeferred;
+}
+
 /*
  =================
  SV_WriteFrameToClient
@@ -315,10 +805,15 @@ void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
 	MSG_Write(msg, frame->areaBits, frame->areaBytes);
 
 	// Delta encode the player state
-	SV_WritePlayerStateToClient(oldFrame, frame, msg);
+	SV_WritePlayerStateToClient(oldFrame, frame, msg, cl->protocol);
+
+	// Defer the least important entity updates if the snapshot would go over
+	// the client's rate
+	if (cl->rateBudget)
+		SV_ShapeClientFrame(cl, oldFrame, frame, cl->rateBudget * 8 - MSG_GetWrittenBits(msg));
 
 	// Delta encode the entities
-	SV_EmitPacketEntities(oldFrame, frame, msg);
+	SV_EmitPacketEntities(cl, oldFrame, frame, msg);
 }
 
 
@@ -330,9 +825,65 @@ void SV_WriteFrameToClient (client_t *cl, msg_t *msg){
  =======================================================================
 */
 
-static byte		sv_fatPVS[65536/8];		// 32767 is MAX_MAP_LEAFS
+#define MAX_SNAPSHOT_SIZE			65536		// Large enough to never overflow
+
+typedef struct {
+	byte					sendable[MAX_EDICTS];	// Entities that may be sent to any client
+
+	// Entities linked into individual clusters, grouped by cluster
+	int						numClusters;
+	uint *					clusterBits;			// Clusters with at least one entity
+	int *					clusterFirstEntity;		// [numClusters + 1]
+	short *					clusterEntities;
+
+	// Entities that must be tested individually
+	int						numHeadNodeEntities;
+	short					headNodeEntities[MAX_EDICTS];
+
+	int						numBeamEntities;
+	short					beamEntities[MAX_EDICTS];
+} snapshotEntities_t;
+
+static snapshotEntities_t	sv_snapshotEntities;
 
 
+/*
+ =================
+ SV_MergeClusterPVS
+
+ ORs together the PVS rows of the given clusters.
+ The rows are padded to a multiple of 16 bytes, so they are merged 16 bytes at
+ a time.
+ =================
+*/
+static void SV_MergeClusterPVS (const int *clusters, int numClusters, byte *fatPVS){
+
+	const byte	*src;
+	int			rowSize;
+	int			i, j;
+
+	rowSize = CM_ClusterRowSize();
+
+	Mem_Copy(fatPVS, CM_ClusterPVS(clusters[0]), rowSize);
+
+	// Or in all the other cluster bits
+	for (i = 1; i < numClusters; i++){
+		src = CM_ClusterPVS(clusters[i]);
+
+#if defined SIMD_X86
+
+		for (j = 0; j < rowSize; j += 16)
+			_mm_storeu_si128((__m128i *)(fatPVS + j), _mm_or_si128(_mm_loadu_si128((const __m128i *)(fatPVS + j)), _mm_load_si128((const __m128i *)(src + j))));
+
+#else
+
+		for (j = 0; j < rowSize; j += 4)
+			*(uint *)(fatPVS + j) |= *(const uint *)(src + j);
+
+#endif
+	}
+}
+
 /*
  =================
  SV_FatPVS
@@ -341,11 +892,10 @@ static byte		sv_fatPVS[65536/8];		// 32767 is MAX_MAP_LEAFS
  PVS point
  =================
 */
-static void SV_FatPVS (vec3_t org){
+static void SV_FatPVS (vec3_t org, byte *fatPVS){
 
-	int		leafs[64];
-	int		i, j, count, longs;
-	byte	*src;
+	int		leafs[64], clusters[64];
+	int		i, j, count, numClusters;
 	vec3_t	mins, maxs;
 
 	for (i = 0; i < 3; i++){
@@ -357,51 +907,213 @@ static void SV_FatPVS (vec3_t org){
 	if (count < 1)
 		Com_Error(ERR_DROP, "SV_FatPVS: count < 1");
 
-	longs = (CM_NumClusters()+31)>>5;
+	// Convert leafs to clusters, skipping the ones we already have
+	numClusters = 0;
 
-	// Convert leafs to clusters
-	for (i = 0; i < count; i++)
+	for (i = 0; i < count; i++){
 		leafs[i] = CM_LeafCluster(leafs[i]);
 
-	Mem_Copy(sv_fatPVS, CM_ClusterPVS(leafs[0]), longs<<2);
-
-	// Or in all the other leaf bits
-	for (i = 1; i < count; i++){
-		for (j = 0; j < i; j++){
-			if (leafs[i] == leafs[j])
+		for (j = 0; j < numClusters; j++){
+			if (clusters[j] == leafs[i])
 				break;
 		}
 
-		if (j != i)
+		if (j != numClusters)
 			continue;		// Already have the cluster we want
 
-		src = CM_ClusterPVS(leafs[i]);
-		for (j = 0; j < longs; j++)
-			((long *)sv_fatPVS)[j] |= ((long *)src)[j];
+		clusters[numClusters++] = leafs[i];
+	}
+
+	SV_MergeClusterPVS(clusters, numClusters, fatPVS);
+}
+
+/*
+ =================
+ SV_BenchmarkFatPVS_f
+
+ Times fat PVS generation for every cluster of the loaded map, merging the row
+ of each cluster with the rows of the next few clusters
+ =================
+*/
+void SV_BenchmarkFatPVS_f (void){
+
+	static ALIGN_16(byte	fatPVS[MAX_MAP_LEAFS/8]);
+	int						clusters[4];
+	longlong				ticks;
+	double					seconds;
+	int						numClusters, iterations;
+	int						i, j, k;
+
+	if (Cmd_Argc() > 2){
+		Com_Printf("Usage: benchmarkFatPVS [iterations]\n");
+		return;
 	}
+
+	if (sv.state != SS_GAME){
+		Com_Printf("No map loaded\n");
+		return;
+	}
+
+	if (Cmd_Argc() == 2)
+		iterations = ClampInt(Str_ToInteger(Cmd_Argv(1)), 1, 1000);
+	else
+		iterations = 10;
+
+	numClusters = CM_NumClusters();
+
+	// Make sure all the rows are decompressed if they are cached
+	for (i = 0; i < numClusters; i++)
+		CM_ClusterPVS(i);
+
+	ticks = Sys_ClockTicks();
+
+	for (i = 0; i < iterations; i++){
+		for (j = 0; j < numClusters; j++){
+			for (k = 0; k < 4; k++)
+				clusters[k] = (j + k) % numClusters;
+
+			SV_MergeClusterPVS(clusters, 4, fatPVS);
+		}
+	}
+
+	seconds = (double)(Sys_ClockTicks() - ticks) / Sys_ClockTicksPerSecond();
+
+	Com_Printf("%i clusters, %i bytes per row, %i iterations\n", numClusters, CM_ClusterRowSize(), iterations);
+	Com_Printf("%.2f msec total, %.3f usec per fat PVS\n", seconds * 1000.0, seconds * 1000000.0 / (iterations * numClusters));
 }
 
 /*
  =================
- SV_BuildClientFrame
+ SV_PrepareSnapshotEntities
 
- Decides which entities are going to be visible to the client
+ Finds the entities that may be sent to any client and groups them by the
+ clusters they touch, so each client can test whole clusters against its
+ fat PVS instead of testing every entity.
+ Must be called from the main thread once per frame, before any client frame
+ is culled.
  =================
 */
-void SV_BuildClientFrame (client_t *cl){
+void SV_PrepareSnapshotEntities (void){
+
+	snapshotEntities_t	*entities = &sv_snapshotEntities;
+	edict_t				*edict;
+	int					*count;
+	int					i, e, l, numClusters, total;
+
+	numClusters = CM_NumClusters();
+
+	entities->numClusters = numClusters;
+	entities->clusterBits = (uint *)Mem_ClearedFrameAlloc(((numClusters + 31) >> 5) * sizeof(uint));
+	entities->clusterFirstEntity = (int *)Mem_ClearedFrameAlloc((numClusters + 1) * sizeof(int));
+
+	entities->numHeadNodeEntities = 0;
+	entities->numBeamEntities = 0;
 
-	int				i, e;
-	vec3_t			org, delta;
-	edict_t			*edict, *clEdict;
-	clientFrame_t	*frame;
-	entity_state_t	*state;
-	int				l, leafNum, area, cluster;
-	byte			*phs, *bitVector;
+	count = entities->clusterFirstEntity;
+
+	// Find the sendable entities and count the cluster references
+	for (e = 0; e < ge->num_edicts; e++){
+		edict = EDICT_NUM(e);
+
+		entities->sendable[e] = 0;
+
+		if (!e)
+			continue;
+
+		// Ignore ents without visible models
+		if (edict->svflags & SVF_NOCLIENT)
+			continue;
+
+		// Ignore ents without visible models unless they have an effect
+		if (!edict->s.modelindex && !edict->s.effects && !edict->s.sound && !edict->s.event)
+			continue;
+
+		entities->sendable[e] = 1;
+
+		// Beams just check one point for PHS
+		if (edict->s.renderfx & RF_BEAM){
+			entities->beamEntities[entities->numBeamEntities++] = e;
+			continue;
+		}
+
+		// Too many leafs for individual check, go by headnode
+		if (edict->num_clusters == -1){
+			entities->headNodeEntities[entities->numHeadNodeEntities++] = e;
+			continue;
+		}
+
+		for (i = 0; i < edict->num_clusters; i++){
+			l = edict->clusternums[i];
+			if (l < 0 || l >= numClusters)
+				continue;
+
+			count[l + 1]++;
+		}
+	}
+
+	// Turn the counts into offsets
+	for (l = 0, total = 0; l < numClusters; l++){
+		if (count[l + 1])
+			entities->clusterBits[l >> 5] |= (1U << (l & 31));
+
+		total += count[l + 1];
+		count[l + 1] = total;
+	}
+
+	entities->clusterEntities = (short *)Mem_FrameAlloc((total + 1) * sizeof(short));
+
+	// Group the entities by cluster, in edict order.
+	// When done, every offset has been moved to the start of the next cluster,
+	// so the array is shifted back to the right place.
+	for (e = 1; e < ge->num_edicts; e++){
+		if (!entities->sendable[e])
+			continue;
+
+		edict = EDICT_NUM(e);
+
+		if ((edict->s.renderfx & RF_BEAM) || edict->num_clusters == -1)
+			continue;
+
+		for (i = 0; i < edict->num_clusters; i++){
+			l = edict->clusternums[i];
+			if (l < 0 || l >= numClusters)
+				continue;
+
+			entities->clusterEntities[count[l]++] = e;
+		}
+	}
+
+	for (l = numClusters; l > 0; l--)
+		count[l] = count[l - 1];
+
+	count[0] = 0;
+}
+
+/*
+ =================
+ SV_SetupClientFrame
+
+ Sets up the frame and the visibility data for the client.
+ Must be called from the main thread, because the collision code is not
+ thread-safe.
+ =================
+*/
+void SV_SetupClientFrame (client_t *cl){
+
+	clientSnapshot_t	*snapshot = &cl->snapshot;
+	edict_t				*clEdict;
+	clientFrame_t		*frame;
+	vec3_t				org;
+	int					leafNum, cluster;
+
+	snapshot->inGame = false;
 
 	clEdict = cl->edict;
 	if (!clEdict->client)
 		return;		// Not in game yet
 
+	snapshot->inGame = true;
+
 	// This is the frame we are creating
 	frame = &cl->frames[sv.frameNum & UPDATE_MASK];
 
@@ -413,79 +1125,173 @@ void SV_BuildClientFrame (client_t *cl){
 	org[2] = clEdict->client->ps.pmove.origin[2] * 0.125 + clEdict->client->ps.viewoffset[2];
 
 	leafNum = CM_PointInLeaf(org, 0);
-	area = CM_LeafArea(leafNum);
 	cluster = CM_LeafCluster(leafNum);
 
+	VectorCopy(org, snapshot->origin);
+	snapshot->area = CM_LeafArea(leafNum);
+
 	// Calculate the visible areas
-	frame->areaBytes = CM_WriteAreaBits(frame->areaBits, area);
+	frame->areaBytes = CM_WriteAreaBits(frame->areaBits, snapshot->area);
 
 	// Grab the current player_state_t
 	frame->ps = clEdict->client->ps;
 
-	SV_FatPVS(org);
-	phs = CM_ClusterPHS(cluster);
+	// The rows are read by the culling jobs later in the frame. Maps without
+	// visibility data have empty rows, so leave some cleared space for them.
+	snapshot->fatPVS = (byte *)Mem_ClearedFrameAlloc(Max(CM_ClusterRowSize(), 16));
+	snapshot->phs = (byte *)Mem_ClearedFrameAlloc(Max(CM_ClusterRowSize(), 16));
 
-	// Build up the list of visible entities
-	frame->numEntities = 0;
-	frame->firstEntity = svs.nextClientEntities;
+	SV_FatPVS(org, snapshot->fatPVS);
+	Mem_Copy(snapshot->phs, CM_ClusterPHS(cluster), (CM_NumClusters() + 7) >> 3);
 
-	for (e = 1; e < ge->num_edicts; e++){
-		edict = EDICT_NUM(e);
+	snapshot->numEntities = 0;
+}
 
-		// Ignore ents without visible models
-		if (edict->svflags & SVF_NOCLIENT)
-			continue;
+/*
+ =================
+ SV_CullClientFrame
 
-		// Ignore ents without visible models unless they have an effect
-		if (!edict->s.modelindex && !edict->s.effects && !edict->s.sound && !edict->s.event)
-			continue;
+ Decides which entities are going to be visible to the client.
+ The clusters that have entities are tested against the client's fat PVS a
+ word at a time, so the cost depends on the number of potentially visible
+ entities rather than the total number of entities.
+ Only writes to the client's snapshot, so it can be called from any thread.
+ =================
+*/
+void SV_CullClientFrame (client_t *cl){
+
+	snapshotEntities_t	*entities = &sv_snapshotEntities;
+	clientSnapshot_t	*snapshot = &cl->snapshot;
+	uint				visible[MAX_EDICTS >> 5];
+	uint				bits, *fatPVS;
+	vec3_t				delta;
+	edict_t				*edict;
+	int					i, e, l, self, words;
+	int					cluster, first, last;
+
+	if (!snapshot->inGame)
+		return;
 
-		// Ignore if not touching a PV leaf
-		if (edict != clEdict){
-			// Check area
-			if (!CM_AreasAreConnected(area, edict->areanum)){
-				// Doors can legally straddle two areas, so we may need 
-				// to check another one
-				if (!edict->areanum2 || !CM_AreasAreConnected(area, edict->areanum2))
-					continue;		// Blocked by a door
-			}
+	snapshot->numEntities = 0;
+
+	Mem_Fill(visible, 0, sizeof(visible));
+
+	// The client's own entity is always visible
+	self = NUM_FOR_EDICT(cl->edict);
+
+	if (self < ge->num_edicts && entities->sendable[self])
+		visible[self >> 5] |= (1U << (self & 31));
 
-			// Beams just check one point for PHS
-			if (edict->s.renderfx & RF_BEAM){
-				l = edict->clusternums[0];
-				if (!(phs[l >> 3] & (1 << (l&7))))
-					continue;
+	// Add the entities in all the potentially visible clusters
+	fatPVS = (uint *)snapshot->fatPVS;
+
+	words = (entities->numClusters + 31) >> 5;
+
+	for (i = 0; i < words; i++){
+		bits = fatPVS[i] & entities->clusterBits[i];
+
+		for (cluster = i << 5; bits; cluster++, bits >>= 1){
+			if (!(bits & 1))
+				continue;
+
+			first = entities->clusterFirstEntity[cluster];
+			last = entities->clusterFirstEntity[cluster + 1];
+
+			for ( ; first < last; first++){
+				e = entities->clusterEntities[first];
+
+				visible[e >> 5] |= (1U << (e & 31));
 			}
-			else {
-				// FIXME: if an entity has a model and a sound, but
-				// isn't in the PVS, only the PHS, clear the model
-				bitVector = sv_fatPVS;
+		}
+	}
 
-				if (edict->num_clusters == -1){
-					// Too many leafs for individual check, go by headnode
-					if (!CM_HeadNodeVisible(edict->headnode, bitVector))
-						continue;
-				}
-				else {
-					// Check individual leafs
-					for (i = 0; i < edict->num_clusters; i++){
-						l = edict->clusternums[i];
-						if (bitVector[l >> 3] & (1 << (l&7)))
-							break;
-					}
-
-					if (i == edict->num_clusters)
-						continue;		// Not visible
+	// Add the entities that are too big for individual cluster checks
+	for (i = 0; i < entities->numHeadNodeEntities; i++){
+		e = entities->headNodeEntities[i];
+
+		if (visible[e >> 5] & (1U << (e & 31)))
+			continue;
+
+		edict = EDICT_NUM(e);
+
+		if (CM_HeadNodeVisible(edict->headnode, snapshot->fatPVS))
+			visible[e >> 5] |= (1U << (e & 31));
+	}
+
+	// Add the beams, which just check one point for PHS
+	for (i = 0; i < entities->numBeamEntities; i++){
+		e = entities->beamEntities[i];
+
+		edict = EDICT_NUM(e);
+
+		l = edict->clusternums[0];
+		if (snapshot->phs[l >> 3] & (1 << (l&7)))
+			visible[e >> 5] |= (1U << (e & 31));
+	}
+
+	// Build up the list of visible entities, in edict order
+	for (i = 0; i < (MAX_EDICTS >> 5); i++){
+		bits = visible[i];
+
+		for (e = i << 5; bits; e++, bits >>= 1){
+			if (!(bits & 1))
+				continue;
+
+			if (e != self){
+				edict = EDICT_NUM(e);
+
+				// Check area
+				if (!CM_AreasAreConnected(snapshot->area, edict->areanum)){
+					// Doors can legally straddle two areas, so we may need 
+					// to check another one
+					if (!edict->areanum2 || !CM_AreasAreConnected(snapshot->area, edict->areanum2))
+						continue;		// Blocked by a door
 				}
 
-				if (!edict->s.modelindex){
+				// FIXME: if an entity has a model and a sound, but
+				// isn't in the PVS, only the PHS, clear the model
+				if (!(edict->s.renderfx & RF_BEAM) && !edict->s.modelindex){
 					// Don't send sounds if they will be attenuated away
-					VectorSubtract(org, edict->s.origin, delta);
+					VectorSubtract(snapshot->origin, edict->s.origin, delta);
 					if (VectorLength(delta) > 400)
 						continue;
 				}
 			}
+
+			snapshot->entities[snapshot->numEntities++] = e;
 		}
+	}
+}
+
+/*
+ =================
+ SV_CopyClientFrame
+
+ Copies the visible entities to the circular clientEntities array.
+ Must be called from the main thread, in client order, so every client gets
+ the same slice of the array it would get if the frames were built serially.
+ =================
+*/
+void SV_CopyClientFrame (client_t *cl){
+
+	clientSnapshot_t	*snapshot = &cl->snapshot;
+	clientFrame_t		*frame;
+	entity_state_t		*state;
+	edict_t				*edict;
+	int					i, e;
+
+	if (!snapshot->inGame)
+		return;
+
+	// This is the frame we are creating
+	frame = &cl->frames[sv.frameNum & UPDATE_MASK];
+
+	frame->numEntities = 0;
+	frame->firstEntity = svs.nextClientEntities;
+
+	for (i = 0; i < snapshot->numEntities; i++){
+		e = snapshot->entities[i];
+		edict = EDICT_NUM(e);
 
 		// Add it to the circular clientEntities array
 		if (edict->s.number != e){
@@ -505,6 +1311,54 @@ void SV_BuildClientFrame (client_t *cl){
 	}
 }
 
+/*
+ =================
+ SV_EncodeClientFrame
+
+ Delta encodes the frame into the client's snapshot.
+ Only writes to state owned by the given client: its snapshot, encode cache,
+ rate shaping counters, and its own slice of the shared clientEntities array,
+ which SV_ShapeClientFrame rewrites to defer updates. The slices of other
+ clients, the baselines, and the rest of the server state are only read.
+ So once all the frames have been copied, different clients can be encoded in
+ parallel, but each client must be encoded by a single thread.
+ The encoded frame is allocated from the frame arena of the calling thread and
+ must be sent before the end of the frame.
+ The frame is written to a buffer that is large enough to never overflow, so
+ no warnings will be printed here, and the caller must check the overflowed
+ flag instead.
+ =================
+*/
+void SV_EncodeClientFrame (client_t *cl){
+
+	clientSnapshot_t	*snapshot = &cl->snapshot;
+	byte				data[MAX_SNAPSHOT_SIZE];
+	msg_t				msg;
+
+	snapshot->overflowed = false;
+	snapshot->size = 0;
+	snapshot->data = NULL;
+
+	snapshot->cacheHits = 0;
+	snapshot->cacheMisses = 0;
+
+	MSG_Init(&msg, data, sizeof(data), true);
+
+	SV_WriteFrameToClient(cl, &msg);
+
+	// Only clients that accept fragmented messages can receive snapshots
+	// larger than a packet
+	if (msg.curSize > (cl->netChan.fragments ? MAX_FRAGMENTED_MSGLEN : MAX_MSGLEN)){
+		snapshot->overflowed = true;
+		return;
+	}
+
+	snapshot->data = (byte *)Mem_FrameAlloc(msg.curSize);
+
+	Mem_Copy(snapshot->data, msg.data, msg.curSize);
+	snapshot->size = msg.curSize;
+}
+
 /*
  =================
  SV_RecordDemoMessage
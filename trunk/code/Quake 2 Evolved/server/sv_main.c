@@ -39,6 +39,8 @@ serverStatic_t				svs;						// Persistant server info
 client_t *					sv_client;					// Current client
 edict_t *					sv_player;					// Current player
 
+serverStats_t				sv_stats;
+
 cvar_t *					sv_maxClients;
 cvar_t *					sv_hostName;
 cvar_t *					sv_nextServer;
@@ -57,6 +59,15 @@ cvar_t *					sv_allowDownload;
 cvar_t *					sv_publicServer;
 cvar_t *					sv_rconPassword;
 cvar_t *					sv_loadGame;
+cvar_t *					sv_parallelSnapshots;
+cvar_t *					sv_snapshotCache;
+cvar_t *					sv_downloadWindow;
+cvar_t *					sv_rateControl;
+cvar_t *					sv_rateBurst;
+cvar_t *					sv_rateDistance;
+cvar_t *					sv_areaGrid;
+cvar_t *					sv_allowLegacyProtocol;
+cvar_t *					sv_showStats;
 
 
 /*
@@ -101,13 +112,30 @@ void SV_DropClient (client_t *client){
 		ge->ClientDisconnect(client->edict);
 
 	// Close file download
+	SV_CloseDownload(client);
+
+	client->state = CS_ZOMBIE;		// Become free in a few seconds
+	client->name[0] = 0;
+}
+
+/*
+ ==================
+ SV_CloseDownload
+ ==================
+*/
+void SV_CloseDownload (client_t *client){
+
 	if (client->downloadFile){
 		FS_CloseFile(client->downloadFile);
 		client->downloadFile = 0;
 	}
 
-	client->state = CS_ZOMBIE;		// Become free in a few seconds
-	client->name[0] = 0;
+	if (client->downloadWindow){
+		Mem_Free(client->downloadWindow);
+		client->downloadWindow = NULL;
+	}
+
+	client->downloadWindowed = false;
 }
 
 /*
@@ -221,7 +249,7 @@ static void SV_InfoPacket (){
 
 	protocol = Str_ToInteger(Cmd_Argv(1));
 
-	if (protocol != PROTOCOL_VERSION)
+	if (protocol != PROTOCOL_VERSION && (protocol != PROTOCOL_VERSION_LEGACY || !sv_allowLegacyProtocol->integerValue))
 		Str_SPrintf(string, sizeof(string), "%s: wrong version\n", sv_hostName->value, sizeof(string));
 	else {
 		for (i = 0; i < sv_maxClients->integerValue; i++){
@@ -309,10 +337,12 @@ static void SV_ConnectPacket (){
 	edict_t		*entity;
 	char		userInfo[MAX_INFO_STRING];
 	int			protocol, challenge, channelPort;
+	int			compression = NC_NONE;
+	bool		fragments = false;
 	int			i;
 
 	protocol = Str_ToInteger(Cmd_Argv(1));
-	if (protocol != PROTOCOL_VERSION){
+	if (protocol != PROTOCOL_VERSION && (protocol != PROTOCOL_VERSION_LEGACY || !sv_allowLegacyProtocol->integerValue)){
 		Com_DPrintf("Rejected connect from version %i\n", protocol);
 
 		NET_OutOfBandPrintf(NS_SERVER, net_from, "print\nServer uses protocol version %i\n", PROTOCOL_VERSION);
@@ -325,6 +355,18 @@ static void SV_ConnectPacket (){
 
 	Str_Copy(userInfo, Cmd_Argv(4), sizeof(userInfo));
 
+	// Newer clients can request packet compression, which is only used if
+	// both sides use the same byte frequency table. Local clients never use
+	// it.
+	if (Cmd_Argc() > 6 && !NET_IsLocalAddress(net_from) && CVar_GetVariableInteger("net_compression")){
+		if (Str_ToInteger(Cmd_Argv(6)) == (int)NetComp_TableChecksum())
+			compression = ClampInt(Str_ToInteger(Cmd_Argv(5)), NC_NONE, NC_ADAPTIVE);
+	}
+
+	// Newer clients can also receive messages larger than a packet
+	if (Cmd_Argc() > 7)
+		fragments = (Str_ToInteger(Cmd_Argv(7)) != 0);
+
 	// Force the IP key/value pair so the game can filter based on IP
 	Info_SetValueForKey(userInfo, "ip", (char *)NET_AddressToString(net_from));
 
@@ -398,12 +440,15 @@ static void SV_ConnectPacket (){
 	// Build a new connection.
 	// Accept the new client.
 	// This is the only place a client_t is ever initialized.
+	SV_CloseDownload(newClient);
+
 	Mem_Fill(newClient, 0, sizeof(client_t));
 
 	i = newClient - svs.clients;
 	entity = EDICT_NUM(i+1);
 	newClient->edict = entity;
 	newClient->challenge = challenge;		// Save challenge for checksumming
+	newClient->protocol = protocol;
 
 	// Get the game a chance to reject this connection or modify the
 	// user info
@@ -421,7 +466,9 @@ static void SV_ConnectPacket (){
 	Str_Copy(newClient->userInfo, userInfo, sizeof(newClient->userInfo));
 	SV_UserInfoChanged(newClient);
 
-	NetChan_Setup(&newClient->netChan, NS_SERVER, net_from, channelPort);
+	NetChan_Setup(&newClient->netChan, NS_SERVER, net_from, channelPort, fragments);
+
+	newClient->netChan.compression = (netCompression_t)compression;
 
 	MSG_Init(&newClient->datagram, newClient->datagramBuffer, sizeof(newClient->datagramBuffer), true);
 
@@ -430,7 +477,7 @@ static void SV_ConnectPacket (){
 	newClient->state = CS_CONNECTED;
 
 	// Send the connect packet to the client
-	NET_OutOfBandPrintf(NS_SERVER, net_from, "client_connect");
+	NET_OutOfBandPrintf(NS_SERVER, net_from, "client_connect %i %i", compression, fragments);
 }
 
 /*
@@ -858,6 +905,9 @@ static void SV_RunGameFrame (){
 	sv.frameNum++;
 	sv.time = sv.frameNum * 100;
 
+	// Cached traces only live for a single frame
+	CM_ClearTraceCache();
+
 	ge->RunFrame();
 
 	// Never get more than one tic behind
@@ -984,6 +1034,13 @@ void SV_Frame (int msec){
 	// frame
 	SV_SendClientMessages();
 
+	// Development tool
+	if (sv_showStats->integerValue)
+		Com_Printf("snapshots: %i, setup: %i, build: %i, copy: %i, encode: %i, send: %i (usec)\n", sv_stats.snapshots, sv_stats.timeSetup, sv_stats.timeBuild, sv_stats.timeCopy, sv_stats.timeEncode, sv_stats.timeTransmit);
+
+	// Clear for next frame
+	Mem_Fill(&sv_stats, 0, sizeof(serverStats_t));
+
 	// Save the entire world state if recording a serverdemo
 	SV_RecordDemoMessage();
 
@@ -1050,6 +1107,15 @@ void SV_Init (){
 	sv_reconnectLimit = CVar_Register("sv_reconnectLimit", "3.0", CVAR_FLOAT, 0, "Time in seconds before a client is allowed to reconnect", 1.0f, 300.0f);
 	sv_rconPassword = CVar_Register("rconPassword", "", CVAR_STRING, 0, "Remote console password", 0, 0);
 	sv_loadGame = CVar_Register("sv_loadGame", "0", CVAR_INTEGER, 0, "Loads the desired game DLL (0 = extended, 1 = original)", 0, 1);
+	sv_parallelSnapshots = CVar_Register("sv_parallelSnapshots", "1", CVAR_BOOL, 0, "Build and encode client snapshots on the job threads", 0, 0);
+	sv_snapshotCache = CVar_Register("sv_snapshotCache", "1", CVAR_BOOL, 0, "Share encoded entity deltas between clients", 0, 0);
+	sv_downloadWindow = CVar_Register("sv_downloadWindow", "32", CVAR_INTEGER, 0, "Number of download blocks sent before waiting for acknowledgements", 1, MAX_DOWNLOAD_WINDOW);
+	sv_rateControl = CVar_Register("sv_rateControl", "1", CVAR_BOOL, 0, "Shape snapshots to the client rate instead of dropping them", 0, 0);
+	sv_rateBurst = CVar_Register("sv_rateBurst", "250", CVAR_INTEGER, 0, "Milliseconds of client rate that can be sent in a single burst", 100, 2000);
+	sv_rateDistance = CVar_Register("sv_rateDistance", "512", CVAR_FLOAT, 0, "Distance at which entity update priority is halved", 64.0f, 8192.0f);
+	sv_areaGrid = CVar_Register("sv_areaGrid", "0", CVAR_BOOL, 0, "Link entities into a loose grid instead of the areanode tree (takes effect on map load)", 0, 0);
+	sv_allowLegacyProtocol = CVar_Register("sv_allowLegacyProtocol", "1", CVAR_BOOL, 0, "Accept clients using the legacy byte-aligned protocol", 0, 0);
+	sv_showStats = CVar_Register("sv_showStats", "0", CVAR_BOOL, CVAR_CHEAT, "Show server frame statistics", 0, 0);
 
 	// Add commands
 	Cmd_AddCommand("loadgame", SV_LoadGame_f, NULL, NULL);
@@ -1066,6 +1132,11 @@ void SV_Init (){
 	Cmd_AddCommand("serverstoprecord", SV_ServerStopRecord_f, NULL, NULL);
 	Cmd_AddCommand("killserver", SV_KillServer_f, "Kills the server", NULL);
 	Cmd_AddCommand("sv", SV_ServerCommand_f, NULL, NULL);
+	Cmd_AddCommand("benchmarkFatPVS", SV_BenchmarkFatPVS_f, "Benchmarks fat PVS generation for all clusters", NULL);
+	Cmd_AddCommand("benchmarkAreaEdicts", SV_BenchmarkAreaEdicts_f, "Benchmarks linking and querying moving entities", NULL);
+	Cmd_AddCommand("snapshotHistogram", SV_SnapshotHistogram_f, "Shows a histogram of encoded snapshot sizes", NULL);
+	Cmd_AddCommand("compressionStats", SV_CompressionStats_f, "Shows packet compression statistics for every client", NULL);
+	Cmd_AddCommand("rateStatus", SV_RateStatus_f, "Shows rate control statistics for every client", NULL);
 
 	if (com_dedicated->integerValue)
 		Cmd_AddCommand("say", SV_ConSay_f, NULL, NULL);
@@ -1112,8 +1183,7 @@ void SV_Shutdown (const char *message, bool reconnect){
 	if (svs.clients){
 		for (i = 0, client = svs.clients; i < sv_maxClients->integerValue; i++, client++){
 			// Close download file
-			if (client->downloadFile)
-				FS_CloseFile(client->downloadFile);
+			SV_CloseDownload(client);
 		}
 
 		Mem_Free(svs.clients);
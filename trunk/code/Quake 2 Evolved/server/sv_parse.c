@@ -81,7 +81,7 @@ static void SV_NewCommand (){
 
 	// Send the server data
 	MSG_WriteByte(&sv_client->netChan.message, SVC_SERVERDATA);
-	MSG_WriteLong(&sv_client->netChan.message, PROTOCOL_VERSION);
+	MSG_WriteLong(&sv_client->netChan.message, sv_client->protocol);
 	MSG_WriteLong(&sv_client->netChan.message, svs.spawnCount);
 	MSG_WriteByte(&sv_client->netChan.message, sv.attractLoop);
 	MSG_WriteString(&sv_client->netChan.message, CVar_GetVariableString("fs_game"));
@@ -131,8 +131,9 @@ static void SV_ConfigStringsCommand (){
 	else if (start > MAX_CONFIGSTRINGS)
 		start = MAX_CONFIGSTRINGS;
 
-	// Write a packet full of data
-	while (sv_client->netChan.message.curSize < MAX_MSGLEN/2 && start < MAX_CONFIGSTRINGS){
+	// Write a packet full of data. If the message can be fragmented, most of
+	// the configstrings will go out at once.
+	while (sv_client->netChan.message.curSize < sv_client->netChan.message.maxSize/2 && start < MAX_CONFIGSTRINGS){
 		if (sv.configStrings[start][0]){
 			MSG_WriteByte(&sv_client->netChan.message, SVC_CONFIGSTRING);
 			MSG_WriteShort(&sv_client->netChan.message, start);
@@ -185,11 +186,15 @@ static void SV_BaseLinesCommand (){
 	Mem_Fill(&nullState, 0, sizeof(nullState));
 
 	// Write a packet full of data
-	while (sv_client->netChan.message.curSize < MAX_MSGLEN/2 && start < MAX_EDICTS){
+	while (sv_client->netChan.message.curSize < sv_client->netChan.message.maxSize/2 && start < MAX_EDICTS){
 		base = &sv.baselines[start];
 		if (base->modelindex || base->sound || base->effects){
 			MSG_WriteByte(&sv_client->netChan.message, SVC_SPAWNBASELINE);
-			MSG_WriteDeltaEntity(&sv_client->netChan.message, &nullState, base, true, true);
+
+			if (sv_client->protocol == PROTOCOL_VERSION_LEGACY)
+				MSG_WriteDeltaEntity(&sv_client->netChan.message, &nullState, base, true, true);
+			else
+				MSG_WritePackedDeltaEntity(&sv_client->netChan.message, &nullState, base, true, true);
 		}
 		start++;
 	}
@@ -261,6 +266,41 @@ static void SV_DisconnectCommand (){
 	SV_DropClient(sv_client);	
 }
 
+/*
+ ==================
+ SV_AcknowledgeDownload
+
+ The client acknowledged all the blocks before the given one
+ ==================
+*/
+static void SV_AcknowledgeDownload (int block){
+
+	if (block > sv_client->downloadAckBlock && block <= sv_client->downloadReadBlock){
+		sv_client->downloadAckBlock = block;
+		sv_client->downloadDuplicateAcks = 0;
+		sv_client->downloadAckTime = svs.realTime;
+		sv_client->downloadRecovering = false;
+
+		if (sv_client->downloadSendBlock < block)
+			sv_client->downloadSendBlock = block;
+
+		// Finished download
+		if (block == sv_client->downloadBlocks){
+			SV_CloseDownload(sv_client);
+			return;
+		}
+	}
+	else if (block == sv_client->downloadAckBlock && sv_client->downloadSendBlock > block && !sv_client->downloadRecovering){
+		// The client keeps asking for the same block while receiving later
+		// ones, so it was lost. Go back and resend everything from there.
+		if (++sv_client->downloadDuplicateAcks == 3){
+			sv_client->downloadSendBlock = block;
+			sv_client->downloadDuplicateAcks = 0;
+			sv_client->downloadRecovering = true;
+		}
+	}
+}
+
 /*
  ==================
  SV_NextDownloadCommand
@@ -274,6 +314,13 @@ static void SV_NextDownloadCommand (){
 	if (!sv_client->downloadFile)
 		return;
 
+	if (sv_client->downloadWindowed){
+		if (Cmd_Argc() > 1)
+			SV_AcknowledgeDownload(Str_ToInteger(Cmd_Argv(1)));
+
+		return;
+	}
+
 	length = sv_client->downloadSize - sv_client->downloadOffset;
 	if (length > sizeof(data))
 		length = sizeof(data);
@@ -294,6 +341,22 @@ static void SV_NextDownloadCommand (){
 	}
 }
 
+/*
+ ==================
+ SV_RefuseDownload
+ ==================
+*/
+static void SV_RefuseDownload (){
+
+	MSG_WriteByte(&sv_client->netChan.message, SVC_DOWNLOAD);
+	MSG_WriteShort(&sv_client->netChan.message, -1);
+	MSG_WriteByte(&sv_client->netChan.message, 0);
+
+	// Windowed downloads always send a block number
+	if (sv_client->netChan.fragments)
+		MSG_WriteLong(&sv_client->netChan.message, 0);
+}
+
 /*
  ==================
  SV_DownloadCommand
@@ -309,41 +372,50 @@ static void SV_DownloadCommand (){
 	if (Cmd_Argc() > 2)
 		offset = Str_ToInteger(Cmd_Argv(2));	// Downloaded offset
 
-	if (Str_FindChar(name, '..') || !Str_FindChar(name, '/') || name[0] == '.' || name[0] == '/' || !sv_allowDownload->integerValue){
-		MSG_WriteByte(&sv_client->netChan.message, SVC_DOWNLOAD);
-		MSG_WriteShort(&sv_client->netChan.message, -1);
-		MSG_WriteByte(&sv_client->netChan.message, 0);
+	if (Str_FindText(name, "..", false) || !Str_FindChar(name, '/') || name[0] == '.' || name[0] == '/' || !sv_allowDownload->integerValue){
+		SV_RefuseDownload();
 		return;
 	}
 
-	if (sv_client->downloadFile){
-		FS_CloseFile(sv_client->downloadFile);
-		sv_client->downloadFile = 0;
-	}
+	SV_CloseDownload(sv_client);
 
 	sv_client->downloadSize = FS_OpenFile(name, FS_READ, &sv_client->downloadFile);
 	
 	if (!sv_client->downloadFile || !sv_client->downloadSize){
 		Com_DPrintf("Couldn't download %s to %s\n", name, sv_client->name);
 
-		if (sv_client->downloadFile){
-			FS_CloseFile(sv_client->downloadFile);
-			sv_client->downloadFile = 0;
-		}
+		SV_CloseDownload(sv_client);
 
-		MSG_WriteByte(&sv_client->netChan.message, SVC_DOWNLOAD);
-		MSG_WriteShort(&sv_client->netChan.message, -1);
-		MSG_WriteByte(&sv_client->netChan.message, 0);
+		SV_RefuseDownload();
 		return;
 	}
 
-	sv_client->downloadOffset = offset;
-	if (sv_client->downloadOffset > sv_client->downloadSize)
-		sv_client->downloadOffset = sv_client->downloadSize;
+	sv_client->downloadOffset = Clamp(offset, 0, sv_client->downloadSize);
 
-	SV_NextDownloadCommand();
+	// Skip the part the client already has
+	if (sv_client->downloadOffset)
+		FS_Seek(sv_client->downloadFile, sv_client->downloadOffset, FS_SEEK_SET);
 
 	Com_DPrintf("Downloading %s to %s...\n", name, sv_client->name);
+
+	// Clients that accept fragmented messages get several blocks at once
+	if (sv_client->netChan.fragments){
+		sv_client->downloadWindowed = true;
+		sv_client->downloadRecovering = false;
+		sv_client->downloadStart = sv_client->downloadOffset;
+		sv_client->downloadBlocks = Max((sv_client->downloadSize - sv_client->downloadOffset + DOWNLOAD_BLOCK_SIZE - 1) / DOWNLOAD_BLOCK_SIZE, 1);
+		sv_client->downloadReadBlock = 0;
+		sv_client->downloadSendBlock = 0;
+		sv_client->downloadAckBlock = 0;
+		sv_client->downloadDuplicateAcks = 0;
+		sv_client->downloadAckTime = svs.realTime;
+		sv_client->downloadWindow = (byte *)Mem_Alloc(MAX_DOWNLOAD_WINDOW * DOWNLOAD_BLOCK_SIZE, TAG_SERVER);
+
+		// The blocks go out with the next datagram
+		return;
+	}
+
+	SV_NextDownloadCommand();
 }
 
 /*
@@ -41,7 +41,7 @@ char sv_outputBuf[OUTPUTBUF_LENGTH];
  SV_FlushRedirect
  =================
 */
-void SV_FlushRedirect (redirect_t redirect, char *outputBuf){
+void SV_FlushRedirect (int redirect, const char *outputBuf){
 
 	if (redirect == RD_PACKET)
 		NET_OutOfBandPrintf(NS_SERVER, net_from, "print\n%s", outputBuf);
@@ -364,21 +364,185 @@ void SV_StartSound (vec3_t origin, edict_t *entity, int channel, int sound, floa
 */
 
 
+/*
+ =================
+ SV_RecordSnapshotSize
+ =================
+*/
+static void SV_RecordSnapshotSize (client_t *cl){
+
+	snapshotHistogram_t	*histogram;
+
+	if (cl->protocol == PROTOCOL_VERSION_LEGACY)
+		histogram = &svs.snapshotSizes[0];
+	else
+		histogram = &svs.snapshotSizes[1];
+
+	histogram->snapshots++;
+	histogram->totalBytes += cl->snapshot.size;
+
+	if (histogram->maxBytes < cl->snapshot.size)
+		histogram->maxBytes = cl->snapshot.size;
+
+	histogram->buckets[Min(cl->snapshot.size / SNAPSHOT_BUCKET_SIZE, SNAPSHOT_BUCKETS - 1)]++;
+}
+
+/*
+ =================
+ SV_PrintSnapshotHistogram
+ =================
+*/
+static void SV_PrintSnapshotHistogram (const snapshotHistogram_t *histogram, const char *name){
+
+	char	bar[41];
+	int		first, last, most;
+	int		i, length;
+
+	if (!histogram->snapshots){
+		Com_Printf("%s protocol: no snapshots\n", name);
+		return;
+	}
+
+	Com_Printf("%s protocol: %i snapshots, %i bytes average, %i bytes max\n", name, histogram->snapshots, (int)(histogram->totalBytes / histogram->snapshots), histogram->maxBytes);
+
+	// Only print the range of buckets that were used
+	first = SNAPSHOT_BUCKETS;
+	last = 0;
+	most = 0;
+
+	for (i = 0; i < SNAPSHOT_BUCKETS; i++){
+		if (!histogram->buckets[i])
+			continue;
+
+		if (first > i)
+			first = i;
+		if (last < i)
+			last = i;
+
+		if (most < histogram->buckets[i])
+			most = histogram->buckets[i];
+	}
+
+	for (i = first; i <= last; i++){
+		length = (int)((longlong)histogram->buckets[i] * (sizeof(bar) - 1) / most);
+
+		Mem_Fill(bar, '*', length);
+		bar[length] = 0;
+
+		if (i == SNAPSHOT_BUCKETS - 1)
+			Com_Printf("%5i+      : %7i %5.1f%% %s\n", i * SNAPSHOT_BUCKET_SIZE, histogram->buckets[i], histogram->buckets[i] * 100.0f / histogram->snapshots, bar);
+		else
+			Com_Printf("%5i - %-4i: %7i %5.1f%% %s\n", i * SNAPSHOT_BUCKET_SIZE, (i + 1) * SNAPSHOT_BUCKET_SIZE - 1, histogram->buckets[i], histogram->buckets[i] * 100.0f / histogram->snapshots, bar);
+	}
+}
+
+/*
+ =================
+ SV_SnapshotHistogram_f
+
+ Shows how many bytes the encoded snapshots took, for each protocol
+ =================
+*/
+void SV_SnapshotHistogram_f (void){
+
+	if (Cmd_Argc() > 2 || (Cmd_Argc() == 2 && Str_ICompare(Cmd_Argv(1), "reset"))){
+		Com_Printf("Usage: snapshotHistogram [reset]\n");
+		return;
+	}
+
+	if (Cmd_Argc() == 2){
+		Mem_Fill(svs.snapshotSizes, 0, sizeof(svs.snapshotSizes));
+		return;
+	}
+
+	SV_PrintSnapshotHistogram(&svs.snapshotSizes[1], "Bit-packed");
+	Com_Printf("\n");
+	SV_PrintSnapshotHistogram(&svs.snapshotSizes[0], "Legacy");
+}
+
+/*
+ =================
+ SV_WriteDownloadBlocks
+
+ Adds as many download blocks to the message as the client window and the
+ given number of bytes allow. Blocks that were not acknowledged in time are
+ sent again.
+ =================
+*/
+static void SV_WriteDownloadBlocks (client_t *cl, msg_t *msg, int budget){
+
+	byte	*block;
+	int		offset, length, percent;
+
+	if (!cl->downloadWindowed)
+		return;
+
+	// If the acknowledgements stopped, assume the rest of the window was lost
+	if (cl->downloadSendBlock > cl->downloadAckBlock && svs.realTime - cl->downloadAckTime > DOWNLOAD_TIMEOUT){
+		cl->downloadSendBlock = cl->downloadAckBlock;
+		cl->downloadAckTime = svs.realTime;
+	}
+
+	// Leave room for the reliable message and the packet header
+	budget = Min(budget, msg->maxSize - msg->curSize - cl->netChan.reliableLength - cl->netChan.message.curSize - PACKET_HEADER);
+
+	while (cl->downloadSendBlock < cl->downloadBlocks && cl->downloadSendBlock < cl->downloadAckBlock + sv_downloadWindow->integerValue){
+		block = cl->downloadWindow + (cl->downloadSendBlock % MAX_DOWNLOAD_WINDOW) * DOWNLOAD_BLOCK_SIZE;
+
+		offset = cl->downloadStart + cl->downloadSendBlock * DOWNLOAD_BLOCK_SIZE;
+		length = Min(cl->downloadSize - offset, DOWNLOAD_BLOCK_SIZE);
+
+		// Each block has an 8 byte header
+		if (length + 8 > budget)
+			break;
+
+		budget -= length + 8;
+
+		// Read the block if it was never sent before, otherwise it is still in
+		// the window
+		if (cl->downloadSendBlock == cl->downloadReadBlock){
+			FS_Read(cl->downloadFile, block, length);
+
+			cl->downloadReadBlock++;
+		}
+
+		percent = (int)((longlong)(offset + length) * 100 / cl->downloadSize);
+
+		MSG_WriteByte(msg, SVC_DOWNLOAD);
+		MSG_WriteShort(msg, length);
+		MSG_WriteByte(msg, percent);
+		MSG_WriteLong(msg, cl->downloadSendBlock);
+		MSG_Write(msg, block, length);
+
+		cl->downloadSendBlock++;
+	}
+}
+
 /*
  =================
  SV_SendClientDatagram
+
+ Sends the client's encoded snapshot along with the accumulated datagram
  =================
 */
 static void SV_SendClientDatagram (client_t *cl){
 
-	byte	data[MAX_MSGLEN];
+	byte	data[MAX_FRAGMENTED_MSGLEN];
 	msg_t	msg;
 
-	MSG_Init(&msg, data, sizeof(data), true);
+	if (cl->netChan.fragments)
+		MSG_Init(&msg, data, sizeof(data), true);
+	else
+		MSG_Init(&msg, data, MAX_MSGLEN, true);
 
 	// Send over all the relevant entity_state_t and the player_state_t
-	SV_BuildClientFrame(cl);
-	SV_WriteFrameToClient(cl, &msg);
+	if (cl->snapshot.overflowed)
+		msg.overflowed = true;
+	else {
+		MSG_Write(&msg, cl->snapshot.data, cl->snapshot.size);
+
+		SV_RecordSnapshotSize(cl);
+	}
 
 	// Copy the accumulated multicast datagram for this client out to 
 	// the message.
@@ -391,17 +555,164 @@ static void SV_SendClientDatagram (client_t *cl){
 
 	MSG_Clear(&cl->datagram);
 
+	// Fill what is left of the budget with download blocks
+	if (!msg.overflowed){
+		if (cl->rateBudget)
+			SV_WriteDownloadBlocks(cl, &msg, cl->rateBudget - cl->snapshot.size);
+		else
+			SV_WriteDownloadBlocks(cl, &msg, msg.maxSize);
+	}
+
 	if (msg.overflowed){
 		// Must have room left for the packet header
 		Com_Printf(S_COLOR_YELLOW "WARNING: msg overflowed for %s\n", cl->name);
 		MSG_Clear(&msg);
 	}
 
-	// Send the datagram
-	NetChan_Transmit(&cl->netChan, msg.data, msg.curSize);
+	// Send the datagram and record the size that actually went out (after
+	// compression) for rate estimation
+	cl->messageSize[sv.frameNum % RATE_MESSAGES] = NetChan_Transmit(&cl->netChan, msg.data, msg.curSize);
 
-	// Record the size for rate estimation
-	cl->messageSize[sv.frameNum % RATE_MESSAGES] = msg.curSize;
+	// Take the bytes out of the bucket. It may go below zero if the snapshot
+	// could not be shaped enough, in which case the next snapshots will wait.
+	if (cl->rateBudget)
+		cl->rateTokens -= cl->messageSize[sv.frameNum % RATE_MESSAGES];
+}
+
+/*
+ =================
+ SV_SendDownloadDatagram
+
+ Sends download blocks to a client that is not in the game yet
+ =================
+*/
+static void SV_SendDownloadDatagram (client_t *cl){
+
+	byte	data[MAX_FRAGMENTED_MSGLEN];
+	msg_t	msg;
+
+	if (cl->netChan.fragments)
+		MSG_Init(&msg, data, sizeof(data), true);
+	else
+		MSG_Init(&msg, data, MAX_MSGLEN, true);
+
+	if (cl->rateBudget)
+		SV_WriteDownloadBlocks(cl, &msg, cl->rateBudget);
+	else
+		SV_WriteDownloadBlocks(cl, &msg, msg.maxSize);
+
+	// Nothing to send, just update reliable if needed
+	if (!msg.curSize && !cl->netChan.message.curSize && Sys_Milliseconds() - cl->netChan.lastSent <= 1000)
+		return;
+
+	cl->messageSize[sv.frameNum % RATE_MESSAGES] = NetChan_Transmit(&cl->netChan, msg.data, msg.curSize);
+
+	if (cl->rateBudget)
+		cl->rateTokens -= cl->messageSize[sv.frameNum % RATE_MESSAGES];
+}
+
+/*
+ =================
+ SV_CullClientFrameJob
+ =================
+*/
+static void SV_CullClientFrameJob (void *data, int index){
+
+	SV_CullClientFrame(((client_t **)data)[index]);
+}
+
+/*
+ =================
+ SV_EncodeClientFrameJob
+ =================
+*/
+static void SV_EncodeClientFrameJob (void *data, int index){
+
+	SV_EncodeClientFrame(((client_t **)data)[index]);
+}
+
+/*
+ =================
+ SV_RunSnapshotJob
+ =================
+*/
+static void SV_RunSnapshotJob (jobFunction_t function, client_t **clients, int numClients){
+
+	int		i;
+
+	if (sv_parallelSnapshots->integerValue){
+		Job_Run(function, clients, numClients);
+		return;
+	}
+
+	for (i = 0; i < numClients; i++)
+		function(clients, i);
+}
+
+/*
+ =================
+ SV_SendSnapshots
+
+ Builds, encodes, and sends a snapshot to each of the given clients.
+ Culling and encoding are independent for every client, so they can be spread
+ across the job threads. Everything that touches shared state is done on the
+ main thread in client order, so the result is identical to building and
+ sending the snapshots one client at a time.
+ =================
+*/
+static void SV_SendSnapshots (client_t **clients, int numClients){
+
+	longlong	ticks;
+	int			i;
+
+	sv_stats.snapshots += numClients;
+
+	// Set up the frames and visibility data
+	ticks = Sys_ClockTicks();
+
+	SV_PrepareSnapshotEntities();
+
+	for (i = 0; i < numClients; i++)
+		SV_SetupClientFrame(clients[i]);
+
+	sv_stats.timeSetup += (int)((Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond());
+
+	// Find the visible entities
+	ticks = Sys_ClockTicks();
+
+	SV_RunSnapshotJob(SV_CullClientFrameJob, clients, numClients);
+
+	sv_stats.timeBuild += (int)((Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond());
+
+	// Copy the visible entities to the circular clientEntities array
+	ticks = Sys_ClockTicks();
+
+	for (i = 0; i < numClients; i++)
+		SV_CopyClientFrame(clients[i]);
+
+	sv_stats.timeCopy += (int)((Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond());
+
+	// Delta encode the frames
+	ticks = Sys_ClockTicks();
+
+	SV_ResetEncodeCache();
+
+	SV_RunSnapshotJob(SV_EncodeClientFrameJob, clients, numClients);
+
+	for (i = 0; i < numClients; i++){
+		svs.encodeCacheHits += clients[i]->snapshot.cacheHits;
+		svs.encodeCacheMisses += clients[i]->snapshot.cacheMisses;
+	}
+
+	sv_stats.timeEncode += (int)((Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond());
+
+	// Send the datagrams
+	ticks = Sys_ClockTicks();
+
+	for (i = 0; i < numClients; i++)
+		SV_SendClientDatagram(clients[i]);
+
+	sv_stats.timeTransmit += (int)((Sys_ClockTicks() - ticks) * 1000000 / Sys_ClockTicksPerSecond());
 }
 
 /*
@@ -447,6 +758,96 @@ static bool SV_RateDrop (client_t *cl){
 	return false;
 }
 
+/*
+ =================
+ SV_RateControl
+
+ Refills the client's token bucket and sets the number of bytes the next
+ snapshot can use. Returns true if the client is still paying for earlier
+ packets and should not be sent another one.
+ =================
+*/
+static bool SV_RateControl (client_t *cl){
+
+	float	capacity;
+	int		elapsed, budget;
+
+	cl->rateBudget = 0;
+	cl->rateDeferred = 0;
+
+	// Never limit the loopback
+	if (NET_IsLocalAddress(cl->netChan.remoteAddress))
+		return false;
+
+	if (!sv_rateControl->integerValue)
+		return SV_RateDrop(cl);
+
+	// Refill the bucket
+	elapsed = svs.realTime - cl->rateTime;
+	cl->rateTime = svs.realTime;
+
+	capacity = cl->rate * sv_rateBurst->integerValue * 0.001f;
+
+	cl->rateTokens = Min(cl->rateTokens + cl->rate * elapsed * 0.001f, capacity);
+
+	if (cl->rateTokens <= 0.0f){
+		cl->suppressCount++;
+		cl->rateSuppressedFrames++;
+		return true;
+	}
+
+	// The datagram and any pending reliable data go out along with the
+	// snapshot. Also keep the snapshot small enough to fit in a message, so
+	// large frames are split across several snapshots instead of being
+	// dropped.
+	if (cl->netChan.fragments)
+		budget = Min((int)cl->rateTokens, MAX_FRAGMENTED_MSGLEN - PACKET_HEADER);
+	else
+		budget = Min((int)cl->rateTokens, MAX_MSGLEN - PACKET_HEADER);
+
+	budget -= cl->datagram.curSize + cl->netChan.message.curSize;
+
+	cl->rateBudget = Max(budget, 1);
+
+	return false;
+}
+
+/*
+ =================
+ SV_RateStatus_f
+
+ Shows the rate control state for every client
+ =================
+*/
+void SV_RateStatus_f (void){
+
+	client_t	*cl;
+	int			i, j, total;
+
+	if (!svs.initialized){
+		Com_Printf("Server is not running\n");
+		return;
+	}
+
+	Com_Printf("\n");
+	Com_Printf("num rate  tokens budget sent/s shaped suppress deferred total    name\n");
+	Com_Printf("--- ----- ------ ------ ------ ------ -------- -------- -------- ---------------\n");
+
+	for (i = 0, cl = svs.clients; i < sv_maxClients->integerValue; i++, cl++){
+		if (cl->state == CS_FREE)
+			continue;
+
+		// The last RATE_MESSAGES frames add up to about a second
+		total = 0;
+		for (j = 0; j < RATE_MESSAGES; j++)
+			total += cl->messageSize[j];
+
+		Com_Printf("%3i %5i %6i %6i %6i %6i %8i %8i %8i %s\n", i, cl->rate, (int)cl->rateTokens, cl->rateBudget, total, cl->rateShapedFrames, cl->rateSuppressedFrames, cl->rateDeferred, (int)cl->rateDeferredTotal, cl->name);
+	}
+
+	Com_Printf("\n");
+}
+
 /*
  =================
  SV_SendClientMessages
@@ -454,9 +855,10 @@ static bool SV_RateDrop (client_t *cl){
 */
 void SV_SendClientMessages (void){
 
-	client_t	*cl;
-	byte		data[MAX_MSGLEN];
+	client_t	*cl, **clients;
+	byte		data[MAX_FRAGMENTED_MSGLEN];
 	int			i, r, length = 0;
+	int			numClients = 0;
 
 	// Read the next demo message if needed
 	if ((sv.state == SS_DEMO && sv.demoFile) && !com_paused->integerValue){
@@ -472,8 +874,8 @@ void SV_SendClientMessages (void){
 			return;
 		}
 
-		if (length > MAX_MSGLEN)
-			Com_Error(ERR_DROP, "SV_SendClientMessages: length > MAX_MSGLEN");
+		if (length > MAX_FRAGMENTED_MSGLEN)
+			Com_Error(ERR_DROP, "SV_SendClientMessages: length > MAX_FRAGMENTED_MSGLEN");
 
 		r = FS_Read(sv.demoFile, data, length);
 		if (r != length){
@@ -482,6 +884,8 @@ void SV_SendClientMessages (void){
 		}
 	}
 
+	clients = (client_t **)Mem_FrameAlloc(sv_maxClients->integerValue * sizeof(client_t *));
+
 	// Send a message to each connected client
 	for (i = 0, cl = svs.clients; i < sv_maxClients->integerValue; i++, cl++){
 		if (cl->state == CS_FREE)
@@ -499,10 +903,18 @@ void SV_SendClientMessages (void){
 			NetChan_Transmit(&cl->netChan, data, length);
 		else if (cl->state == CS_SPAWNED){
 			// Don't overrun bandwidth
-			if (SV_RateDrop(cl))
+			if (SV_RateControl(cl))
+				continue;
+
+			// Build a snapshot for this client
+			clients[numClients++] = cl;
+		}
+		else if (cl->downloadWindowed){
+			// Don't overrun bandwidth
+			if (SV_RateControl(cl))
 				continue;
 
-			SV_SendClientDatagram(cl);
+			SV_SendDownloadDatagram(cl);
 		}
 		else {
 			// Just update reliable	if needed
@@ -510,4 +922,8 @@ void SV_SendClientMessages (void){
 				NetChan_Transmit(&cl->netChan, NULL, 0);
 		}
 	}
+
+	// Build and send the snapshots
+	if (numClients)
+		SV_SendSnapshots(clients, numClients);
 }
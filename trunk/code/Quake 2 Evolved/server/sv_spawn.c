@@ -253,6 +253,9 @@ static void SV_SpawnServer (const char *levelName, const char *spawnPoint, bool
 			svs.clients[i].state = CS_CONNECTED;
 
 		svs.clients[i].lastFrame = -1;
+
+		// Entity numbers and frame numbers start over
+		Mem_Fill(svs.clients[i].entityDeferred, 0, sizeof(svs.clients[i].entityDeferred));
 	}
 
 	if (serverState == SS_GAME){
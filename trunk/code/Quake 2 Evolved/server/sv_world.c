@@ -35,12 +35,15 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 
 // FIXME: remove this mess!
-#define	STRUCT_FROM_LINK(l,t,m) ((t *)((byte *)l - (int)&(((t *)0)->m)))
+#define	STRUCT_FROM_LINK(l,t,m) ((t *)((byte *)l - (size_t)&(((t *)0)->m)))
 #define	EDICT_FROM_AREA(l)		STRUCT_FROM_LINK(l, edict_t, area)
 
 #define	AREA_DEPTH				4
 #define	AREA_NODES				32
 
+#define AREA_GRID_CELLS			64			// Cells per axis
+#define AREA_GRID_MIN_SIZE		64.0f		// Minimum cell size
+
 typedef struct areaNode_s {
 	struct	areaNode_s *children[2];
 
@@ -51,9 +54,32 @@ typedef struct areaNode_s {
 	link_t	solidEdicts;
 } areaNode_t;
 
+// The loose grid is an alternative to the areanode tree.
+// Entities are linked into the cell that contains the center of their bounds,
+// so a cell may hold entities that extend up to a full cell size past its
+// edges, and queries must check one extra cell in every direction.
+// Entities too large for that are linked into a separate list that is always
+// checked.
+typedef struct {
+	link_t	triggerEdicts;
+	link_t	solidEdicts;
+} areaCell_t;
+
+typedef struct {
+	vec2_t		origin;
+	vec2_t		cellSize;
+	vec2_t		invCellSize;
+
+	areaCell_t	cells[AREA_GRID_CELLS][AREA_GRID_CELLS];
+	areaCell_t	largeEdicts;
+} areaGrid_t;
+
 static areaNode_t	sv_areaNodes[AREA_NODES];
 static int			sv_numAreaNodes;
 
+static bool			sv_areaUseGrid;
+static areaGrid_t	sv_looseGrid;
+
 static float		*sv_areaMins, *sv_areaMaxs;
 static edict_t		**sv_areaList;
 static int			sv_areaCount, sv_areaMaxCount;
@@ -140,6 +166,55 @@ static areaNode_t *SV_CreateAreaNode (int depth, vec3_t mins, vec3_t maxs){
 	return areaNode;
 }
 
+/*
+ =================
+ SV_CreateAreaGrid
+
+ Sizes the grid cells so the grid covers the given world size
+ =================
+*/
+static void SV_CreateAreaGrid (vec3_t mins, vec3_t maxs){
+
+	areaGrid_t	*grid = &sv_looseGrid;
+	int			i, x, y;
+
+	for (i = 0; i < 2; i++){
+		grid->origin[i] = mins[i];
+
+		grid->cellSize[i] = (maxs[i] - mins[i]) / AREA_GRID_CELLS;
+		if (grid->cellSize[i] < AREA_GRID_MIN_SIZE)
+			grid->cellSize[i] = AREA_GRID_MIN_SIZE;
+
+		grid->invCellSize[i] = 1.0f / grid->cellSize[i];
+	}
+
+	for (y = 0; y < AREA_GRID_CELLS; y++){
+		for (x = 0; x < AREA_GRID_CELLS; x++){
+			SV_ClearLink(&grid->cells[y][x].triggerEdicts);
+			SV_ClearLink(&grid->cells[y][x].solidEdicts);
+		}
+	}
+
+	SV_ClearLink(&grid->largeEdicts.triggerEdicts);
+	SV_ClearLink(&grid->largeEdicts.solidEdicts);
+}
+
+/*
+ =================
+ SV_AreaGridCell
+
+ Returns the grid cell index along the given axis, clamped to the grid
+ =================
+*/
+static int SV_AreaGridCell (float v, int axis){
+
+	int		cell;
+
+	cell = (int)floor((v - sv_looseGrid.origin[axis]) * sv_looseGrid.invCellSize[axis]);
+
+	return ClampInt(cell, 0, AREA_GRID_CELLS - 1);
+}
+
 /*
  =================
  SV_ClearWorld
@@ -151,6 +226,12 @@ void SV_ClearWorld (void){
 	sv_numAreaNodes = 0;
 
 	SV_CreateAreaNode(0, sv.models[1]->mins, sv.models[1]->maxs);
+
+	// Create the grid if desired
+	sv_areaUseGrid = sv_areaGrid->integerValue;
+
+	if (sv_areaUseGrid)
+		SV_CreateAreaGrid(sv.models[1]->mins, sv.models[1]->maxs);
 }
 
 /*
@@ -178,6 +259,7 @@ void SV_LinkEdict (edict_t *ent){
 #define MAX_ENT_LEAFS	128
 
 	areaNode_t	*node;
+	areaCell_t	*cell;
 	float		max, v;
 	int			leafs[MAX_ENT_LEAFS];
 	int			clusters[MAX_ENT_LEAFS];
@@ -325,6 +407,26 @@ void SV_LinkEdict (edict_t *ent){
 	if (ent->solid == SOLID_NOT)
 		return;
 
+	// Find the grid cell that contains the center of the entity's box
+	if (sv_areaUseGrid){
+		cell = &sv_looseGrid.largeEdicts;
+
+		if (ent->absmax[0] - ent->absmin[0] <= sv_looseGrid.cellSize[0] * 2.0f && ent->absmax[1] - ent->absmin[1] <= sv_looseGrid.cellSize[1] * 2.0f){
+			i = SV_AreaGridCell(0.5f * (ent->absmin[0] + ent->absmax[0]), 0);
+			j = SV_AreaGridCell(0.5f * (ent->absmin[1] + ent->absmax[1]), 1);
+
+			cell = &sv_looseGrid.cells[j][i];
+		}
+
+		// Link it in
+		if (ent->solid == SOLID_TRIGGER)
+			SV_InsertLinkBefore(&ent->area, &cell->triggerEdicts);
+		else
+			SV_InsertLinkBefore(&ent->area, &cell->solidEdicts);
+
+		return;
+	}
+
 	// Find the first node that the entity's box crosses
 	node = sv_areaNodes;
 	while (1){
@@ -348,21 +450,15 @@ void SV_LinkEdict (edict_t *ent){
 
 /*
  =================
- SV_AreaEdicts_r
+ SV_AreaEdictsInList
  =================
 */
-static void SV_AreaEdicts_r (areaNode_t *node){
+static void SV_AreaEdictsInList (link_t *start){
 
-	link_t		*l, *next, *start;
+	link_t		*l, *next;
 	edict_t		*check;
-	int			count = 0;
 
 	// Touch linked edicts
-	if (sv_areaType == AREA_SOLID)
-		start = &node->solidEdicts;
-	else
-		start = &node->triggerEdicts;
-
 	for (l = start->next; l != start; l = next){
 		next = l->next;
 		check = EDICT_FROM_AREA(l);
@@ -374,13 +470,27 @@ static void SV_AreaEdicts_r (areaNode_t *node){
 			continue;		// Not touching
 
 		if (sv_areaCount == sv_areaMaxCount){
-			Com_DPrintf(S_COLOR_YELLOW "SV_AreaEdicts_r: MAXCOUNT\n");
+			Com_DPrintf(S_COLOR_YELLOW "SV_AreaEdicts: MAXCOUNT\n");
 			return;
 		}
 
 		sv_areaList[sv_areaCount] = check;
 		sv_areaCount++;
 	}
+}
+
+/*
+ =================
+ SV_AreaEdicts_r
+ =================
+*/
+static void SV_AreaEdicts_r (areaNode_t *node){
+
+	// Touch linked edicts
+	if (sv_areaType == AREA_SOLID)
+		SV_AreaEdictsInList(&node->solidEdicts);
+	else
+		SV_AreaEdictsInList(&node->triggerEdicts);
 
 	if (node->axis == -1)
 		return;		// Terminal node
@@ -392,6 +502,40 @@ static void SV_AreaEdicts_r (areaNode_t *node){
 		SV_AreaEdicts_r(node->children[1]);
 }
 
+/*
+ =================
+ SV_AreaEdictsGrid
+ =================
+*/
+static void SV_AreaEdictsGrid (void){
+
+	areaCell_t	*cell;
+	int			x, y, minX, minY, maxX, maxY;
+
+	// Entities may extend up to a full cell past the cell they are in
+	minX = SV_AreaGridCell(sv_areaMins[0] - sv_looseGrid.cellSize[0], 0);
+	minY = SV_AreaGridCell(sv_areaMins[1] - sv_looseGrid.cellSize[1], 1);
+	maxX = SV_AreaGridCell(sv_areaMaxs[0] + sv_looseGrid.cellSize[0], 0);
+	maxY = SV_AreaGridCell(sv_areaMaxs[1] + sv_looseGrid.cellSize[1], 1);
+
+	for (y = minY; y <= maxY; y++){
+		for (x = minX; x <= maxX; x++){
+			cell = &sv_looseGrid.cells[y][x];
+
+			if (sv_areaType == AREA_SOLID)
+				SV_AreaEdictsInList(&cell->solidEdicts);
+			else
+				SV_AreaEdictsInList(&cell->triggerEdicts);
+		}
+	}
+
+	// Check the entities that are too large for the grid
+	if (sv_areaType == AREA_SOLID)
+		SV_AreaEdictsInList(&sv_looseGrid.largeEdicts.solidEdicts);
+	else
+		SV_AreaEdictsInList(&sv_looseGrid.largeEdicts.triggerEdicts);
+}
+
 /*
  =================
  SV_AreaEdicts
@@ -406,12 +550,14 @@ int SV_AreaEdicts (vec3_t mins, vec3_t maxs, edict_t **list, int maxCount, int a
 	sv_areaMaxCount = maxCount;
 	sv_areaType = areaType;
 
-	SV_AreaEdicts_r(sv_areaNodes);
+	if (sv_areaUseGrid)
+		SV_AreaEdictsGrid();
+	else
+		SV_AreaEdicts_r(sv_areaNodes);
 
 	return sv_areaCount;
 }
 
-
 // =====================================================================
 
 typedef struct {
@@ -604,3 +750,139 @@ int SV_PointContents (vec3_t p){
 
 	return contents;
 }
+
+
+/*
+ =======================================================================
+
+ BENCHMARK
+
+ =======================================================================
+*/
+
+
+/*
+ =================
+ SV_BenchmarkRandom
+ =================
+*/
+static float SV_BenchmarkRandom (uint *seed){
+
+	*seed = *seed * 1664525 + 1013904223;
+
+	return (float)(*seed >> 8) / (float)(1 << 24);
+}
+
+/*
+ =================
+ SV_BenchmarkAreaEdicts_f
+
+ Links a number of unused edicts as moving boxes, and measures how long it
+ takes to link them and to query the area around each one of them
+ =================
+*/
+void SV_BenchmarkAreaEdicts_f (void){
+
+	edict_t		*touchList[MAX_EDICTS], *ent;
+	byte		*saved;
+	vec3_t		mins, maxs;
+	longlong	ticks, linkTicks = 0, queryTicks = 0;
+	double		linkSeconds, querySeconds;
+	uint		seed = 1;
+	int			first, numEntities, numFrames, numTouched = 0;
+	int			i, j, frame;
+
+	if (Cmd_Argc() < 2 || Cmd_Argc() > 3){
+		Com_Printf("Usage: benchmarkAreaEdicts <numEntities> [frames]\n");
+		return;
+	}
+
+	if (sv.state != SS_GAME){
+		Com_Printf("No map loaded\n");
+		return;
+	}
+
+	// Use the edicts the game is not using
+	first = ge->num_edicts;
+
+	if (first >= ge->max_edicts){
+		Com_Printf("No free edicts\n");
+		return;
+	}
+
+	numEntities = ClampInt(Str_ToInteger(Cmd_Argv(1)), 1, ge->max_edicts - first);
+
+	if (Cmd_Argc() == 3)
+		numFrames = ClampInt(Str_ToInteger(Cmd_Argv(2)), 1, 1000);
+	else
+		numFrames = 100;
+
+	// Save the edicts so they can be restored when done
+	saved = (byte *)Mem_Alloc(numEntities * ge->edict_size, TAG_TEMPORARY);
+	Mem_Copy(saved, EDICT_NUM(first), numEntities * ge->edict_size);
+
+	// Set up monster sized boxes at random positions, with a few triggers
+	for (i = 0; i < numEntities; i++){
+		ent = EDICT_NUM(first + i);
+
+		Mem_Fill(ent, 0, ge->edict_size);
+
+		ent->inuse = true;
+		ent->solid = (i & 7) ? SOLID_BBOX : SOLID_TRIGGER;
+
+		VectorSet(ent->mins, -16.0f, -16.0f, -24.0f);
+		VectorSet(ent->maxs, 16.0f, 16.0f, 32.0f);
+
+		for (j = 0; j < 3; j++)
+			ent->s.origin[j] = sv.models[1]->mins[j] + (sv.models[1]->maxs[j] - sv.models[1]->mins[j]) * SV_BenchmarkRandom(&seed);
+	}
+
+	// Run the frames
+	for (frame = 0; frame < numFrames; frame++){
+		// Move and link all the entities
+		ticks = Sys_ClockTicks();
+
+		for (i = 0; i < numEntities; i++){
+			ent = EDICT_NUM(first + i);
+
+			for (j = 0; j < 3; j++){
+				ent->s.origin[j] += (SV_BenchmarkRandom(&seed) - 0.5f) * 64.0f;
+				ent->s.origin[j] = ClampFloat(ent->s.origin[j], sv.models[1]->mins[j], sv.models[1]->maxs[j]);
+			}
+
+			SV_LinkEdict(ent);
+		}
+
+		linkTicks += Sys_ClockTicks() - ticks;
+
+		// Query the area around every entity, like a movement trace would
+		ticks = Sys_ClockTicks();
+
+		for (i = 0; i < numEntities; i++){
+			ent = EDICT_NUM(first + i);
+
+			for (j = 0; j < 3; j++){
+				mins[j] = ent->absmin[j] - 64.0f;
+				maxs[j] = ent->absmax[j] + 64.0f;
+			}
+
+			numTouched += SV_AreaEdicts(mins, maxs, touchList, MAX_EDICTS, AREA_SOLID);
+		}
+
+		queryTicks += Sys_ClockTicks() - ticks;
+	}
+
+	// Unlink and restore the edicts
+	for (i = 0; i < numEntities; i++)
+		SV_UnlinkEdict(EDICT_NUM(first + i));
+
+	Mem_Copy(EDICT_NUM(first), saved, numEntities * ge->edict_size);
+	Mem_Free(saved);
+
+	linkSeconds = (double)linkTicks / Sys_ClockTicksPerSecond();
+	querySeconds = (double)queryTicks / Sys_ClockTicksPerSecond();
+
+	Com_Printf("%i entities, %i frames, using the %s\n", numEntities, numFrames, (sv_areaUseGrid) ? "loose grid" : "areanode tree");
+	Com_Printf("link: %.2f msec total, %.0f links/sec\n", linkSeconds * 1000.0, (numEntities * numFrames) / linkSeconds);
+	Com_Printf("query: %.2f msec total, %.0f queries/sec, %.1f entities per query\n", querySeconds * 1000.0, (numEntities * numFrames) / querySeconds, (float)numTouched / (numEntities * numFrames));
+}
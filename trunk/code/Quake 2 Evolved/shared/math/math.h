@@ -30,6 +30,10 @@
 #define __MATH_MATH_H__
 
 
+// The system math header may define these as doubles
+#undef M_E
+#undef M_PI
+
 #define M_E							2.71828182845904523536f
 #define M_PI						3.14159265358979323846f
 #define M_PI_TWO					6.28318530717958647692f
@@ -87,6 +87,8 @@ typedef unsigned __int64			ulonglong;
 
 #define INLINE						__forceinline
 
+#define THREAD_LOCAL				__declspec(thread)
+
 #define ALIGN_8(x)					__declspec(align(8)) x
 #define ALIGN_16(x)					__declspec(align(16)) x
 #define ALIGN_32(x)					__declspec(align(32)) x
@@ -119,6 +121,9 @@ typedef uint64_t					ulonglong;
 #if defined __i386__
 #define CPU_STRING					"x86"
 #define BUILD_STRING				"Linux-x86"
+#elif defined __x86_64__
+#define CPU_STRING					"x86_64"
+#define BUILD_STRING				"Linux-x86_64"
 #elif defined __ppc__
 #define CPU_STRING					"PPC"
 #define BUILD_STRING				"Linux-PPC"
@@ -132,13 +137,19 @@ typedef uint64_t					ulonglong;
 
 #define NEWLINE						"\n"
 
-#define INLINE						inline
+#define INLINE						inline __attribute__ ((always_inline))
+
+#define THREAD_LOCAL				__thread
 
 #define ALIGN_8(x)					x __attribute__ ((aligned(8)))
 #define ALIGN_16(x)					x __attribute__ ((aligned(16)))
 #define ALIGN_32(x)					x __attribute__ ((aligned(32)))
 
-#if defined __i386__
+// glibc defines these as byte order values, so leave them alone if the
+// system headers already did
+#if !defined LITTLE_ENDIAN && !defined BIG_ENDIAN
+
+#if defined __i386__ || defined __x86_64__
 
 #define LITTLE_ENDIAN				1
 #define BIG_ENDIAN					0
@@ -152,6 +163,8 @@ typedef uint64_t					ulonglong;
 
 #endif
 
+#endif
+
 /*
  ==============================================================================
 
@@ -187,6 +200,8 @@ typedef uint64_t					ulonglong;
 
 #define INLINE						inline
 
+#define THREAD_LOCAL				__thread
+
 #define ALIGN_8(x)					x __attribute__ ((aligned(8)))
 #define ALIGN_16(x)					x __attribute__ ((aligned(16)))
 #define ALIGN_32(x)					x __attribute__ ((aligned(32)))
@@ -250,7 +265,11 @@ typedef unsigned long				ulong;
 
 typedef uchar						byte;
 typedef ushort						word;
+#ifdef __LP64__
+typedef uint						dword;
+#else
 typedef ulong						dword;
+#endif
 typedef ulonglong					qword;
 
 typedef ushort						half;
@@ -1225,7 +1244,7 @@ typedef struct entity_state_s {
 // to render a view. There will only be 10 player_state_t sent each 
 // second, but the number of pmove_state_t changes will be relative to 
 // client frame rates
-typedef struct {
+typedef struct player_state_s {
 	pmove_state_t	pmove;			// For prediction
 
 	// These fields do not need to be communicated bit-precise
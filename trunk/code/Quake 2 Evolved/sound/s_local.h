@@ -300,12 +300,16 @@ typedef struct {
 
 	short					samples[MUSIC_BUFFER_SAMPLES][2];
 
-	fileHandle_t			oggFile;
+	fileHandle_t			oggFile;			// Only one of oggFile or
+	const byte *			oggData;			// oggData will be used
 	int						oggSize;
 	int						oggSkip;
 	int						oggOffset;
 
 	OggVorbis_File *		oggVorbisBitstream;
+
+	asyncRead_t				prefetchRead;		// Loop track being read in the background
+	char					prefetchTrack[MAX_PATH_LENGTH];
 } music_t;
 
 void				S_UpdateMusic ();
@@ -52,7 +52,11 @@ static size_t S_ReadOGG (void *buffer, size_t size, size_t count, void *data){
 	if (snd.music.oggOffset + bytes > snd.music.oggSize)
 		bytes = snd.music.oggSize - snd.music.oggOffset;
 
-	bytes = FS_Read(snd.music.oggFile, buffer, bytes);
+	if (snd.music.oggData)
+		Mem_Copy(buffer, snd.music.oggData + snd.music.oggOffset, bytes);
+	else
+		bytes = FS_Read(snd.music.oggFile, buffer, bytes);
+
 	snd.music.oggOffset += bytes;
 
 	return bytes / size;
@@ -65,6 +69,9 @@ static size_t S_ReadOGG (void *buffer, size_t size, size_t count, void *data){
 */
 static long S_TellOGG (void *data){
 
+	if (snd.music.oggData)
+		return snd.music.oggOffset;
+
 	return FS_Tell(snd.music.oggFile);
 }
 
@@ -75,6 +82,28 @@ static long S_TellOGG (void *data){
 */
 static int S_SeekOGG (void *data, ogg_int64_t offset, int origin){
 
+	if (snd.music.oggData){
+		switch (origin){
+		case SEEK_SET:
+			break;
+		case SEEK_CUR:
+			offset += snd.music.oggOffset;
+			break;
+		case SEEK_END:
+			offset += snd.music.oggSize;
+			break;
+		default:
+			return -1;
+		}
+
+		if (offset < 0 || offset > snd.music.oggSize)
+			return -1;
+
+		snd.music.oggOffset = (int)offset;
+
+		return 0;
+	}
+
 	switch (origin){
 	case SEEK_SET:
 		FS_Seek(snd.music.oggFile, (int)offset, FS_SEEK_SET);
@@ -183,11 +212,21 @@ static bool S_OpenMusicTrack (const char *name){
 	ov_callbacks	callbacks = {S_ReadOGG, S_SeekOGG, S_CloseOGG, S_TellOGG};
 	vorbis_info		*info;
 
+	// Use the prefetched file if available
+	if (snd.music.prefetchRead && !Str_ICompare(snd.music.prefetchTrack, name)){
+		if (FS_WaitAsyncRead(snd.music.prefetchRead, (void **)&snd.music.oggData, &snd.music.oggSize) != ASYNC_COMPLETE)
+			snd.music.oggData = NULL;
+
+		snd.music.prefetchRead = 0;
+	}
+
 	// Open the file
-	snd.music.oggSize = FS_OpenFile(name, FS_READ, &snd.music.oggFile);
-	if (!snd.music.oggFile){
-		Com_Printf("Music file %s not found\n", name);
-		return false;
+	if (!snd.music.oggData){
+		snd.music.oggSize = FS_OpenFile(name, FS_READ, &snd.music.oggFile);
+		if (!snd.music.oggFile){
+			Com_Printf("Music file %s not found\n", name);
+			return false;
+		}
 	}
 
 	snd.music.oggOffset = 0;
@@ -233,6 +272,35 @@ static void S_CloseMusicTrack (){
 		FS_CloseFile(snd.music.oggFile);
 		snd.music.oggFile = 0;
 	}
+
+	// Free the prefetched file
+	if (snd.music.oggData){
+		FS_FreeFile(snd.music.oggData);
+		snd.music.oggData = NULL;
+	}
+}
+
+/*
+ ==================
+ S_PrefetchMusicTrack
+
+ Starts reading the loop track in the background while the intro track is
+ playing, so switching tracks doesn't stall on disk access
+ ==================
+*/
+static void S_PrefetchMusicTrack (){
+
+	if (snd.music.prefetchRead){
+		FS_CancelAsyncRead(snd.music.prefetchRead);
+		snd.music.prefetchRead = 0;
+	}
+
+	if (!Str_ICompare(snd.music.introTrack, snd.music.loopTrack))
+		return;
+
+	Str_Copy(snd.music.prefetchTrack, snd.music.loopTrack, sizeof(snd.music.prefetchTrack));
+
+	snd.music.prefetchRead = FS_ReadFileAsync(snd.music.loopTrack, FS_PRIORITY_LOW, NULL, NULL);
 }
 
 /*
@@ -363,6 +431,9 @@ static bool S_StreamMusicTrack (){
 		if (!S_OpenMusicTrack(snd.music.introTrack))
 			return false;
 
+		// Start reading the loop track
+		S_PrefetchMusicTrack();
+
 		return true;
 	}
 
@@ -414,6 +485,9 @@ void S_PlayMusic (const char *introTrack, const char *loopTrack, int fadeUpTime)
 		S_StopMusic();
 		return;
 	}
+
+	// Start reading the loop track
+	S_PrefetchMusicTrack();
 }
 
 /*
@@ -489,6 +563,10 @@ void S_StopMusic (){
 	// Close the music track
 	S_CloseMusicTrack();
 
+	// Cancel any prefetching
+	if (snd.music.prefetchRead)
+		FS_CancelAsyncRead(snd.music.prefetchRead);
+
 	Mem_Fill(&snd.music, 0, sizeof(music_t));
 }
 
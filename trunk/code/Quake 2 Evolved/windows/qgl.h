@@ -30,10 +30,16 @@
 #define __QGL_H__
 
 
-#ifdef _WIN32
+#if defined(_WIN32)
 
 #include <GL/gl.h>
 
+#elif defined(__linux__)
+
+// Our own glext.h is included below
+#define GL_GLEXT_LEGACY
+#include <GL/gl.h>
+
 #else
 
 #error "QGL not available for this platform"
@@ -42,7 +48,10 @@
 
 
 #include "../include/OpenGL/glext.h"
+
+#ifdef _WIN32
 #include "../include/OpenGL/wglext.h"
+#endif
 
 
 // ============================================================================
@@ -1577,5 +1586,17 @@ void			QGL_LogPrintf (const char *fmt, ...);
 bool			QGL_Init (const char *driver);
 void			QGL_Shutdown ();
 
+// The null driver records calls instead of rendering, and is selected by
+// passing GL_DRIVER_NULL to QGL_Init. It has no window or display, so the
+// platform code calls these instead of the native swap and lookup functions
+bool			QGL_InitNull ();
+void			QGL_ShutdownNull ();
+
+void *			QGL_NullGetProcAddress (const char *procName);
+void			QGL_NullSwapBuffers ();
+
+void			QGL_ResetNullStats ();
+void			QGL_PrintNullStats ();
+
 
 #endif	// __QGL_H__
\ No newline at end of file
@@ -47,6 +47,8 @@ typedef struct {
 	HDC						hDCFake;
 	HGLRC					hGLRCFake;
 
+	bool					nullDriver;
+
 	int						desktopWidth;
 	int						desktopHeight;
 	int						desktopBitDepth;
@@ -119,7 +121,11 @@ static void *GLW_GetProcAddress (const char *procName){
 
 	void	*procAddress;
 
-	procAddress = qwglGetProcAddress(procName);
+	if (glwState.nullDriver)
+		procAddress = QGL_NullGetProcAddress(procName);
+	else
+		procAddress = qwglGetProcAddress(procName);
+
 	if (!procAddress){
 		GLW_Shutdown();
 
@@ -1077,6 +1083,11 @@ static bool GLW_SetDisplayMode (){
 	else
 		Com_Printf("windowed\n");
 
+	// The null driver has nothing to display, so leave the desktop alone and
+	// don't create a window
+	if (glwState.nullDriver)
+		return true;
+
 	// Get desktop attributes
 	hDC = GetDC(GetDesktopWindow());
 
@@ -1342,6 +1353,12 @@ void GLW_SwapBuffers (){
 
 	int		interval;
 
+	// The null driver has nothing to present
+	if (glwState.nullDriver){
+		QGL_NullSwapBuffers();
+		return;
+	}
+
 	if (!glwState.hDC)
 		return;
 
@@ -1391,6 +1408,8 @@ void GLW_Init (){
 	else
 		driver = GL_DRIVER_OPENGL;
 
+	glwState.nullDriver = !Str_ICompare(driver, GL_DRIVER_NULL);
+
 	if (!QGL_Init(driver))
 		Com_Error(ERR_FATAL, "GLW_Init: could not load OpenGL subsystem");
 
@@ -1415,7 +1434,10 @@ void GLW_Init (){
 	glConfig.extensionsString = (const char *)qglGetString(GL_EXTENSIONS);
 
 	// Get WGL strings if available
-	qwglGetExtensionsStringARB = (PFNWGLGETEXTENSIONSSTRINGARBPROC)qwglGetProcAddress("wglGetExtensionsStringARB");
+	if (!glwState.nullDriver)
+		qwglGetExtensionsStringARB = (PFNWGLGETEXTENSIONSSTRINGARBPROC)qwglGetProcAddress("wglGetExtensionsStringARB");
+	else
+		qwglGetExtensionsStringARB = NULL;
 
 	if (qwglGetExtensionsStringARB)
 		glConfig.wglExtensionsString = qwglGetExtensionsStringARB(glwState.hDC);
@@ -11708,6 +11708,10 @@ bool QGL_Init (const char *driver){
 
 	Com_Printf("...initializing QGL\n");
 
+	// Bind to the null driver if requested
+	if (!Str_ICompare(driver, GL_DRIVER_NULL))
+		return QGL_InitNull();
+
 	Str_Copy(name, driver, sizeof(name));
 	Str_DefaultFileExtension(name, sizeof(name), LIBRARY_EXTENSION);
 
@@ -12498,6 +12502,8 @@ void QGL_Shutdown (){
 		qglState.hModule = NULL;
 	}
 
+	QGL_ShutdownNull();
+
 	Mem_Fill(&qglState, 0, sizeof(qglState_t));
 
 	qwglChoosePixelFormat					= NULL;
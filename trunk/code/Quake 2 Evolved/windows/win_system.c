@@ -29,8 +29,16 @@
 #include "../common/common.h"
 #include "win_local.h"
 #include <float.h>
+#include <process.h>
 
 
+typedef struct {
+	HANDLE					handle;
+
+	void					(*function)(void *);
+	void *					data;
+} thread_t;
+
 static cvar_t *				sys_osVersion;
 static cvar_t *				sys_processor;
 static cvar_t *				sys_memory;
@@ -420,6 +428,58 @@ int Sys_DiskFreeSpace (const char *directory){
 	return freeMegs;
 }
 
+/*
+ ==================
+ Sys_MapFile
+ ==================
+*/
+const void *Sys_MapFile (const char *path, int *size){
+
+	HANDLE	hFile, hMapping;
+	void	*data;
+
+	*size = 0;
+
+	// Open the file
+	hFile = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	*size = GetFileSize(hFile, NULL);
+	if (*size <= 0){
+		CloseHandle(hFile);
+		return NULL;
+	}
+
+	// Map the entire file, read-only
+	hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!hMapping){
+		CloseHandle(hFile);
+		return NULL;
+	}
+
+	data = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+
+	// The view keeps the mapping alive, so we can close the handles now
+	CloseHandle(hMapping);
+	CloseHandle(hFile);
+
+	return data;
+}
+
+/*
+ ==================
+ Sys_UnmapFile
+ ==================
+*/
+void Sys_UnmapFile (const void *data){
+
+	if (!data)
+		Com_Error(ERR_FATAL, "Sys_UnmapFile: NULL data");
+
+	UnmapViewOfFile(data);
+}
+
 
 /*
  ==============================================================================
@@ -468,6 +528,260 @@ void *Sys_GetProcAddress (void *libHandle, const char *procName){
 }
 
 
+/*
+ ==============================================================================
+
+ SYNCHRONIZATION
+
+ ==============================================================================
+*/
+
+
+/*
+ ==================
+ Sys_SetThreadName
+
+ Sets the thread name displayed by the debugger
+ ==================
+*/
+static void Sys_SetThreadName (DWORD threadId, const char *name){
+
+	struct {
+		DWORD				type;
+		LPCSTR				name;
+		DWORD				threadId;
+		DWORD				flags;
+	} info;
+
+	info.type = 0x1000;
+	info.name = name;
+	info.threadId = threadId;
+	info.flags = 0;
+
+	__try {
+		RaiseException(0x406D1388, 0, sizeof(info) / sizeof(ULONG_PTR), (const ULONG_PTR *)&info);
+	}
+	__except (EXCEPTION_CONTINUE_EXECUTION){
+	}
+}
+
+/*
+ ==================
+ Sys_ThreadProc
+ ==================
+*/
+static unsigned __stdcall Sys_ThreadProc (void *param){
+
+	thread_t	*thread = (thread_t *)param;
+
+	thread->function(thread->data);
+
+	return 0;
+}
+
+/*
+ ==================
+ Sys_CreateThread
+ ==================
+*/
+void *Sys_CreateThread (void (*function)(void *), void *data, const char *name){
+
+	thread_t	*thread;
+	unsigned	threadId;
+
+	thread = (thread_t *)malloc(sizeof(thread_t));
+	if (!thread)
+		Com_Error(ERR_FATAL, "Sys_CreateThread: failed to allocate thread");
+
+	thread->function = function;
+	thread->data = data;
+
+	thread->handle = (HANDLE)_beginthreadex(NULL, 0, Sys_ThreadProc, thread, CREATE_SUSPENDED, &threadId);
+	if (!thread->handle)
+		Com_Error(ERR_FATAL, "Sys_CreateThread: failed to create thread '%s'", name);
+
+	Sys_SetThreadName(threadId, name);
+
+	ResumeThread(thread->handle);
+
+	return thread;
+}
+
+/*
+ ==================
+ Sys_DestroyThread
+ ==================
+*/
+void Sys_DestroyThread (void *thread){
+
+	if (!thread)
+		Com_Error(ERR_FATAL, "Sys_DestroyThread: invalid thread");
+
+	WaitForSingleObject(((thread_t *)thread)->handle, INFINITE);
+	CloseHandle(((thread_t *)thread)->handle);
+
+	free(thread);
+}
+
+/*
+ ==================
+ Sys_CreateEvent
+ ==================
+*/
+void *Sys_CreateEvent (bool manualReset){
+
+	HANDLE	event;
+
+	event = CreateEvent(NULL, manualReset, FALSE, NULL);
+	if (!event)
+		Com_Error(ERR_FATAL, "Sys_CreateEvent: failed to create event");
+
+	return event;
+}
+
+/*
+ ==================
+ Sys_DestroyEvent
+ ==================
+*/
+void Sys_DestroyEvent (void *event){
+
+	if (!event)
+		Com_Error(ERR_FATAL, "Sys_DestroyEvent: invalid event");
+
+	CloseHandle((HANDLE)event);
+}
+
+/*
+ ==================
+ Sys_SignalEvent
+ ==================
+*/
+void Sys_SignalEvent (void *event){
+
+	SetEvent((HANDLE)event);
+}
+
+/*
+ ==================
+ Sys_ResetEvent
+ ==================
+*/
+void Sys_ResetEvent (void *event){
+
+	ResetEvent((HANDLE)event);
+}
+
+/*
+ ==================
+ Sys_WaitEvent
+ ==================
+*/
+bool Sys_WaitEvent (void *event, int msec){
+
+	if (WaitForSingleObject((HANDLE)event, (msec < 0) ? INFINITE : msec) != WAIT_OBJECT_0)
+		return false;
+
+	return true;
+}
+
+/*
+ ==================
+ Sys_CreateMutex
+ ==================
+*/
+void *Sys_CreateMutex (){
+
+	CRITICAL_SECTION	*mutex;
+
+	mutex = (CRITICAL_SECTION *)malloc(sizeof(CRITICAL_SECTION));
+	if (!mutex)
+		Com_Error(ERR_FATAL, "Sys_CreateMutex: failed to allocate mutex");
+
+	InitializeCriticalSectionAndSpinCount(mutex, 1000);
+
+	return mutex;
+}
+
+/*
+ ==================
+ Sys_DestroyMutex
+ ==================
+*/
+void Sys_DestroyMutex (void *mutex){
+
+	if (!mutex)
+		Com_Error(ERR_FATAL, "Sys_DestroyMutex: invalid mutex");
+
+	DeleteCriticalSection((CRITICAL_SECTION *)mutex);
+
+	free(mutex);
+}
+
+/*
+ ==================
+ Sys_LockMutex
+ ==================
+*/
+void Sys_LockMutex (void *mutex){
+
+	EnterCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+/*
+ ==================
+ Sys_TryLockMutex
+ ==================
+*/
+bool Sys_TryLockMutex (void *mutex){
+
+	if (!TryEnterCriticalSection((CRITICAL_SECTION *)mutex))
+		return false;
+
+	return true;
+}
+
+/*
+ ==================
+ Sys_UnlockMutex
+ ==================
+*/
+void Sys_UnlockMutex (void *mutex){
+
+	LeaveCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+/*
+ ==================
+ Sys_AtomicIncrement
+ ==================
+*/
+int Sys_AtomicIncrement (volatile int *value){
+
+	return InterlockedIncrement((volatile LONG *)value);
+}
+
+/*
+ ==================
+ Sys_AtomicDecrement
+ ==================
+*/
+int Sys_AtomicDecrement (volatile int *value){
+
+	return InterlockedDecrement((volatile LONG *)value);
+}
+
+/*
+ ==================
+ Sys_AtomicAdd
+ ==================
+*/
+int Sys_AtomicAdd (volatile int *value, int amount){
+
+	return InterlockedExchangeAdd((volatile LONG *)value, amount) + amount;
+}
+
+
 /*
  ==============================================================================
 